@@ -36,10 +36,12 @@ public:
     AstType getAstType() const override {return AstType::Literal;}
     UniquePtr<BaseAST> clone() const override;
     LitNode getValue();
+    const Node& getValueNode() const { return value.getValueNode(); }
 
 
 private:
     LitNode value;
+    friend class AstOptimizer;
 };
 
 class VariableDeclaration : public ASTStatement {
@@ -63,6 +65,7 @@ public:
     );
     
     friend class AttributeDeclaration;
+    friend class AstOptimizer;
     virtual String toString() const override;
 
     String getName() const {return name;}
@@ -117,6 +120,7 @@ public:
     String toString() const override;
     
     friend class ParameterAssignment;
+    friend class AstOptimizer;
     const UniquePtr<ASTStatement>& getExpression() const {return valueExpression;}
     ASTStatement* getRawExpression() const {return valueExpression.get();}
 
@@ -134,19 +138,20 @@ public:
 };
 
 class BinaryOperation : public ASTStatement {
-    String op;
+    BinaryOp op;
     UniquePtr<ASTStatement> left;
     UniquePtr<ASTStatement> right;
+    friend class AstOptimizer;
 
 public:
-    BinaryOperation(const String& op, UniquePtr<ASTStatement> left, UniquePtr<ASTStatement> right, SharedPtr<Scope> scope);
+    BinaryOperation(BinaryOp op, UniquePtr<ASTStatement> left, UniquePtr<ASTStatement> right, SharedPtr<Scope> scope);
 
     String toString() const override;
    
     Node evaluate(SharedPtr<Scope> scope, SharedPtr<ClassInstanceNode> instance = nullptr) const override;
 
     AstType getAstType() const override {return AstType::BinaryOperation;}
-    const String& getOperator() const { return op;}
+    BinaryOp getOperator() const { return op; }
 
     const ASTStatement* getLeftSide() const { return left.get(); }
     const ASTStatement* getRightSide() const { return right.get(); }
@@ -163,9 +168,9 @@ public:
 
 class UnaryOperation : public ASTStatement {
 public:
-    UnaryOperation(const String& op, UniquePtr<ASTStatement> operand, SharedPtr<Scope> scope);
+    UnaryOperation(UnaryOp op, UniquePtr<ASTStatement> operand, SharedPtr<Scope> scope);
     String toString() const override;
-    const String& getOperator() const { return op; }
+    UnaryOp getOperator() const { return op; }
     const ASTStatement* getOperand() const { return operand.get(); }
     AstType getAstType() const override {return AstType::UnaryOperation;}
 
@@ -177,7 +182,8 @@ public:
 
 
 private:
-    String op; // Operator (e.g., "!")
+    UnaryOp op;
     UniquePtr<ASTStatement> operand;
+    friend class AstOptimizer;
 };
 
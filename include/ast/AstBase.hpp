@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <string> 
 #include "core/TypesFWD.hpp"
 #include "core/node/Node.hpp"
@@ -34,23 +35,30 @@ UniquePtr<T> static_shared_ptr_cast(SharedPtr<U>&& ptr) {
     return SharedPtr<T>(static_cast<T*>(ptr.release()));
 }
 
+// Free variables are cached per node: filled once on first use and read-only afterwards,
+// so a parsed tree can be evaluated from several threads at once.
 class FreeVarCollection {
 public:
-    mutable FreeVars freeVars;
-    mutable FreeVars localAssign;
-    mutable bool freeVarsCacheValid = false;
+    FreeVarCollection() = default;
+    FreeVarCollection(const FreeVarCollection&) {}
+    FreeVarCollection& operator=(const FreeVarCollection&) { markFreeVarsDirty(); return *this; }
     virtual FreeVars collectFreeVariables() const = 0;
 protected:
-    void markFreeVarsDirty() const { freeVarsCacheValid = false; }
-    void markFreeVarsClean() const { freeVarsCacheValid = true; }
-    bool isFreeVarsCacheValid() const { return freeVarsCacheValid; }
+    // Only the pointer lives in the node; most nodes never compute their set.
+    mutable std::atomic<const FreeVars*> freeVarsCache{nullptr};
+
+    // Only called while the tree is being built or rewritten, never during evaluation.
+    void markFreeVarsDirty() const { delete freeVarsCache.exchange(nullptr, std::memory_order_acq_rel); }
+    bool isFreeVarsCacheValid() const { return freeVarsCache.load(std::memory_order_acquire) != nullptr; }
+    const FreeVars& cachedFreeVars() const { return *freeVarsCache.load(std::memory_order_acquire); }
+    FreeVars publishFreeVars(FreeVars found) const;
     ~FreeVarCollection();
 };
 
 
 class BaseAST : public FreeVarCollection {
 protected:
-    String branch = "Base";
+    const char* branch = "Base";
 
 public:
     BaseAST(SharedPtr<Scope> scope = nullptr);
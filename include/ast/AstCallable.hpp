@@ -49,6 +49,7 @@ public:
 
 class Arguments: public ASTStatement {
     Vector<Argument> arguments;
+    friend class AstOptimizer;
 
 public:
     AstType getAstType() const override {return AstType::Arguments;}
@@ -175,6 +176,17 @@ protected:
 
 
 
+// The names a definition captures, resolved once and shared by every clone of the definition,
+// so defining a callable walks a short sorted list instead of rebuilding hash sets.
+struct Captures {
+    Vector<String> names;    // free in the body, sorted
+    Vector<String> unbound;  // of those, the ones that are not parameters
+
+    static SharedPtr<const Captures> of(const CallableBody& body, const ParamList& parameters);
+    // A `function` sees only its parameters.
+    void requireBound() const;
+};
+
 // FunctionDef: defines a function, registers it, and may return nothing.
 class CallableDef : public ASTStatement {
 public:
@@ -202,8 +214,15 @@ public:
     FreeVars collectFreeVariables() const override;
 
     void setScope(SharedPtr<Scope> newScope);
-    
-    
+
+    // Resolved after parsing, before anything runs; an unresolved definition computes them per call.
+    SharedPtr<const Captures> getCaptures() const;
+    void resolveCaptures() const;
+    // Resolves every definition under `root`, nested ones included.
+    static void resolveAllCaptures(const BaseAST& root);
+
+protected:
+    mutable SharedPtr<const Captures> captures;
 };
 
 class CallableCall : public ASTStatement {
@@ -38,7 +38,6 @@ private:
     WeakPtr<Scope> classScope; //  set when evaluating in class
     int resolutionStartIndex = 0;  // default is 0, resolve from the beginning
     ResolutionMode mode = ResolutionMode::Normal;
-    mutable SharedPtr<Scope> lastScope;
 
 
 public:
@@ -75,9 +74,6 @@ public:
 
     void setFirstElement(UniquePtr<ASTStatement> probablyScope, String name);
 
-    SharedPtr<Scope> getLastScope();
-    SharedPtr<Scope> getLastScope() const;
-    void setLastScope(SharedPtr<Scope> mostRecentScope) const;
     FreeVars collectFreeVariables() const override;
     
 };
\ No newline at end of file
@@ -29,6 +29,8 @@ public:
     virtual ~ClassBody() override;
 
     Node evaluate(SharedPtr<Scope> scope, SharedPtr<ClassInstanceNode> instanceNode = nullptr) const override;
+    // Defines the body's members in classScope without storing anything on the node.
+    Node evaluateInto(SharedPtr<Scope> classScope, SharedPtr<Scope> capturedScope, const String& classAccessor, SharedPtr<ClassInstanceNode> instanceNode = nullptr) const;
 
     UniquePtr<BaseAST> clone() const override;    
     AstType getAstType() const override {return AstType::ClassBlock;}
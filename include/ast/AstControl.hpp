@@ -8,13 +8,10 @@
 
 // Used as sort of a mixin class for a common interface among only those classes needing it.
 class AstCollector {
-protected:
-    mutable Vector<BaseAST*> collectedNodes;
-
 public:
-    const Vector<BaseAST*>& collectChildrenOfType(const Vector<UniquePtr<BaseAST>>& children, AstType type) const;
+    Vector<BaseAST*> collectChildrenOfType(const Vector<UniquePtr<BaseAST>>& children, AstType type) const;
 
-    const Vector<BaseAST*>& collectChildrenOfType(const Vector<UniquePtr<BaseAST>>& children, const Vector<AstType>& types) const;
+    Vector<BaseAST*> collectChildrenOfType(const Vector<UniquePtr<BaseAST>>& children, const Vector<AstType>& types) const;
     ~AstCollector();
 };
 
@@ -61,11 +58,11 @@ public:
     friend class ClassDef;
     friend class MethodDef;
     friend class CallableDef;
+    friend class AstOptimizer;
 
     UniquePtr<BaseAST> clone() const override;
     
     void setScope(SharedPtr<Scope> newScope) override;
-    void setScope(SharedPtr<Scope> newScope) const;
     virtual FreeVars collectFreeVariables() const override;
     Vector<const BaseAST*> getAllAst(bool includeSelf = true) const override;
 
@@ -77,6 +74,7 @@ protected:
 class ConditionalBlock : public ASTStatement {
 protected:
     UniquePtr<ASTStatement> condition; // The condition to evaluate
+    friend class AstOptimizer;
 
 public:
 
@@ -86,6 +84,8 @@ public:
     void printAST(std::ostream& os, int indent = 0) const override;
     Node evaluate(SharedPtr<Scope> scope, SharedPtr<ClassInstanceNode> instance = nullptr) const override;
     Node evaluate() const override;
+    // Allocation-free truth test used by loops; see Evaluator::evaluateCondition.
+    bool isTruthy(SharedPtr<Scope> scope, SharedPtr<ClassInstanceNode> instance = nullptr) const;
     AstType getAstType() const override {return AstType::Conditional;}
     UniquePtr<BaseAST> clone() const override;
     void setScope(SharedPtr<Scope> newScope) override;
@@ -125,6 +125,7 @@ class ElifStatement : public ASTStatement { // Also contains the logic of If, pa
 
 protected:
     mutable UniquePtr<CodeBlock> body;
+    friend class AstOptimizer;
 public:
     UniquePtr<ConditionalBlock> condition;
     ElifStatement(UniquePtr<ASTStatement> condition, UniquePtr<CodeBlock> body, SharedPtr<Scope> scope);
@@ -151,6 +152,7 @@ protected:
     UniquePtr<ConditionalBlock> condition;
     Vector<UniquePtr<ElifStatement>> elifNodes; // Vector of `elif` nodes
     UniquePtr<ElseStatement> elseNode;          // Optional `else` block
+    friend class AstOptimizer;
 
 public:
     IfStatement(UniquePtr<ASTStatement>condition, UniquePtr<CodeBlock> body, SharedPtr<Scope> scope);
@@ -197,6 +199,7 @@ class LoopBlock : public ASTStatement {
 protected:
     UniquePtr<ConditionalBlock> condition; 
     UniquePtr<CodeBlock> body;             
+    friend class AstOptimizer;
 
 public:
     explicit LoopBlock(UniquePtr<ConditionalBlock> condition, UniquePtr<CodeBlock> body, SharedPtr<Scope> scope);
@@ -242,12 +245,26 @@ public:
 
 };
 
+// One `reduce(variable: op)` entry of a parallel for; op is sum, min, max or a function name.
+// Each chunk starts from `identity` and the variable's own value is folded in once at the end;
+// a custom reducer spells its identity out: `reduce(acc: combine = 0)`.
+struct LoopReduction {
+    String variable;
+    String op;
+    int identity = 0;
+};
+
 class ForLoop : public ASTStatement {
     String loopVariable;
     UniquePtr<ASTStatement> startExpr;
     UniquePtr<ASTStatement> endExpr;
     UniquePtr<ASTStatement> stepExpr;
+    // Set instead of start/end/step for `for x in <expr>:` loops over containers.
+    UniquePtr<ASTStatement> iterableExpr;
     UniquePtr<CodeBlock> body;
+    bool parallel = false;
+    Vector<LoopReduction> reductions;
+    friend class AstOptimizer;
 public:
     ForLoop(String loopVariable,
             UniquePtr<ASTStatement> startExpr,
@@ -256,12 +273,23 @@ public:
             UniquePtr<CodeBlock> body,
             SharedPtr<Scope> scope);
 
+    ForLoop(String loopVariable,
+            UniquePtr<ASTStatement> iterableExpr,
+            UniquePtr<CodeBlock> body,
+            SharedPtr<Scope> scope);
+
     const String& getLoopVariable() const { return loopVariable; }
     const ASTStatement* getStartExpr() const { return startExpr.get(); }
     const ASTStatement* getEndExpr() const { return endExpr.get(); }
     const ASTStatement* getStepExpr() const { return stepExpr.get(); }
+    const ASTStatement* getIterableExpr() const { return iterableExpr.get(); }
+    bool isForIn() const { return iterableExpr != nullptr; }
     const CodeBlock* getBody() const { return body.get(); }
 
+    void makeParallel(Vector<LoopReduction> loopReductions) { parallel = true; reductions = std::move(loopReductions); }
+    bool isParallel() const { return parallel; }
+    const Vector<LoopReduction>& getReductions() const { return reductions; }
+
     AstType getAstType() const override { return AstType::ForLoop; }
     String toString() const override;
     void printAST(std::ostream& os, int indent = 0) const override;
@@ -45,12 +45,15 @@ public:
     ~MethodDef();
 
     UniquePtr<BaseAST> clone() const override;
+    // A copy whose def and body are bound to `scope`; it clears that scope when destroyed.
+    UniquePtr<MethodDef> cloneInto(SharedPtr<Scope> scope) const;
 
     String toString() const override;
     AstType getAstType() const override { return AstType::ClassMethodDef;}
     void setMethodAccessor(String& accessorName);
     String getMethodAccessor() const;
     Node evaluate(SharedPtr<Scope> scope, SharedPtr<ClassInstanceNode> instanceNode = nullptr) const override;
+    Node evaluateIn(SharedPtr<Scope> scope, SharedPtr<Scope> ownerClassScope, SharedPtr<ClassInstanceNode> instanceNode = nullptr) const;
     ParamList& getParameters();
     const ParamList& getParameters() const;   // For inspection
 
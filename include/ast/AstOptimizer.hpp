@@ -0,0 +1,65 @@
+#pragma once
+
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include "core/TypesFWD.hpp"
+#include "core/node/Node.hpp"
+
+class BaseAST;
+class ASTStatement;
+class CodeBlock;
+class IfStatement;
+
+inline constexpr bool kEnableAstOptimizer = true;
+
+// One pass over a parsed program before it first runs:
+//  - operations whose operands are literals become literals;
+//  - references to locked constants (`const x := <literal>`, the only binding of x anywhere
+//    in the program) take the constant's value;
+//  - if/elif/else chains drop branches whose condition is a literal, and while loops whose
+//    condition is a literal false go away;
+//  - statements after a return, break, continue or throw in the same block are dropped.
+// Equal literal values share one frozen Node from the pass's constant pool.
+class AstOptimizer {
+public:
+    struct Stats {
+        size_t folded = 0;          // operations replaced by their value
+        size_t propagated = 0;      // constant references replaced by their value
+        size_t prunedBranches = 0;  // if/elif/else branches and loops that can never run
+        size_t unreachable = 0;     // statements after a return, break, continue or throw
+        size_t constants = 0;       // distinct values in the constant pool
+        size_t literals = 0;        // literal nodes sharing them
+    };
+
+    void run(CodeBlock& program);
+    const Stats& stats() const { return totals; }
+
+private:
+    // Locked constants visible at a point of the walk, by name.
+    using Constants = std::unordered_map<String, Node>;
+    using Statements = Vector<UniquePtr<BaseAST>>;
+
+    void collectBindings(const BaseAST& root);
+    bool isLockable(const String& name) const;
+
+    void optimizeBlock(Statements& statements, Constants constants, bool parallelBody);
+    // False when the statement at `index` was replaced by the statements it reduces to.
+    bool optimizeIf(Statements& statements, size_t index, const Constants& constants, bool parallelBody);
+
+    template <typename T>
+    void rewrite(UniquePtr<T>& slot, const Constants& constants);
+    UniquePtr<ASTStatement> fold(BaseAST& node, const Constants& constants);
+    UniquePtr<ASTStatement> makeLiteral(Node value, const BaseAST& replaced);
+
+    Node pooled(const Node& value);
+    // A dropped subtree must not change what the rest of the program sees: generators are
+    // recognised by any yield in their body, and parallel for bodies reject break and return.
+    bool canDrop(const BaseAST& node, bool parallelBody) const;
+    static std::optional<bool> literalTruth(const ASTStatement* condition);
+
+    std::unordered_map<String, size_t> declarations;
+    std::unordered_set<String> rebound;
+    std::unordered_map<String, Node> pool;
+    Stats totals;
+};
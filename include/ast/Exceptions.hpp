@@ -113,6 +113,28 @@ public:
 };
 
 
+// Suspends the enclosing generator frame and hands the value to its consumer.
+class Yield : public ASTStatement {
+private:
+    UniquePtr<ASTStatement> yieldValue;
+
+public:
+    explicit Yield(SharedPtr<Scope> scope, UniquePtr<ASTStatement> value);
+    Node evaluate(SharedPtr<Scope> scope, SharedPtr<ClassInstanceNode> instance = nullptr) const override;
+    String toString() const override;
+    void printAST(std::ostream& os, int indent = 0) const override;
+    AstType getAstType() const override { return AstType::Yield; }
+    UniquePtr<BaseAST> clone() const override;
+    void setScope(SharedPtr<Scope> newScope) override;
+    UniquePtr<ASTStatement>& getValue() {return yieldValue;}
+    ASTStatement* getValue() const {return yieldValue.get();}
+    Vector<const BaseAST*> getAllAst(bool includeSelf = true) const override;
+    FreeVars collectFreeVariables() const override;
+    EvalResult evaluateFlow(SharedPtr<Scope> scope, SharedPtr<ClassInstanceNode> instance = nullptr) const override;
+
+};
+
+
 // ThrowStatement.h
 class Throw : public ASTStatement {
 private:
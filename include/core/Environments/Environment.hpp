@@ -25,5 +25,8 @@ public:
     virtual VarNode& getVariable(const String& name) = 0;
     virtual bool tryReadInt(const String& name, int& out) const = 0;
     virtual bool tryWriteInt(const String& name, int value) = 0;
+    // Storage a loop can rebind directly each iteration, or nullptr when
+    // writes must go through updateVariable (e.g. frame-owned cells).
+    virtual VarNode* resolveLoopSlot(const String& name) = 0;
 };
 
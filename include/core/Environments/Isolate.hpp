@@ -0,0 +1,56 @@
+#pragma once
+
+#include "core/Environments/Scope.hpp"
+#include "core/Environments/StackScope.hpp"
+
+class Debugger;
+class EventLoop;
+
+// Everything an interpreter run mutates outside of its own scopes: scope and
+// frame bookkeeping, the lookup-cache epoch and debugger configuration.
+// Registries already hang off the root scope a run creates. Each thread has a
+// default isolate; binding a different one with Isolate::Enter lets N threads
+// run independent programs with no shared mutable state.
+class Isolate {
+public:
+    Isolate();
+    ~Isolate();
+
+    Isolate(const Isolate&) = delete;
+    Isolate& operator=(const Isolate&) = delete;
+
+    // The isolate bound to the calling thread, or that thread's default one.
+    static Isolate& current();
+
+    // Binds an isolate to the calling thread for the lifetime of the guard.
+    class Enter {
+    public:
+        explicit Enter(Isolate& isolate);
+        ~Enter();
+
+        Enter(const Enter&) = delete;
+        Enter& operator=(const Enter&) = delete;
+
+    private:
+        Isolate* previous;
+    };
+
+    // Whether a value can be handed to another isolate or thread: plain values and native
+    // containers can, anything tied to interpreter state (functions, user classes, generators)
+    // cannot.
+    static bool isTransferable(const Node& value);
+    // A frozen deep copy; shares nothing with the sender's scopes.
+    static Node transfer(const Node& value);
+
+    ScopeStats& scopeStats() { return scopes; }
+    StackScopeStats& stackScopeStats() { return frames; }
+    Debugger& debugger() { return *debug; }
+    // Created on first use; async I/O started in this isolate runs on it.
+    EventLoop& eventLoop();
+
+private:
+    ScopeStats scopes;
+    StackScopeStats frames;
+    UniquePtr<Debugger> debug;
+    UniquePtr<EventLoop> loop;
+};
@@ -53,6 +53,27 @@ struct ScopeCounts {
 };
 
 
+// Scope bookkeeping owned by the running Isolate rather than the process.
+struct ScopeStats {
+    size_t liveScopeCount = 0;
+    size_t totalScopeCreated = 0;
+    ScopeCounts counts{};
+    uint64_t variableLookupEpoch = 1;
+    int totalWith = 0;
+    int totalWithout = 0;
+#if MERK_SCOPE_DIAGNOSTICS
+    uint64_t parentAppendAttempts = 0;
+    uint64_t ancestorAppendAttempts = 0;
+    uint64_t reparentAttempts = 0;
+    uint64_t ancestorParentChainCycleBailouts = 0;
+    uint64_t classScopeAttachSamples = 0;
+    uint64_t classScopeAttachUnexpectedDelta = 0;
+    uint64_t capturedScopeAttachSamples = 0;
+    uint64_t capturedScopeAttachUnexpectedDelta = 0;
+#endif
+};
+
+
 enum class ParentAppendAttempt {
     None,
     Parent,
@@ -67,52 +88,36 @@ private:
     static void bumpVariableLookupEpoch();
 
     WeakPtr<Scope> parentScope;          // Weak pointer to the parent scope - weak to avoid undue circular references
-    static inline size_t liveScopeCount = 0;
-    static inline size_t totalScopeCreated = 0;
     ClassMembers classMembers;   //map for future uses
-    static inline ScopeCounts counts{};
-    static inline std::atomic<uint64_t> variableLookupEpoch{1};
 
-    inline static int totalWith = 0;
-    inline static int totalWithout = 0;
-#if MERK_SCOPE_DIAGNOSTICS
-    static inline std::atomic<uint64_t> parentAppendAttempts{0};
-    static inline std::atomic<uint64_t> ancestorAppendAttempts{0};
-    static inline std::atomic<uint64_t> reparentAttempts{0};
-    static inline std::atomic<uint64_t> ancestorParentChainCycleBailouts{0};
-    static inline std::atomic<uint64_t> classScopeAttachSamples{0};
-    static inline std::atomic<uint64_t> classScopeAttachUnexpectedDelta{0};
-    static inline std::atomic<uint64_t> capturedScopeAttachSamples{0};
-    static inline std::atomic<uint64_t> capturedScopeAttachUnexpectedDelta{0};
-
-    
-#endif
+    // Stats of the Isolate bound to the calling thread.
+    static ScopeStats& stats();
     mutable uint64_t variableLookupCacheEpoch = 0;
     mutable std::unordered_map<String, int> variableLookupCache;
 
 public:
     static void printScopeReport() {
         std::cout << "----------------------------" << std::endl;
-        std::cout << "Total Scopes Created: " << totalScopeCreated << std::endl;
-        std::cout << "Live Scopes Remaining: " << liveScopeCount << std::endl;
-        if (liveScopeCount != 0) {
-            std::cout << "[Memory Leak Detected!] " << liveScopeCount << " Scope(s) were not destroyed!" << std::endl;
+        std::cout << "Total Scopes Created: " << stats().totalScopeCreated << std::endl;
+        std::cout << "Live Scopes Remaining: " << stats().liveScopeCount << std::endl;
+        if (stats().liveScopeCount != 0) {
+            std::cout << "[Memory Leak Detected!] " << stats().liveScopeCount << " Scope(s) were not destroyed!" << std::endl;
         } else {
             std::cout << "[Memory Clean] All scopes were properly freed." << std::endl;
         }
 
         std::cout << "SCOPE COUNTS: " << std::endl;
-        std::cout << Scope::counts.toString() << std::endl;
+        std::cout << stats().counts.toString() << std::endl;
 #if MERK_SCOPE_DIAGNOSTICS
         std::cout << "Cycle/Attach Diagnostics:" << std::endl;
-        std::cout << "  parentAppendAttempts: " << parentAppendAttempts.load() << std::endl;
-        std::cout << "  ancestorAppendAttempts: " << ancestorAppendAttempts.load() << std::endl;
-        std::cout << "  reparentAttempts: " << reparentAttempts.load() << std::endl;
-        std::cout << "  ancestorParentChainCycleBailouts: " << ancestorParentChainCycleBailouts.load() << std::endl;
-        std::cout << "  classScopeAttachSamples: " << classScopeAttachSamples.load() << std::endl;
-        std::cout << "  classScopeAttachUnexpectedDelta: " << classScopeAttachUnexpectedDelta.load() << std::endl;
-        std::cout << "  capturedScopeAttachSamples: " << capturedScopeAttachSamples.load() << std::endl;
-        std::cout << "  capturedScopeAttachUnexpectedDelta: " << capturedScopeAttachUnexpectedDelta.load() << std::endl;
+        std::cout << "  parentAppendAttempts: " << stats().parentAppendAttempts << std::endl;
+        std::cout << "  ancestorAppendAttempts: " << stats().ancestorAppendAttempts << std::endl;
+        std::cout << "  reparentAttempts: " << stats().reparentAttempts << std::endl;
+        std::cout << "  ancestorParentChainCycleBailouts: " << stats().ancestorParentChainCycleBailouts << std::endl;
+        std::cout << "  classScopeAttachSamples: " << stats().classScopeAttachSamples << std::endl;
+        std::cout << "  classScopeAttachUnexpectedDelta: " << stats().classScopeAttachUnexpectedDelta << std::endl;
+        std::cout << "  capturedScopeAttachSamples: " << stats().capturedScopeAttachSamples << std::endl;
+        std::cout << "  capturedScopeAttachUnexpectedDelta: " << stats().capturedScopeAttachUnexpectedDelta << std::endl;
 #endif
         std::cout << "----------------------------" << std::endl;
     }
@@ -165,7 +170,7 @@ public:
     SharedPtr<Scope> getParent() const;  // Get the parent scope
     int getScopeLevel() const;           // Get the current scope level
     SharedPtr<Scope> makeCallScope();
-    SharedPtr<Scope> detachScope(const std::unordered_set<String>& freeVarNames);
+    SharedPtr<Scope> detachScope(std::span<const String> freeVarNames);
 
     // Context Management
     const Context& getContext() const { return context; }
@@ -180,6 +185,7 @@ public:
     VarNode& getVariable(const String& name);
     bool tryReadInt(const String& name, int& out) const override;
     bool tryWriteInt(const String& name, int value) override;
+    VarNode* resolveLoopSlot(const String& name) override;
     void printContext(int depth = 0) const;
     void printVariables(int depth = 0) const;
 
@@ -247,7 +253,7 @@ public:
     void printChildScopes(int indentLevel = 0) const;
     void printScopeTree() const;
     
-    SharedPtr<Scope> isolateScope(const std::unordered_set<String>& freeVarNames);
+    SharedPtr<Scope> isolateScope(std::span<const String> freeVarNames);
 
 
     // scope builders
@@ -256,11 +262,11 @@ public:
     SharedPtr<Scope> buildMethodCallScope(SharedPtr<Method> func, String name);
 
     SharedPtr<Scope> buildInstanceScope(SharedPtr<ClassBase> classTemplate, String className);
-    SharedPtr<Scope> buildClassScope(FreeVars freeVarNames, String className);
+    SharedPtr<Scope> buildClassScope(std::span<const String> freeVarNames, String className);
 
-    SharedPtr<Scope> buildFunctionDefScope(const FreeVars& freeVars, const String& funcName);
+    SharedPtr<Scope> buildFunctionDefScope(std::span<const String> freeVars, const String& funcName);
 
-    SharedPtr<Scope> buildClassDefScope(const FreeVars& freeVars, const String& className);
+    SharedPtr<Scope> buildClassDefScope(std::span<const String> freeVars, const String& className);
     
     TypeSignatureId bindResolvedType(const ResolvedType& rt, const String& aliasName = "");
 
@@ -2,7 +2,21 @@
 
 #include "core/Environments/Scope.hpp"
 #include "core/Environments/Frame.hpp"
-#include <atomic>
+
+// Frame lookup instrumentation, owned by the running Isolate.
+struct StackScopeStats {
+    uint64_t cacheHits = 0;
+    uint64_t cacheMisses = 0;
+    uint64_t localContextHits = 0;
+    uint64_t localContextMisses = 0;
+    uint64_t parentFallbackLookups = 0;
+    uint64_t parentFallbackUpdates = 0;
+    uint64_t slotKindUnknown = 0;
+    uint64_t slotKindInt = 0;
+    uint64_t slotKindDouble = 0;
+    uint64_t slotKindBool = 0;
+    uint64_t slotKindObject = 0;
+};
 
 // Lightweight callable-frame specialization.
 // Keeps Scope API unchanged so call sites can adopt it incrementally.
@@ -33,6 +47,7 @@ public:
     bool hasVariable(const String& name) const override;
     bool tryReadInt(const String& name, int& out) const override;
     bool tryWriteInt(const String& name, int value) override;
+    VarNode* resolveLoopSlot(const String& name) override;
 
     SharedPtr<Scope> clone(bool strict = false) const override;
     Frame& getFrame() { return frame; }
@@ -47,15 +62,7 @@ private:
     static void noteSlotKind(NodeValueType valueType);
 
     mutable Frame frame;
-    static inline std::atomic<uint64_t> cacheHits{0};
-    static inline std::atomic<uint64_t> cacheMisses{0};
-    static inline std::atomic<uint64_t> localContextHits{0};
-    static inline std::atomic<uint64_t> localContextMisses{0};
-    static inline std::atomic<uint64_t> parentFallbackLookups{0};
-    static inline std::atomic<uint64_t> parentFallbackUpdates{0};
-    static inline std::atomic<uint64_t> slotKindUnknown{0};
-    static inline std::atomic<uint64_t> slotKindInt{0};
-    static inline std::atomic<uint64_t> slotKindDouble{0};
-    static inline std::atomic<uint64_t> slotKindBool{0};
-    static inline std::atomic<uint64_t> slotKindObject{0};
+
+    // Stats of the Isolate bound to the calling thread.
+    static StackScopeStats& stats();
 };
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <functional>
+#include <future>
+#include <mutex>
+
+#include "core/TypesFWD.hpp"
+#include "core/types.h"
+#include "lex/Lexer.hpp"
+#include "utilities/thread_pool.h"
+
+class Isolate;
+
+inline constexpr bool kEnableParallelModules = true;
+
+// Front end for programs spread over several files. A top-level `import a.b` or
+// `from a.b import x` names the module at <root>/a/b.merk. Every module is tokenized, its
+// imports are queued, and then it is parsed, each step on a worker pool. A module's imports
+// are therefore read while it is still being parsed. Import lines are cut from the token
+// stream before parsing, so the parser never sees them.
+class ModuleLoader {
+public:
+    struct Module {
+        String name;                 // dotted, as imported; the entry file's stem for the entry
+        String path;
+        Vector<String> imports;      // in source order, each once
+        UniquePtr<Isolate> isolate;  // the one the module was tokenized and parsed in
+        SharedPtr<Scope> scope;      // root scope the parser built the module against
+        UniquePtr<CodeBlock> ast;
+        size_t tokenCount = 0;
+    };
+
+    // Builds a module's root scope and adds the names it defines to the lexer config. It is
+    // called once per module, on the thread parsing that module, inside the module's isolate.
+    using ScopeFactory = std::function<SharedPtr<Scope>(LexerConfig&)>;
+
+    // workers == 0 uses one per core. A serial loader reads each module on the thread that
+    // asks for it.
+    ModuleLoader(String root, ScopeFactory makeScope, size_t workers = 0, bool parallel = kEnableParallelModules);
+    ~ModuleLoader();
+
+    ModuleLoader(const ModuleLoader&) = delete;
+    ModuleLoader& operator=(const ModuleLoader&) = delete;
+
+    // Starts on `entryPath` and everything it reaches, and returns the entry's module name.
+    // A parallel loader returns before any of it is parsed.
+    String load(const String& entryPath);
+    // Waits for `name` alone and rethrows the error that stopped its load, if any.
+    Module& require(const String& name);
+    // Waits for every module reachable from the entry. Dependencies come before the modules
+    // that import them; a cycle is broken where it was entered.
+    Vector<Module*> requireAll();
+
+    String pathFor(const String& name) const;
+    // Removes the top-level import lines from `tokens` and returns the modules they name.
+    static Vector<String> takeImports(Vector<Token>& tokens);
+
+private:
+    struct Entry {
+        Module module;
+        std::promise<void> parsed;
+        std::shared_future<void> ready;
+    };
+
+    void request(const String& name, const String& path);
+    void read(Entry& entry);
+    Entry& find(const String& name);
+
+    String root;
+    ScopeFactory makeScope;
+    bool parallel;
+    String entryName;
+
+    std::mutex mutex;
+    std::unordered_map<String, UniquePtr<Entry>> entries;
+    // Last: its workers are joined before the modules they fill are destroyed.
+    UniquePtr<WorkStealingPool> pool;
+};
@@ -13,6 +13,7 @@
 
 #include "core/Tokenizer.hpp"
 #include "ast/AstClass.hpp"
+#include "ast/AstOptimizer.hpp"
 
 class Parser {
 private:
@@ -29,6 +30,7 @@ private:
 
     Vector<String> classAccessors;
     UniquePtr<CodeBlock> rootBlock;
+    AstOptimizer::Stats optimizerStats;
 
     Token eofToken = Token(TokenType::EOF_Token, "EOF", 0, 0); // Singleton EOF token
     Token noOpToken = Token(TokenType::NoOp, "NoOp", 0, 0);
@@ -64,7 +66,9 @@ private:
 
     UniquePtr<IfStatement> parseIfStatement();
     UniquePtr<WhileLoop> parseWhileLoop();
-    UniquePtr<ForLoop> parseForLoop();
+    UniquePtr<ForLoop> parseForLoop(bool parallel = false);
+    UniquePtr<ForLoop> parseParallelFor();
+    int parseReductionIdentity();
 
     UniquePtr<CodeBlock> parseBlock(SharedPtr<Scope> = nullptr);
     UniquePtr<BaseAST> parseStatement();
@@ -101,6 +105,7 @@ private:
     void popAccessor();
     
     UniquePtr<ASTStatement> parseReturnStatement();
+    UniquePtr<ASTStatement> parseYieldStatement();
     UniquePtr<ASTStatement> parseContinueStatement();
 
     void processIndent(SharedPtr<Scope> manualScope = nullptr);
@@ -129,6 +134,9 @@ public:
     explicit Parser(Vector<Token>& tokens, SharedPtr<Scope> scope, bool interpretMode=true, bool byBlock=false);
     Vector<String> nativeFunctionNames;
     UniquePtr<CodeBlock> parse();
+    const AstOptimizer::Stats& getOptimizerStats() const { return optimizerStats; }
+    // Where parsing stopped; after a failed parse(), the token it failed on.
+    const Token& stoppedAt() const { return currentToken(); }
     bool interpretMode;
     bool byBlock;
     
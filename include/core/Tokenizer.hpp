@@ -11,14 +11,14 @@
 
 class Tokenizer {
 private:
-    String source;
+    SharedPtr<SourceBuffer> source;
     String filePath;
     Vector<Token> tokens;
 
 public:
     Tokenizer(const String& sourceCode, bool readFile);
 
-    Vector<Token> tokenize(LexerConfig&);
+    Vector<Token>& tokenize(LexerConfig&);
     void read();
 
     void printTokens(bool colored = false) const;
@@ -27,7 +27,10 @@ public:
         return tokens;
     }
 
-    Vector<Token> lex(LexerConfig&);
+    // The scanned bytes (mapped for files); holders of source spans keep this alive.
+    const SharedPtr<SourceBuffer>& getSource() const { return source; }
+
+    Vector<Token>& lex(LexerConfig&);
 
 };
 
@@ -8,6 +8,7 @@
 #include <map>
 #include <iostream>
 #include <span>
+#include <string_view>
 
 template <typename T, typename... Args>
 std::unique_ptr<T> makeUnique(Args&&... args) {
@@ -129,6 +130,8 @@ enum class NodeValueType {
     NativeNode,
     Http,
     File,
+    Range,
+    Generator,
 };
 
 using NodeTypeMap = std::map<String, NodeValueType>;    // For named parameter types in function signatures
@@ -225,6 +228,7 @@ enum class AstType {
     
     Break,
     Return,
+    Yield,
     Continue,
     ThrowStatement,
     LoopBlock,
@@ -285,6 +289,46 @@ enum class CallableType {
     INSTANCE
 };
 
+// Operators are resolved once by the parser; evaluation switches on these instead of
+// comparing spellings. The order groups arithmetic, logic, compound assignment and comparison.
+enum class BinaryOp : uint8_t {
+    Add,
+    Sub,
+    Mul,
+    Div,
+    Mod,
+
+    And,        // and, &&
+    Or,         // or, ||
+
+    AddAssign,
+    SubAssign,
+    MulAssign,
+    DivAssign,
+    Increment,  // ++
+
+    Eq,
+    Ne,
+    Lt,
+    Le,
+    Gt,
+    Ge,
+
+    Unknown
+};
+
+enum class UnaryOp : uint8_t {
+    Not,        // !, not
+    Exists,     // postfix ?
+    Negate,     // -
+    Unknown
+};
+
+inline constexpr size_t kBinaryOpCount = static_cast<size_t>(BinaryOp::Unknown);
+
+constexpr bool isComparisonOp(BinaryOp op) { return op >= BinaryOp::Eq && op <= BinaryOp::Ge; }
+constexpr bool isCompoundAssignOp(BinaryOp op) { return op >= BinaryOp::AddAssign && op <= BinaryOp::Increment; }
+
 
 using TypeSignatureId = uint32_t;
 using TypeId = uint32_t;
@@ -334,6 +378,10 @@ DebugStringifyConfig& debugStringifyConfig();
 String nodeTypeToString(NodeValueType type, bool colored = true); 
 NodeValueType stringToNodeType(String);
 String astTypeToString(AstType type);
+BinaryOp stringToBinaryOp(std::string_view op);
+String binaryOpToString(BinaryOp op);
+UnaryOp stringToUnaryOp(std::string_view op);
+String unaryOpToString(UnaryOp op);
 String tokenTypeToString(TokenType type, bool colored = false);
 String getTokenDescription(TokenType type);
 
@@ -31,6 +31,8 @@ public:
     virtual void setScope(SharedPtr<Scope> newScope) const override = 0;
     virtual String toString() const override = 0; 
 
+    // Generator functions return a suspended frame instead of running their body.
+    virtual bool isGenerator() const { return false; }
 
 };
 
@@ -42,6 +44,8 @@ class UserFunction : public Function {
 public:
     mutable UniquePtr<FunctionBody> body;   // The function’s code block
 
+private:
+    bool generator = false;                 // body contains a top-level yield
 
 public:
     UserFunction(String name, UniquePtr<FunctionBody> body, ParamList parameters, CallableType funcType);
@@ -57,6 +61,7 @@ public:
     void setScope(SharedPtr<Scope> newScope) const override;
     void setCapturedScope(SharedPtr<Scope> scope) override;
     String toString() const override;
+    bool isGenerator() const override { return generator; }
 
 };
 
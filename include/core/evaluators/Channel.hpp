@@ -0,0 +1,108 @@
+#ifndef CHANNEL_HPP
+#define CHANNEL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+#include "core/node/NodeStructures.hpp"
+
+// A multi-producer, multi-consumer queue of values. Every value is deep copied on the way in
+// (Isolate::transfer), so sender and receiver never share Scope or Node internals. Bounded
+// channels use a lock-free ring for the send/recv fast path; the mutex is only taken to block
+// or to wake a blocked peer. Unbounded channels are a mutex-guarded deque.
+class ChannelState {
+public:
+    // capacity 0 makes the channel unbounded.
+    explicit ChannelState(std::size_t capacity);
+
+    ChannelState(const ChannelState&) = delete;
+    ChannelState& operator=(const ChannelState&) = delete;
+
+    // The channel registered under `name`, created with `capacity` on first use, so that
+    // scripts in different isolates can find each other. Throws if it exists with another
+    // capacity. An entry is dropped once nothing but the registry holds it and it is empty.
+    static SharedPtr<ChannelState> named(const String& name, std::size_t capacity);
+
+    // Blocks while the channel is full; throws once it is closed. A send either lands before
+    // close() or throws, so nothing is lost to a concurrent close.
+    void send(const Node& value);
+    bool trySend(const Node& value);
+
+    // Blocks while the channel is empty; false once it is closed and drained.
+    bool recv(Node& out);
+    bool tryRecv(Node& out);
+
+    void close();
+    bool isClosed() const { return (sendState.load(std::memory_order_acquire) & kClosedBit) != 0; }
+    std::size_t capacity() const { return slots; }
+    std::size_t size() const;
+
+    // Receives from whichever channel has a value first. Returns the channel's index, or
+    // channels.size() once every channel is closed and drained.
+    static std::size_t select(const Vector<SharedPtr<ChannelState>>& channels, Node& out);
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> sequence{0};
+        Node value;
+    };
+
+    enum class PushResult { Pushed, Full, Closed };
+
+    PushResult pushUnlessClosed(Node& value);
+    bool push(Node& value);
+    bool pop(Node& out);
+    bool drained() const;
+    // Closed with no send still in flight: nothing can arrive any more.
+    bool finished() const { return sendState.load(std::memory_order_acquire) == kClosedBit; }
+    void wake(std::atomic<int>& waiters, std::condition_variable& cv);
+
+    const std::size_t slots;
+    UniquePtr<Cell[]> ring;
+    alignas(64) std::atomic<std::size_t> head{0};
+    alignas(64) std::atomic<std::size_t> tail{0};
+
+    std::deque<Node> queue; // unbounded channels only
+    mutable std::mutex queueMutex;
+
+    // Bit 0 is the closed flag; the rest counts sends between their closed check and their push.
+    static constexpr std::size_t kClosedBit = 1;
+    static constexpr std::size_t kSendInFlight = 2;
+    std::atomic<std::size_t> sendState{0};
+    std::mutex waitMutex;
+    std::condition_variable notEmpty;
+    std::condition_variable notFull;
+    std::atomic<int> receivers{0};
+    std::atomic<int> senders{0};
+};
+
+
+class ChannelNode : public NativeNode {
+private:
+    SharedPtr<ChannelState> state;
+
+public:
+    explicit ChannelNode(SharedPtr<ChannelState> state);
+
+    SharedPtr<ChannelState> getState() const { return state; }
+
+    String toString() const override;
+    bool holdsValue() override;
+    std::size_t hash() const override;
+
+    VariantType getValue() const override;
+    void setValue(const VariantType& v) override;
+    SharedPtr<NodeBase> clone() const override;
+    void clear() override;
+    // Receives until the channel is closed and drained.
+    UniquePtr<NodeIterator> makeIterator() const override;
+
+    SharedPtr<NativeNode> toNative() const override;
+};
+
+// The channel held by a Channel instance; throws for any other value.
+SharedPtr<ChannelState> channelOf(const Node& value);
+
+#endif // CHANNEL_HPP
@@ -5,6 +5,7 @@
 #include <optional>
 
 class ForLoop;
+struct Captures;
 
 // This acts as a separate module for evaluation logic - as its name implies
 // This is for future considerations when implementing compilation. 
@@ -19,13 +20,20 @@ namespace Evaluator {
     Node evaluateVariableAssignment(String name, ASTStatement* value, SharedPtr<Scope> scope, SharedPtr<ClassInstanceNode> instanceNode = nullptr);
     VarNode& evaluateVariableReference(String name, SharedPtr<Scope> scope, SharedPtr<ClassInstanceNode> instanceNode = nullptr);
 
-    Node evaluateBinaryOperation(const String& op, const Node& left, const Node& right, SharedPtr<Scope> scope, SharedPtr<ClassInstanceNode> instanceNode = nullptr);
-    Node evaluateUnaryOperation(const String& op, const Node& operand, SharedPtr<ClassInstanceNode> instanceNode = nullptr);
+    Node evaluateBinaryOperation(BinaryOp op, const Node& left, const Node& right, SharedPtr<Scope> scope, SharedPtr<ClassInstanceNode> instanceNode = nullptr);
+    Node evaluateUnaryOperation(UnaryOp op, const Node& operand, SharedPtr<ClassInstanceNode> instanceNode = nullptr);
+
+    // if/while conditions: comparisons and and/or chains resolve straight to a bool.
+    bool evaluateCondition(const ASTStatement* condition, SharedPtr<Scope> scope, SharedPtr<ClassInstanceNode> instanceNode = nullptr);
 
     Node evaluateBasicLoop();
 
     Node evaluateWhileLoop(const ConditionalBlock& condition, const BaseAST* body, SharedPtr<Scope> scope, SharedPtr<ClassInstanceNode> instanceNode = nullptr);
     Node evaluateForLoop(const ForLoop& forLoop, SharedPtr<Scope> scope, SharedPtr<ClassInstanceNode> instanceNode = nullptr);
+    // Declares the loop variable if needed and returns the slot each iteration
+    // rebinds directly (nullptr: fall back to scope->updateVariable).
+    VarNode* resolveLoopVariable(const String& name, NodeValueType type, const Node& initial, SharedPtr<Scope> scope);
+    void bindLoopVariable(VarNode* slot, const String& name, const Node& value, SharedPtr<Scope> scope);
 
     Node evaluateBlock(const Vector<UniquePtr<BaseAST>>& statements, SharedPtr<Scope> scope, SharedPtr<ClassInstanceNode> instanceNode = nullptr);
 
@@ -38,10 +46,15 @@ namespace Evaluator {
     Node evaluateMethodBody(Vector<UniquePtr<BaseAST>>& children, SharedPtr<Scope> methodScope, SharedPtr<ClassInstanceNode> instanceNode = nullptr);
     Node evaluateClassBody(SharedPtr<Scope> classCapturedScope, SharedPtr<Scope> classScope, SharedPtr<Scope> generatedScope, String accessor, Vector<UniquePtr<BaseAST>>& children, SharedPtr<ClassInstanceNode> instanceNode = nullptr);
     Node evaluateClassCall(SharedPtr<Scope> callScope, String className, ArgumentList argValues, SharedPtr<ClassInstanceNode> instanceNode = nullptr);
-    Node evaluateMethodDef(SharedPtr<Scope> passedScope, SharedPtr<Scope> ownScope, SharedPtr<Scope> classScope, String methodName, MethodBody* body, ParamList parameters, CallableType callType, SharedPtr<ClassInstanceNode> instanceNode = nullptr);
+    Node evaluateMethodDef(SharedPtr<Scope> passedScope, SharedPtr<Scope> ownScope, SharedPtr<Scope> classScope, String methodName, MethodBody* body, const Captures& captures, ParamList parameters, CallableType callType, SharedPtr<ClassInstanceNode> instanceNode = nullptr);
     
 
     Node evaluateFunctionCall(String name, SharedPtr<Scope> scope, Arguments* arguments, SharedPtr<ClassInstanceNode> instanceNode);
+    // Resolves and calls `name` with already-evaluated arguments, as a call expression would.
+    Node invokeFunction(const String& name, ArgumentList callArgs, SharedPtr<Scope> scope, SharedPtr<ClassInstanceNode> instanceNode = nullptr);
+    // Resolves a function value (e.g. a callback argument) to the overload matching callArgs.
+    SharedPtr<Function> resolveFunctionValue(const Node& callee, const ArgumentList& callArgs, SharedPtr<Scope> scope);
+    Node callFunction(SharedPtr<Function> func, ArgumentList callArgs, SharedPtr<Scope> scope, SharedPtr<ClassInstanceNode> instanceNode = nullptr);
     Node evaluateChain(SharedPtr<Scope> currentScope, SharedPtr<Scope> methodScope, int resolutionStartIndex, const Vector<ChainElement>& elements, SharedPtr<ClassInstanceNode> instanceNode);
     
     [[noreturn]] Node evaluateBreak();
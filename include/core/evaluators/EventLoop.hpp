@@ -0,0 +1,172 @@
+#ifndef EVENT_LOOP_HPP
+#define EVENT_LOOP_HPP
+
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <curl/curl.h>
+
+#include "core/TypesFWD.hpp"
+
+class FutureState;
+
+namespace Async {
+
+// A fire-and-forget coroutine: it runs until its first suspension when called and frees its own
+// frame when it returns. Bodies report results and errors through a FutureState, never by throwing.
+struct Task {
+    struct promise_type {
+        Task get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+} // namespace Async
+
+
+// One per isolate, single threaded. Coroutines suspend on timers, curl transfers (driven through
+// curl-multi on the loop's own poller: epoll on Linux, poll elsewhere), blocking work offloaded to
+// the shared pool, or futures completed by other threads. The loop only advances while some
+// thread of its isolate waits for a result, so a script that never waits never pays for it.
+class EventLoop {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    EventLoop();
+    ~EventLoop();
+
+    EventLoop(const EventLoop&) = delete;
+    EventLoop& operator=(const EventLoop&) = delete;
+
+    // The loop of the calling thread's isolate.
+    static EventLoop& current();
+
+    struct TimerAwaiter {
+        EventLoop& loop;
+        Clock::time_point deadline;
+        bool await_ready() const noexcept { return deadline <= Clock::now(); }
+        void await_suspend(std::coroutine_handle<> handle) { loop.addTimer(deadline, handle); }
+        void await_resume() const noexcept {}
+    };
+
+    struct TransferAwaiter {
+        EventLoop& loop;
+        CURL* easy;
+        CURLcode result = CURLE_OK;
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle) { loop.addTransfer(easy, &result, handle); }
+        CURLcode await_resume() const noexcept { return result; }
+    };
+
+    struct OffloadAwaiter {
+        EventLoop& loop;
+        std::function<void()> work;
+        std::exception_ptr failure;
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle) { loop.addOffload(work, &failure, handle); }
+        void await_resume() const { if (failure) std::rethrow_exception(failure); }
+    };
+
+    struct FutureAwaiter {
+        EventLoop& loop;
+        FutureState& future;
+        bool await_ready() const;
+        void await_suspend(std::coroutine_handle<> handle) { loop.addFutureWait(future, handle); }
+        void await_resume() const noexcept {}
+    };
+
+    TimerAwaiter sleepFor(std::chrono::milliseconds delay) { return {*this, Clock::now() + delay}; }
+
+    // Runs an easy handle to completion; the handle stays owned by the caller.
+    TransferAwaiter perform(CURL* easy) { return {*this, easy}; }
+
+    // Runs `work` on the shared pool. It must not touch interpreter state: the loop's
+    // isolate keeps running other coroutines meanwhile.
+    OffloadAwaiter offload(std::function<void()> work) { return {*this, std::move(work), nullptr}; }
+
+    // Resumes once `future` has completed; its value is read with wait() afterwards.
+    FutureAwaiter whenDone(FutureState& future) { return {*this, future}; }
+
+    // Runs ready coroutines and waits for events until `future` completes or nothing the loop
+    // owns could still complete it.
+    void runUntilDone(FutureState& future);
+    void runUntilAnyDone(const Vector<SharedPtr<FutureState>>& futures);
+
+    // Work the loop owns that has not finished yet.
+    bool idle() const;
+
+private:
+    struct Inbox;
+    struct Poller;
+    struct Timer {
+        Clock::time_point deadline;
+        std::uint64_t order;
+        std::coroutine_handle<> handle;
+        bool operator>(const Timer& other) const {
+            return deadline != other.deadline ? deadline > other.deadline : order > other.order;
+        }
+    };
+    struct Transfer {
+        CURLcode* result;
+        std::coroutine_handle<> handle;
+    };
+
+    void addTimer(Clock::time_point deadline, std::coroutine_handle<> handle);
+    void addTransfer(CURL* easy, CURLcode* result, std::coroutine_handle<> handle);
+    void addOffload(std::function<void()>& work, std::exception_ptr* failure, std::coroutine_handle<> handle);
+    void addFutureWait(FutureState& future, std::coroutine_handle<> handle);
+
+    void runUntil(const std::function<bool()>& done);
+    // Resumes whatever is ready, or waits for at least one event. False when idle.
+    bool runOnce();
+    void resumeReady();
+    void drainInbox();
+    void fireTimers();
+    void finishTransfers();
+    int pollTimeoutMs() const;
+
+    static int onCurlSocket(CURL* easy, curl_socket_t fd, int what, void* loop, void* socketData);
+    static int onCurlTimer(CURLM* multi, long timeoutMs, void* loop);
+
+    SharedPtr<Inbox> inbox;
+    UniquePtr<Poller> poller;
+    std::deque<std::coroutine_handle<>> ready;
+    std::priority_queue<Timer, Vector<Timer>, std::greater<Timer>> timers;
+    std::uint64_t timerOrder = 0;
+
+    CURLM* multi = nullptr;
+    std::unordered_map<CURL*, Transfer> transfers;
+    bool curlTimerArmed = false;
+    Clock::time_point curlDeadline;
+
+    // Suspended on work finishing on other threads; posted back through the inbox.
+    std::unordered_set<void*> parked;
+};
+
+
+namespace Async {
+
+// Waits for `future` from interpreter code. Inside an async() frame this suspends the frame and
+// lets the loop run other work; anywhere else it drives the isolate's loop until the future is done.
+void await(FutureState& future);
+
+// Starts fn(args...) as an async frame on the isolate's loop and returns its pending result.
+SharedPtr<FutureState> start(const Node& fn, const ArgumentList& args, SharedPtr<Scope> scope);
+SharedPtr<FutureState> start(SharedPtr<Function> func, const ArgumentList& args, SharedPtr<Scope> scope);
+
+// A future completed by the loop after `delay`.
+SharedPtr<FutureState> sleep(std::chrono::milliseconds delay);
+
+} // namespace Async
+
+#endif // EVENT_LOOP_HPP
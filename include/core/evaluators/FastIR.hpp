@@ -4,6 +4,7 @@
 #include "core/evaluators/EvalResult.hpp"
 
 class CodeBlock;
+class Frame;
 
 namespace FastIR {
 
@@ -42,8 +43,25 @@ struct Program {
     String unsupportedReason;
 };
 
+// Bound slots for lowerRangeLoop; '@' cannot start a Merk identifier.
+inline constexpr const char* kRangeEndSlot = "@end";
+inline constexpr const char* kRangeStepSlot = "@step";
+// Result slots for lowerFunction; kReturnedSlot is set to 1 once a return has run.
+inline constexpr const char* kReturnSlot = "@ret";
+inline constexpr const char* kReturnedSlot = "@returned";
+
 bool lowerCodeBlock(const CodeBlock& block, Program& outProgram);
+
+// Lowers a whole `for loopVar in range(...)` loop. The loop starts from the current value of
+// loopVar and stops at kRangeEndSlot, so a single program serves every chunk of a split range.
+// Unlike lowerCodeBlock, any function call (print included) makes the body unsupported.
+bool lowerRangeLoop(const String& loopVar, bool ascending, const CodeBlock& body, Program& outProgram);
+// Lowers the body of a function over int parameters. The body may only read its parameters and
+// its own locals, so the program needs nothing but a frame; calls, prints and free variables fail.
+bool lowerFunction(const Vector<String>& params, const CodeBlock& body, Program& outProgram);
 EvalResult execute(const Program& program, SharedPtr<Scope> scope);
+// Runs against a bare frame with no scope behind it; every slot lives in the frame.
+EvalResult execute(const Program& program, Frame& frame);
 
 } // namespace FastIR
 
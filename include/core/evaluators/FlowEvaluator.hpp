@@ -28,8 +28,8 @@ namespace FlowEvaluator {
     EvalResult evaluateVariableAssignment(String name, ASTStatement* value, SharedPtr<Scope> scope, SharedPtr<ClassInstanceNode> instanceNode = nullptr);
     VarNode& evaluateVariableReference(String name, SharedPtr<Scope> scope, SharedPtr<ClassInstanceNode> instanceNode = nullptr);
 
-    EvalResult evaluateBinaryOperation(const String& op, const Node& left, const Node& right, SharedPtr<Scope> scope, SharedPtr<ClassInstanceNode> instanceNode = nullptr);
-    EvalResult evaluateUnaryOperation(const String& op, const Node& operand, SharedPtr<ClassInstanceNode> instanceNode = nullptr);
+    EvalResult evaluateBinaryOperation(BinaryOp op, const Node& left, const Node& right, SharedPtr<Scope> scope, SharedPtr<ClassInstanceNode> instanceNode = nullptr);
+    EvalResult evaluateUnaryOperation(UnaryOp op, const Node& operand, SharedPtr<ClassInstanceNode> instanceNode = nullptr);
 
     EvalResult evaluateBasicLoop();
 
@@ -47,7 +47,7 @@ namespace FlowEvaluator {
     EvalResult evaluateMethodBody(Vector<UniquePtr<BaseAST>>& children, SharedPtr<Scope> methodScope, SharedPtr<ClassInstanceNode> instanceNode = nullptr);
     EvalResult evaluateClassBody(SharedPtr<Scope> classCapturedScope, SharedPtr<Scope> classScope, SharedPtr<Scope> generatedScope, String accessor, Vector<UniquePtr<BaseAST>>& children, SharedPtr<ClassInstanceNode> instanceNode = nullptr);
     EvalResult evaluateClassCall(SharedPtr<Scope> callScope, String className, ArgumentList argValues, SharedPtr<ClassInstanceNode> instanceNode = nullptr);
-    EvalResult evaluateMethodDef(SharedPtr<Scope> passedScope, SharedPtr<Scope> ownScope, SharedPtr<Scope> classScope, String methodName, MethodBody* body, ParamList parameters, CallableType callType, SharedPtr<ClassInstanceNode> instanceNode = nullptr);
+    EvalResult evaluateMethodDef(SharedPtr<Scope> passedScope, SharedPtr<Scope> ownScope, SharedPtr<Scope> classScope, String methodName, MethodBody* body, const Captures& captures, ParamList parameters, CallableType callType, SharedPtr<ClassInstanceNode> instanceNode = nullptr);
     
 
     EvalResult evaluateBreak();
@@ -0,0 +1,80 @@
+#ifndef FUTURE_HPP
+#define FUTURE_HPP
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+
+#include "core/node/NodeStructures.hpp"
+
+// The result of a spawned call. Work that needs no interpreter state (a pure int function
+// lowered to FastIR, or a native builtin fed deep copies of its arguments) runs on the shared
+// pool. An interpreted call cannot leave the isolate that owns its scope tree, so it runs as an
+// async frame on that isolate's event loop. Async I/O results are completed by the loop too,
+// which waiting drives.
+class FutureState {
+public:
+    // Starts `fn(args...)` and returns its pending result.
+    static SharedPtr<FutureState> spawn(const Node& fn, const ArgumentList& args, SharedPtr<Scope> scope);
+
+    // A result some other party completes, e.g. a coroutine on the event loop.
+    static SharedPtr<FutureState> pending();
+
+    FutureState(const FutureState&) = delete;
+    FutureState& operator=(const FutureState&) = delete;
+
+    // Blocks until the result is ready; rethrows the call's error.
+    Node wait();
+    bool isDone() const;
+
+    // Index of the first finished future.
+    static std::size_t waitAny(const Vector<SharedPtr<FutureState>>& futures);
+
+    void complete(Node value, std::exception_ptr failure);
+
+    // Calls `fn` once the result is ready, on the completing thread (or right away if it already is).
+    void onComplete(std::function<void()> fn);
+
+private:
+    FutureState() = default;
+
+    mutable std::mutex mutex;
+    std::condition_variable ready;
+    bool done = false;
+    Node result;
+    std::exception_ptr error;
+    Vector<std::function<void()>> continuations;
+};
+
+
+class FutureNode : public NativeNode {
+private:
+    SharedPtr<FutureState> state;
+
+public:
+    explicit FutureNode(SharedPtr<FutureState> state);
+
+    SharedPtr<FutureState> getState() const { return state; }
+
+    String toString() const override;
+    bool holdsValue() override;
+    std::size_t hash() const override;
+
+    VariantType getValue() const override;
+    void setValue(const VariantType& v) override;
+    SharedPtr<NodeBase> clone() const override;
+    void clear() override;
+
+    SharedPtr<NativeNode> toNative() const override;
+};
+
+bool isFuture(const Node& value);
+
+// The future held by a Future instance; throws for any other value.
+SharedPtr<FutureState> futureOf(const Node& value);
+
+// A Future instance for an already started result.
+Node futureValue(SharedPtr<FutureState> state, SharedPtr<Scope> scope);
+
+#endif // FUTURE_HPP
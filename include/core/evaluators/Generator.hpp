@@ -0,0 +1,99 @@
+#ifndef GENERATOR_HPP
+#define GENERATOR_HPP
+
+#include <exception>
+#include <functional>
+#include <memory>
+#include <ucontext.h>
+
+#include "core/node/NodeStructures.hpp"
+
+class Isolate;
+
+// A suspended call frame. The generator body runs on a stack of its own that the resuming
+// thread switches to and back from (a stackful coroutine), so a frame costs a lazily committed
+// stack mapping rather than a thread, and only one side is ever running.
+class GeneratorState : public std::enable_shared_from_this<GeneratorState> {
+public:
+    using Body = std::function<void()>;
+
+    // Reserved per frame, committed only as it is touched; the size of a default thread stack.
+    static constexpr std::size_t kStackSize = 8u << 20;
+
+    explicit GeneratorState(Body body);
+    ~GeneratorState();
+
+    GeneratorState(const GeneratorState&) = delete;
+    GeneratorState& operator=(const GeneratorState&) = delete;
+
+    // Consumer side: runs the frame until its next yield. Returns false once the body has finished.
+    bool resume(Node& out);
+
+    // Producer side: publishes a value and suspends until the consumer asks for the next one.
+    void yieldValue(Node value);
+
+    bool isFinished() const { return finished; }
+
+    // The generator whose body is executing on the calling thread, if any.
+    static GeneratorState* active();
+
+    // The exception bookkeeping the C++ runtime keeps per thread; each stack keeps its own.
+    struct ExceptionState {
+        void* caught = nullptr;
+        unsigned int uncaught = 0;
+    };
+
+private:
+    static void entry();
+    void start();
+    void enter();  // consumer -> frame
+    void leave();  // frame -> consumer
+    void arrived();
+    void releaseStack();
+
+    Body body;
+    Isolate* isolate; // the frame runs in its creator's isolate
+    void* stack = nullptr;
+    ucontext_t frameContext{};
+    ucontext_t callerContext{};
+    ExceptionState exceptions;
+    GeneratorState* outer = nullptr;  // active() to restore when the frame suspends
+
+    // Sanitizer bookkeeping for the stack switches.
+    void* fakeStack = nullptr;
+    const void* callerStack = nullptr;
+    std::size_t callerStackSize = 0;
+    void* fiber = nullptr;
+    void* callerFiber = nullptr;
+
+    bool started = false;
+    bool finished = false;
+    bool cancelled = false;
+    bool running = false;
+    Node slot;
+    std::exception_ptr error;
+};
+
+
+class GeneratorNode : public NativeNode {
+private:
+    String name;
+    SharedPtr<GeneratorState> state;
+
+public:
+    GeneratorNode(String name, GeneratorState::Body body);
+
+    String toString() const override;
+    bool holdsValue() override;
+    std::size_t hash() const override;
+
+    VariantType getValue() const override;
+    void setValue(const VariantType& v) override;
+    SharedPtr<NodeBase> clone() const override;
+    void clear() override;
+    UniquePtr<NodeIterator> makeIterator() const override;
+
+    SharedPtr<NativeNode> toNative() const override;
+};
+
+#endif // GENERATOR_HPP
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <functional>
+#include <optional>
+
+#include "core/TypesFWD.hpp"
+#include "core/evaluators/EvalResult.hpp"
+#include "core/evaluators/FastIR.hpp"
+
+class ForLoop;
+class Frame;
+class WorkStealingPool;
+
+namespace Parallel {
+
+// Pool shared by parallel constructs; one worker per core unless overridden.
+WorkStealingPool& pool();
+
+// Rebuilds the shared pool with `workers` threads (0 = one per core).
+// Must not be called while parallel work is in flight.
+void setWorkerCount(std::size_t workers);
+
+// Threads in the shared pool; worker indices passed to chunk bodies are below this.
+std::size_t workerCount();
+
+// Chunk count used to split `count` items over the shared pool.
+std::size_t chunkCount(std::size_t count);
+
+// Runs body(chunk, begin, end, worker) for `chunks` contiguous slices of [0, count) on the shared
+// pool and waits for all of them. The first exception thrown by a chunk is rethrown here.
+using ChunkBody = std::function<void(std::size_t chunk, std::size_t begin, std::size_t end, std::size_t worker)>;
+void forChunks(std::size_t count, std::size_t chunks, const ChunkBody& body);
+
+// Splits an already evaluated `parallel for` range into chunks run on the shared pool. Each worker runs the loop
+// lowered to FastIR on a private frame seeded with the captured outer ints; reduction variables
+// start from their identity per chunk and are merged in chunk order on the calling thread.
+// Returns nullopt when the body cannot run in parallel (it does not lower to FastIR or captures
+// non-int values); the caller then runs the loop serially.
+std::optional<EvalResult> tryEvaluateFor(const ForLoop& forLoop, int start, int end, int step, SharedPtr<Scope> scope, SharedPtr<ClassInstanceNode> instanceNode = nullptr);
+
+// A Merk function over int parameters lowered to FastIR. It touches nothing but the frame it runs
+// on, so one kernel can be called from any number of workers, each with its own Frame.
+class IntKernel {
+public:
+    // Null unless `callee` is a user function of exactly `arity` plain parameters whose body lowers.
+    static UniquePtr<IntKernel> compile(const Node& callee, std::size_t arity, SharedPtr<Scope> scope);
+
+    // Returns false when the body finished without reaching a return.
+    bool call(Frame& frame, const int* args, int& out) const;
+    bool requiresReturn() const { return mustReturn; }
+
+private:
+    FastIR::Program program;
+    Vector<String> params;
+    bool mustReturn = false;
+};
+
+} // namespace Parallel
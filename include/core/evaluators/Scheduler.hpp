@@ -0,0 +1,112 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+#include "core/TypesFWD.hpp"
+
+// Cooperative preemption. Loop back-edges, calls and FastIR jumps each burn one unit of the
+// calling thread's fuel; when it runs out, the Scheduler the thread belongs to may hand its
+// run slot to another script. Threads outside a scheduler never run out.
+namespace Fuel {
+
+inline constexpr bool kEnableFuel = true;
+inline constexpr std::int64_t kUnlimited = std::numeric_limits<std::int64_t>::max();
+
+extern constinit thread_local std::int64_t remaining;
+
+// Slow path of burn(): yields to the thread's scheduler, then refills.
+void exhausted();
+
+inline void burn() {
+    if constexpr (kEnableFuel) {
+        if (--remaining <= 0) [[unlikely]] exhausted();
+    }
+}
+
+// burn() against a copy of `remaining` the caller keeps in a local for a hot dispatch loop;
+// the caller stores it back when the loop exits.
+inline void burn(std::int64_t& local) {
+    if constexpr (kEnableFuel) {
+        if (--local <= 0) [[unlikely]] {
+            remaining = 0;
+            exhausted();
+            local = remaining;
+        }
+    }
+}
+
+} // namespace Fuel
+
+
+// Round-robins scripts over `slots` run slots. This is not a worker pool: every started script
+// keeps its own thread, so its interpreter stack survives preemption and blocking, and only
+// `slots` of them run at once. A script that burns through `quantum` units while others are
+// queued goes to the back of the queue; one that blocks gives up its slot until it wakes.
+// A quantum of 0 never preempts.
+class Scheduler {
+public:
+    using Job = std::function<void()>;
+
+    // Held across a wait that another script may have to satisfy (channel, future, event loop):
+    // the calling script's slot goes to the next queued script, and on the way out the script
+    // queues for a slot again. A no-op outside a scheduler.
+    class Blocking {
+    public:
+        Blocking();
+        ~Blocking();
+
+        Blocking(const Blocking&) = delete;
+        Blocking& operator=(const Blocking&) = delete;
+
+    private:
+        Scheduler* scheduler = nullptr;
+        void* script = nullptr;
+    };
+
+    Scheduler(std::size_t slots, std::int64_t quantum);
+    ~Scheduler();
+
+    Scheduler(const Scheduler&) = delete;
+    Scheduler& operator=(const Scheduler&) = delete;
+
+    void submit(Job job);
+
+    // Blocks until every submitted script has finished.
+    void wait();
+
+    std::size_t preemptions() const { return preempted.load(std::memory_order_relaxed); }
+
+private:
+    struct Script {
+        Job job;
+        std::thread thread;
+        std::condition_variable turn;
+        bool started = false;
+        bool running = false;
+    };
+
+    friend void Fuel::exhausted();
+
+    void run(Script* script);
+    void yield(Script* script);
+    void release(Script* script);
+    void reacquire(Script* script);
+    void dispatchLocked();
+
+    std::int64_t quantum;
+    std::mutex mutex;
+    std::condition_variable allDone;
+    std::deque<Script*> queue;
+    Vector<UniquePtr<Script>> scripts;
+    Vector<std::thread> exited;
+    std::size_t freeSlots;
+    std::size_t unfinished = 0;
+    std::atomic<std::size_t> preempted{0};
+};
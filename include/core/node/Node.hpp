@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <stdexcept>
 #include <iostream>
 #include <sstream>
@@ -8,6 +9,8 @@
 #include <optional>
 #include <functional>
 #include <unordered_map>
+#include <atomic>
+#include <utility>
 #include "core/TypesFWD.hpp"
 #include "core/types.h"
 
@@ -57,6 +60,11 @@ struct DataTypeFlags {
     
 };
 
+// Result of a three-way comparison; Unordered covers NaN operands.
+enum class Ordering { Less, Equal, Greater, Unordered };
+
+class NodeRef;
+
 class NodeBase: public std::enable_shared_from_this<NodeBase> {
 public:
     mutable DataTypeFlags flags;
@@ -125,6 +133,9 @@ public:
     virtual SharedPtr<NodeBase> operator>(const NodeBase& other) const;
     virtual SharedPtr<NodeBase> operator<=(const NodeBase& other) const;
     virtual SharedPtr<NodeBase> operator>=(const NodeBase& other) const;
+
+    // Allocation-free ordering; the default falls back to the operators above.
+    virtual Ordering compare(const NodeBase& other) const;
     virtual void clear() = 0;
 
     NodeValueType getNodeType() const {return flags.type;}
@@ -133,7 +144,101 @@ public:
     void setFlags(DataTypeFlags newOnes);
     virtual std::size_t hash() const;
     virtual std::size_t strictHash() const;
-    
+
+    // Switches this value, and everything it holds, to atomic handle counting before it is
+    // handed to another thread. There is no way back: a frozen value stays frozen.
+    void freeze() const;
+    bool isFrozen() const { return handles.frozen; }
+
+protected:
+    virtual void freezeChildren() const {}
+
+private:
+    friend class NodeRef;
+
+    // Node handles are counted here: a plain increment while the value lives in one isolate,
+    // an atomic one once frozen. While any handle exists, `anchor` keeps the shared_ptr
+    // ownership everyone else uses alive.
+    struct HandleCount {
+        mutable std::uint32_t count = 0;
+        mutable bool frozen = false;
+        mutable std::atomic_flag anchorLock = ATOMIC_FLAG_INIT;
+        mutable SharedPtr<NodeBase> anchor;
+
+        HandleCount() = default;
+        // A copied value is a new object with no handles of its own.
+        HandleCount(const HandleCount&) {}
+        HandleCount& operator=(const HandleCount&) { return *this; }
+    };
+    HandleCount handles;
+
+    // The unfrozen paths are inline: they are every Node creation and drop in an isolate.
+    void adoptHandle(SharedPtr<NodeBase>&& owner) const {
+        if (handles.frozen) return adoptFrozenHandle(std::move(owner));
+        if (handles.count++ == 0) handles.anchor = std::move(owner);
+    }
+    void retainHandle() const {
+        if (handles.frozen) {
+            std::atomic_ref<std::uint32_t>(handles.count).fetch_add(1, std::memory_order_relaxed);
+        } else {
+            ++handles.count;
+        }
+    }
+    void releaseHandle() const {
+        if (handles.frozen) return releaseFrozenHandle();
+        // The anchor may be the last owner, so it is only dropped once nothing here is touched again.
+        if (--handles.count == 0) SharedPtr<NodeBase> last = std::move(handles.anchor);
+    }
+    void adoptFrozenHandle(SharedPtr<NodeBase>&& owner) const;
+    void releaseFrozenHandle() const;
+};
+
+
+// The handle a Node holds. Copies only touch NodeBase's intrusive count; the shared_ptr control
+// block is touched when the first handle is taken and when the last one goes away.
+class NodeRef {
+    NodeBase* ptr = nullptr;
+
+    void release() {
+        if (ptr) std::exchange(ptr, nullptr)->releaseHandle();
+    }
+
+public:
+    NodeRef() = default;
+    NodeRef(std::nullptr_t) {}
+    NodeRef(SharedPtr<NodeBase> owner) : ptr(owner.get()) {
+        if (ptr) ptr->adoptHandle(std::move(owner));
+    }
+    NodeRef(const NodeRef& other) : ptr(other.ptr) {
+        if (ptr) ptr->retainHandle();
+    }
+    NodeRef(NodeRef&& other) noexcept : ptr(std::exchange(other.ptr, nullptr)) {}
+    ~NodeRef() { release(); }
+
+    NodeRef& operator=(const NodeRef& other) {
+        if (other.ptr) other.ptr->retainHandle();
+        release();
+        ptr = other.ptr;
+        return *this;
+    }
+    NodeRef& operator=(NodeRef&& other) noexcept {
+        if (this != &other) {
+            release();
+            ptr = std::exchange(other.ptr, nullptr);
+        }
+        return *this;
+    }
+    NodeRef& operator=(SharedPtr<NodeBase> owner) { return *this = NodeRef(std::move(owner)); }
+
+    NodeBase* get() const { return ptr; }
+    NodeBase* operator->() const { return ptr; }
+    NodeBase& operator*() const { return *ptr; }
+    explicit operator bool() const { return ptr != nullptr; }
+    bool operator==(const NodeRef& other) const { return ptr == other.ptr; }
+    bool operator==(std::nullptr_t) const { return ptr == nullptr; }
+
+    // For the APIs that still traffic in shared_ptr.
+    SharedPtr<NodeBase> shared() const { return ptr ? ptr->handles.anchor : nullptr; }
 };
 
 
@@ -146,7 +251,7 @@ class DictNode;
 class SetNode;
 
 class Node {
-    SharedPtr<NodeBase> data;   // Polymorphic pointer, containing even instances
+    NodeRef data;   // Polymorphic pointer, containing even instances
 public:
     
     Node();
@@ -163,6 +268,10 @@ public:
 
     NodeValueType getType() const;
     Node clone() const;
+    // See NodeBase::freeze.
+    void freeze() const { if (data) data->freeze(); }
+    // Gives this handle its own copy of a frozen value before it is written to.
+    void detachIfFrozen();
 
     bool isInt();
     bool isInt() const;
@@ -244,6 +353,7 @@ public:
     bool operator>(const Node& other) const;
     bool operator<=(const Node& other) const;
     bool operator>=(const Node& other) const;
+    Ordering compare(const Node& other) const;
 
     DataTypeFlags& getFlags();
     const DataTypeFlags& getFlags() const;
@@ -264,6 +374,8 @@ public:
     static Node fromVariant(VariantType v);
     SharedPtr<NodeBase> getInner();
     SharedPtr<NodeBase> getInner() const;
+    // The value without taking a handle on it; valid while this Node is.
+    NodeBase* getInnerPtr() const { return data.get(); }
 
     void clear();
 
@@ -391,9 +503,11 @@ public:
     SharedPtr<NodeBase> operator>(const NodeBase& other) const override;
     SharedPtr<NodeBase> operator<=(const NodeBase& other) const override;
     SharedPtr<NodeBase> operator>=(const NodeBase& other) const override;
+    Ordering compare(const NodeBase& other) const override;
 
     void clear() override;
     int rawValue() const { return value; }
+    void setRawValue(int v) { value = v; }
 };
 
 
@@ -440,9 +554,11 @@ public:
     SharedPtr<NodeBase> operator>(const NodeBase& other) const override;
     SharedPtr<NodeBase> operator<=(const NodeBase& other) const override;
     SharedPtr<NodeBase> operator>=(const NodeBase& other) const override;
+    Ordering compare(const NodeBase& other) const override;
 
     void clear() override;
     float rawValue() const { return value; }
+    void setRawValue(float v) { value = v; }
 };
 
 
@@ -489,15 +605,32 @@ public:
     SharedPtr<NodeBase> operator>(const NodeBase& other) const override;
     SharedPtr<NodeBase> operator<=(const NodeBase& other) const override;
     SharedPtr<NodeBase> operator>=(const NodeBase& other) const override;
+    Ordering compare(const NodeBase& other) const override;
 
     void clear() override;
     double rawValue() const { return value; }
+    void setRawValue(double v) { value = v; }
 };
 
+// StringNode views the range [offset, offset + length) of an append-only buffer
+// that may be shared with other StringNodes. Concatenating onto the node that
+// owns the buffer's tail appends in place (amortized O(1)) and every older view
+// stays valid, so `s = s + x` and `s += x` loops no longer copy the whole string.
+// Slices (slice(), File.readLine()) are views into their parent's buffer.
 class StringNode : public NodeBase {
-    String value;
+    mutable SharedPtr<String> buffer;
+    mutable std::size_t offset = 0;
+    mutable std::size_t length = 0;
+
+    bool ownsTail() const { return offset + length == buffer->size(); }
 public:
+    // A retained slice is copied out once its parent is at least this large and
+    // the slice covers less than 1/kSliceCopyOutRatio of it.
+    static constexpr std::size_t kSliceCopyOutMinParent = 1u << 20;
+    static constexpr std::size_t kSliceCopyOutRatio = 8;
+
     explicit StringNode(String v);
+    StringNode(SharedPtr<String> sharedBuffer, std::size_t start, std::size_t len);
 
     VariantType getValue() const override;
     void setValue(const VariantType& v) override;
@@ -538,8 +671,22 @@ public:
     SharedPtr<NodeBase> operator>(const NodeBase& other) const override;
     SharedPtr<NodeBase> operator<=(const NodeBase& other) const override;
     SharedPtr<NodeBase> operator>=(const NodeBase& other) const override;
+    Ordering compare(const NodeBase& other) const override;
     void clear() override;
-    const String& rawValue() const { return value; }
+
+    std::string_view view() const { return std::string_view(buffer->data() + offset, length); }
+    std::size_t size() const { return length; }
+    const String& rawValue() const;
+
+    // Zero-copy substring [start, end), clamped to this string.
+    SharedPtr<StringNode> slice(std::size_t start, std::size_t end) const;
+    // Copies a slice out of its parent when keeping it would pin a much larger buffer.
+    void detachIfSparse() const;
+
+    // Extends this node in place; other nodes sharing the buffer keep their view.
+    void append(std::string_view tail);
+    // Returns a new node holding this + tail, reusing the buffer when possible.
+    SharedPtr<StringNode> concat(std::string_view tail) const;
 };
 
 class CharNode : public NodeBase {
@@ -590,6 +737,7 @@ public:
     SharedPtr<NodeBase> operator>(const NodeBase& other) const override;
     SharedPtr<NodeBase> operator<=(const NodeBase& other) const override;
     SharedPtr<NodeBase> operator>=(const NodeBase& other) const override;
+    Ordering compare(const NodeBase& other) const override;
     void clear() override;
     char rawValue() const { return value; }
 };
@@ -640,6 +788,7 @@ public:
     SharedPtr<NodeBase> operator>(const NodeBase& other) const override;
     SharedPtr<NodeBase> operator<=(const NodeBase& other) const override;
     SharedPtr<NodeBase> operator>=(const NodeBase& other) const override;
+    Ordering compare(const NodeBase& other) const override;
 
     void clear() override;
     bool rawValue() const { return value; }
@@ -656,25 +805,6 @@ public:
     static Node dispatchNode(VariantType val, String typeStr, bool coerce = false);
     static AnyNode fromVariant(VariantType v);
 
-    static SharedPtr<NodeBase> applyAdd(const NodeBase& lhs, const NodeBase& rhs);
-    static SharedPtr<NodeBase> applySub(const NodeBase& lhs, const NodeBase& rhs);
-    static SharedPtr<NodeBase> applyMul(const NodeBase& lhs, const NodeBase& rhs);
-    static SharedPtr<NodeBase> applyDiv(const NodeBase& lhs, const NodeBase& rhs);
-    static SharedPtr<NodeBase> applyMod(const NodeBase& lhs, const NodeBase& rhs);
-
-    // Mutating
-    static void applyAddMut(NodeBase& target, const NodeBase& rhs);
-    static void applySubMut(NodeBase& target, const NodeBase& rhs);
-    static void applyMulMut(NodeBase& target, const NodeBase& rhs);
-    static void applyDivMut(NodeBase& target, const NodeBase& rhs);
-
-    // Comparison
-    static SharedPtr<NodeBase> applyEq(const NodeBase& lhs, const NodeBase& rhs);
-    static SharedPtr<NodeBase> applyNeq(const NodeBase& lhs, const NodeBase& rhs);
-    static SharedPtr<NodeBase> applyLt(const NodeBase& lhs, const NodeBase& rhs);
-    static SharedPtr<NodeBase> applyGt(const NodeBase& lhs, const NodeBase& rhs);
-    static SharedPtr<NodeBase> applyLe(const NodeBase& lhs, const NodeBase& rhs);
-    static SharedPtr<NodeBase> applyGe(const NodeBase& lhs, const NodeBase& rhs);
     static void validateMutability(const NodeBase&);
     static void validateMutability(const Node&);
 
@@ -724,8 +854,12 @@ public:
     SharedPtr<NodeBase> operator>(const NodeBase& other) const override;
     SharedPtr<NodeBase> operator<=(const NodeBase& other) const override;
     SharedPtr<NodeBase> operator>=(const NodeBase& other) const override;
+    Ordering compare(const NodeBase& other) const override;
 
     void clear() override;
+
+protected:
+    void freezeChildren() const override;
 };
 
 
@@ -778,6 +912,14 @@ public:
 class VarNode: public NodeWrapper {
     DataTypeFlags varFlags;
     String staticType = "Any";
+
+    // Set while valueNode is shared with a container element (for-in binding);
+    // the next assignment then rebinds instead of writing through in place.
+    bool borrowed = false;
+
+    // Variables outlive the expression that produced them; don't let a short
+    // string slice pin its (much larger) parent buffer.
+    void detachSparseString();
 public:
     VarNode();
     VarNode(Node node, bool isC, bool isMut, ResolvedType t, bool isStatic);
@@ -786,6 +928,9 @@ public:
     VarNode(Node node, DataTypeFlags);
 
     void setValue(Node other) override;
+    // Loop-variable fast path: rebinds to `value` without flag merging or
+    // in-place writes, so the element stays owned by its container.
+    void bindValue(const Node& value);
 
     DataTypeFlags& getVarFlags();
     const DataTypeFlags& getVarFlags() const;
@@ -824,6 +969,8 @@ public:
     LitNode();
     LitNode(const String& value, const String& type);
     LitNode(SharedPtr<DataStructure>);
+    // An already computed value, as the AST optimizer produces when it folds an operation.
+    explicit LitNode(Node value);
 };
 
 
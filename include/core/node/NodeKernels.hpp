@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include "core/node/Node.hpp"
+#include "core/errors.h"
+
+inline constexpr bool kEnableOperatorKernels = true;
+
+// Typed kernels for the binary operators, looked up by (operator, left kind, right kind).
+// Primitive operands are combined straight from their values; a pair with no kernel is left
+// to the nodes' own operators.
+namespace NodeKernels {
+
+// Float widens to Double, as the evaluator always has for mixed arithmetic.
+enum class Kind : std::uint8_t { Int, Double, String, Bool, Other };
+inline constexpr size_t kKindCount = 5;
+
+Kind kindOf(const NodeBase& node);
+
+// Integer arithmetic for the int fast paths; false for operators it does not cover.
+inline bool applyInt(BinaryOp op, int lhs, int rhs, int& out) {
+    switch (op) {
+        case BinaryOp::Add: out = lhs + rhs; return true;
+        case BinaryOp::Sub: out = lhs - rhs; return true;
+        case BinaryOp::Mul: out = lhs * rhs; return true;
+        case BinaryOp::Div:
+            if (rhs == 0) throw MerkError("Division by zero");
+            out = lhs / rhs;
+            return true;
+        case BinaryOp::Mod:
+            if (rhs == 0) throw MerkError("Modulo by zero");
+            out = lhs % rhs;
+            return true;
+        default:
+            return false;
+    }
+}
+
+// `lhs op rhs` when a kernel covers the operand kinds; otherwise false and `out` is untouched.
+bool apply(BinaryOp op, const Node& lhs, const Node& rhs, Node& out);
+
+// `target op= rhs` for AddAssign..DivAssign. Int, Float and Double targets are updated in
+// place; anything else goes through the target's arithmetic operator and setValue.
+void applyInPlace(BinaryOp op, NodeBase& target, const NodeBase& rhs);
+
+} // namespace NodeKernels
@@ -7,6 +7,21 @@
 #include "core/node/Node.hpp"
 #include <fstream>
 
+class FutureState;
+
+// Pull-style cursor used by for-in loops. next() writes the following element
+// into `out` and returns false once the source is exhausted. Iterators keep
+// their source alive, so the loop never copies the container up front.
+class NodeIterator {
+public:
+    virtual ~NodeIterator() = default;
+    virtual bool next(Node& out) = 0;
+};
+
+// Resolves the iterator for any iterable runtime value: native containers,
+// class instances wrapping one (List/Array/Dict/Set/File), and strings.
+UniquePtr<NodeIterator> makeNodeIterator(const Node& iterable);
+
 class NativeNode: public NodeBase {
 protected:
     NodeValueType dataType;
@@ -26,6 +41,7 @@ public:
     bool isNative() const {return true;}
     virtual SharedPtr<NativeNode> toNative() const override = 0;
     virtual SharedPtr<NodeBase> clone() const override;
+    virtual UniquePtr<NodeIterator> makeIterator() const;
 
     
     // SharedPtr<NodeBase> operator==(const NodeBase& other) const override = 0;
@@ -85,9 +101,13 @@ public:
     virtual SharedPtr<NodeBase> clone() const override;
     void clear() override;
     int length() const override;
+    UniquePtr<NodeIterator> makeIterator() const override;
 
     virtual SharedPtr<NativeNode> toNative() const override;
     // SharedPtr<NodeBase> operator==(const NodeBase& other) const override;
+
+protected:
+    void freezeChildren() const override;
 };
 
 class ArrayNode: public ListNode {
@@ -139,9 +159,13 @@ public:
     SharedPtr<NodeBase> clone() const override;
     void clear() override;
     int length() const override;
+    UniquePtr<NodeIterator> makeIterator() const override; // yields keys
 
     SharedPtr<NativeNode> toNative() const override;
     // SharedPtr<NodeBase> operator==(const NodeBase& other) const override;
+
+protected:
+    void freezeChildren() const override;
 };
 
 class SetNode: public DataStructure {    
@@ -176,9 +200,41 @@ public:
     void setValue(const VariantType& v) override;
     void clear() override;
     int length() const override;
+    UniquePtr<NodeIterator> makeIterator() const override;
 
     SharedPtr<NativeNode> toNative() const override;
     // SharedPtr<NodeBase> operator==(const NodeBase& other) const override;
+
+protected:
+    void freezeChildren() const override;
+};
+
+// Lazy integer sequence produced by range(); nothing is materialized.
+class RangeNode: public NativeNode {
+private:
+    int start = 0;
+    int stop = 0;
+    int step = 1;
+
+public:
+    RangeNode(int start, int stop, int step = 1);
+
+    int getStart() const { return start; }
+    int getStop() const { return stop; }
+    int getStep() const { return step; }
+
+    String toString() const override;
+    bool holdsValue() override;
+    std::size_t hash() const override;
+    int length() const override;
+
+    VariantType getValue() const override;
+    void setValue(const VariantType& v) override;
+    SharedPtr<NodeBase> clone() const override;
+    void clear() override;
+    UniquePtr<NodeIterator> makeIterator() const override;
+
+    SharedPtr<NativeNode> toNative() const override;
 };
 
 
@@ -217,6 +273,7 @@ public:
     NodeValueType getType() const override { return NodeValueType::Http; }
 
     Node send(); // performs the HTTP request and returns a response Node
+    SharedPtr<FutureState> sendAsync(); // the same request on the event loop; resolves to the response
 
     String toString() const override;
     std::size_t hash() const override;
@@ -269,15 +326,33 @@ public:
     static std::uintmax_t sizeOf(const String& path);
     static void removeFile(const String& path);
 
+    // Whole-file reads and writes on the shared pool, resumed on the event loop. They open
+    // `path` themselves, independent of any File's stream.
+    static SharedPtr<FutureState> readAllAsync(const String& path);
+    static SharedPtr<FutureState> writeAllAsync(const String& path, String data, bool append);
+
+    // Yields lines from the current position, as readLineNode() does.
+    UniquePtr<NodeIterator> makeIterator() const override;
+
     SharedPtr<NativeNode> toNative() const override;
 
 private:
     std::fstream stream;
     bool binary = false;
 
+    // readLineNode() reads the file in chunks and returns each line as a
+    // StringNode slice of the current chunk instead of allocating per line.
+    static constexpr std::size_t kLineChunkSize = 64 * 1024;
+    SharedPtr<String> lineChunk;
+    std::size_t lineChunkPos = 0;
+
+    bool refillLineChunk();
+    // Hands unconsumed chunk bytes back to the stream before any other file op.
+    void dropLineChunk();
+
     // Pulls "path" and "mode" from the bound instance’s scope
     void loadConfigFromInstance();
-    void closeQuiet() { if (stream.is_open()) stream.close(); }
+    void closeQuiet() { dropLineChunk(); if (stream.is_open()) stream.close(); }
 };
 
 
@@ -214,8 +214,8 @@ struct Token {
     int line;
     int column;
 
-    Token(TokenType t, const String& v, int l, int c)
-        : type(t), value(v), line(l), column(c) {}
+    Token(TokenType t, String v, int l, int c)
+        : type(t), value(std::move(v)), line(l), column(c) {}
 
     String toString() const {
         return "Token(Type: " + tokenTypeToString(type) +
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+// The words the lexer knows before it has seen any source: the special words it classifies by
+// name, the keyword bucket and the primitive constructors. The table is fixed, so it is looked
+// up through a perfect hash found at compile time: one hash, one compare, no allocation.
+namespace Keywords {
+
+// Special words with a classification of their own.
+enum class Kind : std::uint8_t {
+    None,
+    ClassDef,        // Class
+    FunctionDef,     // function, def
+    Bool,            // true, false
+    WordOperator,    // and, or, not
+    VarDeclaration,  // var, const
+    Null,            // null
+};
+
+// What an identifier is known as. Keyword and Primitive come from this table; Class and
+// Function are interned by the lexer from the runtime's builtins and the source's definitions.
+enum Flag : std::uint8_t {
+    Keyword   = 1 << 0,
+    Primitive = 1 << 1,
+    KnownType = 1 << 2,
+    Class     = 1 << 3,
+    Function  = 1 << 4,
+};
+
+struct Entry {
+    std::string_view word;
+    Kind kind = Kind::None;
+    std::uint8_t flags = 0;
+};
+
+inline constexpr Entry kTable[] = {
+    {"Class", Kind::ClassDef},
+    {"function", Kind::FunctionDef},
+    {"def", Kind::FunctionDef},
+    {"true", Kind::Bool},
+    {"false", Kind::Bool},
+    {"and", Kind::WordOperator},
+    {"or", Kind::WordOperator},
+    {"not", Kind::WordOperator},
+    {"var", Kind::VarDeclaration},
+    {"const", Kind::VarDeclaration, Keyword},
+    {"null", Kind::Null},
+
+    {"if", Kind::None, Keyword},
+    {"elif", Kind::None, Keyword},
+    {"else", Kind::None, Keyword},
+    {"from", Kind::None, Keyword},
+    {"as", Kind::None, Keyword},
+    {"import", Kind::None, Keyword},
+    {"while", Kind::None, Keyword},
+    {"continue", Kind::None, Keyword},
+    {"break", Kind::None, Keyword},
+    {"return", Kind::None, Keyword},
+    {"yield", Kind::None, Keyword},
+    {"for", Kind::None, Keyword},
+    {"parallel", Kind::None, Keyword},
+    {"throw", Kind::None, Keyword},
+    {"mut", Kind::None, Keyword},
+
+    {"Int", Kind::None, Primitive | KnownType},
+    {"Float", Kind::None, Primitive | KnownType},
+    {"Long", Kind::None, Primitive | KnownType},
+    {"Bool", Kind::None, Primitive | KnownType},
+    {"String", Kind::None, Primitive | KnownType},
+};
+
+inline constexpr std::size_t kSlots = 64;
+inline constexpr std::size_t kMinLength = [] {
+    std::size_t n = kTable[0].word.size();
+    for (const Entry& entry : kTable) n = entry.word.size() < n ? entry.word.size() : n;
+    return n;
+}();
+inline constexpr std::size_t kMaxLength = [] {
+    std::size_t n = 0;
+    for (const Entry& entry : kTable) n = entry.word.size() > n ? entry.word.size() : n;
+    return n;
+}();
+
+// Length and three characters are enough to tell the table's words apart.
+constexpr std::uint32_t hash(std::string_view word, std::uint32_t seed) {
+    std::uint32_t h = seed ^ static_cast<std::uint32_t>(word.size());
+    h = (h ^ static_cast<unsigned char>(word[0])) * 16777619u;
+    h = (h ^ static_cast<unsigned char>(word[word.size() / 2])) * 16777619u;
+    h = (h ^ static_cast<unsigned char>(word[word.size() - 1])) * 16777619u;
+    return (h ^ (h >> 15)) & (kSlots - 1);
+}
+
+constexpr bool collisionFree(std::uint32_t seed) {
+    std::array<bool, kSlots> used{};
+    for (const Entry& entry : kTable) {
+        const std::uint32_t slot = hash(entry.word, seed);
+        if (used[slot]) return false;
+        used[slot] = true;
+    }
+    return true;
+}
+
+constexpr std::uint32_t findSeed() {
+    for (std::uint32_t seed = 2166136261u; seed < 2166136261u + 100000u; ++seed) {
+        if (collisionFree(seed)) return seed;
+    }
+    return 0;
+}
+
+inline constexpr std::uint32_t kSeed = findSeed();
+static_assert(kSeed != 0, "no perfect hash seed for the keyword table");
+
+// Slot -> index into kTable plus one; zero is empty.
+inline constexpr std::array<std::uint8_t, kSlots> kSlotTable = [] {
+    std::array<std::uint8_t, kSlots> slots{};
+    for (std::size_t i = 0; i < std::size(kTable); ++i) {
+        slots[hash(kTable[i].word, kSeed)] = static_cast<std::uint8_t>(i + 1);
+    }
+    return slots;
+}();
+
+inline const Entry* find(std::string_view word) {
+    if (word.size() < kMinLength || word.size() > kMaxLength) return nullptr;
+    const std::uint8_t index = kSlotTable[hash(word, kSeed)];
+    if (index == 0) return nullptr;
+    const Entry& entry = kTable[index - 1];
+    return entry.word == word ? &entry : nullptr;
+}
+
+} // namespace Keywords
@@ -1,8 +1,11 @@
 #pragma once
-#include "lex/Structurizer.hpp"
+#include "lex/Scanner.hpp"
+#include "lex/Keywords.hpp"
 #include "core/TypesFWD.hpp"
 
 
+// Keywords and primitive constructors default to the built-in tables (lex/Keywords.hpp); words
+// listed here beyond those are added to them.
 struct LexerConfig {
     std::unordered_set<String> knownTypes;    // Int, List, Dict...
     std::unordered_set<String> keywords;      // if, else, return...
@@ -17,7 +20,12 @@ public:
     Lexer(LexerConfig);
     Lexer();
 
-    Vector<Token> lex(const Vector<RawToken>& raw, Vector<Token>&);
+    // The interned names refer to the config's strings.
+    Lexer(const Lexer&) = delete;
+    Lexer& operator=(const Lexer&) = delete;
+
+    // Pulls the scanner dry, appending the parser's tokens to `out`.
+    void lex(Scanner& scanner, Vector<Token>& out);
 
 private:
     LexerConfig cfg;
@@ -26,6 +34,7 @@ private:
     bool insideParams = false;
     bool insideArgs   = false;
     bool insideClass  = false;
+    int  brackets = 0;       // open (, [ and {
     int  classIndentLevel = 0;
     int  currentIndent = 0;
 
@@ -35,29 +44,25 @@ private:
     Vector<int> indentStack{0};
 
 
-    std::unordered_set<String> classes;
-    std::unordered_set<String> functions;
-    std::unordered_set<String> primitives;
+    // Names not in the fixed table, with their Keywords flags: the config's classes, functions
+    // and extra words, then every class and function the source defines. Keys view either the
+    // config or the source being lexed; `defined` counts the latter.
+    std::unordered_map<std::string_view, std::uint8_t> names;
+    size_t defined = 0;
 
-    // tables (ported)
-    std::unordered_set<String> keywords;
-    std::unordered_set<String> knownTypes;
+    void internConfig();
+    void define(std::string_view name, std::uint8_t flag);
 
     // helpers
     TokenType classifyIdentifier(
-        const String& value,
+        std::string_view value,
         const Vector<Token>& out,
-        const Vector<RawToken>& raw,
-        size_t rawIndex
+        Scanner& scanner
     );
 
-    bool nextNonTriviaIsLParen(const Vector<RawToken>& raw, size_t i) const;
     bool prevTokenWasDot(const Vector<Token>& out) const;
 
-    bool tryEmitCompoundOp(
-        const Vector<RawToken>& raw, size_t& i,
-        Vector<Token>& out
-    );
+    bool tryEmitCompoundOp(Scanner& scanner, Vector<Token>& out);
 
     void onIndent(int);
     void onDedent(int);
@@ -2,10 +2,12 @@
 
 #include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <stdexcept>
 #include <iostream>
 #include <iomanip>
+#include "lex/SourceBuffer.hpp"
 
 using std::uint8_t;
 using String = std::string;
@@ -36,35 +38,22 @@ enum class RawKind : uint8_t {
     Punctuation,    // (), {}, [], :, ,, .
     Unknown,
     NoOp,
-    
+
     Indent,
     Dedent,
 };
 
+// A token as a span of the scanner's source. Nothing is copied out of the source until the
+// lexer builds the parser's Token. For String/Char/Text the span is the body between the
+// quotes and aux is 1 when it contains escapes; Newline carries the run length, Indent and
+// Dedent the new indentation width.
 struct RawToken {
-    RawKind kind {};
-    String lexeme;
-    int line;
-    int column;
+    RawKind kind = RawKind::Unknown;
+    std::uint32_t offset = 0;
+    std::uint32_t length = 0;
+    int line = -1;
+    int column = -1;
     int aux = -1;
-
-    RawToken(): kind(RawKind::Unknown), line(-1), column(-1) {}
-
-    explicit RawToken(RawKind t, char* v, int l, int c)
-        : kind(t), line(l), column(c) {
-            lexeme += v;
-        }
-
-    explicit RawToken(RawKind t, char v, int l, int c, int a = -1)
-        : kind(t), line(l), column(c), aux(a) {
-            lexeme += v;
-        }
-
-    explicit RawToken(RawKind k, String lx, int l, int c, int a = -1)
-    : kind(k), lexeme(std::move(lx)), line(l), column(c), aux(a) {}
-
-    
-    RawToken(RawKind t): kind(t), line(-1), column(-1) {}
 };
 
 struct CommentPair {
@@ -78,105 +67,84 @@ struct CommentConfig {
     Vector<CommentPair> blockPairs; // { "/*","*/" }, { "{-","-}" }, ...
 };
 
+struct LayoutConfig {
+    int tabWidth = 4;
+    bool tabsAllowed = true;
+    bool parenContinuation = true;       // ignore newline inside (), [], {}
+};
 
 
-// If you don't already have this:
 const char* rawKindToString(RawKind k);
 
 // Escape lexeme so newlines/tabs are visible in debug output.
 String escapeLexeme(const String& s);
 
-void printRawTokens(const Vector<RawToken>& toks, std::ostream& os = std::cout);
-
-// Optional: nice operator<< for RawToken
-std::ostream& operator<<(std::ostream& os, const RawToken& t);
-
 
+// Single-pass front end: scans the source on demand and tracks indentation inline, so the
+// lexer pulls finished layout tokens (Newline/Indent/Dedent included, whitespace and comments
+// dropped) straight off the source with a few tokens of lookahead. A plain view must outlive
+// the scanner and every token taken from it; a SourceBuffer is kept alive by the scanner.
+class Scanner {
+public:
+    Scanner(std::string_view source, CommentConfig comments, LayoutConfig layout = {});
+    Scanner(SharedPtr<SourceBuffer> buffer, CommentConfig comments, LayoutConfig layout = {});
 
+    // The token `ahead` places past the cursor; scans only as far as needed.
+    const RawToken& peek(size_t ahead = 0);
+    void advance();
 
+    std::string_view text(const RawToken& t) const { return source.substr(t.offset, t.length); }
+    bool textIs(const RawToken& t, char c) const { return t.length == 1 && source[t.offset] == c; }
+    // The value of a String/Char/Text token with escapes resolved.
+    String literal(const RawToken& t) const;
 
+    size_t size() const { return source.size(); }
 
-class Scanner {
-    // Source state
-public:
-    const String source;
+private:
+    SharedPtr<SourceBuffer> buffer;
+    std::string_view source;
     size_t position = 0;
-    size_t sourceLength = 0;
-    char current = '\0';
     int line = 1;
-    int column = 1;
+    size_t lineStart = 0;
 
-    Vector<RawToken> rawTokens;
-    RawToken noOpToken = RawToken(RawKind::NoOp);
     CommentConfig commentCfg;
-
-    Scanner(const char* sourceFile, const CommentConfig& cfg);
-    Scanner(String src, CommentConfig cfg);
-
-    char next();
-    bool hasNext();
-
-    bool isWhiteSpace(char);
-    bool isDigit(char);
-    bool isTextBegin(char);
-    bool isOperator(char);
-
-    bool isCommentBegin(char);
-    bool isPunctuation(char);
-    bool isLetter(char);
-    bool isSpecialChar(char);
+    LayoutConfig layoutCfg;
+
+    // Layout state. The first line's indentation is not significant.
+    Vector<int> indentStack{0};
+    bool atLineStart = false;
+    int pendingIndent = 0;
+    int parenDepth = 0;
+    bool finished = false;
+
+    // Tokens scanned but not yet consumed; pending[head] is the cursor.
+    Vector<RawToken> pending;
+    size_t head = 0;
+    RawToken eofToken;
+
+    int column() const { return static_cast<int>(position - lineStart) + 1; }
+    const char* at(size_t pos) const { return source.data() + pos; }
+    const char* end() const { return source.data() + source.size(); }
+    size_t offsetOf(const char* p) const { return static_cast<size_t>(p - source.data()); }
+    RawToken span(RawKind kind, size_t start, int startLine, int startColumn, int aux = -1) const;
+
+    // Scans until at least one more token is pending.
+    void scanMore();
+    void finish();
+    void emit(const RawToken& t);
+    void applyIndent(const RawToken& atToken);
+
+    bool handleWhiteSpace();
+    bool skipComment();
+    void skipBlockComment(const CommentPair& pair, int startLine, int startColumn);
+    void newLine();
 
     RawToken readIdentifier();
     RawToken readNumber();
     RawToken readText();
-
-    RawToken readPunctuation();
-    bool handleSpecialChar(char nextChar, char startChar, String& resultAccum);
-    bool handleSpecialChars();
-    void handleWhiteSpace();    
-    RawToken readOperator();
-
-    int matchBlockStartIndex() const;
-
-
-    void readSource();
-
-
-    // Call from your main scan loop *only when not inside a string/text literal*
-    // Returns true if it consumed and emitted a comment delimiter token.
-    bool tryScanCommentDelimiter();
-
-    RawToken scanLineCommentBody();
-
-    RawToken scanBlockCommentBody(int pairIndex);
-
-
-    Vector<RawToken> scan();
-private:
-    // ---- helpers ----
-    bool inBounds(size_t pos) const;
+    RawToken readSingle(RawKind kind);
 
     bool matchAt(size_t pos, const String& s) const;
-
-    void advanceN(size_t n);
-
-    // ---- comment delimiter scanning ----
-
-    bool tryScanCommentStart();
-
-    bool tryScanCommentEnd();
-
-
-
-
-
-    bool matchBlockEndIndex(int i) const;
-
-    RawToken scanBlockComment(int pairIndex);
-
-    RawToken scanLineComment(const String& startLexeme);
-
-    bool tryScanComment();
 };
 
 using RunTimeError = std::runtime_error;
@@ -198,4 +166,4 @@ public:
     const char* what() const noexcept override;
 
     ~ScannerError() = default;
-};
\ No newline at end of file
+};
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <string_view>
+#include "core/TypesFWD.hpp"
+
+// The bytes a Scanner runs over. Files are memory-mapped read-only where the platform allows
+// (falling back to a read loop into an owned string), so scanning starts without copying the
+// file. Anything holding spans into the source holds the buffer's SharedPtr with them.
+class SourceBuffer {
+public:
+    static SharedPtr<SourceBuffer> open(const String& path);
+    static SharedPtr<SourceBuffer> fromString(String text);
+
+    ~SourceBuffer();
+
+    SourceBuffer(const SourceBuffer&) = delete;
+    SourceBuffer& operator=(const SourceBuffer&) = delete;
+
+    std::string_view view() const { return {data, length}; }
+    size_t size() const { return length; }
+    bool mapped() const { return mapping != nullptr; }
+    const String& path() const { return filePath; }
+
+private:
+    SourceBuffer() = default;
+
+    const char* data = "";
+    size_t length = 0;
+    void* mapping = nullptr;
+    String owned;
+    String filePath;
+};
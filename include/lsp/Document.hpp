@@ -0,0 +1,125 @@
+#pragma once
+
+#include <exception>
+#include <functional>
+#include <optional>
+
+#include "core/TypesFWD.hpp"
+#include "core/types.h"
+#include "lex/Lexer.hpp"
+
+inline constexpr bool kEnableIncrementalReparse = true;
+
+// A source file open in an editor, kept as its top-level blocks: a block starts on a line
+// whose first token sits in column 1 with the lexer's indent stack back at its base and no
+// bracket open (elif/else continue the block above), and runs to the next such line. That
+// line is where lexing can restart, so an edit re-lexes only the blocks it touches, from the
+// start of the block before it when it changes a block's first line. Lexing stops at the
+// first untouched block whose first line still starts a block; otherwise (an unclosed
+// bracket or string) it takes that block in too and tries the next. Only re-lexed blocks are
+// parsed again. Each block is tokenized as the lexer would with every class and function
+// the file defines already known; when that set changes, the blocks naming the changed
+// names are re-lexed as well. Lines and columns are 0-based; columns count bytes.
+class Document {
+public:
+    struct Position {
+        int line = 0;
+        int column = 0;
+    };
+
+    struct Diagnostic {
+        int line = 0;
+        int column = 0;
+        int length = 1;
+        String message;
+
+        bool operator==(const Diagnostic&) const = default;
+    };
+
+    enum class SymbolKind { Class, Function, Method, Variable };
+
+    struct Symbol {
+        String name;
+        SymbolKind kind = SymbolKind::Variable;
+        int line = 0;
+        int column = 0;
+        String container;  // the class of a method
+
+        bool operator==(const Symbol&) const = default;
+    };
+
+    // What the last setText or edit did.
+    struct Stats {
+        size_t blocks = 0;       // in the document afterwards
+        size_t lexedBlocks = 0;
+        size_t lexedLines = 0;
+        size_t parsedBlocks = 0;
+    };
+
+    // Builds the root scope blocks are parsed under and adds the native names to the lexer
+    // config; called once.
+    using ScopeFactory = std::function<SharedPtr<Scope>(LexerConfig&)>;
+
+    // A document that is not incremental re-lexes and re-parses all of itself on every edit.
+    explicit Document(const ScopeFactory& makeScope, bool incremental = kEnableIncrementalReparse);
+    ~Document();
+
+    Document(const Document&) = delete;
+    Document& operator=(const Document&) = delete;
+
+    void setText(const String& text);
+    // Replaces the text between `from` and `to` with `text`; positions past the end of a line
+    // or of the document are clamped to it.
+    void edit(Position from, Position to, const String& text);
+
+    String text() const;
+    size_t lineCount() const { return lines.size(); }
+    size_t blockCount() const { return blocks.size(); }
+    const Stats& lastStats() const { return stats; }
+
+    // The first parse or lex error of each block, in document order.
+    Vector<Diagnostic> diagnostics() const;
+    Vector<Symbol> symbols() const;
+    // The definition of the name at `at`: the nearest one at or above it, else the first below.
+    std::optional<Symbol> definitionAt(Position at) const;
+
+private:
+    struct Block {
+        int start = 0;                 // first line; the block runs to the next block's start
+        Vector<Token> tokens;          // lines relative to the block, its first line being 1
+        Vector<String> classes;        // names the block defines, as the lexer defines them
+        Vector<String> functions;
+        std::unordered_set<String> names;  // every word in it
+        Vector<Symbol> symbols;        // lines relative to the block, 0-based
+        std::optional<Diagnostic> diagnostic;
+        bool parsed = false;
+    };
+
+    size_t blockAt(int line) const;
+    int endOf(size_t index) const;
+
+    void relex(size_t first, size_t end);
+    bool lexRegion(int regionStart, int regionEnd, bool probe, Vector<Block>& out);
+    int nextOpening(int line) const;
+    int lastOpening(int from, int line) const;
+    Block failed(int start, int end, const std::exception& error);
+    void replace(size_t first, size_t end, Vector<Block> fresh);
+    void count(std::unordered_map<String, size_t>& counts, const Vector<String>& names, int step);
+    void refreshNames();
+    void parse(Block& block);
+
+    static void index(Block& block);
+
+    SharedPtr<Scope> scope;
+    LexerConfig natives;
+    LexerConfig config;   // natives plus every class and function the document defines
+    bool incremental;
+
+    Vector<String> lines;
+    Vector<Block> blocks;
+
+    std::unordered_map<String, size_t> classCounts;
+    std::unordered_map<String, size_t> functionCounts;
+    std::unordered_set<String> changedNames;
+    Stats stats;
+};
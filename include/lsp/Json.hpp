@@ -0,0 +1,61 @@
+#pragma once
+
+#include <concepts>
+#include <cstdint>
+#include <initializer_list>
+#include "core/TypesFWD.hpp"
+
+// The JSON the language server reads and writes: objects keep their keys in insertion order,
+// numbers are doubles. Lookups on a missing key or a value of the wrong kind give null, so
+// optional protocol fields read the same as absent ones.
+class Json {
+public:
+    enum class Kind : std::uint8_t { Null, Bool, Number, String, Array, Object };
+    using Array = Vector<Json>;
+    using Object = Vector<std::pair<String, Json>>;
+
+    Json() = default;
+    Json(std::nullptr_t) {}
+    Json(bool value) : kind(Kind::Bool), boolean(value) {}
+    Json(double value) : kind(Kind::Number), number(value) {}
+    template <std::integral T>
+        requires (!std::same_as<T, bool>)
+    Json(T value) : kind(Kind::Number), number(static_cast<double>(value)) {}
+    Json(const char* value) : kind(Kind::String), text(value) {}
+    Json(String value) : kind(Kind::String), text(std::move(value)) {}
+    Json(Array values) : kind(Kind::Array), items(std::move(values)) {}
+    Json(Object values) : kind(Kind::Object), fields(std::move(values)) {}
+
+    static Json object(std::initializer_list<std::pair<String, Json>> values = {});
+    static Json array(std::initializer_list<Json> values = {});
+
+    // Throws MerkError on malformed input.
+    static Json parse(std::string_view source);
+    String dump() const;
+
+    Kind getKind() const { return kind; }
+    bool isNull() const { return kind == Kind::Null; }
+    bool isObject() const { return kind == Kind::Object; }
+    bool isArray() const { return kind == Kind::Array; }
+
+    bool asBool() const { return kind == Kind::Bool && boolean; }
+    double asNumber() const { return kind == Kind::Number ? number : 0.0; }
+    int asInt() const { return static_cast<int>(asNumber()); }
+    const String& asString() const;
+    const Array& asArray() const;
+
+    bool has(std::string_view key) const;
+    const Json& operator[](std::string_view key) const;
+    Json& set(String key, Json value);
+    void push(Json value);
+
+private:
+    void write(String& out) const;
+
+    Kind kind = Kind::Null;
+    bool boolean = false;
+    double number = 0.0;
+    String text;
+    Array items;
+    Object fields;
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <iosfwd>
+
+#include "core/TypesFWD.hpp"
+#include "lsp/Document.hpp"
+#include "lsp/Json.hpp"
+
+// A Language Server Protocol endpoint speaking JSON-RPC with Content-Length framing. It
+// keeps every open file as a Document, takes incremental changes, publishes diagnostics
+// after each one, and answers documentSymbol and definition.
+class LanguageServer {
+public:
+    LanguageServer(std::istream& in, std::ostream& out, Document::ScopeFactory makeScope);
+
+    // Serves until `exit` or the end of input; the process exit code. Anything else written
+    // to std::cout meanwhile would corrupt the stream, so it is discarded.
+    int run();
+
+private:
+    bool read(String& body);
+    void send(const Json& message);
+    void respond(const Json& id, Json result);
+    void fail(const Json& id, int code, const String& message);
+    void notify(const String& method, Json params);
+
+    void handle(const Json& message);
+    void publishDiagnostics(const String& uri);
+    Json documentSymbols(const String& uri) const;
+    Json definition(const String& uri, const Json& position) const;
+    Document& document(const String& uri) const;
+
+    std::istream& in;
+    std::ostream& out;
+    Document::ScopeFactory makeScope;
+    std::unordered_map<String, UniquePtr<Document>> documents;
+    bool shutdown = false;
+    bool exited = false;
+};
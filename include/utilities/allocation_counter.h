@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstddef>
+
+#ifndef MERK_COUNT_ALLOCATIONS
+#define MERK_COUNT_ALLOCATIONS 0
+#endif
+
+// Global operator new is only replaced in bench builds (-DENABLE_ALLOCATION_COUNTING=ON);
+// otherwise the count stays 0 and the benchmarks report allocations as unavailable.
+inline constexpr bool kCountAllocations = MERK_COUNT_ALLOCATIONS != 0;
+
+// Allocations made through operator new on the calling thread.
+std::size_t allocationCount();
@@ -78,10 +78,8 @@ enum class FlowLevel {
 // --- Debugger Singleton ---
 class Debugger {
 public:
-    static Debugger& getInstance() {
-        static Debugger instance;
-        return instance;
-    }
+    // The debugger of the Isolate bound to the calling thread.
+    static Debugger& getInstance();
     bool enabled = true;
 
     // Global log level.
@@ -155,6 +153,7 @@ private:
     FlowLevel flowLevel = FlowLevel::NONE;
     std::mutex mtx;
 
+    friend class Isolate;
     Debugger() = default;
     Debugger(const Debugger&) = delete;
     Debugger& operator=(const Debugger&) = delete;
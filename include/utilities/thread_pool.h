@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed-size pool with one deque per worker. A worker pops from the back of
+// its own deque and, when that runs dry, steals from the front of the others.
+// Tasks receive the index of the worker running them so callers can keep
+// per-worker state (an Isolate, scratch buffers) without locking.
+class WorkStealingPool {
+public:
+    using Task = std::function<void(std::size_t worker)>;
+
+    explicit WorkStealingPool(std::size_t workers = std::thread::hardware_concurrency());
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    // From a worker the task goes to that worker's own deque; otherwise round-robin.
+    // Tasks must not throw.
+    void submit(Task task);
+
+    // Blocks until every submitted task has finished. A worker's own task would never
+    // finish while it waits, so calling this from a worker throws std::logic_error.
+    void wait();
+
+    // Runs one queued task on the calling worker, so a worker blocked on its own
+    // sub-tasks helps instead of holding its thread. False off-pool or when idle.
+    bool runPending();
+
+    std::size_t size() const { return queues.size(); }
+
+    // True when the calling thread is one of this pool's workers.
+    bool isWorkerThread() const;
+
+    // Index of the pool worker running on the calling thread, or npos.
+    static std::size_t currentWorker();
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void workerLoop(std::size_t self);
+    bool tryTake(std::size_t self, Task& out);
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> threads;
+
+    void finished();
+
+    // Counters are atomic so submit and take only lock the deque they touch; the
+    // mutexes are only taken to put a worker to sleep or to wake one.
+    std::atomic<std::size_t> queued{0};      // submitted, not yet taken
+    std::atomic<std::size_t> unfinished{0};  // submitted, not yet completed
+    std::atomic<std::size_t> sleepers{0};
+    std::atomic<std::size_t> nextQueue{0};
+    std::atomic<bool> stopping{false};
+
+    std::mutex sleepMutex;
+    std::condition_variable workAvailable;
+    std::mutex doneMutex;
+    std::condition_variable allDone;
+};
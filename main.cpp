@@ -4,6 +4,15 @@
 #include <cassert>
 #include <chrono>
 #include <iomanip>
+#include <filesystem>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <algorithm>
+#include <numeric>
+#include <thread>
 
 #include "core/TypesFWD.hpp"
 #include "utilities/streaming.h"
@@ -12,6 +21,9 @@
 #include "core/node/Node.hpp"
 #include "core/Tokenizer.hpp"
 #include "core/Parser.hpp"
+#include "core/ModuleLoader.hpp"
+#include "lsp/Document.hpp"
+#include "lsp/LanguageServer.hpp"
 #include "core/registry/Context.hpp"
 
 #include "ast/AstBase.hpp"
@@ -20,22 +32,30 @@
 
 #include "core/Environments/Scope.hpp"
 #include "core/Environments/StackScope.hpp"
+#include "core/Environments/Isolate.hpp"
 #include "core/builtins.h"
 
 #include "utilities/helper_functions.h"
 #include "utilities/debugging_functions.h"
 #include "utilities/debugger.h"
 #include "utilities/utilities.h"
+#include "utilities/allocation_counter.h"
 
 
 #include "lex/Scanner.hpp"
-#include "lex/Structurizer.hpp"
 #include "lex/Lexer.hpp"
 #include "core/evaluators/TypeEvaluator.hpp"
 #include "core/evaluators/FastIR.hpp"
+#include "core/evaluators/Parallel.hpp"
+#include "core/evaluators/Channel.hpp"
+#include "core/evaluators/Scheduler.hpp"
 
 
 
+String allocationsText(std::size_t count) {
+    return kCountAllocations ? std::to_string(count) : String("n/a");
+}
+
 std::tuple<String, String> getFileContents(int argc, char* argv[], bool onlyPath) {
     const String codeDir = "code/";
     const String defaultFile = "test1.merk";
@@ -130,7 +150,7 @@ int run_original(int argc, char* argv[]) {
         Tokenizer tokenizer(filePath, true);
         DEBUG_LOG(LogLevel::DEBUG, "Starting tokenization...");
 
-        auto tokens = tokenizer.tokenize(lCfg);
+        auto& tokens = tokenizer.tokenize(lCfg);
         DEBUG_LOG(LogLevel::DEBUG, "Tokenization complete.\n");
         
         #ifdef ENABLE_DEBUG
@@ -196,6 +216,27 @@ struct CliOptions {
     bool benchmarkEvalFastInt = false;
     bool nodeBenchmark = false;
     bool manualComputeBenchmark = false;
+    bool stringBuildBenchmark = false;
+    bool iterationBenchmark = false;
+    bool generatorBenchmark = false;
+    bool isolateBenchmark = false;
+    bool parallelForBenchmark = false;
+    bool bulkBenchmark = false;
+    bool channelBenchmark = false;
+    bool sharedAstBenchmark = false;
+    bool asyncBenchmark = false;
+    bool fuelBenchmark = false;
+    bool tokenizerBenchmark = false;
+    bool moduleBenchmark = false;
+    bool lspBenchmark = false;
+    bool languageServer = false;
+    bool dumpOptimizedAst = false;
+    bool dumpModules = false;
+    int isolateThreads = 0;
+    String batchPath;
+    int batchThreads = 0;
+    int batchFuel = 10000;
+    int generatorMegabytes = 1024;
     int benchmarkIters = 10;
     int benchmarkWarmup = 1;
     String fileName = "test1.merk";
@@ -205,8 +246,11 @@ struct CliOptions {
 struct RunMetrics {
     bool ok = false;
     size_t tokenCount = 0;
+    double readMs = 0.0;
+    double scanMs = 0.0;      // layout tokens alone, timed in a separate pass
     double tokenizeMs = 0.0;
     double parseMs = 0.0;
+    size_t parseAllocations = 0;
     double evalMs = 0.0;
     double totalMs = 0.0;
 };
@@ -276,6 +320,91 @@ static CliOptions parseCliOptions(int argc, char* argv[]) {
             options.manualComputeBenchmark = true;
             continue;
         }
+        if (arg == "--bench-string") {
+            options.stringBuildBenchmark = true;
+            continue;
+        }
+        if (arg == "--bench-iter") {
+            options.iterationBenchmark = true;
+            continue;
+        }
+        if (arg == "--bench-isolates") {
+            options.isolateBenchmark = true;
+            continue;
+        }
+        if (arg == "--bench-bulk") {
+            options.bulkBenchmark = true;
+            continue;
+        }
+        if (arg == "--bench-channel") {
+            options.channelBenchmark = true;
+            continue;
+        }
+        if (arg == "--bench-shared-ast") {
+            options.sharedAstBenchmark = true;
+            continue;
+        }
+        if (arg == "--bench-async") {
+            options.asyncBenchmark = true;
+            continue;
+        }
+        if (arg == "--bench-parallel-for") {
+            options.parallelForBenchmark = true;
+            continue;
+        }
+        if (arg == "--batch" && i + 1 < argc) {
+            options.batchPath = argv[++i];
+            continue;
+        }
+        if (arg == "--batch-threads" && i + 1 < argc) {
+            options.batchThreads = parsePositiveInt(argv[++i], "--batch-threads");
+            continue;
+        }
+        if (arg == "--batch-fuel" && i + 1 < argc) {
+            const String value = argv[++i];
+            options.batchFuel = value == "0" ? 0 : parsePositiveInt(value, "--batch-fuel");
+            continue;
+        }
+        if (arg == "--bench-tokenizer") {
+            options.tokenizerBenchmark = true;
+            continue;
+        }
+        if (arg == "--bench-modules") {
+            options.moduleBenchmark = true;
+            continue;
+        }
+        if (arg == "--bench-lsp") {
+            options.lspBenchmark = true;
+            continue;
+        }
+        if (arg == "--lsp") {
+            options.languageServer = true;
+            continue;
+        }
+        if (arg == "--dump-optimized-ast") {
+            options.dumpOptimizedAst = true;
+            continue;
+        }
+        if (arg == "--dump-modules") {
+            options.dumpModules = true;
+            continue;
+        }
+        if (arg == "--bench-fuel") {
+            options.fuelBenchmark = true;
+            continue;
+        }
+        if (arg == "--bench-threads" && i + 1 < argc) {
+            options.isolateThreads = parsePositiveInt(argv[++i], "--bench-threads");
+            continue;
+        }
+        if (arg == "--bench-generator") {
+            options.generatorBenchmark = true;
+            continue;
+        }
+        if (arg == "--bench-gen-mb" && i + 1 < argc) {
+            options.generatorMegabytes = parsePositiveInt(argv[++i], "--bench-gen-mb");
+            continue;
+        }
         if (arg == "--bench-iters" && i + 1 < argc) {
             options.benchmarkIters = parsePositiveInt(argv[++i], "--bench-iters");
             continue;
@@ -304,18 +433,37 @@ static void printUsage() {
     std::cout
         << "Usage:\n"
         << "  ./merk [file.merk]\n"
+        << "  ./merk --dump-optimized-ast [file.merk]\n"
+        << "  ./merk --dump-modules [file.merk]\n"
+        << "  ./merk --lsp\n"
         << "  ./merk --bench [file.merk] [--bench-iters N] [--bench-warmup N]\n"
         << "  ./merk --bench-eval [file.merk] [--bench-iters N] [--bench-warmup N]\n"
         << "  ./merk --bench-eval-fastint [file.merk] [--bench-iters N] [--bench-warmup N]\n"
         << "  ./merk --bench-node [--bench-iters N] [--bench-warmup N]\n"
-        << "  ./merk --bench-manual [--bench-iters N] [--bench-warmup N]\n";
+        << "  ./merk --bench-manual [--bench-iters N] [--bench-warmup N]\n"
+        << "  ./merk --bench-string [--bench-iters N] [--bench-warmup N]\n"
+        << "  ./merk --bench-iter [--bench-iters N] [--bench-warmup N]\n"
+        << "  ./merk --bench-generator [--bench-gen-mb N]\n"
+        << "  ./merk --bench-isolates [--bench-iters N] [--bench-threads N]\n"
+        << "  ./merk --bench-parallel-for [--bench-iters N] [--bench-threads N]\n"
+        << "  ./merk --bench-bulk [--bench-iters N] [--bench-threads N]\n"
+        << "  ./merk --bench-channel [--bench-iters N] [--bench-threads N]\n"
+        << "  ./merk --bench-shared-ast [--bench-iters N] [--bench-threads N]\n"
+        << "  ./merk --bench-async [--bench-iters N]\n"
+        << "  ./merk --bench-tokenizer [--bench-iters N]\n"
+        << "  ./merk --bench-modules [--bench-iters N] [--bench-threads N]\n"
+        << "  ./merk --bench-lsp\n"
+        << "  ./merk --bench-fuel [--bench-iters N]\n"
+        << "  ./merk --batch <dir|manifest> [--batch-threads N] [--batch-fuel N (0 = never preempt)]\n";
 }
 
 struct NodeBenchMetrics {
     double isNullMs = 0.0;
     double isCallableMs = 0.0;
     double toStringMs = 0.0;
+    double creationMs = 0.0;
     double copyAssignMs = 0.0;
+    double frozenCopyAssignMs = 0.0;
     double arithmeticMs = 0.0;
     double hashMs = 0.0;
     double totalMs = 0.0;
@@ -365,6 +513,14 @@ static NodeBenchMetrics runNodeMicroBenchOnce() {
     t1 = Clock::now();
     m.toStringMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
 
+    t0 = Clock::now();
+    for (int i = 0; i < inner; ++i) {
+        Node made(i);
+        sinkInt += made.toInt();
+    }
+    t1 = Clock::now();
+    m.creationMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+
     t0 = Clock::now();
     Node a(1), b(2), c(3);
     for (int i = 0; i < inner; ++i) {
@@ -376,6 +532,21 @@ static NodeBenchMetrics runNodeMicroBenchOnce() {
     t1 = Clock::now();
     m.copyAssignMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
 
+    // The same copies on frozen values, which count their handles atomically.
+    Node fa(1), fb(2), fc(3);
+    fa.freeze();
+    fb.freeze();
+    fc.freeze();
+    t0 = Clock::now();
+    for (int i = 0; i < inner; ++i) {
+        fa = fb;
+        fb = fc;
+        fc = fa;
+        sinkInt += fa.toInt();
+    }
+    t1 = Clock::now();
+    m.frozenCopyAssignMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+
     t0 = Clock::now();
     for (int i = 0; i < inner; ++i) {
         Node sum = nOne + nTwo;
@@ -406,7 +577,9 @@ static int runNodeBenchmark(const CliOptions& options) {
     double isNullTotal = 0.0;
     double isCallableTotal = 0.0;
     double toStringTotal = 0.0;
+    double creationTotal = 0.0;
     double copyAssignTotal = 0.0;
+    double frozenCopyAssignTotal = 0.0;
     double arithmeticTotal = 0.0;
     double hashTotal = 0.0;
     double overallTotal = 0.0;
@@ -420,7 +593,9 @@ static int runNodeBenchmark(const CliOptions& options) {
         isNullTotal += r.isNullMs;
         isCallableTotal += r.isCallableMs;
         toStringTotal += r.toStringMs;
+        creationTotal += r.creationMs;
         copyAssignTotal += r.copyAssignMs;
+        frozenCopyAssignTotal += r.frozenCopyAssignMs;
         arithmeticTotal += r.arithmeticMs;
         hashTotal += r.hashMs;
         overallTotal += r.totalMs;
@@ -434,7 +609,9 @@ static int runNodeBenchmark(const CliOptions& options) {
     std::cout << "Avg isNull:      " << (isNullTotal / denom) << " ms\n";
     std::cout << "Avg isCallable:  " << (isCallableTotal / denom) << " ms\n";
     std::cout << "Avg toString:    " << (toStringTotal / denom) << " ms\n";
+    std::cout << "Avg creation:    " << (creationTotal / denom) << " ms\n";
     std::cout << "Avg copyAssign:  " << (copyAssignTotal / denom) << " ms\n";
+    std::cout << "Avg copyAssign (frozen): " << (frozenCopyAssignTotal / denom) << " ms\n";
     std::cout << "Avg arithmetic:  " << (arithmeticTotal / denom) << " ms\n";
     std::cout << "Avg hash:        " << (hashTotal / denom) << " ms\n";
     std::cout << "Avg total:       " << (overallTotal / denom) << " ms\n";
@@ -446,6 +623,7 @@ struct ManualComputeMetrics {
     double nodeOpMs = 0.0;
     int rawChecksum = 0;
     int nodeChecksum = 0;
+    std::size_t nodeOpAllocs = 0;
 };
 
 static ManualComputeMetrics runManualComputeOnce() {
@@ -495,6 +673,7 @@ static ManualComputeMetrics runManualComputeOnce() {
         Node bNode(2);
         Node cNode(0);
 
+        const std::size_t allocsBefore = allocationCount();
         auto t0 = Clock::now();
         while (iNode < nNode) {
             aNode = ((aNode * mulNode) + addNode) % modNode;
@@ -513,16 +692,65 @@ static ManualComputeMetrics runManualComputeOnce() {
         m.nodeChecksum = checksum.toInt();
         auto t1 = Clock::now();
         m.nodeOpMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        m.nodeOpAllocs = allocationCount() - allocsBefore;
     }
 
     return m;
 }
 
+static RunMetrics runPipelineOnce(const String& filePath, bool printScopeReport, bool timeScan = false);
+
+struct ScriptComputeMetrics {
+    bool ok = false;
+    double evalMs = 0.0;
+    std::size_t allocs = 0;
+};
+
+// The same kernel through the interpreter; conditions dominate its allocation profile.
+static ScriptComputeMetrics runManualComputeScript(int n) {
+    namespace fs = std::filesystem;
+    const fs::path dir = fs::temp_directory_path() / "merk_bench_manual";
+    fs::create_directories(dir);
+
+    const fs::path scriptPath = dir / "compute_loop.merk";
+    {
+        std::ofstream out(scriptPath);
+        out << "var n = " << n << "\n"
+            << "var mod = 1000003\n"
+            << "var i = 0\n"
+            << "var a = 1\n"
+            << "var b = 2\n"
+            << "var c = 0\n"
+            << "while i < n:\n"
+            << "    a = (a * 13 + 17) % mod\n"
+            << "    b = (b + a + i) % mod\n"
+            << "    if i % 7 == 0:\n"
+            << "        c = c + (a % 97)\n"
+            << "    else:\n"
+            << "        c = c + (b % 89)\n"
+            << "    i = i + 1\n";
+    }
+
+    ScriptComputeMetrics m;
+    RunMetrics run;
+    const std::size_t allocsBefore = allocationCount();
+    {
+        ScopedSilenceCout silence(true);
+        run = runPipelineOnce(scriptPath.string(), false);
+    }
+    m.allocs = allocationCount() - allocsBefore;
+    m.ok = run.ok;
+    m.evalMs = run.evalMs;
+    fs::remove_all(dir);
+    return m;
+}
+
 static int runManualComputeBenchmark(const CliOptions& options) {
     double rawTotal = 0.0;
     double nodeTotal = 0.0;
     int rawChecksum = 0;
     int nodeChecksum = 0;
+    std::size_t nodeAllocs = 0;
 
     for (int i = 0; i < options.benchmarkWarmup; ++i) {
         (void)runManualComputeOnce();
@@ -534,8 +762,12 @@ static int runManualComputeBenchmark(const CliOptions& options) {
         nodeTotal += r.nodeOpMs;
         rawChecksum = r.rawChecksum;
         nodeChecksum = r.nodeChecksum;
+        nodeAllocs = r.nodeOpAllocs;
     }
 
+    constexpr int scriptIters = 20000;
+    const ScriptComputeMetrics script = runManualComputeScript(scriptIters);
+
     const double denom = static_cast<double>(options.benchmarkIters);
     const double rawAvg = rawTotal / denom;
     const double nodeAvg = nodeTotal / denom;
@@ -550,11 +782,495 @@ static int runManualComputeBenchmark(const CliOptions& options) {
     std::cout << "Avg node-op:    " << nodeAvg << " ms\n";
     std::cout << "Node/raw ratio: " << ratio << "x\n";
     std::cout << "Checksums: raw=" << rawChecksum << ", node=" << nodeChecksum << "\n";
+    std::cout << "Node-op allocs: " << allocationsText(nodeAllocs) << "\n";
+    if (!script.ok) {
+        std::cerr << "Interpreted compute_loop failed\n";
+        return 1;
+    }
+    std::cout << "Script eval:    " << script.evalMs << " ms (n=" << scriptIters << ")\n";
+    std::cout << "Script allocs:  " << allocationsText(script.allocs);
+    if (kCountAllocations) std::cout << " (" << (static_cast<double>(script.allocs) / scriptIters) << " per iteration)";
+    std::cout << "\n";
+
+    return 0;
+}
+
+struct StringBuildMetrics {
+    double rawAppendMs = 0.0;
+    double nodeConcatMs = 0.0;
+    double nodeAppendMs = 0.0;
+    std::size_t rawBytes = 0;
+    std::size_t concatBytes = 0;
+    std::size_t appendBytes = 0;
+};
+
+static StringBuildMetrics runStringBuildOnce() {
+    using Clock = std::chrono::steady_clock;
+    StringBuildMetrics m;
+
+    // 10 MB built out of 16-byte pieces, the shape of a log/CSV builder loop.
+    constexpr std::size_t targetBytes = 10u * 1024u * 1024u;
+    const String piece = "merk,string,row\n";
+    const std::size_t steps = targetBytes / piece.size();
+
+    {
+        auto t0 = Clock::now();
+        String raw;
+        for (std::size_t i = 0; i < steps; ++i) {
+            raw += piece;
+        }
+        m.rawBytes = raw.size();
+        auto t1 = Clock::now();
+        m.rawAppendMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    }
+
+    {
+        const Node pieceNode(piece);
+        auto t0 = Clock::now();
+        Node s(String(""));
+        for (std::size_t i = 0; i < steps; ++i) {
+            s = s + pieceNode;
+        }
+        m.concatBytes = s.toString().size();
+        auto t1 = Clock::now();
+        m.nodeConcatMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    }
+
+    {
+        const Node pieceNode(piece);
+        auto t0 = Clock::now();
+        Node s(String(""));
+        for (std::size_t i = 0; i < steps; ++i) {
+            s += pieceNode;
+        }
+        m.appendBytes = s.toString().size();
+        auto t1 = Clock::now();
+        m.nodeAppendMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    }
+
+    return m;
+}
+
+static int runStringBuildBenchmark(const CliOptions& options) {
+    double rawTotal = 0.0;
+    double concatTotal = 0.0;
+    double appendTotal = 0.0;
+    StringBuildMetrics last;
+
+    for (int i = 0; i < options.benchmarkWarmup; ++i) {
+        (void)runStringBuildOnce();
+    }
+
+    for (int i = 0; i < options.benchmarkIters; ++i) {
+        last = runStringBuildOnce();
+        rawTotal += last.rawAppendMs;
+        concatTotal += last.nodeConcatMs;
+        appendTotal += last.nodeAppendMs;
+    }
 
+    const double denom = static_cast<double>(options.benchmarkIters);
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "\nString Build Benchmark Results\n";
+    std::cout << "Target: " << last.rawBytes << " bytes\n";
+    std::cout << "Iterations: " << options.benchmarkIters
+              << " (warmup: " << options.benchmarkWarmup << ")\n";
+    std::cout << "Avg raw +=:      " << (rawTotal / denom) << " ms\n";
+    std::cout << "Avg node s=s+x:  " << (concatTotal / denom) << " ms\n";
+    std::cout << "Avg node s+=x:   " << (appendTotal / denom) << " ms\n";
+    if (last.concatBytes != last.rawBytes || last.appendBytes != last.rawBytes) {
+        std::cerr << "String build size mismatch: raw=" << last.rawBytes
+                  << ", concat=" << last.concatBytes << ", append=" << last.appendBytes << "\n";
+        return 1;
+    }
     return 0;
 }
 
-static RunMetrics runPipelineOnce(const String& filePath, bool printScopeReport) {
+// Generated source of roughly `bytes`: functions, classes, nested blocks, strings and comments.
+static String generateTokenizerSource(size_t bytes) {
+    String source;
+    source.reserve(bytes + 512);
+    for (size_t i = 0; source.size() < bytes; ++i) {
+        const String n = std::to_string(i);
+        source += "# helper " + n + "\n"
+            "def f" + n + "(a, b):\n"
+            "    var total = a * " + n + " + b\n"
+            "    if total >= 10 and not (b == 0):\n"
+            "        total = total - 1.5\n"
+            "    return total\n"
+            "\n"
+            "Class C" + n + ":\n"
+            "    def construct(self, x: Int):\n"
+            "        self.x = x\n"
+            "    def name(self):\n"
+            "        return \"item\\t" + n + "\" + String(self.x)\n"
+            "\n"
+            "var v" + n + " = List(1, 2, 3).map(f" + n + ")\n";
+    }
+    return source;
+}
+
+// Tokenizer throughput on generated sources, best of N runs per size. "scan" only pulls layout
+// tokens through the Scanner from memory; "tokenize" also builds the parser's tokens. The file
+// rows load the same source from disk and scan it, once through a stream copy into a String
+// (how sources were read before) and once through a SourceBuffer mapping.
+static int runTokenizerBenchmark(const CliOptions& options) {
+    namespace fs = std::filesystem;
+    using Clock = std::chrono::steady_clock;
+    LexerConfig lCfg;
+    SharedPtr<Scope> scope = generateGlobalScope(false, lCfg);
+    const fs::path dir = fs::temp_directory_path() / "merk_bench_tokenizer";
+    fs::create_directories(dir);
+
+    const auto scanAll = [](Scanner scanner) {
+        while (scanner.peek().kind != RawKind::EOF_) {
+            scanner.advance();
+        }
+    };
+    const auto best = [&](double& slot, int iter, auto&& body) {
+        const auto t0 = Clock::now();
+        body();
+        const double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        slot = iter == 0 ? ms : std::min(slot, ms);
+    };
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Tokenizer Benchmark (best of " << options.benchmarkIters << ")\n";
+    for (const size_t megabytes : {1, 8, 32}) {
+        const String source = generateTokenizerSource(megabytes << 20);
+        const double mb = static_cast<double>(source.size()) / (1024.0 * 1024.0);
+        const String path = (dir / ("source" + std::to_string(megabytes) + ".merk")).string();
+        {
+            std::ofstream out(path, std::ios::binary);
+            out << source;
+        }
+
+        double scanMs = 0.0;
+        double tokenizeMs = 0.0;
+        double streamMs = 0.0;
+        double mappedMs = 0.0;
+        size_t tokenCount = 0;
+        for (int i = 0; i < options.benchmarkIters; ++i) {
+            best(scanMs, i, [&] { scanAll(Scanner(source, CommentConfig{{"#"}, {}})); });
+
+            Tokenizer tokenizer(source, false);
+            best(tokenizeMs, i, [&] {
+                ScopedSilenceCout silence(true);
+                tokenCount = tokenizer.tokenize(lCfg).size();
+            });
+
+            best(streamMs, i, [&] {
+                std::ifstream in(path);
+                std::ostringstream content;
+                content << in.rdbuf();
+                const String text = content.str();
+                scanAll(Scanner(text, CommentConfig{{"#"}, {}}));
+            });
+            best(mappedMs, i, [&] { scanAll(Scanner(SourceBuffer::open(path), CommentConfig{{"#"}, {}})); });
+        }
+
+        std::cout << std::setw(6) << mb << " MB"
+                  << "  scan " << std::setw(8) << (mb / (scanMs / 1000.0)) << " MB/s"
+                  << "  tokenize " << std::setw(8) << (mb / (tokenizeMs / 1000.0)) << " MB/s"
+                  << "  (" << tokenCount << " tokens, "
+                  << (static_cast<double>(tokenCount) / (tokenizeMs / 1000.0) / 1e6) << " M tokens/s)\n"
+                  << "          file+scan: stream copy " << std::setw(8) << (mb / (streamMs / 1000.0)) << " MB/s"
+                  << "  mmap " << std::setw(8) << (mb / (mappedMs / 1000.0)) << " MB/s\n";
+    }
+    scope->clear();
+    fs::remove_all(dir);
+    return 0;
+}
+
+// Source for one generated module: its imports, then functions, classes and control flow.
+static String generateModuleSource(size_t index, const Vector<String>& imports) {
+    String source;
+    for (const String& name : imports) {
+        source += "import " + name + "\n";
+    }
+    source += "\n";
+    const String m = std::to_string(index);
+    for (size_t i = 0; i < 30; ++i) {
+        const String n = m + "_" + std::to_string(i);
+        source += "def step" + n + "(a, b):\n"
+            "    var total = a * " + std::to_string(i + 1) + " + b\n"
+            "    if total > 100:\n"
+            "        total = total - 7\n"
+            "    elif total > 50:\n"
+            "        total = total + 3\n"
+            "    else:\n"
+            "        total = total * 2\n"
+            "    return total\n"
+            "\n"
+            "Class Item" + n + ":\n"
+            "    def construct(self, x):\n"
+            "        var self.x = x\n"
+            "        var self.seen = [x, 1, \"item" + n + "\"]\n"
+            "\n"
+            "    def bump(self, by):\n"
+            "        self.x = self.x + by\n"
+            "        return self.x\n"
+            "\n"
+            "var acc" + n + " = 0\n"
+            "var i" + n + " = 0\n"
+            "while i" + n + " < 10:\n"
+            "    acc" + n + " = step" + n + "(acc" + n + ", i" + n + ")\n"
+            "    i" + n + " = i" + n + " + 1\n"
+            "\n";
+    }
+    return source;
+}
+
+// Front-end time for a program of 200 generated modules: every module read, tokenized and
+// parsed on the calling thread, against the same through the pooled ModuleLoader. Best of N.
+// "entry" is how long the pooled loader keeps a caller waiting for the entry module alone.
+static int runModuleBenchmark(const CliOptions& options) {
+    namespace fs = std::filesystem;
+    using Clock = std::chrono::steady_clock;
+    constexpr size_t kModules = 200;
+    constexpr size_t kFanOut = 20;  // the entry imports mod0..mod19; mod k imports mod k+20
+
+    const fs::path dir = fs::temp_directory_path() / "merk_bench_modules";
+    fs::create_directories(dir);
+    {
+        Vector<String> entryImports;
+        for (size_t k = 0; k < kFanOut; ++k) {
+            entryImports.push_back("mod" + std::to_string(k));
+        }
+        std::ofstream(dir / "main.merk") << generateModuleSource(kModules, entryImports);
+        for (size_t k = 0; k < kModules; ++k) {
+            Vector<String> imports;
+            if (k + kFanOut < kModules) {
+                imports.push_back("mod" + std::to_string(k + kFanOut));
+            }
+            std::ofstream(dir / ("mod" + std::to_string(k) + ".merk")) << generateModuleSource(k, imports);
+        }
+    }
+    const String entryPath = (dir / "main.merk").string();
+
+    const ModuleLoader::ScopeFactory makeScope = [](LexerConfig& cfg) {
+        return generateGlobalScope(false, cfg);
+    };
+    const size_t workers = options.isolateThreads > 0
+        ? static_cast<size_t>(options.isolateThreads)
+        : std::max(1u, std::thread::hardware_concurrency());
+
+    struct Totals {
+        size_t modules = 0;
+        size_t tokens = 0;
+        size_t nodes = 0;
+    };
+    // Loads the program once; ms covers everything up to the last parsed module.
+    const auto loadOnce = [&](bool parallel, double& ms, double& entryMs) {
+        Totals totals;
+        ScopedSilenceCout silence(true);
+        const auto t0 = Clock::now();
+        ModuleLoader loader(dir.string(), makeScope, workers, parallel);
+        const String entry = loader.load(entryPath);
+        loader.require(entry);
+        entryMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        const auto modules = loader.requireAll();
+        ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        for (const ModuleLoader::Module* module : modules) {
+            totals.modules += 1;
+            totals.tokens += module->tokenCount;
+            totals.nodes += module->ast->getAllAst(true).size();
+        }
+        return totals;
+    };
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Module Front-End Benchmark (" << (kModules + 1) << " modules, best of "
+              << options.benchmarkIters << ", " << workers << " workers)\n";
+
+    bool ok = true;
+    try {
+        double serialMs = 0.0;
+        double parallelMs = 0.0;
+        double serialEntryMs = 0.0;
+        double parallelEntryMs = 0.0;
+        Totals serial;
+        Totals pooled;
+        for (int i = 0; i < options.benchmarkIters; ++i) {
+            double ms = 0.0;
+            double entryMs = 0.0;
+            serial = loadOnce(false, ms, entryMs);
+            serialMs = i == 0 ? ms : std::min(serialMs, ms);
+            serialEntryMs = i == 0 ? entryMs : std::min(serialEntryMs, entryMs);
+
+            pooled = loadOnce(true, ms, entryMs);
+            parallelMs = i == 0 ? ms : std::min(parallelMs, ms);
+            parallelEntryMs = i == 0 ? entryMs : std::min(parallelEntryMs, entryMs);
+        }
+        ok = serial.modules == pooled.modules && serial.tokens == pooled.tokens && serial.nodes == pooled.nodes;
+
+        std::cout << "Modules: " << serial.modules << "  tokens: " << serial.tokens << "  AST nodes: " << serial.nodes << "\n";
+        std::cout << "Serial:   " << std::setw(9) << serialMs << " ms  (entry " << serialEntryMs << " ms)\n";
+        std::cout << "Parallel: " << std::setw(9) << parallelMs << " ms  (entry " << parallelEntryMs << " ms)\n";
+        std::cout << "Speedup:  " << std::setw(9) << (serialMs / parallelMs) << "x\n";
+        if (!ok) {
+            std::cout << "Mismatch: parallel load gave " << pooled.modules << " modules, " << pooled.tokens
+                      << " tokens, " << pooled.nodes << " AST nodes\n";
+        }
+    } catch (MerkError& e) {
+        std::cerr << e.errorString() << std::endl;
+        ok = false;
+    }
+
+    fs::remove_all(dir);
+    return ok ? 0 : 1;
+}
+
+// Editor latency on a generated file of about 50K lines. An edit trace types statements
+// into function bodies one keystroke at a time, renames functions and adds top-level lines
+// with auto-closed brackets; each edit is timed with the diagnostics it publishes and a
+// definition lookup. The full parse is what every edit costs without incremental re-parse.
+// The final document must match a fresh parse of the same text.
+static int runLspBenchmark() {
+    using Clock = std::chrono::steady_clock;
+    constexpr size_t kLines = 50000;
+    constexpr size_t kSites = 60;
+
+    String source;
+    for (size_t m = 0; std::count(source.begin(), source.end(), '\n') < static_cast<long>(kLines); ++m) {
+        source += generateModuleSource(m, {});
+    }
+
+    struct Edit {
+        Document::Position from;
+        Document::Position to;
+        String text;
+        Document::Position lookup;  // a call to a function near the edit
+    };
+    Vector<Edit> trace;
+
+    // The text as the trace leaves it, to place each edit.
+    Vector<String> shadow(1);
+    for (const char c : source) {
+        if (c == '\n') {shadow.emplace_back();} else {shadow.back() += c;}
+    }
+    const auto add = [&](int line, int column, int endLine, int endColumn, const String& text) {
+        String head = shadow[line].substr(0, column);
+        const String tail = shadow[endLine].substr(endColumn);
+        shadow.erase(shadow.begin() + line, shadow.begin() + endLine + 1);
+        const size_t newline = text.find('\n');
+        if (newline == String::npos) {
+            shadow.insert(shadow.begin() + line, head + text + tail);
+        } else {
+            shadow.insert(shadow.begin() + line, {head + text.substr(0, newline), text.substr(newline + 1) + tail});
+        }
+
+        Document::Position lookup{line, column};
+        for (int l = line; l < static_cast<int>(shadow.size()) && l < line + 40; ++l) {
+            const size_t call = shadow[l].find("= step");
+            if (call != String::npos) {lookup = {l, static_cast<int>(call) + 2}; break;}
+        }
+        trace.push_back({{line, column}, {endLine, endColumn}, text, lookup});
+    };
+    // Types `text` into an empty line; an opening bracket brings its closer with it, and
+    // typing the closer steps over it.
+    const auto type = [&](int line, const String& text, size_t upto) {
+        int column = 0;
+        for (size_t i = 0; i < upto; ++i) {
+            const char c = text[i];
+            if (c == ')' && column < static_cast<int>(shadow[line].size()) && shadow[line][column] == ')') {
+                ++column;
+                continue;
+            }
+            add(line, column, line, column, c == '(' ? "()" : String(1, c));
+            ++column;
+        }
+    };
+    const auto findFrom = [&](size_t from, const String& prefix) {
+        size_t line = from;
+        while (line < shadow.size() && shadow[line].rfind(prefix, 0) != 0) {++line;}
+        return static_cast<int>(line);
+    };
+
+    // Sites run bottom-up so each leaves the lines above it where they were. The last one
+    // leaves its edits in place, with a statement typed only halfway.
+    const size_t stride = shadow.size() / kSites;
+    for (size_t site = kSites; site-- > 0;) {
+        const bool keep = site == 0;
+        const int body = findFrom(site * stride, "    return total");
+        const String statement = "    total = total + 1";
+        add(body, 0, body, 0, "\n");
+        type(body, statement, keep ? statement.size() - 2 : statement.size());
+        if (!keep) {add(body, 0, body + 1, 0, "");}
+
+        if (site % 5 == 0) {
+            int def = body;
+            while (def > 0 && shadow[def].rfind("def step", 0) != 0) {--def;}
+            const int end = static_cast<int>(shadow[def].find('('));
+            add(def, end, def, end, "x");
+            if (!keep) {add(def, end, def, end + 1, "");}
+        }
+        if (site % 4 == 0) {
+            const int top = findFrom(static_cast<size_t>(body), "var acc");
+            const String line = "var extra = (1 + 2) * 3";
+            add(top, 0, top, 0, "\n");
+            type(top, line, line.size());
+            if (!keep) {add(top, 0, top + 1, 0, "");}
+        }
+    }
+    String finalText;
+    for (size_t i = 0; i < shadow.size(); ++i) {
+        if (i) {finalText += '\n';}
+        finalText += shadow[i];
+    }
+
+    const Document::ScopeFactory makeScope = [](LexerConfig& cfg) { return generateGlobalScope(false, cfg); };
+    Document document(makeScope);
+    Document fresh(makeScope);
+    double fullMs = 0.0;
+    Vector<double> editMs;
+    size_t lexedLines = 0;
+    size_t parsedBlocks = 0;
+    size_t resolved = 0;
+    {
+        ScopedSilenceCout silence(true);
+        const auto t0 = Clock::now();
+        document.setText(source);
+        fullMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+
+        for (const Edit& edit : trace) {
+            const auto start = Clock::now();
+            document.edit(edit.from, edit.to, edit.text);
+            const auto diagnostics = document.diagnostics();
+            const auto definition = document.definitionAt(edit.lookup);
+            editMs.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+            lexedLines += document.lastStats().lexedLines;
+            parsedBlocks += document.lastStats().parsedBlocks;
+            resolved += definition ? 1 : 0;
+        }
+        fresh.setText(finalText);
+    }
+
+    const bool ok = document.text() == finalText && document.diagnostics() == fresh.diagnostics()
+        && document.symbols() == fresh.symbols();
+
+    Vector<double> sorted = editMs;
+    std::sort(sorted.begin(), sorted.end());
+    const double totalMs = std::accumulate(editMs.begin(), editMs.end(), 0.0);
+    const double meanMs = totalMs / static_cast<double>(editMs.size());
+    const size_t underBudget = static_cast<size_t>(std::lower_bound(sorted.begin(), sorted.end(), 10.0) - sorted.begin());
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Incremental Re-parse Benchmark (" << document.lineCount() << " lines, "
+              << document.blockCount() << " top-level blocks, " << trace.size() << " edits)\n";
+    std::cout << "Full parse:   " << std::setw(9) << fullMs << " ms\n";
+    std::cout << "Per edit:     " << std::setw(9) << meanMs << " ms mean, " << sorted[sorted.size() / 2] << " p50, "
+              << sorted[sorted.size() * 95 / 100] << " p95, " << sorted.back() << " max\n";
+    std::cout << "Under 10 ms:  " << std::setw(9) << underBudget << " of " << sorted.size() << " edits\n";
+    std::cout << "Re-done:      " << std::setw(9) << (static_cast<double>(lexedLines) / editMs.size()) << " lines lexed, "
+              << (static_cast<double>(parsedBlocks) / editMs.size()) << " blocks parsed per edit\n";
+    std::cout << "Lookups:      " << std::setw(9) << resolved << " of " << trace.size() << " resolved\n";
+    std::cout << "Speedup:      " << std::setw(9) << (fullMs / meanMs) << "x\n";
+    std::cout << "Final state:  " << document.diagnostics().size() << " diagnostics, " << document.symbols().size()
+              << " symbols; " << (ok ? "matches" : "DIFFERS FROM") << " a fresh parse\n";
+    return ok ? 0 : 1;
+}
+
+static RunMetrics runPipelineOnce(const String& filePath, bool printScopeReport, bool timeScan) {
     using Clock = std::chrono::steady_clock;
     RunMetrics metrics;
     const bool interpretMode = false;
@@ -566,25 +1282,42 @@ static RunMetrics runPipelineOnce(const String& filePath, bool printScopeReport)
     auto tTotalStart = Clock::now();
 
     try {
-        Tokenizer tokenizer(filePath, true);
-
         auto t0 = Clock::now();
-        auto tokens = tokenizer.tokenize(lCfg);
+        Tokenizer tokenizer(filePath, true);
         auto t1 = Clock::now();
+        metrics.readMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+
+        t0 = Clock::now();
+        auto& tokens = tokenizer.tokenize(lCfg);
+        t1 = Clock::now();
         metrics.tokenizeMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
         metrics.tokenCount = tokens.size();
 
+        // The fused lexer has no scan phase of its own to time; a scan-only pass over the same
+        // source splits tokenize into scanning and classification/token building.
+        if (timeScan) {
+            t0 = Clock::now();
+            Scanner scanner(tokenizer.getSource(), CommentConfig{{"#"}, {}});
+            while (scanner.peek().kind != RawKind::EOF_) {
+                scanner.advance();
+            }
+            t1 = Clock::now();
+            metrics.scanMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        }
+
 #ifdef ENABLE_DEBUG
         if (logLevel == LogLevel::DEBUG) {
             tokenizer.printTokens(true);
         }
 #endif
 
+        const size_t allocationsBefore = allocationCount();
         t0 = Clock::now();
         Parser parser(tokens, globalScope, interpretMode, byBlock);
         auto ast = parser.parse();
         t1 = Clock::now();
         metrics.parseMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        metrics.parseAllocations = allocationCount() - allocationsBefore;
 
         t0 = Clock::now();
         if (!interpretMode) {
@@ -609,39 +1342,45 @@ static RunMetrics runPipelineOnce(const String& filePath, bool printScopeReport)
     }
 
     auto tTotalEnd = Clock::now();
-    metrics.totalMs = std::chrono::duration<double, std::milli>(tTotalEnd - tTotalStart).count();
+    metrics.totalMs = std::chrono::duration<double, std::milli>(tTotalEnd - tTotalStart).count() - metrics.scanMs;
     return metrics;
 }
 
 static int runBenchmark(const CliOptions& options) {
     const String filePath = resolveFilePath(options.fileName);
 
+    double totalRead = 0.0;
+    double totalScan = 0.0;
     double totalTok = 0.0;
     double totalParse = 0.0;
     double totalEval = 0.0;
     double totalTotal = 0.0;
     size_t tokens = 0;
+    RunMetrics last;
 
     {
         ScopedSilenceCout silence(true);
 
         for (int i = 0; i < options.benchmarkWarmup; ++i) {
-            auto warmup = runPipelineOnce(filePath, false);
+            auto warmup = runPipelineOnce(filePath, false, true);
             if (!warmup.ok) {
                 return 1;
             }
         }
 
         for (int i = 0; i < options.benchmarkIters; ++i) {
-            auto run = runPipelineOnce(filePath, false);
+            auto run = runPipelineOnce(filePath, false, true);
             if (!run.ok) {
                 return 1;
             }
+            totalRead += run.readMs;
+            totalScan += run.scanMs;
             totalTok += run.tokenizeMs;
             totalParse += run.parseMs;
             totalEval += run.evalMs;
             totalTotal += run.totalMs;
             tokens = run.tokenCount;
+            last = run;
         }
     }
 
@@ -652,13 +1391,938 @@ static int runBenchmark(const CliOptions& options) {
     std::cout << "Iterations: " << options.benchmarkIters
               << " (warmup: " << options.benchmarkWarmup << ")\n";
     std::cout << "Tokens: " << tokens << "\n";
-    std::cout << "Avg tokenize: " << (totalTok / denom) << " ms\n";
-    std::cout << "Avg parse:    " << (totalParse / denom) << " ms\n";
+    std::cout << "Avg read:     " << (totalRead / denom) << " ms\n";
+    std::cout << "Avg tokenize: " << (totalTok / denom) << " ms"
+              << " (scan " << (totalScan / denom) << " ms, classify+build "
+              << ((totalTok - totalScan) / denom) << " ms)\n";
+    std::cout << "Avg parse:    " << (totalParse / denom) << " ms"
+              << " (" << allocationsText(last.parseAllocations) << " allocations)\n";
     std::cout << "Avg eval:     " << (totalEval / denom) << " ms\n";
     std::cout << "Avg total:    " << (totalTotal / denom) << " ms\n";
     return 0;
 }
 
+// for-in over each iterable kind. Every script builds its source once (inside
+// the timed eval) and then walks it kIterPasses times.
+static constexpr int kIterElements = 2000;
+static constexpr int kIterPasses = 5;
+
+static String iterationScript(const String& build, const String& iterable, const String& afterPass = "") {
+    String src = build;
+    src += "var total = 0\n";
+    src += "var pass = 0\n";
+    src += "while pass < " + std::to_string(kIterPasses) + ":\n";
+    src += "    for x in " + iterable + ":\n";
+    src += "        total = total + 1\n";
+    src += afterPass;
+    src += "    pass = pass + 1\n";
+    src += "print(total)\n";
+    return src;
+}
+
+static int runIterationBenchmark(const CliOptions& options) {
+    namespace fs = std::filesystem;
+    const fs::path dir = fs::temp_directory_path() / "merk_bench_iter";
+    fs::create_directories(dir);
+
+    const String n = std::to_string(kIterElements);
+    const fs::path linesPath = dir / "lines.txt";
+    {
+        std::ofstream lines(linesPath);
+        for (int i = 0; i < kIterElements; ++i) {
+            lines << "row," << i << "\n";
+        }
+    }
+
+    const auto fill = [&](const String& ctor, const String& add) {
+        return "var c = " + ctor + "()\nfor i in range(0, " + n + "):\n    c." + add + "(i)\n";
+    };
+
+    const Vector<std::pair<String, String>> cases = {
+        {"range(...)", iterationScript("", "range(0, " + n + ")")},
+        {"Range",      iterationScript("var c = range(0, " + n + ")\n", "c")},
+        {"List",       iterationScript(fill("List", "append"), "c")},
+        {"Array",      iterationScript(fill("Array", "append"), "c")},
+        {"Dict",       iterationScript("var c = Dict()\nfor i in range(0, " + n + "):\n    c.set(i, i)\n", "c")},
+        {"Set",        iterationScript(fill("Set", "add"), "c")},
+        {"String",     iterationScript("var c = \"" + String(kIterElements, 'x') + "\"\n", "c")},
+        // Closing rewinds the file; the next for-in reopens it from the start.
+        {"File lines", iterationScript("var c = File(\"" + linesPath.string() + "\", \"r\")\n", "c", "    c.close()\n")},
+    };
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "\nIteration Benchmark Results\n";
+    std::cout << "Elements: " << kIterElements << " x " << kIterPasses << " passes\n";
+    std::cout << "Iterations: " << options.benchmarkIters
+              << " (warmup: " << options.benchmarkWarmup << ")\n";
+
+    for (const auto& [kind, source] : cases) {
+        const fs::path scriptPath = dir / "iter.merk";
+        {
+            std::ofstream out(scriptPath);
+            out << source;
+        }
+
+        double totalEval = 0.0;
+        {
+            ScopedSilenceCout silence(true);
+            for (int i = 0; i < options.benchmarkWarmup; ++i) {
+                if (!runPipelineOnce(scriptPath.string(), false).ok) {
+                    return 1;
+                }
+            }
+            for (int i = 0; i < options.benchmarkIters; ++i) {
+                auto run = runPipelineOnce(scriptPath.string(), false);
+                if (!run.ok) {
+                    return 1;
+                }
+                totalEval += run.evalMs;
+            }
+        }
+        std::cout << "Avg " << std::left << std::setw(12) << (kind + ":") << std::right
+                  << (totalEval / static_cast<double>(options.benchmarkIters)) << " ms\n";
+    }
+
+    fs::remove_all(dir);
+    return 0;
+}
+
+// Streams a generated file through a three-stage generator pipeline. Each stage
+// holds one line at a time, so peak RSS should stay flat regardless of file size.
+static int runGeneratorBenchmark(const CliOptions& options) {
+    namespace fs = std::filesystem;
+    const fs::path dir = fs::temp_directory_path() / "merk_bench_gen";
+    fs::create_directories(dir);
+
+    const fs::path dataPath = dir / "stream.txt";
+    const std::uintmax_t targetBytes = static_cast<std::uintmax_t>(options.generatorMegabytes) * 1024 * 1024;
+    {
+        std::ofstream data(dataPath, std::ios::binary);
+        const String line = String(4095, 'x') + "\n";
+        for (std::uintmax_t written = 0; written < targetBytes; written += line.size()) {
+            data << line;
+        }
+    }
+
+    const fs::path scriptPath = dir / "pipeline.merk";
+    {
+        std::ofstream out(scriptPath);
+        out << "def readLines(path):\n"
+            << "    var f = File(path, \"r\")\n"
+            << "    for line in f:\n"
+            << "        yield line\n"
+            << "    f.close()\n"
+            << "def lengths(lines):\n"
+            << "    for line in lines:\n"
+            << "        yield len(line)\n"
+            << "def nonEmpty(values):\n"
+            << "    for v in values:\n"
+            << "        if v > 0:\n"
+            << "            yield v\n"
+            << "print(sum(nonEmpty(lengths(readLines(\"" << dataPath.string() << "\")))))\n";
+    }
+
+    RunMetrics run;
+    {
+        ScopedSilenceCout silence(true);
+        run = runPipelineOnce(scriptPath.string(), false);
+    }
+
+    struct rusage usage {};
+    getrusage(RUSAGE_SELF, &usage);
+    const std::uintmax_t fileBytes = fs::file_size(dataPath);
+    fs::remove_all(dir);
+    if (!run.ok) {
+        return 1;
+    }
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "\nGenerator Pipeline Benchmark Results\n";
+    std::cout << "File size:    " << (static_cast<double>(fileBytes) / (1024.0 * 1024.0)) << " MB\n";
+    std::cout << "Eval:         " << run.evalMs << " ms\n";
+    std::cout << "Peak RSS:     " << (static_cast<double>(usage.ru_maxrss) / 1024.0) << " MB\n";
+    return 0;
+}
+
+// Runs independent copies of one script on 1..N threads, each thread inside
+// its own Isolate. Throughput should scale with the thread count.
+static int runIsolateBenchmark(const CliOptions& options) {
+    using Clock = std::chrono::steady_clock;
+    namespace fs = std::filesystem;
+    const fs::path dir = fs::temp_directory_path() / "merk_bench_isolates";
+    fs::create_directories(dir);
+
+    const fs::path scriptPath = dir / "worker.merk";
+    {
+        std::ofstream out(scriptPath);
+        out << "def step(a, i):\n"
+            << "    return (a * 13 + 17 + i) % 1000003\n"
+            << "var a = 1\n"
+            << "var i = 0\n"
+            << "while i < 2000:\n"
+            << "    a = step(a, i)\n"
+            << "    i = i + 1\n";
+    }
+
+    // Each worker owns an Isolate for its whole run; nothing mutable is shared.
+    const int scriptsPerThread = options.benchmarkIters;
+    const auto runThreads = [&](unsigned threads, double& ms) {
+        std::vector<std::thread> workers;
+        std::vector<char> results(threads, 1);
+        ScopedSilenceCout silence(true);
+        const auto t0 = Clock::now();
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                Isolate isolate;
+                Isolate::Enter enter(isolate);
+                for (int i = 0; i < scriptsPerThread; ++i) {
+                    if (!runPipelineOnce(scriptPath.string(), false).ok) {
+                        results[t] = 0;
+                        return;
+                    }
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        return std::all_of(results.begin(), results.end(), [](char r) { return r != 0; });
+    };
+
+    const unsigned maxThreads = options.isolateThreads > 0
+        ? static_cast<unsigned>(options.isolateThreads)
+        : std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned> counts;
+    for (unsigned threads = 1; threads < maxThreads; threads *= 2) {
+        counts.push_back(threads);
+    }
+    counts.push_back(maxThreads);
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "\nIsolate Throughput Benchmark Results\n";
+    std::cout << "Scripts per thread: " << scriptsPerThread << "\n";
+
+    bool ok = true;
+    double baseline = 0.0;
+    for (unsigned threads : counts) {
+        double ms = 0.0;
+        if (!runThreads(threads, ms)) {
+            ok = false;
+            break;
+        }
+        const double perSecond = (static_cast<double>(threads) * scriptsPerThread) / (ms / 1000.0);
+        if (threads == 1) {
+            baseline = perSecond;
+        }
+        std::cout << "Threads: " << std::setw(3) << threads
+                  << "  scripts/s: " << std::setw(10) << perSecond
+                  << "  speedup: " << (perSecond / baseline) << "x\n";
+    }
+
+    fs::remove_all(dir);
+    return ok ? 0 : 1;
+}
+
+// Parses one script once and evaluates that same tree from 1..N threads at a time.
+// Each thread has its own Isolate and globals; only the parsed program is shared.
+static int runSharedAstBenchmark(const CliOptions& options) {
+    using Clock = std::chrono::steady_clock;
+    namespace fs = std::filesystem;
+    const fs::path dir = fs::temp_directory_path() / "merk_bench_shared_ast";
+    fs::create_directories(dir);
+
+    const fs::path scriptPath = dir / "shared.merk";
+    {
+        std::ofstream out(scriptPath);
+        out << "Class Counter:\n"
+            << "    def construct(self):\n"
+            << "        var self.total = 0\n"
+            << "\n"
+            << "    def add(self, n):\n"
+            << "        self.total = self.total + n\n"
+            << "        return self.total\n"
+            << "\n"
+            << "def step(a, i):\n"
+            << "    return (a * 13 + 17 + i) % 1000003\n"
+            << "\n"
+            << "def fresh(n):\n"
+            << "    var k = Counter()\n"
+            << "    return k.add(n)\n"
+            << "\n"
+            << "var c = Counter()\n"
+            << "var seen = [0]\n"
+            << "var a = 1\n"
+            << "var i = 0\n"
+            << "while i < 300:\n"
+            << "    a = step(a, i)\n"
+            << "    if a % 5 == 0:\n"
+            << "        seen.append(c.add(a % 7))\n"
+            << "    if a % 11 == 0:\n"
+            << "        seen.append(fresh(a % 3))\n"
+            << "    i = i + 1\n"
+            << "var result = a + c.total\n";
+    }
+
+    LexerConfig lCfg;
+    SharedPtr<Scope> parseScope = generateGlobalScope(false, lCfg);
+    UniquePtr<CodeBlock> ast;
+    try {
+        Tokenizer tokenizer(scriptPath.string(), true);
+        auto& tokens = tokenizer.tokenize(lCfg);
+        Parser parser(tokens, parseScope, false, false);
+        ast = parser.parse();
+    } catch (MerkError& e) {
+        std::cerr << e.errorString() << std::endl;
+        fs::remove_all(dir);
+        return 1;
+    }
+
+    // One evaluation against a fresh set of globals; returns the script's result.
+    const auto evaluateOnce = [&ast]() {
+        LexerConfig workerCfg;
+        SharedPtr<Scope> scope = generateGlobalScope(false, workerCfg);
+        ast->evaluateFlow(scope);
+        String result = scope->getVariable("result").toString();
+        scope->clear();
+        return result;
+    };
+
+    String expected;
+    try {
+        ScopedSilenceCout silence(true);
+        expected = evaluateOnce();
+    } catch (MerkError& e) {
+        std::cerr << e.errorString() << std::endl;
+        fs::remove_all(dir);
+        return 1;
+    }
+
+    const int runsPerThread = options.benchmarkIters;
+    const auto runThreads = [&](unsigned threads, double& ms) {
+        std::vector<std::thread> workers;
+        std::vector<char> results(threads, 1);
+        ScopedSilenceCout silence(true);
+        const auto t0 = Clock::now();
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                Isolate isolate;
+                Isolate::Enter enter(isolate);
+                try {
+                    for (int i = 0; i < runsPerThread; ++i) {
+                        if (evaluateOnce() != expected) {
+                            results[t] = 0;
+                            return;
+                        }
+                    }
+                } catch (const std::exception&) {
+                    results[t] = 0;
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        return std::all_of(results.begin(), results.end(), [](char r) { return r != 0; });
+    };
+
+    const unsigned maxThreads = options.isolateThreads > 0
+        ? static_cast<unsigned>(options.isolateThreads)
+        : std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned> counts;
+    for (unsigned threads = 1; threads < maxThreads; threads *= 2) {
+        counts.push_back(threads);
+    }
+    counts.push_back(maxThreads);
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "\nShared AST Benchmark Results\n";
+    std::cout << "Runs per thread: " << runsPerThread << "  result: " << expected << "\n";
+
+    bool ok = true;
+    double baseline = 0.0;
+    for (unsigned threads : counts) {
+        double ms = 0.0;
+        if (!runThreads(threads, ms)) {
+            std::cout << "Threads: " << std::setw(3) << threads << "  FAILED (result mismatch or error)\n";
+            ok = false;
+            break;
+        }
+        const double perSecond = (static_cast<double>(threads) * runsPerThread) / (ms / 1000.0);
+        if (threads == 1) {
+            baseline = perSecond;
+        }
+        std::cout << "Threads: " << std::setw(3) << threads
+                  << "  runs/s: " << std::setw(10) << perSecond
+                  << "  speedup: " << (perSecond / baseline) << "x\n";
+    }
+
+    ast->clear();
+    ast.reset();
+    parseScope->clear();
+    fs::remove_all(dir);
+    return ok ? 0 : 1;
+}
+
+// Local stand-in for a slow HTTP service: every request is answered after `delay`,
+// each connection on its own thread so concurrent clients overlap.
+class StandInHttpServer {
+public:
+    explicit StandInHttpServer(std::chrono::milliseconds delay) : delay(delay) {
+        listener = socket(AF_INET, SOCK_STREAM, 0);
+        if (listener < 0) throw MerkError("stand-in server: socket failed");
+        const int reuse = 1;
+        setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        socklen_t len = sizeof(addr);
+        if (bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0
+            || listen(listener, 512) != 0
+            || getsockname(listener, reinterpret_cast<sockaddr*>(&addr), &len) != 0) {
+            close(listener);
+            throw MerkError("stand-in server: bind/listen failed");
+        }
+        port = ntohs(addr.sin_port);
+        acceptor = std::thread([this] { acceptLoop(); });
+    }
+
+    ~StandInHttpServer() {
+        stopping = true;
+        shutdown(listener, SHUT_RDWR);
+        acceptor.join();
+        close(listener);
+        for (auto& t : connections) t.join();
+    }
+
+    String url() const { return "http://127.0.0.1:" + std::to_string(port) + "/"; }
+    std::size_t served() const { return count.load(); }
+
+private:
+    void acceptLoop() {
+        while (!stopping) {
+            const int client = accept(listener, nullptr, nullptr);
+            if (client < 0) continue;
+            connections.emplace_back([this, client] { answer(client); });
+        }
+    }
+
+    void answer(int client) {
+        String request;
+        char buffer[1024];
+        while (request.find("\r\n\r\n") == String::npos) {
+            const auto got = recv(client, buffer, sizeof(buffer), 0);
+            if (got <= 0) break;
+            request.append(buffer, static_cast<std::size_t>(got));
+        }
+        std::this_thread::sleep_for(delay);
+        const String body = "ok";
+        const String response = "HTTP/1.1 200 OK\r\nContent-Length: " + std::to_string(body.size())
+            + "\r\nConnection: close\r\n\r\n" + body;
+        [[maybe_unused]] auto sent = send(client, response.data(), response.size(), MSG_NOSIGNAL);
+        ++count;
+        close(client);
+    }
+
+    std::chrono::milliseconds delay;
+    int listener = -1;
+    int port = 0;
+    std::atomic<bool> stopping{false};
+    std::atomic<std::size_t> count{0};
+    std::thread acceptor;
+    Vector<std::thread> connections;
+};
+
+// Times the same batch of HTTP requests, timers, file reads and spawned calls issued one after another and
+// issued together on the event loop. Requests go to an in-process server that answers each
+// after a fixed delay. Each script checks its own results.
+static int runAsyncBenchmark(const CliOptions& options) {
+    namespace fs = std::filesystem;
+    const fs::path dir = fs::temp_directory_path() / "merk_bench_async";
+    fs::create_directories(dir);
+
+    const int requests = 10 * options.benchmarkIters;
+    const int delayMs = 20;
+    StandInHttpServer server{std::chrono::milliseconds(delayMs)};
+
+    const int files = 8;
+    for (int i = 0; i < files; ++i) {
+        std::ofstream out(dir / ("data" + std::to_string(i) + ".txt"), std::ios::binary);
+        out << String(1 << 20, static_cast<char>('a' + i));
+    }
+    const String dataPath = (dir / "data").string();
+
+    struct Case {
+        const char* label;
+        String script;
+    };
+    const String count = std::to_string(requests);
+    const String check = "if ok != " + count + ":\n    var mismatch = 1 / 0\n"; // no throw statement yet; fail the run instead
+    const String fileCheck = "if total != " + std::to_string(files * (1 << 20)) + ":\n    var mismatch = 1 / 0\n";
+    const Vector<Case> cases = {
+        {"http   serial send()      ",
+            "var ok = 0\nvar i = 0\nwhile i < " + count + ":\n"
+            "    if Http(\"" + server.url() + "\").send().status == 200:\n        ok = ok + 1\n"
+            "    i = i + 1\n" + check},
+        {"http   sendAsync + await  ",
+            "var pending = List()\nvar i = 0\nwhile i < " + count + ":\n"
+            "    pending.append(Http(\"" + server.url() + "\").sendAsync())\n"
+            "    i = i + 1\n"
+            "var ok = 0\nfor f in pending:\n"
+            "    if await(f).status == 200:\n        ok = ok + 1\n" + check},
+        {"http   async def + await  ",
+            "def fetch(url):\n    var r = await(Http(url).sendAsync())\n    return r.status\n"
+            "var pending = List()\nvar i = 0\nwhile i < " + count + ":\n"
+            "    pending.append(async(fetch, \"" + server.url() + "\"))\n"
+            "    i = i + 1\n"
+            "var ok = 0\nfor f in pending:\n"
+            "    if await(f) == 200:\n        ok = ok + 1\n" + check},
+        {"timer  serial await(sleep)",
+            "var ok = 0\nwhile ok < " + count + ":\n"
+            "    await(sleep(" + std::to_string(delayMs) + "))\n"
+            "    ok = ok + 1\n" + check},
+        {"timer  sleep + await      ",
+            "var pending = List()\nvar i = 0\nwhile i < " + count + ":\n"
+            "    pending.append(sleep(" + std::to_string(delayMs) + "))\n"
+            "    i = i + 1\n"
+            "var ok = 0\nfor f in pending:\n"
+            "    await(f)\n    ok = ok + 1\n" + check},
+        {"file   serial readAll     ",
+            "var total = 0\nvar i = 0\nwhile i < " + std::to_string(files) + ":\n"
+            "    total = total + len(File.readAll(\"" + dataPath + "\" + String(i) + \".txt\"))\n"
+            "    i = i + 1\n" + fileCheck},
+        {"file   readAllAsync       ",
+            "var pending = List()\nvar i = 0\nwhile i < " + std::to_string(files) + ":\n"
+            "    pending.append(File.readAllAsync(\"" + dataPath + "\" + String(i) + \".txt\"))\n"
+            "    i = i + 1\n"
+            "var total = 0\nfor f in pending:\n"
+            "    total = total + len(await(f))\n" + fileCheck},
+        {"spawn  serial calls       ",
+            "def tick(ms):\n    await(sleep(ms))\n    return 1\n"
+            "var ok = 0\nvar i = 0\nwhile i < " + count + ":\n"
+            "    ok = ok + tick(" + std::to_string(delayMs) + ")\n"
+            "    i = i + 1\n" + check},
+        {"spawn  fan-out + await    ",
+            "def tick(ms):\n    await(sleep(ms))\n    return 1\n"
+            "var pending = List()\nvar i = 0\nwhile i < " + count + ":\n"
+            "    pending.append(spawn(tick, " + std::to_string(delayMs) + "))\n"
+            "    i = i + 1\n"
+            "var ok = 0\nfor f in pending:\n"
+            "    ok = ok + await(f)\n" + check},
+    };
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "\nAsync Benchmark Results\n";
+    std::cout << "Requests/timers per run: " << requests << " (server delay " << delayMs << " ms), files: " << files << " x 1 MiB\n";
+
+    bool ok = true;
+    double serialMs = 0.0;
+    for (std::size_t c = 0; ok && c < cases.size(); ++c) {
+        const fs::path path = dir / ("case" + std::to_string(c) + ".merk");
+        {
+            std::ofstream out(path);
+            out << cases[c].script;
+        }
+        RunMetrics metrics;
+        {
+            ScopedSilenceCout silence(true);
+            metrics = runPipelineOnce(path.string(), false);
+        }
+        ok = metrics.ok;
+        if (!ok) {
+            std::cerr << "async benchmark case failed: " << cases[c].label << "\n";
+            break;
+        }
+        const bool serial = String(cases[c].label).find("serial") != String::npos;
+        if (serial) serialMs = metrics.evalMs;
+        std::cout << cases[c].label << "  " << std::setw(10) << metrics.evalMs << " ms";
+        if (!serial && metrics.evalMs > 0.0) std::cout << "  speedup vs serial: " << (serialMs / metrics.evalMs) << "x";
+        std::cout << "\n";
+    }
+
+    fs::remove_all(dir);
+    return ok ? 0 : 1;
+}
+
+
+// Producer/consumer throughput through a Channel: P producers and P consumers move
+// string payloads of several sizes through a bounded and an unbounded channel.
+// Every message pays for the deep copy a real cross-isolate send makes.
+static int runChannelBenchmark(const CliOptions& options) {
+    using Clock = std::chrono::steady_clock;
+    const std::size_t messages = 20000 * static_cast<std::size_t>(options.benchmarkIters);
+    const unsigned maxPairs = options.isolateThreads > 0 ? static_cast<unsigned>(options.isolateThreads) : 4u;
+
+    std::cout << std::fixed << std::setprecision(0);
+    std::cout << "\nChannel Benchmark Results\n";
+    std::cout << "Messages per run: " << messages << "\n";
+
+    bool ok = true;
+    for (const std::size_t capacity : {std::size_t(1024), std::size_t(0)}) {
+        for (const std::size_t payload : {std::size_t(8), std::size_t(256), std::size_t(4096)}) {
+            for (unsigned pairs = 1; ok && pairs <= maxPairs; pairs *= 2) {
+                ChannelState channel(capacity);
+                const Node message(String(payload, 'x'));
+                std::atomic<std::size_t> received{0};
+                std::atomic<std::size_t> bytes{0};
+
+                const auto t0 = Clock::now();
+                Vector<std::thread> threads;
+                for (unsigned p = 0; p < pairs; ++p) {
+                    const std::size_t share = messages / pairs + (p < messages % pairs ? 1 : 0);
+                    threads.emplace_back([&, share] {
+                        for (std::size_t i = 0; i < share; ++i) channel.send(message);
+                    });
+                    threads.emplace_back([&] {
+                        Node out;
+                        while (channel.recv(out)) {
+                            bytes += out.toString().size();
+                            if (++received == messages) channel.close();
+                        }
+                    });
+                }
+                for (auto& t : threads) t.join();
+                const double seconds = std::chrono::duration<double>(Clock::now() - t0).count();
+
+                ok = received == messages && bytes == messages * payload;
+                std::cout << (capacity ? "bounded  " : "unbounded")
+                          << "  payload=" << std::setw(5) << payload << "B"
+                          << "  producers/consumers=" << pairs << "/" << pairs
+                          << "  " << std::setw(10) << (static_cast<double>(messages) / seconds) << " msg/s\n";
+            }
+        }
+    }
+
+    if (!ok) {
+        std::cerr << "channel benchmark failed\n";
+    }
+    return ok ? 0 : 1;
+}
+
+// Times one reduction kernel as a serial for-loop and as a parallel for on
+// 1..N pool threads. Each script checks its own total, so a wrong merge fails the run.
+static int runParallelForBenchmark(const CliOptions& options) {
+    namespace fs = std::filesystem;
+    const fs::path dir = fs::temp_directory_path() / "merk_bench_parallel_for";
+    fs::create_directories(dir);
+
+    const int iterations = 20000 * options.benchmarkIters;
+    long long expected = 0;
+    for (int i = 0; i < iterations; ++i) {
+        const int x = i % 1000;
+        expected += (x * x) % 7;
+    }
+
+    const auto writeKernel = [&](const fs::path& path, bool parallel) {
+        std::ofstream out(path);
+        out << "var total = 0\n"
+            << (parallel ? "parallel for i in range(0, " : "for i in range(0, ") << iterations << ")"
+            << (parallel ? " reduce(total: sum)" : "") << ":\n"
+            << "    total = total + ((i % 1000) * (i % 1000)) % 7\n"
+            << "if total != " << expected << ":\n"
+            << "    var mismatch = 1 / 0\n"; // no throw statement yet; fail the run instead
+    };
+    const fs::path serialPath = dir / "serial.merk";
+    const fs::path parallelPath = dir / "parallel.merk";
+    writeKernel(serialPath, false);
+    writeKernel(parallelPath, true);
+
+    const auto timeScript = [](const fs::path& path, double& ms) {
+        ScopedSilenceCout silence(true);
+        const RunMetrics metrics = runPipelineOnce(path.string(), false);
+        ms = metrics.evalMs;
+        return metrics.ok;
+    };
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "\nParallel For Benchmark Results\n";
+    std::cout << "Iterations: " << iterations << "\n";
+
+    double serialMs = 0.0;
+    bool ok = timeScript(serialPath, serialMs);
+    if (ok) {
+        std::cout << "Serial for:      " << std::setw(10) << serialMs << " ms\n";
+    }
+
+    const unsigned maxThreads = options.isolateThreads > 0 ? static_cast<unsigned>(options.isolateThreads) : 16u;
+    for (unsigned threads = 1; ok && threads <= maxThreads; threads *= 2) {
+        Parallel::setWorkerCount(threads);
+        double ms = 0.0;
+        ok = timeScript(parallelPath, ms);
+        if (!ok) break;
+        std::cout << "Threads: " << std::setw(3) << threads
+                  << "  " << std::setw(10) << ms << " ms"
+                  << "  speedup vs serial: " << (serialMs / ms) << "x\n";
+    }
+    Parallel::setWorkerCount(0);
+
+    if (!ok) {
+        std::cerr << "parallel for benchmark failed\n";
+    }
+    fs::remove_all(dir);
+    return ok ? 0 : 1;
+}
+
+// Times List.map/filter/reduce/sort against the same work written as an interpreted loop,
+// then the native methods on 1..N pool threads. Each script checks its own result.
+static int runBulkBenchmark(const CliOptions& options) {
+    namespace fs = std::filesystem;
+    const fs::path dir = fs::temp_directory_path() / "merk_bench_bulk";
+    fs::create_directories(dir);
+
+    const int items = 5000 * options.benchmarkIters;
+    int expected = 0;
+    for (int i = 0; i < items; ++i) {
+        const int y = (i * 31) % 1009;
+        if (y % 2 == 0) expected += y;
+    }
+
+    const String prelude =
+        "def scramble(x):\n"
+        "    return (x * 31) % 1009\n"
+        "def isEven(x):\n"
+        "    return x % 2 == 0\n"
+        "def add(a, b):\n"
+        "    return a + b\n";
+    const String check =
+        "if total != " + std::to_string(expected) + ":\n"
+        "    var mismatch = 1 / 0\n";
+
+    const fs::path loopPath = dir / "loop.merk";
+    {
+        std::ofstream out(loopPath);
+        out << prelude
+            << "var total = 0\n"
+            << "var y = 0\n"
+            << "for i in range(0, " << items << "):\n"
+            << "    y = scramble(i)\n"
+            << "    if isEven(y):\n"
+            << "        total = add(total, y)\n"
+            << check;
+    }
+    const fs::path bulkPath = dir / "bulk.merk";
+    {
+        std::ofstream out(bulkPath);
+        out << prelude
+            << "var values = List(range(0, " << items << ")).map(scramble)\n"
+            << "values.sort()\n"
+            << "var total = values.filter(isEven).reduce(add, 0)\n"
+            << check;
+    }
+
+    const auto timeScript = [](const fs::path& path, double& ms) {
+        ScopedSilenceCout silence(true);
+        const RunMetrics metrics = runPipelineOnce(path.string(), false);
+        ms = metrics.evalMs;
+        return metrics.ok;
+    };
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "\nBulk Method Benchmark Results\n";
+    std::cout << "Items: " << items << "\n";
+
+    double loopMs = 0.0;
+    bool ok = timeScript(loopPath, loopMs);
+    if (ok) {
+        std::cout << "Interpreted loop: " << std::setw(10) << loopMs << " ms\n";
+    }
+
+    const unsigned maxThreads = options.isolateThreads > 0 ? static_cast<unsigned>(options.isolateThreads) : 16u;
+    for (unsigned threads = 1; ok && threads <= maxThreads; threads *= 2) {
+        Parallel::setWorkerCount(threads);
+        double ms = 0.0;
+        ok = timeScript(bulkPath, ms);
+        if (!ok) break;
+        std::cout << "Threads: " << std::setw(3) << threads
+                  << "  " << std::setw(10) << ms << " ms"
+                  << "  speedup vs loop: " << (loopMs / ms) << "x\n";
+    }
+    Parallel::setWorkerCount(0);
+
+    if (!ok) {
+        std::cerr << "bulk benchmark failed\n";
+    }
+    fs::remove_all(dir);
+    return ok ? 0 : 1;
+}
+
+// A directory is scanned recursively for .merk files; anything else is read as
+// a manifest with one path per line (blank lines and '#' comments skipped),
+// relative to the manifest's own directory.
+static Vector<String> collectBatchFiles(const String& source) {
+    namespace fs = std::filesystem;
+    Vector<String> files;
+    const fs::path root(source);
+
+    if (fs::is_directory(root)) {
+        for (const auto& entry : fs::recursive_directory_iterator(root)) {
+            if (entry.is_regular_file() && entry.path().extension() == ".merk") {
+                files.push_back(entry.path().string());
+            }
+        }
+        std::sort(files.begin(), files.end());
+        return files;
+    }
+
+    std::ifstream manifest(root);
+    if (!manifest) {
+        throw std::runtime_error("Cannot open batch source: " + source);
+    }
+    String line;
+    while (std::getline(manifest, line)) {
+        const auto first = line.find_first_not_of(" \t\r");
+        if (first == String::npos || line[first] == '#') continue;
+        const auto last = line.find_last_not_of(" \t\r");
+        fs::path file(line.substr(first, last - first + 1));
+        if (file.is_relative()) {
+            file = root.parent_path() / file;
+        }
+        files.push_back(file.string());
+    }
+    return files;
+}
+
+struct ScheduledRun {
+    Vector<RunMetrics> results;
+    Vector<double> doneMs; // since the batch started, queueing and preemption included
+    std::size_t preemptions = 0;
+    double wallMs = 0.0;
+};
+
+// Runs every file in-process on a Scheduler: each script gets its own thread (and so that
+// thread's default Isolate), at most `slots` run at once, and a script that burns `fuel` units
+// while others are queued gives up its slot. Script stdout is suppressed; errors still go to stderr.
+static ScheduledRun runScheduled(const Vector<String>& files, std::size_t slots, std::int64_t fuel) {
+    using Clock = std::chrono::steady_clock;
+    ScheduledRun run;
+    run.results.resize(files.size());
+    run.doneMs.resize(files.size(), 0.0);
+
+    ScopedSilenceCout silence(true);
+    const auto t0 = Clock::now();
+    {
+        Scheduler scheduler(slots, fuel);
+        for (std::size_t i = 0; i < files.size(); ++i) {
+            scheduler.submit([&, i] {
+                try {
+                    run.results[i] = runPipelineOnce(files[i], false);
+                } catch (const std::exception& ex) {
+                    std::cerr << files[i] << ": " << ex.what() << std::endl;
+                }
+                run.doneMs[i] = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+            });
+        }
+        scheduler.wait();
+        run.preemptions = scheduler.preemptions();
+    }
+    run.wallMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    return run;
+}
+
+static int runBatch(const CliOptions& options) {
+    const Vector<String> files = collectBatchFiles(options.batchPath);
+    if (files.empty()) {
+        std::cerr << "No .merk files found in " << options.batchPath << "\n";
+        return 1;
+    }
+
+    const std::size_t workers = options.batchThreads > 0
+        ? static_cast<std::size_t>(options.batchThreads)
+        : std::max(1u, std::thread::hardware_concurrency());
+
+    const ScheduledRun run = runScheduled(files, workers, options.batchFuel);
+    const Vector<RunMetrics>& results = run.results;
+    const double wallMs = run.wallMs;
+
+    std::size_t failed = 0;
+    Vector<double> latencies;
+    latencies.reserve(results.size());
+    std::cout << std::fixed << std::setprecision(3);
+    for (std::size_t i = 0; i < files.size(); ++i) {
+        const RunMetrics& r = results[i];
+        if (!r.ok) ++failed;
+        latencies.push_back(r.totalMs);
+        std::cout << (r.ok ? "ok   " : "FAIL ") << files[i]
+                  << "  tokenize=" << r.tokenizeMs << "ms parse=" << r.parseMs
+                  << "ms eval=" << r.evalMs << "ms total=" << r.totalMs
+                  << "ms done=" << run.doneMs[i] << "ms\n";
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    const auto percentile = [&](double p) {
+        const std::size_t rank = static_cast<std::size_t>(p * static_cast<double>(latencies.size() - 1) + 0.5);
+        return latencies[rank];
+    };
+
+    std::cout << "\nBatch Results\n";
+    std::cout << "Files:      " << files.size() << " (" << failed << " failed)\n";
+    std::cout << "Workers:    " << workers << "\n";
+    std::cout << "Fuel:       " << (options.batchFuel > 0 ? std::to_string(options.batchFuel) : String("unlimited"))
+              << " (" << run.preemptions << " preemptions)\n";
+    std::cout << "Wall:       " << wallMs << " ms\n";
+    std::cout << "Throughput: " << (static_cast<double>(files.size()) / (wallMs / 1000.0)) << " files/s\n";
+    std::cout << "Latency:    p50=" << percentile(0.50) << "ms p95=" << percentile(0.95)
+              << "ms p99=" << percentile(0.99) << "ms max=" << latencies.back() << "ms\n";
+    return failed == 0 ? 0 : 1;
+}
+
+// One long-running loop queued ahead of many short scripts on a single run slot, with and
+// without a fuel budget. Without one the short scripts wait for the loop to finish; with
+// one they finish while it is still running.
+static int runFuelBenchmark(const CliOptions& options) {
+    namespace fs = std::filesystem;
+    const fs::path dir = fs::temp_directory_path() / "merk_bench_fuel";
+    fs::create_directories(dir);
+
+    const int longIters = 10000 * options.benchmarkIters;
+    const int shortScripts = 20;
+    Vector<String> files;
+    {
+        const fs::path path = dir / "long.merk";
+        std::ofstream out(path);
+        out << "var total = 0\n"
+            << "var i = 0\n"
+            << "while i < " << longIters << ":\n"
+            << "    total = total + (i * 7) % 13\n"
+            << "    i = i + 1\n";
+        files.push_back(path.string());
+    }
+    for (int s = 0; s < shortScripts; ++s) {
+        const fs::path path = dir / ("short" + std::to_string(s) + ".merk");
+        std::ofstream out(path);
+        out << "var total = 0\n"
+            << "for i in range(0, 100):\n"
+            << "    total = total + i\n";
+        files.push_back(path.string());
+    }
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Fuel Benchmark (1 slot, 1 loop of " << longIters << " iterations ahead of "
+              << shortScripts << " short scripts)\n";
+
+    bool ok = true;
+    for (const std::int64_t fuel : {std::int64_t{0}, std::int64_t{CliOptions{}.batchFuel}}) {
+        const ScheduledRun run = runScheduled(files, 1, fuel);
+        Vector<double> shortDone(run.doneMs.begin() + 1, run.doneMs.end());
+        std::sort(shortDone.begin(), shortDone.end());
+        for (const RunMetrics& r : run.results) ok = ok && r.ok;
+
+        std::cout << "Fuel: " << std::setw(9) << (fuel > 0 ? std::to_string(fuel) : String("unlimited"))
+                  << "  loop done " << std::setw(10) << run.doneMs.front() << " ms"
+                  << "  short p50 " << std::setw(10) << shortDone[shortDone.size() / 2] << " ms"
+                  << "  short max " << std::setw(10) << shortDone.back() << " ms"
+                  << "  preemptions " << run.preemptions << "\n";
+    }
+
+    if (!ok) {
+        std::cerr << "fuel benchmark failed\n";
+    }
+    fs::remove_all(dir);
+    return ok ? 0 : 1;
+}
+
 // Parse once, eval many times (fresh scope per eval). Comparable to Python's compile-once-exec-many.
 static int runBenchmarkEvalOnly(int argc, char* argv[], const CliOptions& options) {
     const String codeDir = "code/";
@@ -676,7 +2340,7 @@ static int runBenchmarkEvalOnly(int argc, char* argv[], const CliOptions& option
 
     try {
         Tokenizer tokenizer(filePath, true);
-        auto tokens = tokenizer.tokenize(lCfg);
+        auto& tokens = tokenizer.tokenize(lCfg);
         tokenCount = tokens.size();
 
         Parser parser(tokens, parseScope, interpretMode, byBlock);
@@ -748,6 +2412,67 @@ static int runBenchmarkEvalOnly(int argc, char* argv[], const CliOptions& option
     return 0;
 }
 
+// Parses a program without running it and prints the tree the evaluator would get, after the
+// AST optimizer has folded constants and dropped dead code.
+static int runDumpOptimizedAst(const CliOptions& options) {
+    const String filePath = resolveFilePath(options.fileName);
+    LexerConfig lCfg;
+    SharedPtr<Scope> globalScope = generateGlobalScope(false, lCfg);
+
+    try {
+        Tokenizer tokenizer(filePath, true);
+        auto& tokens = tokenizer.tokenize(lCfg);
+        Parser parser(tokens, globalScope, false, false);
+        auto ast = parser.parse();
+        ast->printAST(std::cout, 0);
+
+        const AstOptimizer::Stats& stats = parser.getOptimizerStats();
+        std::cout << "\nOptimizer:   " << stats.folded << " folded, "
+                  << stats.propagated << " constants propagated, "
+                  << stats.prunedBranches << " dead branches, "
+                  << stats.unreachable << " unreachable statements\n";
+        std::cout << "Constants:   " << stats.constants << " pooled values shared by "
+                  << stats.literals << " literals\n";
+        ast->clear();
+    } catch (MerkError& e) {
+        std::cerr << e.errorString() << std::endl;
+        return 1;
+    }
+    globalScope->clear();
+    return 0;
+}
+
+// Loads a file and every module it imports, then lists them dependencies first.
+static int runDumpModules(const CliOptions& options) {
+    const String filePath = resolveFilePath(options.fileName);
+    const String root = std::filesystem::path(filePath).parent_path().string();
+    ModuleLoader loader(root, [](LexerConfig& cfg) { return generateGlobalScope(false, cfg); });
+
+    try {
+        loader.load(filePath);
+        for (const ModuleLoader::Module* module : loader.requireAll()) {
+            std::cout << module->name << "  (" << module->path << ", " << module->tokenCount << " tokens, "
+                      << module->ast->getAllAst(true).size() << " AST nodes)";
+            for (size_t i = 0; i < module->imports.size(); ++i) {
+                std::cout << (i == 0 ? "  imports " : ", ") << module->imports[i];
+            }
+            std::cout << "\n";
+        }
+    } catch (MerkError& e) {
+        std::cerr << e.errorString() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+// Serves the Language Server Protocol on stdin and stdout.
+static int runLanguageServer() {
+    std::ios::sync_with_stdio(false);
+    std::ostream protocol(std::cout.rdbuf());
+    LanguageServer server(std::cin, protocol, [](LexerConfig& cfg) { return generateGlobalScope(false, cfg); });
+    return server.run();
+}
+
 int main(int argc, char* argv[]) {
     Debug::configureDebugger();
 
@@ -769,6 +2494,57 @@ int main(int argc, char* argv[]) {
         if (options.manualComputeBenchmark) {
             return runManualComputeBenchmark(options);
         }
+        if (options.stringBuildBenchmark) {
+            return runStringBuildBenchmark(options);
+        }
+        if (options.iterationBenchmark) {
+            return runIterationBenchmark(options);
+        }
+        if (options.generatorBenchmark) {
+            return runGeneratorBenchmark(options);
+        }
+        if (options.isolateBenchmark) {
+            return runIsolateBenchmark(options);
+        }
+        if (options.bulkBenchmark) {
+            return runBulkBenchmark(options);
+        }
+        if (options.parallelForBenchmark) {
+            return runParallelForBenchmark(options);
+        }
+        if (options.channelBenchmark) {
+            return runChannelBenchmark(options);
+        }
+        if (options.sharedAstBenchmark) {
+            return runSharedAstBenchmark(options);
+        }
+        if (options.asyncBenchmark) {
+            return runAsyncBenchmark(options);
+        }
+        if (options.tokenizerBenchmark) {
+            return runTokenizerBenchmark(options);
+        }
+        if (options.moduleBenchmark) {
+            return runModuleBenchmark(options);
+        }
+        if (options.lspBenchmark) {
+            return runLspBenchmark();
+        }
+        if (options.fuelBenchmark) {
+            return runFuelBenchmark(options);
+        }
+        if (options.dumpOptimizedAst) {
+            return runDumpOptimizedAst(options);
+        }
+        if (options.dumpModules) {
+            return runDumpModules(options);
+        }
+        if (options.languageServer) {
+            return runLanguageServer();
+        }
+        if (!options.batchPath.empty()) {
+            return runBatch(options);
+        }
         return run_original(argc, argv);
     } catch (const std::exception& ex) {
         std::cerr << ex.what() << std::endl;
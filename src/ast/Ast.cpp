@@ -38,6 +38,7 @@ EvalResult BaseAST::evaluateFlow() const {
 
 
 BaseAST::~BaseAST() = default;
+
 LiteralValue::~LiteralValue()  {
     // DEBUG_FLOW(FlowLevel::PERMISSIVE);
     // // value = Node(Null);
@@ -83,6 +84,8 @@ LiteralValue::LiteralValue(LitNode value, SharedPtr<Scope> scope)
         if (!value.isValid()) {
             throw MerkError("LitNode Became Invalid After LiteralValue construction");
         }
+        // Every evaluation hands out this same value, possibly on several threads.
+        this->value.getValueNode().freeze();
     }
 
 // Variable Constructors
@@ -124,7 +127,7 @@ VariableReference::VariableReference(const String& name, SharedPtr<Scope> scope)
     }
 }
 
-UnaryOperation::UnaryOperation(const String& op, UniquePtr<ASTStatement> operand, SharedPtr<Scope> scope)
+UnaryOperation::UnaryOperation(UnaryOp op, UniquePtr<ASTStatement> operand, SharedPtr<Scope> scope)
     : ASTStatement(scope), op(op), operand(std::move(operand)) {
     // validateScope(scope, "UnaryOperation::UnaryOperation", op );
 }
@@ -132,7 +135,7 @@ UnaryOperation::UnaryOperation(const String& op, UniquePtr<ASTStatement> operand
 
 
 // Calculation Constructors
-BinaryOperation::BinaryOperation(const String& op, UniquePtr<ASTStatement> left, UniquePtr<ASTStatement> right, SharedPtr<Scope> scope)
+BinaryOperation::BinaryOperation(BinaryOp op, UniquePtr<ASTStatement> left, UniquePtr<ASTStatement> right, SharedPtr<Scope> scope)
     : ASTStatement(scope), op(op), left(std::move(left)), right(std::move(right)) {
     DEBUG_FLOW(FlowLevel::NONE);
     // if (!scope) {throw MerkError("The Scope Passed to BinaryOperation::BinaryOperation is null");}
@@ -144,15 +147,9 @@ BinaryOperation::BinaryOperation(const String& op, UniquePtr<ASTStatement> left,
 
 
 Node LiteralValue::evaluate(SharedPtr<Scope> scope, [[maybe_unused]] SharedPtr<ClassInstanceNode> instanceNode) const {
-    DEBUG_FLOW(FlowLevel::NONE);
     MARK_UNUSED_MULTI(scope);
-
-    if (val) {throw MerkError("returning cached literal"); return Node(val->getInner()); }  // something of a cached value
-    // validateScope(scope, "LiteralValue", toString());
-    Node evaluated =  Evaluator::evaluateLiteral(value.getValueNode());
-
-    DEBUG_FLOW_EXIT();
-    return evaluated;
+    // Validated and frozen at construction; every evaluation hands out the same node.
+    return value.getValueNode();
 };
 
 // Variable Evaluations
@@ -218,7 +215,7 @@ Node BinaryOperation::evaluate(SharedPtr<Scope> scope, [[maybe_unused]] SharedPt
         
     // }
     auto leftValue = left->evaluate(scope, instanceNode);
-    if (op == "and" || op == "&&") {
+    if (op == BinaryOp::And) {
         if (!leftValue.isTruthy()) {
             DEBUG_FLOW_EXIT();
             return Node(false);
@@ -227,7 +224,7 @@ Node BinaryOperation::evaluate(SharedPtr<Scope> scope, [[maybe_unused]] SharedPt
         DEBUG_FLOW_EXIT();
         return Node(rightValue.isTruthy());
     }
-    if (op == "or" || op == "||") {
+    if (op == BinaryOp::Or) {
         if (leftValue.isTruthy()) {
             DEBUG_FLOW_EXIT();
             return Node(true);
@@ -239,7 +236,7 @@ Node BinaryOperation::evaluate(SharedPtr<Scope> scope, [[maybe_unused]] SharedPt
 
     auto rightValue = right->evaluate(scope, instanceNode);
 
-    if ((leftValue.isNull() || rightValue.isNull()) && op == "==") {
+    if ((leftValue.isNull() || rightValue.isNull()) && op == BinaryOp::Eq) {
         throw MerkError("About To Attempt Operation with lhs: " + leftValue.toString() + " And rhs: " + rightValue.toString() + " AST IS: " + toString());
     }
     // if (leftValue.nodeType == "LitNode" && rightValue.nodeType == "LitNode") {
@@ -322,6 +319,10 @@ void Return::setScope(SharedPtr<Scope> newScope) {
     DEBUG_FLOW_EXIT();
 }
 
+void Yield::setScope(SharedPtr<Scope> newScope) {
+    MARK_UNUSED_MULTI(newScope);
+}
+
 
 
 
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <unordered_set>
 #include <ostream>
 
@@ -258,6 +259,42 @@ CallableDef::CallableDef(String name, ParamList parameters, UniquePtr<CallableBo
     branch = "Callable";
 }
 
+SharedPtr<const Captures> Captures::of(const CallableBody& body, const ParamList& parameters) {
+    FreeVars free = body.collectFreeVariables();
+    auto resolved = makeShared<Captures>();
+    resolved->names.assign(free.begin(), free.end());
+    std::sort(resolved->names.begin(), resolved->names.end());
+
+    for (const auto& param : parameters) {free.erase(param.getName());}
+    resolved->unbound.assign(free.begin(), free.end());
+    std::sort(resolved->unbound.begin(), resolved->unbound.end());
+    return resolved;
+}
+
+void Captures::requireBound() const {
+    if (unbound.empty()) {return;}
+    String listed;
+    for (const auto& name : unbound) {
+        if (!listed.empty()) {listed += ", ";}
+        listed += name;
+    }
+    throw MerkError("The Following Vars: " + highlight(listed, Colors::yellow) + "; were defined outside of function defined using function");
+}
+
+SharedPtr<const Captures> CallableDef::getCaptures() const {
+    return captures ? captures : Captures::of(*body, parameters);
+}
+
+void CallableDef::resolveCaptures() const {
+    if (!captures && body) {captures = Captures::of(*body, parameters);}
+}
+
+void CallableDef::resolveAllCaptures(const BaseAST& root) {
+    for (const BaseAST* node : root.getAllAst(true)) {
+        if (auto def = dynamic_cast<const CallableDef*>(node)) {def->resolveCaptures();}
+    }
+}
+
 
 CallableRef::CallableRef(String name, SharedPtr<Scope> scope)
     : ASTStatement(scope), name(name) {
@@ -70,7 +70,6 @@ void Chain::clear() {
     for (auto& elem : elements){
         elem.clear();
     } 
-    if (lastScope) {lastScope.reset();}
     if (getSecondaryScope()){
         scope.reset();
         setScope(nullptr);
@@ -105,9 +104,6 @@ void Chain::setScope(SharedPtr<Scope> newScope) {
     // scope = newScope;
     // for (auto& elem : elements) { if (elem.object) {elem.object->setScope(newScope);} }
 }
-void Chain::setLastScope(SharedPtr<Scope> mostRecentScope) const {
-    lastScope = mostRecentScope;
-}
 
 
 
@@ -172,14 +168,6 @@ UniquePtr<BaseAST> Chain::clone() const {
     return copy;
 }
 
-SharedPtr<Scope> Chain::getLastScope() {
-    return lastScope;
-}
-
-SharedPtr<Scope> Chain::getLastScope() const {
-    return lastScope;
-}
-
 void Chain::replaceLastElementWith(ChainElement&& elem) {
     if (elements.empty()) {
         elements[0] = std::move(elem);
@@ -318,8 +306,6 @@ Node Chain::evaluate(SharedPtr<Scope> methodScope, [[maybe_unused]] SharedPtr<Cl
     
     if (!currentScope) {throw MerkError("Chain::evaluate: no valid scope");}
     int index = resolutionStartIndex;
-    
-    setLastScope(currentScope);
 
     return Evaluator::evaluateChain(currentScope, methodScope, index, getElements(), instanceNode);
     
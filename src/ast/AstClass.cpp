@@ -63,10 +63,10 @@ Node ClassDef::evaluate(SharedPtr<Scope> defScope, [[maybe_unused]] SharedPtr<Cl
     if (!defScope) {throw MerkError("No Scope Was Found in ClassDef::evaluate()");}
     if (!body->getScope()){throw MerkError("scope not present in ClassDef::evaluate in body");}
 
-    FreeVars freeVarNames = body->collectFreeVariables();
-    if (freeVarNames.size() == 0) {DEBUG_LOG(LogLevel::TRACE, "There Are No Free Variables in classdef: ", name);}
+    auto resolved = getCaptures();
+    if (resolved->names.empty()) {DEBUG_LOG(LogLevel::TRACE, "There Are No Free Variables in classdef: ", name);}
 
-    SharedPtr<Scope> classDefCapturedScope = defScope->buildClassDefScope(freeVarNames, name);
+    SharedPtr<Scope> classDefCapturedScope = defScope->buildClassDefScope(resolved->names, name);
     SharedPtr<Scope> classScope = classDefCapturedScope->createChildScope();
     if (!classDefCapturedScope){throw MerkError("classScope was not created correctly on the ClassBase.");}
 
@@ -81,25 +81,15 @@ Node ClassDef::evaluate(SharedPtr<Scope> defScope, [[maybe_unused]] SharedPtr<Cl
     cls->setParameters(std::move(paramsForCls));
 
     auto classBody = static_cast<ClassBody*>(getBody());
-    classBody->setClassScope(classScope);
-
-    classBody->setCapturedScope(cls->getCapturedScope());
-    String bodyAccess = accessor;
-    classBody->setAccessor(bodyAccess);
-
     DEBUG_LOG(LogLevel::TRACE, "ClassScope Below: ");    
 
-    auto out = classBody->evaluate(cls->getClassScope(), instanceNode);
+    classBody->evaluateInto(cls->getClassScope(), cls->getCapturedScope(), accessor, instanceNode);
 
     if (!cls->getClassScope()->hasFunction("construct")) {
         cls->getClassScope()->debugPrint();
         cls->getClassScope()->printChildScopes();
         throw MerkError("Class '" + name + "' must implement a 'construct' method.");
     }
-    
-    classBody->setCapturedScope(nullptr);
-    classBody->setClassScope(nullptr);
-    // classBody->getScope()->owner = generateScopeOwner("ClassBody", name);
 
     defScope->registerClass(name, cls);
     
@@ -155,6 +145,11 @@ Node ClassBody::evaluate(SharedPtr<Scope> classScope, [[maybe_unused]] SharedPtr
     return Evaluator::evaluateClassBody(classCapturedScope, classScope, getScope(), accessor, getMutableChildren(), instanceNode);
 }
 
+Node ClassBody::evaluateInto(SharedPtr<Scope> classScope, SharedPtr<Scope> capturedScope, const String& classAccessor, SharedPtr<ClassInstanceNode> instanceNode) const {
+    DEBUG_FLOW(FlowLevel::HIGH);
+    return Evaluator::evaluateClassBody(capturedScope, classScope, getScope(), classAccessor, getMutableChildren(), instanceNode);
+}
+
 Node ClassCall::evaluate(SharedPtr<Scope> callScope, [[maybe_unused]] SharedPtr<ClassInstanceNode> instanceNode) const {
     DEBUG_FLOW(FlowLevel::PERMISSIVE);
     if (!callScope) {throw MerkError("Initial Scope Failed in ClassCall::evaluate()");}
@@ -188,7 +183,6 @@ Node Accessor::evaluate(SharedPtr<Scope> evalScope, SharedPtr<ClassInstanceNode>
 ClassDef::~ClassDef() {if (getBody()) { getBody().reset(); }}
 
 ClassCall::~ClassCall() {
-    if (getScope()) { getScope()->clear();}
     if (arguments) {
         arguments.reset();
     }
@@ -5,6 +5,7 @@
 #include <optional>
 #include <cassert>
 #include <string>
+#include <mutex>
 #include <unordered_set>
 
 #include "core/TypesFWD.hpp"
@@ -21,18 +22,29 @@
 #include "utilities/helper_functions.h"
 
 #include "core/evaluators/FlowEvaluator.hpp"
+#include "core/evaluators/Evaluator.hpp"
 #include "core/Environments/Scope.hpp"
 
 
 FreeVarCollection::~FreeVarCollection() {
-    freeVars.clear();
-    localAssign.clear();
+    delete freeVarsCache.load(std::memory_order_relaxed);
+}
+
+FreeVars FreeVarCollection::publishFreeVars(FreeVars found) const {
+    // Two threads may race to fill the same node; the first result wins and is never rewritten.
+    const FreeVars* fresh = new FreeVars(std::move(found));
+    const FreeVars* published = nullptr;
+    if (!freeVarsCache.compare_exchange_strong(published, fresh, std::memory_order_acq_rel)) {
+        delete fresh;
+        return *published;
+    }
+    return *fresh;
 } 
 
-AstCollector::~AstCollector() { collectedNodes.clear(); }
+AstCollector::~AstCollector() = default;
 
-const Vector<BaseAST*>& AstCollector::collectChildrenOfType(const Vector<UniquePtr<BaseAST>>& children, AstType type) const {
-    collectedNodes.clear();
+Vector<BaseAST*> AstCollector::collectChildrenOfType(const Vector<UniquePtr<BaseAST>>& children, AstType type) const {
+    Vector<BaseAST*> collectedNodes;
     for (const auto& child : children) {
         if (child && child->getAstType() == type) {
             collectedNodes.push_back(child.get());
@@ -41,8 +53,8 @@ const Vector<BaseAST*>& AstCollector::collectChildrenOfType(const Vector<UniqueP
     return collectedNodes;
 }
 
-const Vector<BaseAST*>& AstCollector::collectChildrenOfType(const Vector<UniquePtr<BaseAST>>& children, const Vector<AstType>& types) const {
-    collectedNodes.clear();
+Vector<BaseAST*> AstCollector::collectChildrenOfType(const Vector<UniquePtr<BaseAST>>& children, const Vector<AstType>& types) const {
+    Vector<BaseAST*> collectedNodes;
     for (const auto& child : children) {
         if (!child) continue;
         if (std::find(types.begin(), types.end(), child->getAstType()) != types.end()) {
@@ -244,11 +256,34 @@ ForLoop::ForLoop(String loopVariable,
     branch = "HoldsBody";
 }
 
+ForLoop::ForLoop(String loopVariable,
+                 UniquePtr<ASTStatement> iterableExpr,
+                 UniquePtr<CodeBlock> body,
+                 SharedPtr<Scope> scope)
+    : ASTStatement(scope),
+      loopVariable(std::move(loopVariable)),
+      iterableExpr(std::move(iterableExpr)),
+      body(std::move(body)) {
+    if (this->loopVariable.empty()) {
+        throw MerkError("ForLoop: loop variable cannot be empty.");
+    }
+    if (!this->iterableExpr) {
+        throw MerkError("ForLoop: iterable expression must be present.");
+    }
+    if (!this->body) {
+        throw MerkError("ForLoop: body is null.");
+    }
+    branch = "HoldsBody";
+}
+
 
 Node ConditionalBlock::evaluate(SharedPtr<Scope> scope, [[maybe_unused]] SharedPtr<ClassInstanceNode> instanceNode) const {
     return condition.get()->evaluate(scope, instanceNode);
 }
 Node ConditionalBlock::evaluate() const {return condition.get()->evaluate(getScope());}
+bool ConditionalBlock::isTruthy(SharedPtr<Scope> scope, SharedPtr<ClassInstanceNode> instanceNode) const {
+    return Evaluator::evaluateCondition(condition.get(), scope, instanceNode);
+}
 EvalResult ConditionalBlock::evaluateFlow(SharedPtr<Scope> scope, SharedPtr<ClassInstanceNode> instance) const {
     return condition.get()->evaluateFlow(scope, instance);
 }
@@ -297,15 +332,9 @@ EvalResult ForLoop::evaluateFlow(SharedPtr<Scope> scope, SharedPtr<ClassInstance
 }
 
 
-void CodeBlock::setScope(SharedPtr<Scope> newScope) const {
-    MARK_UNUSED_MULTI(newScope);
-    // this->scope = newScope;
-}
-
 // Control Flow Evaluations
 Node CodeBlock::evaluate(SharedPtr<Scope> scope, [[maybe_unused]] SharedPtr<ClassInstanceNode> instanceNode) const {
     DEBUG_FLOW(FlowLevel::LOW);
-    setScope(scope);
     Node val =  Evaluator::evaluateBlock(children, scope, instanceNode);
 
     DEBUG_FLOW_EXIT();
@@ -313,7 +342,6 @@ Node CodeBlock::evaluate(SharedPtr<Scope> scope, [[maybe_unused]] SharedPtr<Clas
 }
 
 EvalResult CodeBlock::evaluateFlow(SharedPtr<Scope> scope, [[maybe_unused]] SharedPtr<ClassInstanceNode> instanceNode) const {
-    setScope(scope);
     return FlowEvaluator::evaluateBlock(children, scope, instanceNode);
 }
 
@@ -440,6 +468,7 @@ void ForLoop::setScope(SharedPtr<Scope> newScope) {
     if (startExpr) startExpr->setScope(newScope);
     if (endExpr) endExpr->setScope(newScope);
     if (stepExpr) stepExpr->setScope(newScope);
+    if (iterableExpr) iterableExpr->setScope(newScope);
     if (body) body->setScope(newScope);
 }
 
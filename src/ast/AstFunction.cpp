@@ -101,6 +101,7 @@ UniquePtr<BaseAST> FunctionDef::clone() const {
     auto clonedBody = static_unique_ptr_cast<FunctionBody>(std::move(clonedBodyBase));
 
     auto funcDef = std::make_unique<FunctionDef>(name, parameters, std::move(clonedBody), callType, getScope());
+    funcDef->captures = captures;
     
     DEBUG_FLOW_EXIT();
     return funcDef;
@@ -110,25 +111,10 @@ UniquePtr<BaseAST> FunctionDef::clone() const {
 
 Node FunctionDef::evaluate(SharedPtr<Scope> scope, [[maybe_unused]] SharedPtr<ClassInstanceNode> instanceNode) const {
     DEBUG_FLOW(FlowLevel::HIGH);
-    auto freeVarNames = body->collectFreeVariables();
-    
-    if (callType == CallableType::FUNCTION){
-        FreeVars tempFreeVars = freeVarNames;
-
-        for (auto& param : parameters){
-            auto it = tempFreeVars.find(param.getName()); // find a matching param name
-            if (it != tempFreeVars.end()){                // indicates a match
-                tempFreeVars.erase(it);
-            }
-        }
-        
-        if (tempFreeVars.size() > 0){
-            throw MerkError("The Following Vars: " + highlight(joinUnorderedSetStrings(tempFreeVars, ", "), Colors::yellow) + "; were defined outside of function defined using function");
-        }
-    }   
-    
+    auto resolved = getCaptures();
+    if (callType == CallableType::FUNCTION) {resolved->requireBound();}
 
-    SharedPtr<Scope> defScope = scope->buildFunctionDefScope(freeVarNames, name);
+    SharedPtr<Scope> defScope = scope->buildFunctionDefScope(resolved->names, name);
     // SharedPtr<Scope> defScope = scope->isolateScope(freeVarNames);
     if (!defScope) {throw MerkError("defScope for FunctionDef::evaluate is null");}
     defScope->owner = generateScopeOwner("FunctionDef", name);
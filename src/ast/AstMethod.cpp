@@ -60,6 +60,7 @@ MethodDef::MethodDef(UniquePtr<FunctionDef> funcDef)
     : CallableDef(funcDef->getName(), funcDef->getParameters(), makeUnique<MethodBody>(std::move(funcDef->getBody())), CallableType::METHOD, funcDef->getScope()) 
 {
     InvocableType = funcDef->callType;
+    captures = funcDef->captures;
     funcDef.reset();
 }
 
@@ -206,6 +207,13 @@ Node MethodDef::evaluate(SharedPtr<Scope> scope, [[maybe_unused]] SharedPtr<Clas
     if (!getClassScope()) {
         throw MerkError("Class Scope was not supplied to Method: " + name);
     }
+    return evaluateIn(scope, getClassScope(), instanceNode);
+}
+
+Node MethodDef::evaluateIn(SharedPtr<Scope> scope, SharedPtr<Scope> ownerClassScope, SharedPtr<ClassInstanceNode> instanceNode) const {
+    if (!ownerClassScope) {
+        throw MerkError("Class Scope was not supplied to Method: " + name);
+    }
     auto methodBody = static_cast<MethodBody*>(getBody());
-    return Evaluator::evaluateMethodDef(scope, getScope(), getClassScope(), name, methodBody, parameters, InvocableType, instanceNode);
+    return Evaluator::evaluateMethodDef(scope, getScope(), ownerClassScope, name, methodBody, *getCaptures(), parameters, InvocableType, instanceNode);
 }
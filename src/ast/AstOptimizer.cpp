@@ -0,0 +1,379 @@
+#include "ast/AstOptimizer.hpp"
+
+#include <bit>
+#include <cstdint>
+#include <iterator>
+
+#include "ast/Ast.hpp"
+#include "ast/AstControl.hpp"
+#include "ast/AstCallable.hpp"
+#include "ast/Exceptions.hpp"
+#include "core/node/NodeKernels.hpp"
+#include "core/evaluators/Evaluator.hpp"
+#include "core/errors.h"
+
+namespace {
+
+using NodeKernels::Kind;
+
+Kind kindOf(const Node& value) {
+    const NodeBase* base = value.getInnerPtr();
+    return base ? NodeKernels::kindOf(*base) : Kind::Other;
+}
+
+// The kernels' operand pairs, less a string that happens to read as a bool.
+bool foldableKinds(Kind lhs, Kind rhs) {
+    const auto numeric = [](Kind kind) { return kind == Kind::Int || kind == Kind::Double; };
+    if (numeric(lhs) && numeric(rhs)) return true;
+    return lhs == rhs && lhs != Kind::Other;
+}
+
+const LiteralValue* asLiteral(const BaseAST* node) {
+    return node && node->getAstType() == AstType::Literal ? static_cast<const LiteralValue*>(node) : nullptr;
+}
+
+bool endsFlow(AstType type) {
+    return type == AstType::Return || type == AstType::Break ||
+           type == AstType::Continue || type == AstType::ThrowStatement;
+}
+
+// Pool key: the type plus the exact value; doubles by their bits so 0.1 + 0.2 stays apart from 0.3.
+String poolKey(const Node& value) {
+    const NodeValueType type = value.getInnerPtr()->getType();
+    String key = nodeTypeToString(type, false);
+    key += '\x1f';
+    if (kindOf(value) == Kind::Double) {
+        key += std::to_string(std::bit_cast<std::uint64_t>(value.toDouble()));
+    } else {
+        key += value.toString();
+    }
+    return key;
+}
+
+} // namespace
+
+
+void AstOptimizer::run(CodeBlock& program) {
+    collectBindings(program);
+    optimizeBlock(program.getMutableChildren(), {}, false);
+    totals.constants = pool.size();
+}
+
+void AstOptimizer::collectBindings(const BaseAST& root) {
+    for (const BaseAST* node : root.getAllAst(true)) {
+        switch (node->getAstType()) {
+            case AstType::VariableDeclaration:
+                ++declarations[static_cast<const VariableDeclaration*>(node)->getName()];
+                break;
+            case AstType::VariableAssignment:
+                rebound.insert(static_cast<const VariableAssignment*>(node)->getName());
+                break;
+            case AstType::ForLoop: {
+                const auto* loop = static_cast<const ForLoop*>(node);
+                rebound.insert(loop->getLoopVariable());
+                for (const auto& reduction : loop->getReductions()) { rebound.insert(reduction.variable); }
+                break;
+            }
+            case AstType::CallableDefinition:
+            case AstType::FunctionDefinition:
+            case AstType::ClassDefinition:
+            case AstType::ClassMethodDef: {
+                const auto* def = static_cast<const CallableDef*>(node);
+                rebound.insert(def->name);
+                for (const String& param : def->parameters.getNames()) { rebound.insert(param); }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+}
+
+bool AstOptimizer::isLockable(const String& name) const {
+    auto it = declarations.find(name);
+    return it != declarations.end() && it->second == 1 && !rebound.count(name);
+}
+
+void AstOptimizer::optimizeBlock(Statements& statements, Constants constants, bool parallelBody) {
+    size_t index = 0;
+    while (index < statements.size()) {
+        BaseAST& statement = *statements[index];
+        switch (statement.getAstType()) {
+            case AstType::VariableDeclaration: {
+                auto& decl = static_cast<VariableDeclaration&>(statement);
+                rewrite(decl.valueExpression, constants);
+                const DataTypeFlags& meta = decl.variableMeta;
+                const LiteralValue* literal = asLiteral(decl.valueExpression.get());
+                if (literal && meta.isConst && !meta.isMutable && !meta.isStatic &&
+                    kindOf(literal->getValueNode()) != Kind::Other && isLockable(decl.name)) {
+                    constants[decl.name] = literal->getValueNode();
+                }
+                break;
+            }
+            case AstType::VariableAssignment:
+                rewrite(static_cast<VariableAssignment&>(statement).valueExpression, constants);
+                break;
+            case AstType::IfStatement:
+                if (!optimizeIf(statements, index, constants, parallelBody)) { continue; }
+                break;
+            case AstType::WhileLoop: {
+                auto& loop = static_cast<WhileLoop&>(statement);
+                rewrite(loop.condition->condition, constants);
+                if (literalTruth(loop.condition->condition.get()) == false && canDrop(loop, parallelBody)) {
+                    statements.erase(statements.begin() + index);
+                    ++totals.prunedBranches;
+                    continue;
+                }
+                optimizeBlock(loop.body->getMutableChildren(), constants, parallelBody);
+                break;
+            }
+            case AstType::ForLoop: {
+                auto& loop = static_cast<ForLoop&>(statement);
+                rewrite(loop.startExpr, constants);
+                rewrite(loop.endExpr, constants);
+                rewrite(loop.stepExpr, constants);
+                rewrite(loop.iterableExpr, constants);
+                optimizeBlock(loop.body->getMutableChildren(), constants, parallelBody || loop.parallel);
+                break;
+            }
+            case AstType::Return:
+                rewrite(static_cast<Return&>(statement).getValue(), constants);
+                break;
+            case AstType::Yield:
+                rewrite(static_cast<Yield&>(statement).getValue(), constants);
+                break;
+            case AstType::ThrowStatement:
+                rewrite(static_cast<Throw&>(statement).getValue(), constants);
+                break;
+            case AstType::CallableDefinition:
+            case AstType::FunctionDefinition: {
+                auto& def = static_cast<CallableDef&>(statement);
+                // A `function` only sees its parameters; outer names must keep failing there.
+                optimizeBlock(def.body->getMutableChildren(),
+                              def.callType == CallableType::DEF ? constants : Constants{}, parallelBody);
+                break;
+            }
+            case AstType::ClassDefinition:
+            case AstType::ClassMethodDef:
+                // Bare names in class and method bodies resolve through class and instance scopes.
+                optimizeBlock(static_cast<CallableDef&>(statement).body->getMutableChildren(), {}, parallelBody);
+                break;
+            default:
+                rewrite(statements[index], constants);
+                break;
+        }
+
+        if (endsFlow(statements[index]->getAstType())) {
+            for (size_t tail = statements.size(); tail-- > index + 1;) {
+                if (!canDrop(*statements[tail], parallelBody)) { continue; }
+                statements.erase(statements.begin() + tail);
+                ++totals.unreachable;
+            }
+        }
+        ++index;
+    }
+}
+
+bool AstOptimizer::optimizeIf(Statements& statements, size_t index, const Constants& constants, bool parallelBody) {
+    auto& ifs = static_cast<IfStatement&>(*statements[index]);
+    rewrite(ifs.condition->condition, constants);
+    for (auto& elif : ifs.elifNodes) { rewrite(elif->condition->condition, constants); }
+
+    const auto tailDroppable = [&](size_t fromElif) {
+        for (size_t k = fromElif; k < ifs.elifNodes.size(); ++k) {
+            if (!canDrop(*ifs.elifNodes[k], parallelBody)) return false;
+        }
+        return !ifs.elseNode || canDrop(*ifs.elseNode, parallelBody);
+    };
+    const auto tailSize = [&](size_t fromElif) {
+        return ifs.elifNodes.size() - fromElif + (ifs.elseNode ? 1 : 0);
+    };
+
+    // Set when one body is all that is left; its statements then replace the if.
+    UniquePtr<CodeBlock> taken;
+    const std::optional<bool> own = literalTruth(ifs.condition->condition.get());
+    if (own == true && tailDroppable(0)) {
+        totals.prunedBranches += tailSize(0);
+        taken = std::move(ifs.body);
+    } else {
+        const bool ownKept = !(own == false && canDrop(*ifs.body, parallelBody));
+        if (!ownKept) { ++totals.prunedBranches; }
+
+        Vector<UniquePtr<ElifStatement>> kept;
+        for (size_t k = 0; k < ifs.elifNodes.size(); ++k) {
+            auto& elif = ifs.elifNodes[k];
+            const std::optional<bool> truth = literalTruth(elif->condition->condition.get());
+            if (truth == false && canDrop(*elif, parallelBody)) {
+                ++totals.prunedBranches;
+                continue;
+            }
+            if (truth == true && tailDroppable(k + 1)) {
+                // Reached only when every earlier branch is skipped, and then always taken.
+                totals.prunedBranches += tailSize(k + 1);
+                ifs.elseNode = makeUnique<ElseStatement>(std::move(elif->body), elif->getScope());
+                break;
+            }
+            kept.push_back(std::move(elif));
+        }
+        ifs.elifNodes = std::move(kept);
+
+        if (!ownKept) {
+            if (!ifs.elifNodes.empty()) {
+                UniquePtr<ElifStatement> first = std::move(ifs.elifNodes.front());
+                ifs.elifNodes.erase(ifs.elifNodes.begin());
+                ifs.condition = std::move(first->condition);
+                ifs.body = std::move(first->body);
+            } else if (ifs.elseNode) {
+                taken = std::move(ifs.elseNode->getBody());
+            } else {
+                statements.erase(statements.begin() + index);
+                return false;
+            }
+        }
+    }
+
+    if (taken) {
+        // Branch bodies run in the scope of the if itself, so their statements can stand in for it.
+        Statements body = std::move(taken->getMutableChildren());
+        statements.erase(statements.begin() + index);
+        statements.insert(statements.begin() + index,
+                          std::make_move_iterator(body.begin()), std::make_move_iterator(body.end()));
+        return false;
+    }
+
+    optimizeBlock(ifs.body->getMutableChildren(), constants, parallelBody);
+    for (auto& elif : ifs.elifNodes) { optimizeBlock(elif->body->getMutableChildren(), constants, parallelBody); }
+    if (ifs.elseNode) { optimizeBlock(ifs.elseNode->getBody()->getMutableChildren(), constants, parallelBody); }
+    return true;
+}
+
+template <typename T>
+void AstOptimizer::rewrite(UniquePtr<T>& slot, const Constants& constants) {
+    if (!slot) return;
+    if (UniquePtr<ASTStatement> replacement = fold(*slot, constants)) {
+        slot = std::move(replacement);
+    }
+}
+
+UniquePtr<ASTStatement> AstOptimizer::fold(BaseAST& node, const Constants& constants) {
+    switch (node.getAstType()) {
+        case AstType::Literal: {
+            auto& literal = static_cast<LiteralValue&>(node);
+            if (kindOf(literal.getValueNode()) != Kind::Other) {
+                literal.value.setValue(pooled(literal.getValueNode()));
+                ++totals.literals;
+            }
+            return nullptr;
+        }
+
+        case AstType::VariableReference: {
+            auto it = constants.find(static_cast<VariableReference&>(node).getName());
+            if (it == constants.end()) return nullptr;
+            ++totals.propagated;
+            return makeLiteral(it->second, node);
+        }
+
+        case AstType::BinaryOperation: {
+            auto& binary = static_cast<BinaryOperation&>(node);
+            // The left side of a compound assignment names the variable it updates.
+            if (isCompoundAssignOp(binary.op)) {
+                rewrite(binary.right, constants);
+                return nullptr;
+            }
+            rewrite(binary.left, constants);
+            rewrite(binary.right, constants);
+
+            const LiteralValue* lhs = asLiteral(binary.left.get());
+            if (!lhs) return nullptr;
+            const LiteralValue* rhs = asLiteral(binary.right.get());
+
+            if (binary.op == BinaryOp::And || binary.op == BinaryOp::Or) {
+                // A deciding left side short-circuits here just as it does at run time.
+                const bool decided = binary.op == BinaryOp::Or;
+                if (lhs->getValueNode().isTruthy() == decided) {
+                    ++totals.folded;
+                    return makeLiteral(Node(decided), node);
+                }
+                if (!rhs) return nullptr;
+                ++totals.folded;
+                return makeLiteral(Node(rhs->getValueNode().isTruthy()), node);
+            }
+
+            if (!rhs) return nullptr;
+            const Node& a = lhs->getValueNode();
+            const Node& b = rhs->getValueNode();
+            if (!foldableKinds(kindOf(a), kindOf(b))) return nullptr;
+
+            Node result;
+            try {
+                if (!NodeKernels::apply(binary.op, a, b, result)) return nullptr;
+            } catch (const MerkError&) {
+                return nullptr;  // division by zero and the like still raise when the line runs
+            }
+            ++totals.folded;
+            return makeLiteral(std::move(result), node);
+        }
+
+        case AstType::UnaryOperation: {
+            auto& unary = static_cast<UnaryOperation&>(node);
+            rewrite(unary.operand, constants);
+            const LiteralValue* operand = asLiteral(unary.operand.get());
+            if (!operand || unary.op == UnaryOp::Unknown || kindOf(operand->getValueNode()) == Kind::Other) {
+                return nullptr;
+            }
+            Node result;
+            try {
+                result = Evaluator::evaluateUnaryOperation(unary.op, operand->getValueNode());
+            } catch (const MerkError&) {
+                return nullptr;
+            }
+            ++totals.folded;
+            return makeLiteral(std::move(result), node);
+        }
+
+        case AstType::Arguments:
+            // Keyword names are left alone; only the values are expressions.
+            for (Argument& argument : static_cast<Arguments&>(node).arguments) {
+                rewrite(argument.value, constants);
+            }
+            return nullptr;
+
+        case AstType::CallableCall:
+        case AstType::FunctionCall:
+        case AstType::ClassCall: {
+            auto& call = static_cast<CallableCall&>(node);
+            if (call.arguments) { fold(*call.arguments, constants); }
+            return nullptr;
+        }
+
+        default:
+            // Chains and the rest resolve names against instances and class scopes; left as parsed.
+            return nullptr;
+    }
+}
+
+UniquePtr<ASTStatement> AstOptimizer::makeLiteral(Node value, const BaseAST& replaced) {
+    ++totals.literals;
+    return makeUnique<LiteralValue>(LitNode(pooled(value)), replaced.getScope());
+}
+
+Node AstOptimizer::pooled(const Node& value) {
+    auto [it, inserted] = pool.try_emplace(poolKey(value), value);
+    if (inserted) { it->second.freeze(); }
+    return it->second;
+}
+
+bool AstOptimizer::canDrop(const BaseAST& node, bool parallelBody) const {
+    for (const BaseAST* inner : node.getAllAst(true)) {
+        const AstType type = inner->getAstType();
+        if (type == AstType::Yield) return false;
+        if (parallelBody && (type == AstType::Break || type == AstType::Return)) return false;
+    }
+    return true;
+}
+
+std::optional<bool> AstOptimizer::literalTruth(const ASTStatement* condition) {
+    const LiteralValue* literal = asLiteral(condition);
+    if (!literal) return std::nullopt;
+    return literal->getValueNode().isTruthy();
+}
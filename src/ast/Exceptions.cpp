@@ -3,6 +3,7 @@
 #include "ast/AstBase.hpp"
 #include "ast/Ast.hpp"
 #include "ast/Exceptions.hpp"
+#include "core/evaluators/Generator.hpp"
 #include "utilities/debugging_functions.h"
 #include "utilities/debugger.h"
 #include "utilities/helper_functions.h"
@@ -69,6 +70,40 @@ EvalResult Return::evaluateFlow(SharedPtr<Scope> scope, SharedPtr<ClassInstanceN
 }
 
 
+Yield::Yield(SharedPtr<Scope> scope, UniquePtr<ASTStatement> value)
+: ASTStatement(scope), yieldValue(std::move(value)) {}
+
+Node Yield::evaluate(SharedPtr<Scope> scope, SharedPtr<ClassInstanceNode> instanceNode) const {
+    DEBUG_FLOW(FlowLevel::PERMISSIVE);
+    if (!yieldValue) { throw MerkError("Yield statement must have a value."); }
+    GeneratorState* generator = GeneratorState::active();
+    if (!generator) { throw MerkError("'yield' used outside of a generator function"); }
+
+    Node value = yieldValue->evaluate(scope, instanceNode);
+    // Scalars are updated in place by later assignments in the frame, so the
+    // consumer gets its own copy.
+    switch (value.getType()) {
+        case NodeValueType::Int:
+        case NodeValueType::Float:
+        case NodeValueType::Double:
+        case NodeValueType::Long:
+        case NodeValueType::Bool:
+            value = value.clone();
+            break;
+        default:
+            break;
+    }
+
+    generator->yieldValue(std::move(value));
+    DEBUG_FLOW_EXIT();
+    return Node();
+}
+
+EvalResult Yield::evaluateFlow(SharedPtr<Scope> scope, SharedPtr<ClassInstanceNode> instance) const {
+    return EvalResult::Normal(evaluate(scope, instance));
+}
+
+
 
 
 Break::Break(SharedPtr<Scope> scope) : ASTStatement(scope) {}
@@ -85,10 +85,15 @@ UniquePtr<BaseAST> Return::clone() const {
     return makeUnique<Return>(getScope(), std::move(clonedReturn));
 } 
 
+UniquePtr<BaseAST> Yield::clone() const {
+    auto clonedValue = static_unique_ptr_cast<ASTStatement>(yieldValue->clone());
+    return makeUnique<Yield>(getScope(), std::move(clonedValue));
+}
+
 UniquePtr<BaseAST> ConditionalBlock::clone() const {
     UniquePtr<BaseAST> clonedCondBase = condition->clone();
-    auto clonedCond = static_unique_ptr_cast<ConditionalBlock>(std::move(clonedCondBase));
-    return clonedCond;
+    auto clonedCond = static_unique_ptr_cast<ASTStatement>(std::move(clonedCondBase));
+    return ConditionalBlock::create(std::move(clonedCond), getScope());
 }
 
 UniquePtr<BaseAST> ElseStatement::clone() const {
@@ -147,12 +152,18 @@ UniquePtr<BaseAST> WhileLoop::clone() const {
 }
 
 UniquePtr<BaseAST> ForLoop::clone() const {
+    if (iterableExpr) {
+        auto clonedIterable = static_unique_ptr_cast<ASTStatement>(iterableExpr->clone());
+        auto clonedBody = dynamic_unique_ptr_cast<CodeBlock>(body->clone());
+        return makeUnique<ForLoop>(loopVariable, std::move(clonedIterable), std::move(clonedBody), getScope());
+    }
+
     auto clonedStart = static_unique_ptr_cast<ASTStatement>(startExpr->clone());
     auto clonedEnd = static_unique_ptr_cast<ASTStatement>(endExpr->clone());
     auto clonedStep = static_unique_ptr_cast<ASTStatement>(stepExpr->clone());
     auto clonedBody = dynamic_unique_ptr_cast<CodeBlock>(body->clone());
 
-    return makeUnique<ForLoop>(
+    auto cloned = makeUnique<ForLoop>(
         loopVariable,
         std::move(clonedStart),
         std::move(clonedEnd),
@@ -160,6 +171,10 @@ UniquePtr<BaseAST> ForLoop::clone() const {
         std::move(clonedBody),
         getScope()
     );
+    if (parallel) {
+        cloned->makeParallel(reductions);
+    }
+    return cloned;
 }
 
 
@@ -224,7 +239,9 @@ UniquePtr<BaseAST> ClassDef::clone() const {
     if (!getScope()) { throw MerkError("ClassDef::clone: no scope"); }
     UniquePtr<BaseAST> clonedBodyBase = body->clone();
     auto clonedBody = static_unique_ptr_cast<ClassBody>(std::move(clonedBodyBase));
-    return makeUnique<ClassDef>(name, parameters.clone(), std::move(clonedBody), getClassAccessor(), getScope()->clone());
+    auto classDef = makeUnique<ClassDef>(name, parameters.clone(), std::move(clonedBody), getClassAccessor(), getScope()->clone());
+    classDef->captures = captures;
+    return classDef;
 }
 
 UniquePtr<BaseAST> ClassBody::clone() const {
@@ -277,6 +294,22 @@ UniquePtr<BaseAST> MethodDef::clone() const {
     methodDef->setNonStaticElements(nonStaticElements);
 
     methodDef->setMethodAccessor(access);
+    methodDef->captures = captures;
+
+    DEBUG_FLOW_EXIT();
+    return methodDef;
+}
+
+UniquePtr<MethodDef> MethodDef::cloneInto(SharedPtr<Scope> scope) const {
+    DEBUG_FLOW(FlowLevel::VERY_HIGH);
+    if (!scope) {throw MerkError("MethodDef::cloneInto -> No scope");}
+    auto clonedBody = static_unique_ptr_cast<MethodBody>(body->clone());
+    clonedBody->setScope(scope);
+
+    auto methodDef = makeUnique<MethodDef>(name, parameters.clone(), std::move(clonedBody), InvocableType, scope);
+    String access = getMethodAccessor();
+    methodDef->setMethodAccessor(access);
+    methodDef->captures = captures;
 
     DEBUG_FLOW_EXIT();
     return methodDef;
@@ -317,6 +350,7 @@ UniquePtr<BaseAST> CallableDef::clone() const {
     
 
     UniquePtr<CallableDef> calDef = std::make_unique<CallableDef>(name, clonedParams, std::move(clonedBodyBase), callType, getScope());
+    calDef->captures = captures;
 
     return calDef;
 }
@@ -14,9 +14,9 @@
 FreeVars CodeBlock::collectFreeVariables() const {
     DEBUG_FLOW();
     if (isFreeVarsCacheValid()) {
-        return freeVars;
+        return cachedFreeVars();
     }
-    freeVars.clear();
+    FreeVars found;
     FreeVars localDecls;
 
     // First pass: gather declared variables
@@ -33,14 +33,13 @@ FreeVars CodeBlock::collectFreeVariables() const {
 
         for (const auto& var : childFree) {
             if (localDecls.find(var) == localDecls.end()) {
-                freeVars.insert(var);
+                found.insert(var);
             }
         }
     }
     localDecls.clear();
-    markFreeVarsClean();
     DEBUG_FLOW_EXIT();
-    return freeVars;
+    return publishFreeVars(std::move(found));
 }
 
 
@@ -53,84 +52,80 @@ FreeVars VariableReference::collectFreeVariables() const {
 
 FreeVars VariableDeclaration::collectFreeVariables() const {
     DEBUG_FLOW();
-    freeVars.clear();
+    FreeVars found;
 
     auto* expression = getRawExpression();
     if (expression){
-        freeVars.merge(expression->collectFreeVariables());
+        found.merge(expression->collectFreeVariables());
     }
 
     DEBUG_FLOW_EXIT();
-    return freeVars;
+    return found;
 }
 
 
 FreeVars VariableAssignment::collectFreeVariables() const {
     DEBUG_FLOW();
-    freeVars.clear();
+    FreeVars found;
 
     auto expr = getRawExpression(); 
     if (expr) {
-        freeVars.merge(expr->collectFreeVariables());
+        found.merge(expr->collectFreeVariables());
     }
 
     DEBUG_FLOW_EXIT();
-    return freeVars;
+    return found;
 }
 
 FreeVars ElseStatement::collectFreeVariables() const {
     DEBUG_FLOW();
     if (isFreeVarsCacheValid()) {
-        return freeVars;
+        return cachedFreeVars();
     }
-    freeVars.clear();
-    freeVars.merge(getBody()->collectFreeVariables());
+    FreeVars found;
+    found.merge(getBody()->collectFreeVariables());
 
-    markFreeVarsClean();
     DEBUG_FLOW_EXIT();
-    return freeVars;
+    return publishFreeVars(std::move(found));
 
 }
 
 FreeVars ElifStatement::collectFreeVariables() const {
     DEBUG_FLOW();
     if (isFreeVarsCacheValid()) {
-        return freeVars;
+        return cachedFreeVars();
     }
-    freeVars.clear();
-    freeVars.merge(getBody()->collectFreeVariables());
+    FreeVars found;
+    found.merge(getBody()->collectFreeVariables());
 
-    markFreeVarsClean();
     DEBUG_FLOW_EXIT();
-    return freeVars;
+    return publishFreeVars(std::move(found));
 
 }
 
 FreeVars IfStatement::collectFreeVariables() const {
     DEBUG_FLOW();
     if (isFreeVarsCacheValid()) {
-        return freeVars;
+        return cachedFreeVars();
     }
-    freeVars.clear();
-    localAssign.clear();
+    FreeVars found;
   
         
     for (const auto& nestedFree : getBody()->collectFreeVariables()){
-        freeVars.insert(nestedFree);
+        found.insert(nestedFree);
     }
 
 
     for (auto& elif : getElifs()) {
-        freeVars.merge(elif->collectFreeVariables());
+        found.merge(elif->collectFreeVariables());
     }
 
     if (getElse()){
-        freeVars.merge(getElse()->collectFreeVariables());
+        found.merge(getElse()->collectFreeVariables());
     }
 
-    markFreeVarsClean();
     DEBUG_FLOW_EXIT();
-    return freeVars;
+    return publishFreeVars(std::move(found));
 }
 
 
@@ -138,95 +133,107 @@ FreeVars IfStatement::collectFreeVariables() const {
 
 FreeVars Throw::collectFreeVariables() const {
     DEBUG_FLOW();
-    freeVars.clear();
+    FreeVars found;
 
     if (getValue()){
-        freeVars.merge(getValue()->collectFreeVariables());
+        found.merge(getValue()->collectFreeVariables());
     }
 
     DEBUG_FLOW_EXIT();
-    return freeVars;
+    return found;
 }
 
 
 
 FreeVars Return::collectFreeVariables() const {
     DEBUG_FLOW();
-    freeVars.clear();
+    FreeVars found;
 
     if (getValue()){
-        freeVars.merge(getValue()->collectFreeVariables());
+        found.merge(getValue()->collectFreeVariables());
     }
 
     DEBUG_FLOW_EXIT();
-    return freeVars;
+    return found;
+}
+
+FreeVars Yield::collectFreeVariables() const {
+    DEBUG_FLOW();
+    FreeVars found;
+
+    if (getValue()){
+        found.merge(getValue()->collectFreeVariables());
+    }
+
+    DEBUG_FLOW_EXIT();
+    return found;
 }
 
 
 FreeVars WhileLoop::collectFreeVariables() const {
     DEBUG_FLOW();
     if (isFreeVarsCacheValid()) {
-        return freeVars;
+        return cachedFreeVars();
     }
-    freeVars.clear();
+    FreeVars found;
 
     if (condition) {
-        freeVars.merge(condition->collectFreeVariables());
+        found.merge(condition->collectFreeVariables());
     }
 
     if (body) {
-        freeVars.merge(body->collectFreeVariables());
+        found.merge(body->collectFreeVariables());
     }
-    markFreeVarsClean();
     DEBUG_FLOW_EXIT();
-    return freeVars;
+    return publishFreeVars(std::move(found));
 }
 
 FreeVars ForLoop::collectFreeVariables() const {
     if (isFreeVarsCacheValid()) {
-        return freeVars;
+        return cachedFreeVars();
     }
 
-    freeVars.clear();
+    FreeVars found;
     if (startExpr) {
-        freeVars.merge(startExpr->collectFreeVariables());
+        found.merge(startExpr->collectFreeVariables());
     }
     if (endExpr) {
-        freeVars.merge(endExpr->collectFreeVariables());
+        found.merge(endExpr->collectFreeVariables());
     }
     if (stepExpr) {
-        freeVars.merge(stepExpr->collectFreeVariables());
+        found.merge(stepExpr->collectFreeVariables());
+    }
+    if (iterableExpr) {
+        found.merge(iterableExpr->collectFreeVariables());
     }
     if (body) {
-        freeVars.merge(body->collectFreeVariables());
+        found.merge(body->collectFreeVariables());
     }
 
     // Loop variable is assigned by this node, so it is not a free variable.
-    freeVars.erase(loopVariable);
-    markFreeVarsClean();
-    return freeVars;
+    found.erase(loopVariable);
+    return publishFreeVars(std::move(found));
 }
 
 
 FreeVars BinaryOperation::collectFreeVariables() const {
     DEBUG_FLOW();
     if (isFreeVarsCacheValid()) {
-        return freeVars;
+        return cachedFreeVars();
     }
-    freeVars.clear();
+    FreeVars found;
 
     auto left = getLeftSide();
     if (left){
-        freeVars.merge(left->collectFreeVariables());
+        found.merge(left->collectFreeVariables());
     }
     
     if (right){
-        freeVars.merge(right->collectFreeVariables());
+        found.merge(right->collectFreeVariables());
     }
 
-    markFreeVarsClean();
     DEBUG_FLOW_EXIT();
-    return freeVars;
+    return publishFreeVars(std::move(found));
 }
 
 
@@ -242,24 +249,21 @@ FreeVars Argument::collectFreeVariables() const {
 
 FreeVars Arguments::collectFreeVariables() const {
     if (isFreeVarsCacheValid()) {
-        return freeVars;
+        return cachedFreeVars();
     }
-    freeVars.clear();
-    FreeVars freeVars;
+    FreeVars found;
     for (auto& arg : arguments) {
-        freeVars.merge(arg.collectFreeVariables());
+        found.merge(arg.collectFreeVariables());
     }
-    this->freeVars = std::move(freeVars);
-    markFreeVarsClean();
-    return this->freeVars;
+    return publishFreeVars(std::move(found));
 }
 
 FreeVars CallableDef::collectFreeVariables() const {
     DEBUG_FLOW();
     if (isFreeVarsCacheValid()) {
-        return freeVars;
+        return cachedFreeVars();
     }
-    freeVars.clear();
+    FreeVars found;
 
     std::unordered_set<String> paramNames;
     for (const auto& param : parameters) {
@@ -269,42 +273,39 @@ FreeVars CallableDef::collectFreeVariables() const {
     FreeVars nestedFree = body->collectFreeVariables();
     for (const auto& var : nestedFree) {
         if (paramNames.find(var) == paramNames.end()) {
-            freeVars.insert(var);
+            found.insert(var);
         }
     }
 
-    markFreeVarsClean();
     DEBUG_FLOW_EXIT();
-    return freeVars;
+    return publishFreeVars(std::move(found));
 }
 
 FreeVars CallableCall::collectFreeVariables() const {
     DEBUG_FLOW();
     if (isFreeVarsCacheValid()) {
-        return freeVars;
+        return cachedFreeVars();
     }
-    freeVars.clear();
-    freeVars.merge(arguments->collectFreeVariables());
+    FreeVars found;
+    found.merge(arguments->collectFreeVariables());
 
-    markFreeVarsClean();
     DEBUG_FLOW_EXIT();
-    return freeVars;
+    return publishFreeVars(std::move(found));
 }
 
 FreeVars Chain::collectFreeVariables() const {
     DEBUG_FLOW();
     if (isFreeVarsCacheValid()) {
-        return freeVars;
+        return cachedFreeVars();
     }
-    freeVars.clear();
+    FreeVars found;
 
     if (!elements.empty()) {
         auto& element = getElements()[0];
-        freeVars.merge(element.object->collectFreeVariables());
+        found.merge(element.object->collectFreeVariables());
     }
 
-    markFreeVarsClean();
     DEBUG_FLOW_EXIT();
-    return freeVars;
+    return publishFreeVars(std::move(found));
 }
 
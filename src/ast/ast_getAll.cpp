@@ -186,6 +186,11 @@ Vector<const BaseAST*> ForLoop::getAllAst(bool includeSelf) const {
         mergeVectors(all, stepNodes);
     }
 
+    if (iterableExpr) {
+        auto iterableNodes = iterableExpr->getAllAst(includeSelf);
+        mergeVectors(all, iterableNodes);
+    }
+
     if (body) {
         auto bodyNodes = body->getAllAst(includeSelf);
         mergeVectors(all, bodyNodes);
@@ -244,6 +249,18 @@ Vector<const BaseAST*> Return::getAllAst(bool includeSelf) const {
     return all; 
 }
 
+Vector<const BaseAST*> Yield::getAllAst(bool includeSelf) const {
+    Vector<const BaseAST*> all = {};
+    if (includeSelf){
+        all.push_back(this);
+    }
+    if (yieldValue){
+        mergeVectors(all, yieldValue->getAllAst(includeSelf));
+    }
+
+    return all;
+}
+
 
 Vector<const BaseAST*> Throw::getAllAst(bool includeSelf) const {
     Vector<const BaseAST*> all = {};
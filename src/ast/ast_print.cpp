@@ -43,7 +43,7 @@ String VariableAssignment::toString() const {
 }
 
 String BinaryOperation::toString() const {
-    return getAstTypeAsString() + "(operator=" + op +
+    return getAstTypeAsString() + "(operator=" + binaryOpToString(op) +
         ", left=" + (left ? left->toString() : "null") +
         ", right=" + (right ? right->toString() : "null") +
         scopeLevelAsString(getScope(), getAstTypeAsString()) + ")";
@@ -51,7 +51,7 @@ String BinaryOperation::toString() const {
 }
 
 String UnaryOperation::toString() const {
-    return "UnaryOperation(" + op +
+    return "UnaryOperation(" + unaryOpToString(op) +
     scopeLevelAsString(getScope(), getAstTypeAsString()) + ")";
 }
 
@@ -100,7 +100,7 @@ void BinaryOperation::printAST(std::ostream& os, int indent) const {
     DEBUG_FLOW(FlowLevel::VERY_LOW);
 
     printIndent(os, indent);
-    debugLog(true, highlight(getAstTypeAsString(), Colors::bold_blue), "(operator =", op, scopeLevelAsString(getScope(), getAstTypeAsString()), ")");
+    debugLog(true, highlight(getAstTypeAsString(), Colors::bold_blue), "(operator =", binaryOpToString(op), scopeLevelAsString(getScope(), getAstTypeAsString()), ")");
     if (left) {
         left->printAST(os, indent + 2);
     }
@@ -114,7 +114,7 @@ void UnaryOperation::printAST(std::ostream& os, int indent) const {
     DEBUG_FLOW(FlowLevel::VERY_LOW);
 
     indent = printIndent(os, indent);
-    debugLog(true, highlight(getAstTypeAsString(), Colors::bold_blue), "(operator =", op, scopeLevelAsString(getScope(), getAstTypeAsString()) + ")");
+    debugLog(true, highlight(getAstTypeAsString(), Colors::bold_blue), "(operator =", unaryOpToString(op), scopeLevelAsString(getScope(), getAstTypeAsString()) + ")");
     operand->printAST(os, indent);
 
     DEBUG_FLOW_EXIT();
@@ -152,6 +152,19 @@ void Return::printAST(std::ostream& os, int indent) const  {
     DEBUG_FLOW_EXIT();
 }
 
+String Yield::toString() const {
+    return getAstTypeAsString()+"(value=" + (yieldValue ? yieldValue->toString() : "None") + ")";
+}
+
+void Yield::printAST(std::ostream& os, int indent) const  {
+    indent = printIndent(os, indent);
+
+    debugLog(true, highlight(getAstTypeAsString(), Colors::bold_red));
+    if (yieldValue) {
+        yieldValue->printAST(os, indent);
+    }
+}
+
 
 // AST CONTROL
 String CodeBlock::toString() const {
@@ -166,7 +179,12 @@ String WhileLoop::toString() const {
 }
 
 String ForLoop::toString() const {
-    return "ForLoop(var=" + loopVariable +
+    if (iterableExpr) {
+        return "ForLoop(var=" + loopVariable +
+               ", in=" + iterableExpr->toString() +
+               ", body=" + (body ? body->toString() : "null") + ")";
+    }
+    return String(parallel ? "ParallelFor" : "ForLoop") + "(var=" + loopVariable +
            ", start=" + (startExpr ? startExpr->toString() : "null") +
            ", end=" + (endExpr ? endExpr->toString() : "null") +
            ", step=" + (stepExpr ? stepExpr->toString() : "null") +
@@ -276,7 +294,11 @@ void WhileLoop::printAST(std::ostream& os, int indent) const {
 void ForLoop::printAST(std::ostream& os, int indent) const {
     DEBUG_FLOW(FlowLevel::VERY_LOW);
     indent = printIndent(os, indent);
-    debugLog(true, getAstTypeAsString(), "(var=", loopVariable, ")");
+    debugLog(true, getAstTypeAsString(), "(var=", loopVariable, parallel ? ", parallel" : "", ")");
+    for (const auto& reduction : reductions) {
+        printIndent(os, indent + 1);
+        debugLog(true, "reduce:", reduction.variable, "->", reduction.op, "identity:", reduction.identity);
+    }
 
     if (startExpr) {
         indent = printIndent(os, indent);
@@ -296,6 +318,12 @@ void ForLoop::printAST(std::ostream& os, int indent) const {
         stepExpr->printAST(os, indent);
     }
 
+    if (iterableExpr) {
+        indent = printIndent(os, indent);
+        debugLog(true, "in:");
+        iterableExpr->printAST(os, indent);
+    }
+
     if (body) {
         indent = printIndent(os, indent);
         debugLog(true, "body:");
@@ -0,0 +1,95 @@
+#include "core/Environments/Isolate.hpp"
+#include "utilities/debugger.h"
+#include "core/errors.h"
+#include "core/callables/classes/ClassBase.hpp"
+#include "core/node/NodeStructures.hpp"
+#include "core/evaluators/EventLoop.hpp"
+
+namespace {
+
+thread_local Isolate* boundIsolate = nullptr;
+
+Node deepCopy(const Node& value);
+
+// clone() on a container copies its element handles; the elements need copies of their own.
+void deepCopyElements(const SharedPtr<NativeNode>& data) {
+    if (auto list = std::dynamic_pointer_cast<ListNode>(data)) {
+        for (auto& element : list->getMutableElements()) { element = deepCopy(element); }
+    } else if (auto dict = std::dynamic_pointer_cast<DictNode>(data)) {
+        std::unordered_map<Node, Node> copied;
+        for (const auto& [key, item] : dict->getElements()) { copied.emplace(deepCopy(key), deepCopy(item)); }
+        dict->getMutableElements() = std::move(copied);
+    } else if (auto set = std::dynamic_pointer_cast<SetNode>(data)) {
+        std::unordered_set<Node> copied;
+        for (const auto& element : set->getElements()) { copied.insert(deepCopy(element)); }
+        set->getMutableElements() = std::move(copied);
+    }
+}
+
+Node deepCopy(const Node& value) {
+    if (!Isolate::isTransferable(value)) {
+        throw MerkError("Cannot transfer a " + value.getTypeAsString() + " value between isolates");
+    }
+    if (value.isInstance()) {
+        ClassInstanceNode instance(value.toInstance()->cloneInstance());
+        instance.getFlags() = value.getFlags();
+        deepCopyElements(instance.getInstance()->getNativeData());
+        return instance;
+    }
+    // String copies share an append-only buffer; give this one its own.
+    Node copy = value.isString() ? Node(value.toString()) : value.clone();
+    copy.getFlags() = value.getFlags();
+    return copy;
+}
+
+} // namespace
+
+
+Isolate::Isolate() : debug(new Debugger()) {}
+
+Isolate::~Isolate() {
+    // Frames still parked on the loop hold nodes whose teardown reads this isolate's stats.
+    loop.reset();
+}
+
+Isolate& Isolate::current() {
+    if (boundIsolate) {
+        return *boundIsolate;
+    }
+    thread_local Isolate threadDefault;
+    return threadDefault;
+}
+
+EventLoop& Isolate::eventLoop() {
+    if (!loop) loop = makeUnique<EventLoop>();
+    return *loop;
+}
+
+Isolate::Enter::Enter(Isolate& isolate) : previous(boundIsolate) {
+    boundIsolate = &isolate;
+}
+
+Isolate::Enter::~Enter() {
+    boundIsolate = previous;
+}
+
+bool Isolate::isTransferable(const Node& value) {
+    if (value.isFunctionNode() || value.getType() == NodeValueType::Generator) return false;
+    if (value.isInstance()) return value.toInstance()->getNativeData() != nullptr;
+    return true;
+}
+
+Node Isolate::transfer(const Node& value) {
+    Node copy = deepCopy(value);
+    // Sender and receiver may both hold handles to the copy for a while; count them atomically.
+    copy.freeze();
+    return copy;
+}
+
+ScopeStats& Scope::stats() {
+    return Isolate::current().scopeStats();
+}
+
+StackScopeStats& StackScope::stats() {
+    return Isolate::current().stackScopeStats();
+}
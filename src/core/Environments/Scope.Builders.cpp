@@ -32,8 +32,8 @@ Scope::Scope(int scopeNum, bool interpretMode, bool isRootBool)
         initRootTypes();
     }
 
-    ++liveScopeCount;
-    ++totalScopeCreated;
+    ++stats().liveScopeCount;
+    ++stats().totalScopeCreated;
 }
 
 Scope::Scope(WeakPtr<Scope> parentScope, bool interpretMode)
@@ -61,8 +61,8 @@ Scope::Scope(WeakPtr<Scope> parentScope, bool interpretMode)
         initRootTypes();
     }
 
-    ++liveScopeCount;
-    ++totalScopeCreated;
+    ++stats().liveScopeCount;
+    ++stats().totalScopeCreated;
 }
 
 // Root scope with pre-existing registries (for clone)
@@ -78,8 +78,8 @@ Scope::Scope(SharedPtr<FunctionRegistry> globalF, SharedPtr<ClassRegistry> globa
     if (!globalTypes) throw MerkError("Scope root-with-registries ctor: globalTypes is null");
     if (!this->globalTypeSigs) throw MerkError("Scope root-with-registries ctor: globalTypeSigs is null");
     initRootTypes();
-    ++liveScopeCount;
-    ++totalScopeCreated;
+    ++stats().liveScopeCount;
+    ++stats().totalScopeCreated;
 }
 
 SharedPtr<Scope> Scope::createChildScope() {
@@ -94,7 +94,7 @@ SharedPtr<Scope> Scope::createChildScope() {
         c->owner = makeDeterministicChildBlockOwner(*this, childOrdinal);
     }
     childScopes.push_back(c);
-    Scope::counts.blocks += 1;
+    stats().counts.blocks += 1;
     return c;
   }
 
@@ -119,8 +119,8 @@ Scope::Scope(SharedPtr<Scope> parent, SharedPtr<FunctionRegistry> globalF, Share
 
     localTypes.attach(*globalTypeSigs);
 
-    ++liveScopeCount;
-    ++totalScopeCreated;
+    ++stats().liveScopeCount;
+    ++stats().totalScopeCreated;
 
 }
 
@@ -134,7 +134,7 @@ Scope::~Scope() {
     } else {
     
         clear();
-        --liveScopeCount;
+        --stats().liveScopeCount;
     }
 
 
@@ -226,7 +226,7 @@ SharedPtr<Scope> Scope::makeCallScope() {
 
 
 // creates a copy of the scope
-SharedPtr<Scope> Scope::detachScope(const std::unordered_set<String>& freeVarNames) {
+SharedPtr<Scope> Scope::detachScope(std::span<const String> freeVarNames) {
     DEBUG_FLOW(FlowLevel::MED);
 
     auto detached = makeShared<Scope>(shared_from_this(), globalFunctions, globalClasses, globalTypes, interpretMode);
@@ -253,7 +253,7 @@ SharedPtr<Scope> Scope::detachScope(const std::unordered_set<String>& freeVarNam
 }
 
 // creates a standalone scope with only freevariables and local functions/classes
-SharedPtr<Scope> Scope::isolateScope(const std::unordered_set<String>& freeVarNames) {
+SharedPtr<Scope> Scope::isolateScope(std::span<const String> freeVarNames) {
     DEBUG_FLOW(FlowLevel::NONE);
     auto isolated = makeShared<Scope>(0, interpretMode, false);
     isolated->globalTypes    = globalTypes;
@@ -291,7 +291,7 @@ SharedPtr<Scope> Scope::buildFunctionCallScope(SharedPtr<Function> func, String
     callScope->owner = generateScopeOwner("FuncCall", name);
     this->appendChildScope(callScope, false);                       // appending for recursion
     callScope->kind = ScopeKind::FunctionCall;
-    Scope::counts.functionCalls += 1;
+    stats().counts.functionCalls += 1;
     return callScope;
 }
 
@@ -308,7 +308,7 @@ SharedPtr<Scope> Scope::buildMethodCallScope(SharedPtr<Method> method, String na
     callScope->owner = generateScopeOwner("MethodCall", name);
     this->appendChildScope(callScope, false);                       // appending for recursion
     callScope->kind = ScopeKind::MethodCall;
-    Scope::counts.methodCalls += 1;
+    stats().counts.methodCalls += 1;
     return callScope;
 }
 
@@ -366,9 +366,9 @@ SharedPtr<Scope> Scope::buildInstanceScope(SharedPtr<ClassBase> classTemplate, S
 #if MERK_SCOPE_DIAGNOSTICS
     const size_t classChildrenAfter = classScope->getChildren().size();
     const size_t classDelta = (classChildrenAfter >= classChildrenBefore) ? (classChildrenAfter - classChildrenBefore) : 0;
-    classScopeAttachSamples.fetch_add(1, std::memory_order_relaxed);
+    stats().classScopeAttachSamples += 1;
     if (classDelta != 1) {
-        classScopeAttachUnexpectedDelta.fetch_add(1, std::memory_order_relaxed);
+        stats().classScopeAttachUnexpectedDelta += 1;
         DEBUG_LOG(
             LogLevel::WARNING,
             "[ScopeDiag] classScope attach delta != 1 | class=",
@@ -395,9 +395,9 @@ SharedPtr<Scope> Scope::buildInstanceScope(SharedPtr<ClassBase> classTemplate, S
 #if MERK_SCOPE_DIAGNOSTICS
     const size_t capturedChildrenAfter = capturedClone->getChildren().size();
     const size_t capturedDelta = (capturedChildrenAfter >= capturedChildrenBefore) ? (capturedChildrenAfter - capturedChildrenBefore) : 0;
-    capturedScopeAttachSamples.fetch_add(1, std::memory_order_relaxed);
+    stats().capturedScopeAttachSamples += 1;
     if (capturedDelta != 1) {
-        capturedScopeAttachUnexpectedDelta.fetch_add(1, std::memory_order_relaxed);
+        stats().capturedScopeAttachUnexpectedDelta += 1;
         DEBUG_LOG(
             LogLevel::WARNING,
             "[ScopeDiag] capturedScope attach delta != 1 | class=",
@@ -423,12 +423,12 @@ SharedPtr<Scope> Scope::buildInstanceScope(SharedPtr<ClassBase> classTemplate, S
         );
     }
     instanceScope->kind = ScopeKind::Instance;
-    Scope::counts.instanceCalls += 1;
+    stats().counts.instanceCalls += 1;
     return instanceScope;
 }
 
 // This one requires that the calling class pulls the parent in order to store the captured scope
-SharedPtr<Scope> Scope::buildClassScope(FreeVars freeVarNames, String className) {
+SharedPtr<Scope> Scope::buildClassScope(std::span<const String> freeVarNames, String className) {
 
     SharedPtr<Scope> classDefCapturedScope = this->detachScope(freeVarNames);
     SharedPtr<Scope> classScope = classDefCapturedScope->makeCallScope();
@@ -438,7 +438,7 @@ SharedPtr<Scope> Scope::buildClassScope(FreeVars freeVarNames, String className)
     classDefCapturedScope->owner = generateScopeOwner("ClassDef--InitialCaptured", className);
     classDefCapturedScope->appendChildScope(classScope);  // cls->getClassScope // place classScope inside of classDefCapturedScope
     classScope->kind = ScopeKind::Instance;
-    Scope::counts.classCalls += 1;
+    stats().counts.classCalls += 1;
     return classScope;
 }
 
@@ -460,14 +460,14 @@ void Scope::includeMetaData(SharedPtr<Scope> newScope, bool thisIsDetached) cons
 
 
 
-SharedPtr<Scope> Scope::buildFunctionDefScope(const FreeVars& freeVars, const String& funcName) {
+SharedPtr<Scope> Scope::buildFunctionDefScope(std::span<const String> freeVars, const String& funcName) {
     auto defScope = this->isolateScope(freeVars);
     defScope->owner = generateScopeOwner("FunctionDef", funcName);
     
     return defScope;
 }
 
-SharedPtr<Scope> Scope::buildClassDefScope(const FreeVars& freeVars, const String& className) {
+SharedPtr<Scope> Scope::buildClassDefScope(std::span<const String> freeVars, const String& className) {
     auto classCaptured = this->detachScope(freeVars);
     auto classScope = classCaptured->makeCallScope();
     classCaptured->owner = generateScopeOwner("ClassDefCaptured", className);
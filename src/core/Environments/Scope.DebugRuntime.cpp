@@ -92,13 +92,13 @@ void Scope::appendDiagnostics(ParentAppendAttempt attempt) {
         case ParentAppendAttempt::None:
             break;
         case ParentAppendAttempt::Parent:
-            parentAppendAttempts.fetch_add(1, std::memory_order_relaxed);
+            stats().parentAppendAttempts += 1;
             break;
         case ParentAppendAttempt::Ancestor:
-            ancestorAppendAttempts.fetch_add(1, std::memory_order_relaxed);
+            stats().ancestorAppendAttempts += 1;
             break;
         case ParentAppendAttempt::Reparent:
-            reparentAttempts.fetch_add(1, std::memory_order_relaxed);
+            stats().reparentAttempts += 1;
             break;
     }
 #else
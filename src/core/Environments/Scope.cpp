@@ -29,11 +29,11 @@
 
 
 ScopeCounts Scope::getCounts() {
-    return counts;
+    return stats().counts;
 }
 
 void Scope::refreshVariableLookupCache() const {
-    const uint64_t epoch = variableLookupEpoch.load(std::memory_order_relaxed);
+    const uint64_t epoch = stats().variableLookupEpoch;
     if (variableLookupCacheEpoch != epoch) {
         variableLookupCache.clear();
         variableLookupCacheEpoch = epoch;
@@ -41,7 +41,7 @@ void Scope::refreshVariableLookupCache() const {
 }
 
 void Scope::bumpVariableLookupEpoch() {
-    variableLookupEpoch.fetch_add(1, std::memory_order_relaxed);
+    stats().variableLookupEpoch += 1;
 }
 
 
@@ -162,7 +162,7 @@ bool Scope::isAncestorOf(const Scope* maybeDesc) const {
         }
         if (!visited.insert(p).second) {
 #if MERK_SCOPE_DIAGNOSTICS
-            ancestorParentChainCycleBailouts.fetch_add(1, std::memory_order_relaxed);
+            stats().ancestorParentChainCycleBailouts += 1;
             DEBUG_LOG(
                 LogLevel::WARNING,
                 "[ScopeDiag] isAncestorOf bailed due to parent-chain cycle | target=",
@@ -226,7 +226,7 @@ void Scope::appendChildScope(SharedPtr<Scope> childScope, bool update) {
 
     // Fast-path in normal runtime: only check immediate children.
     if (hasImmediateChild(childScope)) {
-        totalWith += 1;
+        stats().totalWith += 1;
         return;
     }
 
@@ -240,7 +240,7 @@ void Scope::appendChildScope(SharedPtr<Scope> childScope, bool update) {
             " | child=",
             childScope.get()
         );
-        totalWith += 1;
+        stats().totalWith += 1;
         return;
     }
 #endif
@@ -248,7 +248,7 @@ void Scope::appendChildScope(SharedPtr<Scope> childScope, bool update) {
     childScope->parentScope = shared_from_this();
     childScope->scopeLevel = getScopeLevel() + 1;
     childScopes.push_back(childScope);
-    totalWithout += 1;
+    stats().totalWithout += 1;
 
     childScope->isDetached = false;
     includeMetaData(childScope, false);
@@ -439,6 +439,20 @@ bool Scope::tryReadInt(const String& name, int& out) const {
     return false;
 }
 
+VarNode* Scope::resolveLoopSlot(const String& name) {
+    if (VarNode* var = context.findVariable(name)) {
+        if (var->getVarFlags().isConst) {
+            throw MerkError("Cannot assign to const variable '" + name + "'");
+        }
+        return var;
+    }
+    // Parents may be StackScopes with frame-owned cells; let them decide.
+    if (auto parent = getParent()) {
+        return parent->resolveLoopSlot(name);
+    }
+    return nullptr;
+}
+
 bool Scope::tryWriteInt(const String& name, int value) {
     for (Scope* s = this; s != nullptr; ) {
         if (VarNode* var = s->context.findVariable(name)) {
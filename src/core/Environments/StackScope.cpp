@@ -32,54 +32,54 @@ SharedPtr<Scope> StackScope::clone(bool strict) const {
 void StackScope::noteSlotKind(NodeValueType valueType) {
     switch (Frame::classify(valueType)) {
         case Frame::SlotKind::Int:
-            slotKindInt.fetch_add(1, std::memory_order_relaxed);
+            stats().slotKindInt += 1;
             break;
         case Frame::SlotKind::Double:
-            slotKindDouble.fetch_add(1, std::memory_order_relaxed);
+            stats().slotKindDouble += 1;
             break;
         case Frame::SlotKind::Bool:
-            slotKindBool.fetch_add(1, std::memory_order_relaxed);
+            stats().slotKindBool += 1;
             break;
         case Frame::SlotKind::Object:
-            slotKindObject.fetch_add(1, std::memory_order_relaxed);
+            stats().slotKindObject += 1;
             break;
         case Frame::SlotKind::Unknown:
         default:
-            slotKindUnknown.fetch_add(1, std::memory_order_relaxed);
+            stats().slotKindUnknown += 1;
             break;
     }
 }
 
 VarNode* StackScope::findLocalVar(const String& name) {
     if (VarNode* slot = frame.getSlot(name)) {
-        cacheHits.fetch_add(1, std::memory_order_relaxed);
+        stats().cacheHits += 1;
         return slot; 
     }
-    cacheMisses.fetch_add(1, std::memory_order_relaxed);
+    stats().cacheMisses += 1;
 
     VarNode* var = getContext().findVariable(name);
     if (var) {
-        localContextHits.fetch_add(1, std::memory_order_relaxed);
+        stats().localContextHits += 1;
         frame.bindSlot(name, var, var->getValueNode().getType());
     } else {
-        localContextMisses.fetch_add(1, std::memory_order_relaxed);
+        stats().localContextMisses += 1;
     }
     return var;
 }
 
 const VarNode* StackScope::findLocalVar(const String& name) const {
     if (const VarNode* slot = frame.getSlot(name)) {
-        cacheHits.fetch_add(1, std::memory_order_relaxed);
+        stats().cacheHits += 1;
         return slot;
     }
-    cacheMisses.fetch_add(1, std::memory_order_relaxed);
+    stats().cacheMisses += 1;
 
     const VarNode* var = getContext().findVariable(name);
     if (var) {
-        localContextHits.fetch_add(1, std::memory_order_relaxed);
+        stats().localContextHits += 1;
         frame.bindSlot(name, const_cast<VarNode*>(var), var->getValueNode().getType());
     } else {
-        localContextMisses.fetch_add(1, std::memory_order_relaxed);
+        stats().localContextMisses += 1;
     }
     return var;
 }
@@ -90,22 +90,12 @@ void StackScope::clear(bool internalCall) {
 }
 
 void StackScope::resetInstrumentation() {
-    cacheHits.store(0, std::memory_order_relaxed);
-    cacheMisses.store(0, std::memory_order_relaxed);
-    localContextHits.store(0, std::memory_order_relaxed);
-    localContextMisses.store(0, std::memory_order_relaxed);
-    parentFallbackLookups.store(0, std::memory_order_relaxed);
-    parentFallbackUpdates.store(0, std::memory_order_relaxed);
-    slotKindUnknown.store(0, std::memory_order_relaxed);
-    slotKindInt.store(0, std::memory_order_relaxed);
-    slotKindDouble.store(0, std::memory_order_relaxed);
-    slotKindBool.store(0, std::memory_order_relaxed);
-    slotKindObject.store(0, std::memory_order_relaxed);
+    stats() = StackScopeStats{};
 }
 
 void StackScope::printInstrumentation(std::ostream& os) {
-    const uint64_t hits = cacheHits.load(std::memory_order_relaxed);
-    const uint64_t misses = cacheMisses.load(std::memory_order_relaxed);
+    const uint64_t hits = stats().cacheHits;
+    const uint64_t misses = stats().cacheMisses;
     const uint64_t total = hits + misses;
     const double hitRate = (total > 0) ? (100.0 * static_cast<double>(hits) / static_cast<double>(total)) : 0.0;
 
@@ -113,15 +103,15 @@ void StackScope::printInstrumentation(std::ostream& os) {
     os << "  cacheHits: " << hits << '\n';
     os << "  cacheMisses: " << misses << '\n';
     os << "  cacheHitRate: " << hitRate << "%\n";
-    os << "  localContextHits: " << localContextHits.load(std::memory_order_relaxed) << '\n';
-    os << "  localContextMisses: " << localContextMisses.load(std::memory_order_relaxed) << '\n';
-    os << "  parentFallbackLookups: " << parentFallbackLookups.load(std::memory_order_relaxed) << '\n';
-    os << "  parentFallbackUpdates: " << parentFallbackUpdates.load(std::memory_order_relaxed) << '\n';
-    os << "  slotKindUnknown: " << slotKindUnknown.load(std::memory_order_relaxed) << '\n';
-    os << "  slotKindInt: " << slotKindInt.load(std::memory_order_relaxed) << '\n';
-    os << "  slotKindDouble: " << slotKindDouble.load(std::memory_order_relaxed) << '\n';
-    os << "  slotKindBool: " << slotKindBool.load(std::memory_order_relaxed) << '\n';
-    os << "  slotKindObject: " << slotKindObject.load(std::memory_order_relaxed) << '\n';
+    os << "  localContextHits: " << stats().localContextHits << '\n';
+    os << "  localContextMisses: " << stats().localContextMisses << '\n';
+    os << "  parentFallbackLookups: " << stats().parentFallbackLookups << '\n';
+    os << "  parentFallbackUpdates: " << stats().parentFallbackUpdates << '\n';
+    os << "  slotKindUnknown: " << stats().slotKindUnknown << '\n';
+    os << "  slotKindInt: " << stats().slotKindInt << '\n';
+    os << "  slotKindDouble: " << stats().slotKindDouble << '\n';
+    os << "  slotKindBool: " << stats().slotKindBool << '\n';
+    os << "  slotKindObject: " << stats().slotKindObject << '\n';
 }
 
 void StackScope::declareVariable(const String& name, UniquePtr<VarNode> value) {
@@ -226,7 +216,7 @@ void StackScope::updateVariable(const String& name, const Node& value) {
     }
 
     if (auto parent = getParent()) {
-        parentFallbackUpdates.fetch_add(1, std::memory_order_relaxed);
+        stats().parentFallbackUpdates += 1;
         parent->updateVariable(name, value);
         return;
     }
@@ -237,7 +227,7 @@ VarNode& StackScope::getVariable(const String& name) {
     if (VarNode* local = findLocalVar(name)) {
         return *local;
     }
-    parentFallbackLookups.fetch_add(1, std::memory_order_relaxed);
+    stats().parentFallbackLookups += 1;
 
     for (Scope* s = this; s != nullptr;) {
         if (VarNode* variable = s->getContext().findVariable(name)) {
@@ -254,7 +244,7 @@ bool StackScope::hasVariable(const String& name) const {
     if (findLocalVar(name)) {
         return true;
     }
-    parentFallbackLookups.fetch_add(1, std::memory_order_relaxed);
+    stats().parentFallbackLookups += 1;
 
     for (const Scope* s = this; s != nullptr;) {
         if (s->getContext().hasVariable(name)) {
@@ -363,10 +353,27 @@ bool StackScope::tryWriteInt(const String& name, int value) {
     }
 
     if (auto parent = getParent()) {
-        parentFallbackUpdates.fetch_add(1, std::memory_order_relaxed);
+        stats().parentFallbackUpdates += 1;
         return parent->tryWriteInt(name, value);
     }
 
     return false;
 }
 
+VarNode* StackScope::resolveLoopSlot(const String& name) {
+    if (frame.hasOwned(name)) {
+        return nullptr;
+    }
+
+    if (VarNode* var = findLocalVar(name)) {
+        if (var->getVarFlags().isConst) {
+            throw MerkError("Cannot assign to const variable '" + name + "'");
+        }
+        return var;
+    }
+
+    if (auto parent = getParent()) {
+        return parent->resolveLoopSlot(name);
+    }
+    return nullptr;
+}
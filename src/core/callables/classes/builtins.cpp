@@ -8,6 +8,12 @@
 #include "core/callables/classes/NativeClass.hpp"
 #include "core/node/NodeStructures.hpp"
 #include "core/evaluators/Evaluator.hpp"
+#include "core/evaluators/Parallel.hpp"
+#include "core/evaluators/Future.hpp"
+#include "core/evaluators/Channel.hpp"
+#include "core/Environments/Frame.hpp"
+#include "core/callables/functions/Function.hpp"
+#include <algorithm>
 
 
 void validateSelf(SharedPtr<ClassInstanceNode> self, String className, String methodName) {
@@ -136,6 +142,281 @@ static Node returnConstructedInstanceOf(SharedPtr<ClassInstanceNode> self, const
 }
 
 
+// A fresh instance of the same native class as `self`, holding `data`.
+static Node returnNewInstanceLike(SharedPtr<ClassInstanceNode> self, SharedPtr<NativeNode> data, const String& className) {
+    if (!self) { throw MerkError("returnNewInstanceLike: self is null"); }
+    auto source = self->getInstance();
+    auto instanceScope = source->getInstanceScope()->clone();
+    auto instance = makeShared<ClassInstance>(source->getName(), instanceScope->getParent(), instanceScope, source->parameters.clone(), source->getAccessor());
+    instance->setNativeData(data);
+    instance->isConstructed = true;
+    return returnConstructedInstanceOf(makeShared<ClassInstanceNode>(instance), className);
+}
+
+
+// ---- Bulk operations shared by List and Array ----
+// Callbacks that lower to a Parallel::IntKernel run natively, on the shared pool once the input is
+// large enough; any other callback is resolved once and called through the interpreter per element.
+namespace {
+
+constexpr bool kEnableParallelBulk = true;
+constexpr std::size_t kParallelBulkMinItems = 2048;
+
+using DataFactory = std::function<SharedPtr<NativeNode>(NodeList)>;
+
+bool runsInParallel(std::size_t count) {
+    return kEnableParallelBulk && count >= kParallelBulkMinItems;
+}
+
+bool allInts(const NodeList& items) {
+    return std::all_of(items.begin(), items.end(), [](const Node& item) { return item.isInt(); });
+}
+
+ArgumentList argsOf(std::initializer_list<Node> values) {
+    ArgumentList args;
+    for (const auto& value : values) { args.addPositionalArg(value); }
+    return args;
+}
+
+Node kernelResult(const Parallel::IntKernel& kernel, bool returned, int value) {
+    if (returned) return Node(value);
+    if (kernel.requiresReturn()) { throw MerkError("Function did not return a value."); }
+    return Node();
+}
+
+// Runs body(frame, begin, end) over [0, count), each worker on a frame of its own.
+void forEachSlice(std::size_t count, const std::function<void(Frame&, std::size_t, std::size_t)>& body) {
+    if (!runsInParallel(count)) {
+        Frame frame;
+        body(frame, 0, count);
+        return;
+    }
+    Vector<UniquePtr<Frame>> frames(Parallel::workerCount());
+    Parallel::forChunks(count, Parallel::chunkCount(count), [&](std::size_t, std::size_t begin, std::size_t end, std::size_t worker) {
+        if (!frames[worker]) { frames[worker] = makeUnique<Frame>(); }
+        body(*frames[worker], begin, end);
+    });
+}
+
+// fn(item) for every element, in order.
+NodeList applyEach(const NodeList& items, const Node& fn, SharedPtr<Scope> scope) {
+    NodeList out(items.size());
+    if (items.empty()) return out;
+
+    if (allInts(items)) {
+        if (auto kernel = Parallel::IntKernel::compile(fn, 1, scope)) {
+            forEachSlice(items.size(), [&](Frame& frame, std::size_t begin, std::size_t end) {
+                for (std::size_t i = begin; i < end; ++i) {
+                    const int arg = items[i].toInt();
+                    int value = 0;
+                    const bool returned = kernel->call(frame, &arg, value);
+                    out[i] = kernelResult(*kernel, returned, value);
+                }
+            });
+            return out;
+        }
+    }
+
+    auto func = Evaluator::resolveFunctionValue(fn, argsOf({items.front()}), scope);
+    for (std::size_t i = 0; i < items.size(); ++i) {
+        out[i] = Evaluator::callFunction(func, argsOf({items[i]}), scope);
+    }
+    return out;
+}
+
+// Whether fn(item) is truthy for any element (or, with `every`, for all of them).
+// The interpreted path stops at the first deciding element.
+bool testEach(const NodeList& items, const Node& fn, SharedPtr<Scope> scope, bool every) {
+    if (items.empty()) return every;
+
+    if (allInts(items) && runsInParallel(items.size())) {
+        if (Parallel::IntKernel::compile(fn, 1, scope)) {
+            const NodeList results = applyEach(items, fn, scope);
+            const auto truthy = [](const Node& r) { return r.isTruthy(); };
+            return every ? std::all_of(results.begin(), results.end(), truthy)
+                         : std::any_of(results.begin(), results.end(), truthy);
+        }
+    }
+
+    auto func = Evaluator::resolveFunctionValue(fn, argsOf({items.front()}), scope);
+    for (const auto& item : items) {
+        const bool truthy = Evaluator::callFunction(func, argsOf({item}), scope).isTruthy();
+        if (truthy != every) return truthy;
+    }
+    return every;
+}
+
+// Left fold of fn(acc, item). Large int inputs with a compiled reducer fold each chunk separately
+// and then fold the chunk results in order, so the reducer must be associative there.
+Node reduceEach(const NodeList& items, const Node& fn, const Node* initial, SharedPtr<Scope> scope) {
+    if (items.empty()) {
+        if (!initial) { throw MerkError("reduce of an empty sequence with no initial value"); }
+        return *initial;
+    }
+
+    if (allInts(items) && (!initial || initial->isInt()) && runsInParallel(items.size())) {
+        if (auto kernel = Parallel::IntKernel::compile(fn, 2, scope)) {
+            const std::size_t chunks = Parallel::chunkCount(items.size());
+            Vector<int> partials(chunks);
+            Vector<UniquePtr<Frame>> frames(Parallel::workerCount());
+            Parallel::forChunks(items.size(), chunks, [&](std::size_t k, std::size_t begin, std::size_t end, std::size_t worker) {
+                if (!frames[worker]) { frames[worker] = makeUnique<Frame>(); }
+                int args[2] = {items[begin].toInt(), 0};
+                for (std::size_t i = begin + 1; i < end; ++i) {
+                    args[1] = items[i].toInt();
+                    if (!kernel->call(*frames[worker], args, args[0])) { throw MerkError("reduce callback did not return a value"); }
+                }
+                partials[k] = args[0];
+            });
+
+            Frame frame;
+            int args[2] = {initial ? initial->toInt() : partials.front(), 0};
+            for (std::size_t k = initial ? 0 : 1; k < chunks; ++k) {
+                args[1] = partials[k];
+                if (!kernel->call(frame, args, args[0])) { throw MerkError("reduce callback did not return a value"); }
+            }
+            return Node(args[0]);
+        }
+    }
+
+    Node acc = initial ? *initial : items.front();
+    auto func = Evaluator::resolveFunctionValue(fn, argsOf({acc, items.front()}), scope);
+    for (std::size_t i = initial ? 0 : 1; i < items.size(); ++i) {
+        acc = Evaluator::callFunction(func, argsOf({acc, items[i]}), scope);
+    }
+    return acc;
+}
+
+bool nodeLess(const Node& a, const Node& b) {
+    const Ordering order = a.compare(b);
+    if (order == Ordering::Unordered) {
+        throw MerkError("Cannot order " + a.getTypeAsString() + " and " + b.getTypeAsString());
+    }
+    return order == Ordering::Less;
+}
+
+// Stable sort; large inputs sort chunks on the pool and then merge neighbouring runs level by level.
+template <typename T, typename Less>
+void sortValues(Vector<T>& values, Less less) {
+    if (!runsInParallel(values.size())) {
+        std::stable_sort(values.begin(), values.end(), less);
+        return;
+    }
+
+    const std::size_t count = values.size();
+    const std::size_t chunks = Parallel::chunkCount(count);
+    Vector<std::size_t> bounds;
+    for (std::size_t k = 0; k <= chunks; ++k) {
+        bounds.push_back(k * count / chunks);
+    }
+    Parallel::forChunks(count, chunks, [&](std::size_t, std::size_t begin, std::size_t end, std::size_t) {
+        std::stable_sort(values.begin() + begin, values.begin() + end, less);
+    });
+
+    while (bounds.size() > 2) {
+        const std::size_t pairs = (bounds.size() - 1) / 2;
+        Parallel::forChunks(pairs, pairs, [&](std::size_t p, std::size_t, std::size_t, std::size_t) {
+            const auto first = values.begin() + bounds[2 * p];
+            std::inplace_merge(first, values.begin() + bounds[2 * p + 1], values.begin() + bounds[2 * p + 2], less);
+        });
+        Vector<std::size_t> merged;
+        for (std::size_t i = 0; i < bounds.size(); i += 2) {
+            merged.push_back(bounds[i]);
+        }
+        if (merged.back() != count) { merged.push_back(count); }
+        bounds = std::move(merged);
+    }
+}
+
+void addBulkMethods(SharedPtr<NativeClass> cls, SharedPtr<Scope> classScope, const String& className, DataFactory makeData) {
+    ParamList fnParams;
+    fnParams.addParameter(ParamNode("fn", NodeValueType::Any));
+
+    ParamList reduceParams;
+    reduceParams.addParameter(ParamNode("fn", NodeValueType::Any));
+    auto initialParam = ParamNode("initial", NodeValueType::Any);
+    initialParam.setIsVarArgsParam(true);
+    reduceParams.addParameter(initialParam);
+
+    auto mapFunction = [className, makeData](ArgumentList args, SharedPtr<Scope> callScope, SharedPtr<ClassInstanceNode> self) -> Node {
+        validateNativeInstance("map", className, self, callScope);
+        if (args.size() != 1) {throw MerkError(className + ".map takes exactly one function");}
+        auto& list = pullNativeRef<ListNode>(self, className + ".map");
+        return returnNewInstanceLike(self, makeData(applyEach(list.getElements(), args[0], callScope)), className);
+    };
+
+    auto filterFunction = [className, makeData](ArgumentList args, SharedPtr<Scope> callScope, SharedPtr<ClassInstanceNode> self) -> Node {
+        validateNativeInstance("filter", className, self, callScope);
+        if (args.size() != 1) {throw MerkError(className + ".filter takes exactly one function");}
+        auto& list = pullNativeRef<ListNode>(self, className + ".filter");
+        const NodeList& items = list.getElements();
+        const NodeList keep = applyEach(items, args[0], callScope);
+        NodeList kept;
+        for (std::size_t i = 0; i < items.size(); ++i) {
+            if (keep[i].isTruthy()) { kept.push_back(items[i]); }
+        }
+        return returnNewInstanceLike(self, makeData(std::move(kept)), className);
+    };
+
+    auto reduceFunction = [className](ArgumentList args, SharedPtr<Scope> callScope, SharedPtr<ClassInstanceNode> self) -> Node {
+        validateNativeInstance("reduce", className, self, callScope);
+        if (args.size() != 1 && args.size() != 2) {throw MerkError(className + ".reduce takes a function and an optional initial value");}
+        auto& list = pullNativeRef<ListNode>(self, className + ".reduce");
+        const Node initial = args.size() == 2 ? args[1] : Node();
+        return reduceEach(list.getElements(), args[0], args.size() == 2 ? &initial : nullptr, callScope);
+    };
+
+    auto anyFunction = [className](ArgumentList args, SharedPtr<Scope> callScope, SharedPtr<ClassInstanceNode> self) -> Node {
+        validateNativeInstance("any", className, self, callScope);
+        if (args.size() != 1) {throw MerkError(className + ".any takes exactly one function");}
+        auto& list = pullNativeRef<ListNode>(self, className + ".any");
+        return Node(testEach(list.getElements(), args[0], callScope, false));
+    };
+
+    auto allFunction = [className](ArgumentList args, SharedPtr<Scope> callScope, SharedPtr<ClassInstanceNode> self) -> Node {
+        validateNativeInstance("all", className, self, callScope);
+        if (args.size() != 1) {throw MerkError(className + ".all takes exactly one function");}
+        auto& list = pullNativeRef<ListNode>(self, className + ".all");
+        return Node(testEach(list.getElements(), args[0], callScope, true));
+    };
+
+    auto sortFunction = [className](ArgumentList args, SharedPtr<Scope> callScope, SharedPtr<ClassInstanceNode> self) -> Node {
+        validateNativeInstance("sort", className, self, callScope);
+        if (args.size() != 0) {throw MerkError(className + ".sort takes no arguments; use sortBy for a key function");}
+        auto& list = pullNativeRef<ListNode>(self, className + ".sort");
+        sortValues(list.getMutableElements(), nodeLess);
+        return Node();  // None
+    };
+
+    auto sortByFunction = [className](ArgumentList args, SharedPtr<Scope> callScope, SharedPtr<ClassInstanceNode> self) -> Node {
+        validateNativeInstance("sortBy", className, self, callScope);
+        if (args.size() != 1) {throw MerkError(className + ".sortBy takes exactly one key function");}
+        auto& list = pullNativeRef<ListNode>(self, className + ".sortBy");
+        NodeList& items = list.getMutableElements();
+        const NodeList keys = applyEach(items, args[0], callScope);
+
+        Vector<std::size_t> order(items.size());
+        for (std::size_t i = 0; i < order.size(); ++i) { order[i] = i; }
+        sortValues(order, [&keys](std::size_t a, std::size_t b) { return nodeLess(keys[a], keys[b]); });
+
+        NodeList sorted;
+        sorted.reserve(items.size());
+        for (std::size_t i : order) { sorted.push_back(std::move(items[i])); }
+        items = std::move(sorted);
+        return Node();  // None
+    };
+
+    cls->addMethod("map", makeShared<NativeMethod>("map", fnParams, classScope, mapFunction));
+    cls->addMethod("filter", makeShared<NativeMethod>("filter", fnParams, classScope, filterFunction));
+    cls->addMethod("reduce", makeShared<NativeMethod>("reduce", reduceParams, classScope, reduceFunction));
+    cls->addMethod("any", makeShared<NativeMethod>("any", fnParams, classScope, anyFunction));
+    cls->addMethod("all", makeShared<NativeMethod>("all", fnParams, classScope, allFunction));
+    cls->addMethod("sort", makeShared<NativeMethod>("sort", ParamList(), classScope, sortFunction));
+    cls->addMethod("sortBy", makeShared<NativeMethod>("sortBy", fnParams, classScope, sortByFunction));
+}
+
+} // namespace
+
 SharedPtr<NativeClass> createNativeListClass(SharedPtr<Scope> globalScope) {
     SharedPtr<Scope> classScope = generateScope(globalScope);
 
@@ -154,7 +435,17 @@ SharedPtr<NativeClass> createNativeListClass(SharedPtr<Scope> globalScope) {
     auto constructFunction = [className](ArgumentList args, SharedPtr<Scope> callScope, SharedPtr<ClassInstanceNode> self) -> Node {
         MARK_UNUSED_MULTI(callScope);
         validateSelf(self, className, "constructFunction");
-        auto list = makeShared<ListNode>(args);
+        SharedPtr<ListNode> list;
+        // List(range(...)) / List(generator) drains the lazy source instead of wrapping it.
+        if (args.size() == 1 && (args[0].getType() == NodeValueType::Range || args[0].getType() == NodeValueType::Generator)) {
+            NodeList items;
+            auto it = makeNodeIterator(args[0]);
+            Node item;
+            while (it->next(item)) { items.push_back(item); }
+            list = makeShared<ListNode>(std::move(items));
+        } else {
+            list = makeShared<ListNode>(args);
+        }
         if (!list) {throw MerkError("List Doesn't Exist");}
         
         self->getInstance()->setNativeData(list);
@@ -231,6 +522,10 @@ SharedPtr<NativeClass> createNativeListClass(SharedPtr<Scope> globalScope) {
     auto popMethod = makeShared<NativeMethod>("pop", popParams, classScope, popFunction);
     listClass->addMethod("pop", popMethod);
 
+    addBulkMethods(listClass, classScope, className, [](NodeList items) -> SharedPtr<NativeNode> {
+        return makeShared<ListNode>(std::move(items));
+    });
+
 
     return listClass;
 }
@@ -369,8 +664,7 @@ SharedPtr<NativeClass> createNativeArrayClass(SharedPtr<Scope> globalScope) {
         String funcName = "arrayConstruct";
         // validateSelf(self, className, "constructFunction");
         validateNativeInstance(funcName, className, self, callScope); 
-        // auto arr = makeShared<ArrayNode>(args, NodeValueType::Any);
-        auto arr = makeShared<ListNode>(args);
+        auto arr = makeShared<ArrayNode>(args, NodeValueType::Any);
         // auto var = VarNode(arr);
         auto var = Node(arr);
         var.getFlags().name = className;
@@ -456,6 +750,10 @@ SharedPtr<NativeClass> createNativeArrayClass(SharedPtr<Scope> globalScope) {
     auto popMethod = makeShared<NativeMethod>("pop", popParams, classScope, popFunction);
     arrClass->addMethod("pop", popMethod);
 
+    addBulkMethods(arrClass, classScope, className, [](NodeList items) -> SharedPtr<NativeNode> {
+        return makeShared<ArrayNode>(std::move(items), NodeValueType::Any);
+    });
+
     return arrClass;
 }
 
@@ -601,6 +899,12 @@ SharedPtr<NativeClass> createNativeHttpClass(SharedPtr<Scope> globalScope) {
         return http->send();
     };
 
+    auto sendAsyncFn = [](ArgumentList args, SharedPtr<Scope> callScope, SharedPtr<ClassInstanceNode> self) -> Node {
+        MARK_UNUSED_MULTI(args);
+        if (!self) throw MerkError("Http.sendAsync requires instance");
+        return futureValue(pullNative<HttpNode>(self)->sendAsync(), callScope);
+    };
+
     
     auto constructMethod = makeShared<NativeMethod>("construct", parameters.clone(), classScope, constructFunction);
     httpClass->addMethod("construct", constructMethod);
@@ -614,6 +918,8 @@ SharedPtr<NativeClass> createNativeHttpClass(SharedPtr<Scope> globalScope) {
     auto sendMethod = makeShared<NativeMethod>("send", sendParams, classScope, sendFn);
     httpClass->addMethod("send", sendMethod);
 
+    httpClass->addMethod("sendAsync", makeShared<NativeMethod>("sendAsync", sendParams, classScope, sendAsyncFn));
+
     return httpClass;
 }
 
@@ -693,6 +999,18 @@ SharedPtr<NativeClass> createNativeFileClass(SharedPtr<Scope> globalScope) {
         pullNative<FileNode>(self)->write(a[0].toString()); return Node();
     };
 
+    // readAsync(), writeAsync(s): Futures over the whole file at `path`; "a" modes append.
+    auto readAsyncFn = [](ArgumentList, SharedPtr<Scope> callScope, SharedPtr<ClassInstanceNode> self)->Node {
+        const auto path = self->getInstance()->getField("path").toString();
+        return futureValue(FileNode::readAllAsync(path), callScope);
+    };
+
+    auto writeAsyncFn = [](ArgumentList a, SharedPtr<Scope> callScope, SharedPtr<ClassInstanceNode> self)->Node {
+        auto inst = self->getInstance();
+        const bool append = inst->getField("mode").toString().find('a') != String::npos;
+        return futureValue(FileNode::writeAllAsync(inst->getField("path").toString(), a[0].toString(), append), callScope);
+    };
+
     ParamList writeLineP; writeLineP.addParameter(ParamNode("s", NodeValueType::Any));
     auto writeLineFn = [](ArgumentList a, SharedPtr<Scope>, SharedPtr<ClassInstanceNode> self)->Node {
         pullNative<FileNode>(self)->writeLine(a[0].toString());
@@ -767,6 +1085,14 @@ SharedPtr<NativeClass> createNativeFileClass(SharedPtr<Scope> globalScope) {
         auto s = a[1].toString(); ofs.write(s.data(), static_cast<std::streamsize>(s.size())); return Node();
     });
 
+    addStatic("readAllAsync", pathP, [](ArgumentList a, SharedPtr<Scope> callScope, SharedPtr<ClassInstanceNode>){
+        return futureValue(FileNode::readAllAsync(a[0].toString()), callScope);
+    });
+
+    addStatic("writeAllAsync", wAllP, [](ArgumentList a, SharedPtr<Scope> callScope, SharedPtr<ClassInstanceNode>){
+        return futureValue(FileNode::writeAllAsync(a[0].toString(), a[1].toString(), false), callScope);
+    });
+
     ParamList appendAllP;
     appendAllP.addParameter(ParamNode("path", NodeValueType::String));
     appendAllP.addParameter(ParamNode("data", NodeValueType::Any));
@@ -792,12 +1118,167 @@ SharedPtr<NativeClass> createNativeFileClass(SharedPtr<Scope> globalScope) {
     cls->addMethod("read", makeShared<NativeMethod>("read", readN, classScope, readFn));
     cls->addMethod("write", makeShared<NativeMethod>("write", writeP, classScope, writeFn));
     cls->addMethod("writeLine", makeShared<NativeMethod>("writeLine", writeLineP, classScope, writeLineFn));
+    cls->addMethod("readAsync", makeShared<NativeMethod>("readAsync", noArgs, classScope, readAsyncFn));
+    cls->addMethod("writeAsync", makeShared<NativeMethod>("writeAsync", writeP, classScope, writeAsyncFn));
 
     return cls;
 }
 
 
 
+// Future(fn, args...): the pending result of fn(args...), started on construction.
+SharedPtr<NativeClass> createNativeFutureClass(SharedPtr<Scope> globalScope) {
+    auto classScope = generateScope(globalScope);
+    auto [className, accessor] = getClassAccessorName("Future");
+    ParamList params;
+    params.addParameter(ParamNode("fn", NodeValueType::Any));
+    auto argsParam = ParamNode("args", NodeValueType::Any);
+    argsParam.setIsVarArgsParam(true);
+    params.addParameter(argsParam);
+
+    auto cls = makeShared<NativeClass>(className, accessor, classScope);
+    cls->setParameters(params);
+    cls->setCapturedScope(classScope->getParent());
+
+    // The spawned call may outlive construct(), and from the method's own scope `await` would
+    // resolve to Future.await, so it is attached to the scope the class was defined in.
+    WeakPtr<Scope> definingScope = globalScope;
+    auto constructFunction = [className, definingScope](ArgumentList args, SharedPtr<Scope> callScope, SharedPtr<ClassInstanceNode> self)->Node {
+        validateSelf(self, className, "construct");
+        if (args.size() < 1) { throw MerkError("Future expects (fn, args...)"); }
+        if (auto started = std::dynamic_pointer_cast<FutureNode>(args[0].getInner()); started && args.size() == 1) {
+            self->getInstance()->setNativeData(started); // from futureValue()
+            return returnConstructedInstanceOf(self, className);
+        }
+        ArgumentList callArgs;
+        for (size_t i = 1; i < args.size(); ++i) { callArgs.addPositionalArg(args[i]); }
+        SharedPtr<Scope> spawnScope = definingScope.lock();
+        if (!spawnScope) spawnScope = callScope;
+        self->getInstance()->setNativeData(makeShared<FutureNode>(FutureState::spawn(args[0], callArgs, spawnScope)));
+        return returnConstructedInstanceOf(self, className);
+    };
+
+    auto awaitFn = [](ArgumentList, SharedPtr<Scope>, SharedPtr<ClassInstanceNode> self)->Node {
+        return pullNative<FutureNode>(self)->getState()->wait();
+    };
+
+    auto doneFn = [](ArgumentList, SharedPtr<Scope>, SharedPtr<ClassInstanceNode> self)->Node {
+        return Node(pullNative<FutureNode>(self)->getState()->isDone());
+    };
+
+    auto noArgs = ParamList{};
+    cls->addMethod("construct", makeShared<NativeMethod>("construct", params.clone(), classScope, constructFunction));
+    cls->addMethod("await", makeShared<NativeMethod>("await", noArgs, classScope, awaitFn));
+    cls->addMethod("join", makeShared<NativeMethod>("join", noArgs, classScope, awaitFn));
+    cls->addMethod("done", makeShared<NativeMethod>("done", noArgs, classScope, doneFn));
+
+    return cls;
+}
+
+// Channel(capacity=0, name=""): capacity 0 is unbounded; a name shares one channel across isolates.
+SharedPtr<NativeClass> createNativeChannelClass(SharedPtr<Scope> globalScope) {
+    auto classScope = generateScope(globalScope);
+    auto [className, accessor] = getClassAccessorName("Channel");
+    ParamList params;
+    auto optionsParam = ParamNode("options", NodeValueType::Any); // [capacity[, name]]
+    optionsParam.setIsVarArgsParam(true);
+    params.addParameter(optionsParam);
+
+    auto cls = makeShared<NativeClass>(className, accessor, classScope);
+    cls->setParameters(params);
+    cls->setCapturedScope(classScope->getParent());
+
+    auto constructFunction = [className](ArgumentList args, SharedPtr<Scope> callScope, SharedPtr<ClassInstanceNode> self)->Node {
+        MARK_UNUSED_MULTI(callScope);
+        validateSelf(self, className, "construct");
+        if (args.size() > 2) { throw MerkError("Channel expects ([capacity[, name]])"); }
+        const int capacity = args.size() >= 1 ? args[0].toInt() : 0;
+        if (capacity < 0) { throw MerkError("Channel capacity must be >= 0"); }
+        const String name = args.size() >= 2 ? args[1].toString() : "";
+        auto state = name.empty()
+            ? makeShared<ChannelState>(static_cast<size_t>(capacity))
+            : ChannelState::named(name, static_cast<size_t>(capacity));
+        self->getInstance()->setNativeData(makeShared<ChannelNode>(state));
+        return returnConstructedInstanceOf(self, className);
+    };
+
+    ParamList valueP; valueP.addParameter(ParamNode("value", NodeValueType::Any));
+    auto sendFn = [](ArgumentList a, SharedPtr<Scope>, SharedPtr<ClassInstanceNode> self)->Node {
+        pullNative<ChannelNode>(self)->getState()->send(a[0]);
+        return Node();
+    };
+
+    auto trySendFn = [](ArgumentList a, SharedPtr<Scope>, SharedPtr<ClassInstanceNode> self)->Node {
+        return Node(pullNative<ChannelNode>(self)->getState()->trySend(a[0]));
+    };
+
+    // recv/tryRecv give Null once there is nothing (more) to receive.
+    auto recvFn = [](ArgumentList, SharedPtr<Scope>, SharedPtr<ClassInstanceNode> self)->Node {
+        Node out;
+        return pullNative<ChannelNode>(self)->getState()->recv(out) ? out : Node(Null);
+    };
+
+    auto tryRecvFn = [](ArgumentList, SharedPtr<Scope>, SharedPtr<ClassInstanceNode> self)->Node {
+        Node out;
+        return pullNative<ChannelNode>(self)->getState()->tryRecv(out) ? out : Node(Null);
+    };
+
+    // recvOk(): [value, true], or [Null, false] once closed and drained; tells a sent null from the end.
+    auto recvOkFn = [](ArgumentList, SharedPtr<Scope> callScope, SharedPtr<ClassInstanceNode> self)->Node {
+        Node out(Null);
+        const bool ok = pullNative<ChannelNode>(self)->getState()->recv(out);
+        ArgumentList pair;
+        pair.addPositionalArg(ok ? out : Node(Null));
+        pair.addPositionalArg(Node(ok));
+        return Evaluator::evaluateClassCall(callScope, "List", pair);
+    };
+
+    auto closeFn = [](ArgumentList, SharedPtr<Scope>, SharedPtr<ClassInstanceNode> self)->Node {
+        pullNative<ChannelNode>(self)->getState()->close();
+        return Node();
+    };
+
+    auto isClosedFn = [](ArgumentList, SharedPtr<Scope>, SharedPtr<ClassInstanceNode> self)->Node {
+        return Node(pullNative<ChannelNode>(self)->getState()->isClosed());
+    };
+
+    auto sizeFn = [](ArgumentList, SharedPtr<Scope>, SharedPtr<ClassInstanceNode> self)->Node {
+        return Node(static_cast<int>(pullNative<ChannelNode>(self)->getState()->size()));
+    };
+
+    // Channel.select(channels...): [index, value] from the first ready channel, [-1, Null] once all are closed.
+    ParamList selectP;
+    auto channelsParam = ParamNode("channels", NodeValueType::Any);
+    channelsParam.setIsVarArgsParam(true);
+    selectP.addParameter(channelsParam);
+    auto selectFn = [](ArgumentList a, SharedPtr<Scope> callScope, SharedPtr<ClassInstanceNode>)->Node {
+        Vector<SharedPtr<ChannelState>> channels;
+        for (size_t i = 0; i < a.size(); ++i) { channels.push_back(channelOf(a[i])); }
+        Node value(Null);
+        const size_t index = ChannelState::select(channels, value);
+        ArgumentList pair;
+        pair.addPositionalArg(Node(index < channels.size() ? static_cast<int>(index) : -1));
+        pair.addPositionalArg(value);
+        return Evaluator::evaluateClassCall(callScope, "List", pair);
+    };
+    auto m_select = makeShared<NativeMethod>("select", selectP, classScope, selectFn);
+    m_select->setIsStatic(true);
+
+    auto noArgs = ParamList{};
+    cls->addMethod("construct", makeShared<NativeMethod>("construct", params.clone(), classScope, constructFunction));
+    cls->addMethod("send", makeShared<NativeMethod>("send", valueP, classScope, sendFn));
+    cls->addMethod("trySend", makeShared<NativeMethod>("trySend", valueP, classScope, trySendFn));
+    cls->addMethod("recv", makeShared<NativeMethod>("recv", noArgs, classScope, recvFn));
+    cls->addMethod("tryRecv", makeShared<NativeMethod>("tryRecv", noArgs, classScope, tryRecvFn));
+    cls->addMethod("recvOk", makeShared<NativeMethod>("recvOk", noArgs, classScope, recvOkFn));
+    cls->addMethod("close", makeShared<NativeMethod>("close", noArgs, classScope, closeFn));
+    cls->addMethod("isClosed", makeShared<NativeMethod>("isClosed", noArgs, classScope, isClosedFn));
+    cls->addMethod("size", makeShared<NativeMethod>("size", noArgs, classScope, sizeFn));
+    cls->addMethod("select", m_select);
+
+    return cls;
+}
+
 
 std::unordered_map<String, NativeClassFactory> nativeClassFactories = {
     {"List", createNativeListClass},
@@ -805,7 +1286,9 @@ std::unordered_map<String, NativeClassFactory> nativeClassFactories = {
     {"Dict", createNativeDictClass},
     {"Set", createNativeSetClass},
     {"Http", createNativeHttpClass},
-    {"File", createNativeFileClass}
+    {"File", createNativeFileClass},
+    {"Future", createNativeFutureClass},
+    {"Channel", createNativeChannelClass}
 };
 
 
@@ -15,17 +15,44 @@
 #include "core/callables/Invocable.hpp"
 #include "ast/AstCallable.hpp"
 #include "core/evaluators/Executor.hpp"
+#include "core/evaluators/Generator.hpp"
 
 
 Function::Function(String name, ParamList params, [[maybe_unused]] CallableType funcType, bool requiresReturn, bool isStatic)
     : Invocable(name, params, CallableType::FUNCTION, requiresReturn, isStatic) {}
 
+// A yield belongs to this function unless it sits inside a nested definition.
+static bool hasOwnYield(const FunctionBody* body) {
+    if (!body) return false;
+
+    Vector<const BaseAST*> all = body->getAllAst(true);
+    std::unordered_set<const BaseAST*> nested;
+    for (const BaseAST* node : all) {
+        switch (node->getAstType()) {
+            case AstType::CallableDefinition:
+            case AstType::FunctionDefinition:
+            case AstType::ClassDefinition:
+            case AstType::ClassMethodDef:
+                for (const BaseAST* inner : node->getAllAst(true)) { if (inner != node) nested.insert(inner); }
+                break;
+            default:
+                break;
+        }
+    }
+
+    for (const BaseAST* node : all) {
+        if (node->getAstType() == AstType::Yield && !nested.count(node)) return true;
+    }
+    return false;
+}
+
 UserFunction::UserFunction(String name, UniquePtr<FunctionBody> body, ParamList parameters, CallableType funcType)
     : Function(name, parameters, CallableType::FUNCTION), body(std::move(body)) {
         DEBUG_FLOW(FlowLevel::NONE);
 
         setSubType(funcType);
         setCallableType(CallableType::FUNCTION);
+        generator = hasOwnYield(this->body.get());
         DEBUG_FLOW_EXIT();
 }
 
@@ -54,6 +81,16 @@ Node UserFunction::execute(ArgumentList args, SharedPtr<Scope> callScope, [[mayb
     // // no explicit return
     // if (requiresReturn) throw MerkError("Function did not return a value.");
     // return Node();
+    if (generator) {
+        // The call scope and arguments travel with the suspended frame; the body
+        // only starts running on the first resume.
+        auto self = std::static_pointer_cast<const UserFunction>(shared_from_this());
+        auto frame = [self, args, callScope, instanceNode]() {
+            ParamList params = self->parameters;
+            Executor::Function(self->name, callScope, self->getCapturedScope(), false, args, self->body.get(), params, instanceNode);
+        };
+        return Node(std::static_pointer_cast<NodeBase>(makeShared<GeneratorNode>(name, std::move(frame))));
+    }
     return Executor::Function(name, callScope, getCapturedScope(), requiresReturn, args, body.get(), parameters, instanceNode);
 }
 
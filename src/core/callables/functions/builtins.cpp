@@ -10,6 +10,9 @@
 #include "core/callables/functions/builtins.h"
 #include "core/Environments/Scope.hpp"
 #include "core/evaluators/TypeEvaluator.hpp"
+#include "core/evaluators/Evaluator.hpp"
+#include "core/evaluators/Future.hpp"
+#include "core/evaluators/EventLoop.hpp"
 // Define native functions 
 
 Node print(ArgumentList args, [[maybe_unused]] SharedPtr<Scope> scope, [[maybe_unused]] SharedPtr<ClassInstanceNode> instanceNode = nullptr) {
@@ -88,6 +91,120 @@ Node floatFunc(ArgumentList args, [[maybe_unused]] SharedPtr<Scope> scope, [[may
     return Node(TypeEvaluator::to<float>(args[0].getValue(), CoerceMode::Strict));  
 }
 
+static const StringNode& pullStringArg(const ArgumentList& args, size_t index, const String& funcName) {
+    const Node& arg = args[index];
+    if (!arg.isValid() || arg.getType() != NodeValueType::String) {
+        throw MerkError(funcName + " expects a String as argument " + std::to_string(index + 1) + ", got " + nodeTypeToString(arg.getType()));
+    }
+    return static_cast<const StringNode&>(*arg.getInner());
+}
+
+static size_t clampIndex(int index, size_t length) {
+    // Negative indices count from the end, as in slice("merk", -2) == "rk".
+    if (index < 0) {
+        const auto back = static_cast<size_t>(-static_cast<long>(index));
+        return back >= length ? 0 : length - back;
+    }
+    return std::min(static_cast<size_t>(index), length);
+}
+
+Node sliceFunc(ArgumentList args, [[maybe_unused]] SharedPtr<Scope> scope, [[maybe_unused]] SharedPtr<ClassInstanceNode> instanceNode = nullptr) {
+    if (args.size() < 2 || args.size() > 3) { throw MerkError("slice expects (value, start[, end])"); }
+    const auto& str = pullStringArg(args, 0, "slice");
+    const size_t start = clampIndex(args[1].toInt(), str.size());
+    const size_t end = args.size() == 3 ? clampIndex(args[2].toInt(), str.size()) : str.size();
+    return Node(std::static_pointer_cast<NodeBase>(str.slice(start, end)));
+}
+
+Node findFunc(ArgumentList args, [[maybe_unused]] SharedPtr<Scope> scope, [[maybe_unused]] SharedPtr<ClassInstanceNode> instanceNode = nullptr) {
+    if (args.size() < 2 || args.size() > 3) { throw MerkError("find expects (value, needle[, from])"); }
+    const auto haystack = pullStringArg(args, 0, "find").view();
+    const auto needle = pullStringArg(args, 1, "find").view();
+    const size_t from = args.size() == 3 ? clampIndex(args[2].toInt(), haystack.size()) : 0;
+    const auto pos = haystack.find(needle, from);
+    return Node(pos == std::string_view::npos ? -1 : static_cast<int>(pos));
+}
+
+Node lenFunc(ArgumentList args, [[maybe_unused]] SharedPtr<Scope> scope, [[maybe_unused]] SharedPtr<ClassInstanceNode> instanceNode = nullptr) {
+    if (args.size() != 1) { throw MerkError("Only One Argument may be passed to Function 'len'"); }
+    return Node(static_cast<int>(pullStringArg(args, 0, "len").size()));
+}
+
+// range(stop) / range(start, stop[, step]): a lazy RangeNode for for-in loops.
+Node rangeFunc(ArgumentList args, [[maybe_unused]] SharedPtr<Scope> scope, [[maybe_unused]] SharedPtr<ClassInstanceNode> instanceNode = nullptr) {
+    if (args.size() < 1 || args.size() > 3) { throw MerkError("range expects (stop) or (start, stop[, step])"); }
+    if (args.size() == 1) { return Node(std::static_pointer_cast<NodeBase>(makeShared<RangeNode>(0, args[0].toInt()))); }
+    const int step = args.size() == 3 ? args[2].toInt() : 1;
+    return Node(std::static_pointer_cast<NodeBase>(makeShared<RangeNode>(args[0].toInt(), args[1].toInt(), step)));
+}
+
+// sum(iterable[, start]): folds any iterable one element at a time, so lazy
+// sources (ranges, generators, files) are never materialised.
+Node sumFunc(ArgumentList args, [[maybe_unused]] SharedPtr<Scope> scope, [[maybe_unused]] SharedPtr<ClassInstanceNode> instanceNode = nullptr) {
+    if (args.size() < 1 || args.size() > 2) { throw MerkError("sum expects (iterable[, start])"); }
+    Node total = args.size() == 2 ? args[1] : Node(0);
+    auto it = makeNodeIterator(args[0]);
+    Node item;
+    while (it->next(item)) {
+        total = total + item;
+    }
+    return total;
+}
+
+// spawn(fn, args...): starts fn(args...) and returns its Future.
+Node spawnFunc(ArgumentList args, SharedPtr<Scope> scope, [[maybe_unused]] SharedPtr<ClassInstanceNode> instanceNode = nullptr) {
+    if (args.size() < 1) { throw MerkError("spawn expects (fn, args...)"); }
+    return Evaluator::evaluateClassCall(scope, "Future", args);
+}
+
+// The futures passed either directly or as a single iterable of futures.
+Vector<SharedPtr<FutureState>> pullFutures(const ArgumentList& args, const char* forWhat) {
+    Vector<SharedPtr<FutureState>> futures;
+    if (args.size() == 1 && !isFuture(args[0])) {
+        auto it = makeNodeIterator(args[0]);
+        Node item;
+        while (it->next(item)) { futures.push_back(futureOf(item)); }
+    } else {
+        for (size_t i = 0; i < args.size(); ++i) { futures.push_back(futureOf(args[i])); }
+    }
+    if (futures.empty()) { throw MerkError(String(forWhat) + " expects at least one Future"); }
+    return futures;
+}
+
+// waitAll(futures...): the results, in order, as a List.
+Node waitAllFunc(ArgumentList args, SharedPtr<Scope> scope, [[maybe_unused]] SharedPtr<ClassInstanceNode> instanceNode = nullptr) {
+    ArgumentList results;
+    for (auto& future : pullFutures(args, "waitAll")) { results.addPositionalArg(future->wait()); }
+    return Evaluator::evaluateClassCall(scope, "List", results);
+}
+
+// waitAny(futures...): the index of the first one to finish.
+Node waitAnyFunc(ArgumentList args, [[maybe_unused]] SharedPtr<Scope> scope, [[maybe_unused]] SharedPtr<ClassInstanceNode> instanceNode = nullptr) {
+    return Node(static_cast<int>(FutureState::waitAny(pullFutures(args, "waitAny"))));
+}
+
+// async(fn, args...): runs fn(args...) on the event loop until its first await; returns its Future.
+Node asyncFunc(ArgumentList args, SharedPtr<Scope> scope, [[maybe_unused]] SharedPtr<ClassInstanceNode> instanceNode = nullptr) {
+    if (args.size() < 1) { throw MerkError("async expects (fn, args...)"); }
+    ArgumentList callArgs;
+    for (size_t i = 1; i < args.size(); ++i) { callArgs.addPositionalArg(args[i]); }
+    return futureValue(Async::start(args[0], callArgs, scope), scope);
+}
+
+// await(future): its result. Inside an async call this lets other work on the loop run meanwhile.
+Node awaitFunc(ArgumentList args, [[maybe_unused]] SharedPtr<Scope> scope, [[maybe_unused]] SharedPtr<ClassInstanceNode> instanceNode = nullptr) {
+    if (args.size() != 1) { throw MerkError("await expects a single Future"); }
+    return futureOf(args[0])->wait();
+}
+
+// sleep(ms): a Future that completes after ms milliseconds.
+Node sleepFunc(ArgumentList args, SharedPtr<Scope> scope, [[maybe_unused]] SharedPtr<ClassInstanceNode> instanceNode = nullptr) {
+    if (args.size() != 1) { throw MerkError("sleep expects (ms)"); }
+    const int ms = args[0].toInt();
+    if (ms < 0) { throw MerkError("sleep expects a non-negative delay"); }
+    return futureValue(Async::sleep(std::chrono::milliseconds(ms)), scope);
+}
+
 SharedPtr<NativeFunction> createPrintFunction([[maybe_unused]] SharedPtr<Scope> scope) {
     ParamList params;
     auto param = ParamNode("value", NodeValueType::Any);
@@ -147,12 +264,98 @@ SharedPtr<NativeFunction> createIsInstanceFunction([[maybe_unused]] SharedPtr<Sc
     return makeShared<NativeFunction>("String", std::move(params), isInstanceFunc);
 }
 
+SharedPtr<NativeFunction> createSliceFunction([[maybe_unused]] SharedPtr<Scope> scope) {
+    ParamList params;
+    params.addParameter(ParamNode("value", NodeValueType::String));
+    params.addParameter(ParamNode("start", NodeValueType::Int));
+    params.addParameter(ParamNode("end", NodeValueType::Int, true)); // optional
+    return makeShared<NativeFunction>("slice", std::move(params), sliceFunc);
+}
+
+SharedPtr<NativeFunction> createFindFunction([[maybe_unused]] SharedPtr<Scope> scope) {
+    ParamList params;
+    params.addParameter(ParamNode("value", NodeValueType::String));
+    params.addParameter(ParamNode("needle", NodeValueType::String));
+    params.addParameter(ParamNode("from", NodeValueType::Int, true)); // optional
+    return makeShared<NativeFunction>("find", std::move(params), findFunc);
+}
+
+SharedPtr<NativeFunction> createRangeFunction([[maybe_unused]] SharedPtr<Scope> scope) {
+    ParamList params;
+    params.addParameter(ParamNode("start", NodeValueType::Int));
+    params.addParameter(ParamNode("stop", NodeValueType::Int, true)); // optional
+    params.addParameter(ParamNode("step", NodeValueType::Int, true)); // optional
+    return makeShared<NativeFunction>("range", std::move(params), rangeFunc);
+}
+
+SharedPtr<NativeFunction> createSumFunction([[maybe_unused]] SharedPtr<Scope> scope) {
+    ParamList params;
+    params.addParameter(ParamNode("iterable", NodeValueType::Any));
+    params.addParameter(ParamNode("start", NodeValueType::Any, true)); // optional
+    return makeShared<NativeFunction>("sum", std::move(params), sumFunc);
+}
+
+SharedPtr<NativeFunction> createLenFunction([[maybe_unused]] SharedPtr<Scope> scope) {
+    ParamList params;
+    params.addParameter(ParamNode("value", NodeValueType::String));
+    return makeShared<NativeFunction>("len", std::move(params), lenFunc);
+}
+
+SharedPtr<NativeFunction> createSpawnFunction([[maybe_unused]] SharedPtr<Scope> scope) {
+    ParamList params;
+    params.addParameter(ParamNode("fn", NodeValueType::Any));
+    params.addParameter(ParamNode("args", NodeValueType::Any, true));
+    return makeShared<NativeFunction>("spawn", std::move(params), spawnFunc);
+}
+
+SharedPtr<NativeFunction> createWaitAllFunction([[maybe_unused]] SharedPtr<Scope> scope) {
+    ParamList params;
+    params.addParameter(ParamNode("futures", NodeValueType::Any, true));
+    return makeShared<NativeFunction>("waitAll", std::move(params), waitAllFunc);
+}
+
+SharedPtr<NativeFunction> createWaitAnyFunction([[maybe_unused]] SharedPtr<Scope> scope) {
+    ParamList params;
+    params.addParameter(ParamNode("futures", NodeValueType::Any, true));
+    return makeShared<NativeFunction>("waitAny", std::move(params), waitAnyFunc);
+}
+
+SharedPtr<NativeFunction> createAsyncFunction([[maybe_unused]] SharedPtr<Scope> scope) {
+    ParamList params;
+    params.addParameter(ParamNode("fn", NodeValueType::Any));
+    params.addParameter(ParamNode("args", NodeValueType::Any, true));
+    return makeShared<NativeFunction>("async", std::move(params), asyncFunc);
+}
+
+SharedPtr<NativeFunction> createAwaitFunction([[maybe_unused]] SharedPtr<Scope> scope) {
+    ParamList params;
+    params.addParameter(ParamNode("future", NodeValueType::Any));
+    return makeShared<NativeFunction>("await", std::move(params), awaitFunc);
+}
+
+SharedPtr<NativeFunction> createSleepFunction([[maybe_unused]] SharedPtr<Scope> scope) {
+    ParamList params;
+    params.addParameter(ParamNode("ms", NodeValueType::Int));
+    return makeShared<NativeFunction>("sleep", std::move(params), sleepFunc);
+}
+
 std::unordered_map<String, NativeFuncFactory> nativeFunctionFactories = {
     {"print", createPrintFunction},
     {"Float", createFloatFunction},
     {"Int", createIntFunction},
     {"String", createStringFunction},
     {"isInstance", createIsInstanceFunction},
+    {"slice", createSliceFunction},
+    {"find", createFindFunction},
+    {"len", createLenFunction},
+    {"range", createRangeFunction},
+    {"sum", createSumFunction},
+    {"spawn", createSpawnFunction},
+    {"waitAll", createWaitAllFunction},
+    {"waitAny", createWaitAnyFunction},
+    {"async", createAsyncFunction},
+    {"await", createAwaitFunction},
+    {"sleep", createSleepFunction},
     {"DEBUG_LOG", createDebugLogFunction}
 };
 
@@ -120,6 +120,17 @@ void AnyNode::validateMutability(const Node& value) {
     }
 }
 
+// An instance's values live in its native container; instance fields live in its own scope.
+void AnyNode::freezeChildren() const {
+    if (const auto* callable = std::get_if<SharedPtr<Callable>>(&value)) {
+        if (auto instance = std::dynamic_pointer_cast<ClassInstance>(*callable)) {
+            if (auto data = instance->getNativeData()) { data->freeze(); }
+        }
+    } else if (const auto* native = std::get_if<SharedPtr<NativeNode>>(&value)) {
+        if (*native) { (*native)->freeze(); }
+    }
+}
+
 SharedPtr<NodeBase> AnyNode::clone() const {
     auto node = makeShared<AnyNode>(*this); 
     node->flags = flags;
@@ -18,8 +18,8 @@ bool NodeBase::isValid() const { return false; }
 bool NodeBase::isNumeric() const { throw MerkError("isNumeric Called On NodeBase"); }
 
 
-SharedPtr<NodeBase> Node::getInner() { return data; }
-SharedPtr<NodeBase> Node::getInner() const { return data; }
+SharedPtr<NodeBase> Node::getInner() { return data.shared(); }
+SharedPtr<NodeBase> Node::getInner() const { return data.shared(); }
 
 
 
@@ -65,6 +65,43 @@ void NodeBase::setFlags(DataTypeFlags newOnes) {
 }
 
 
+namespace {
+
+class AnchorGuard {
+    std::atomic_flag& lock;
+public:
+    explicit AnchorGuard(std::atomic_flag& flag) : lock(flag) {
+        while (lock.test_and_set(std::memory_order_acquire)) {}
+    }
+    ~AnchorGuard() { lock.clear(std::memory_order_release); }
+};
+
+} // namespace
+
+// Frozen: another thread may be dropping the last handle right now.
+void NodeBase::adoptFrozenHandle(SharedPtr<NodeBase>&& owner) const {
+    AnchorGuard guard(handles.anchorLock);
+    if (std::atomic_ref<std::uint32_t>(handles.count).fetch_add(1, std::memory_order_acq_rel) == 0 || !handles.anchor) {
+        handles.anchor = std::move(owner);
+    }
+}
+
+void NodeBase::releaseFrozenHandle() const {
+    // The anchor may be the last owner, so it is only dropped once nothing here is touched again.
+    SharedPtr<NodeBase> last;
+    std::atomic_ref<std::uint32_t> count(handles.count);
+    if (count.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+    AnchorGuard guard(handles.anchorLock);
+    if (count.load(std::memory_order_acquire) == 0) last = std::move(handles.anchor);
+}
+
+// Values are frozen by the thread that owns them, before anyone else can see them.
+void NodeBase::freeze() const {
+    if (handles.frozen) return;
+    handles.frozen = true;
+    freezeChildren();
+}
+
 bool NodeBase::isList() const {
         if (flags.fullType.getBaseType() == "List" ) { return true; }
         if (TypeEvaluator::getTypeFromValue(getValue()) == NodeValueType::List) { return true; }
@@ -302,7 +339,16 @@ FunctionNode Node::toFunctionNode() const {
     throw MerkError("Cannot Cast A Simple Node To A FUnctionNode");
 }
 
-void Node::setFlags(DataTypeFlags newOnes) { data->setFlags(newOnes); }
+// Frozen values are shared read-only (literals, values sent between threads): writers take a private copy.
+void Node::detachIfFrozen() {
+    if (data && data->isFrozen()) {
+        auto own = data->clone();
+        own->flags = data->flags;
+        data = own;
+    }
+}
+
+void Node::setFlags(DataTypeFlags newOnes) { detachIfFrozen(); data->setFlags(newOnes); }
 VariantType Node::getValue() const { return data->getValue(); }
 void Node::setValue(const VariantType& v) {
     if (!data) {
@@ -315,6 +361,7 @@ void Node::setValue(const VariantType& v) {
             return;
         }
     }
+    detachIfFrozen();
     data->setValue(v); 
 }
 
@@ -426,7 +473,10 @@ Node Node::negate() const {
     throw MerkError("Unary '-' requires a numeric operand, got " + nodeTypeToString(getType(), false));
 }
 
-DataTypeFlags& Node::getFlags() { return data->flags; }
+DataTypeFlags& Node::getFlags() {
+    detachIfFrozen();
+    return data->flags;
+}
 const DataTypeFlags& Node::getFlags() const { return data->flags; }
 
 void Node::clear() { if (data) {data->clear();} }
@@ -472,23 +522,76 @@ bool BoolNode::isTruthy() const { return toBool(); }
 bool StringNode::isNumeric() const {return false;}
 bool StringNode::isString() const { return true; }
 bool StringNode::isValid() const {return true;}
-bool StringNode::isBool() const {return value == "true" || value == "false" || value == "0" || value == "1";}
-bool StringNode::isTruthy() const {return !value.empty() || value == "true" || value == "1" || value != "null";}
+bool StringNode::isBool() const {
+    const auto v = view();
+    return v == "true" || v == "false" || v == "0" || v == "1";
+}
+bool StringNode::isTruthy() const {return length != 0 || view() != "null";}
 
 // StringNode
-VariantType StringNode::getValue() const { return value; }
-void StringNode::setValue(const VariantType& v)  { value = std::get<String>(v); }
+VariantType StringNode::getValue() const { return String(view()); }
+void StringNode::setValue(const VariantType& v)  {
+    buffer = makeShared<String>(std::get<String>(v));
+    offset = 0;
+    length = buffer->size();
+}
 
 NodeValueType StringNode::getType() const { return NodeValueType::String; }
 SharedPtr<NodeBase> StringNode::clone() const { return makeShared<StringNode>(*this); }
 
 int StringNode::toInt() const { throw MerkError("Cannot Implicitly cast String to Int"); }
-String StringNode::toString() const { return String(value); }
+String StringNode::toString() const { return String(view()); }
 std::size_t StringNode::hash() const {
     const std::size_t typeHash = static_cast<std::size_t>(NodeValueType::String) * 0x9e3779b97f4a7c15ULL;
-    return typeHash ^ (std::hash<String>{}(value) + 0x9e3779b9 + (typeHash << 6) + (typeHash >> 2));
+    return typeHash ^ (std::hash<std::string_view>{}(view()) + 0x9e3779b9 + (typeHash << 6) + (typeHash >> 2));
+}
+bool StringNode::toBool() const { return length != 0; }
+
+const String& StringNode::rawValue() const {
+    // Detach from the shared buffer so the reference cannot grow under the caller.
+    if (offset != 0 || !ownsTail() || buffer.use_count() > 1) {
+        buffer = makeShared<String>(view());
+        offset = 0;
+    }
+    return *buffer;
+}
+
+void StringNode::append(std::string_view tail) {
+    if (!ownsTail()) {
+        auto detached = makeShared<String>();
+        detached->reserve(std::max<std::size_t>((length + tail.size()) * 2, 16));
+        detached->append(view());
+        buffer = std::move(detached);
+        offset = 0;
+    }
+    buffer->append(tail.data(), tail.size());
+    length = buffer->size() - offset;
+}
+
+SharedPtr<StringNode> StringNode::slice(std::size_t start, std::size_t end) const {
+    end = std::min(end, length);
+    start = std::min(start, end);
+    return makeShared<StringNode>(buffer, offset + start, end - start);
+}
+
+void StringNode::detachIfSparse() const {
+    const std::size_t parentSize = buffer->size();
+    if (parentSize < kSliceCopyOutMinParent) { return; }
+    if (length * kSliceCopyOutRatio >= parentSize) { return; }
+    buffer = makeShared<String>(view());
+    offset = 0;
+}
+
+SharedPtr<StringNode> StringNode::concat(std::string_view tail) const {
+    if (ownsTail()) {
+        buffer->append(tail.data(), tail.size());
+        return makeShared<StringNode>(buffer, offset, length + tail.size());
+    }
+    auto out = makeShared<StringNode>(String());
+    out->append(view());
+    out->append(tail);
+    return out;
 }
-bool StringNode::toBool() const { return !value.empty(); }
 
 
 // CharNode
@@ -665,7 +768,8 @@ String VarNode::varString() const { return NodeWrapper::toString() + (!varFlags.
 
 void VarNode::setValue(Node other) {
     DEBUG_FLOW(FlowLevel::PERMISSIVE);
-    if (std::holds_alternative<NullType>(other.getValue()) || other.getType() == NodeValueType::Null) {
+    // Strings are never null; avoid copying their buffer out through getValue().
+    if (!other.isString() && (std::holds_alternative<NullType>(other.getValue()) || other.getType() == NodeValueType::Null)) {
         if (other.getType() == NodeValueType::Null && !std::holds_alternative<NullType>(other.getValue())) {
             throw MerkError("Tried Setting value typed as null, but actually isn't. It is type " + nodeTypeToString(TypeEvaluator::getTypeFromValue(other.getValue())));
         }
@@ -694,6 +798,7 @@ void VarNode::setValue(Node other) {
     const NodeValueType currType = valueNode.getType();
     const NodeValueType nextType = other.getType();
     const bool canUpdateInPlace =
+        !borrowed &&
         valueNode.isValid() &&
         currType == nextType &&
         (nextType == NodeValueType::Int ||
@@ -705,6 +810,8 @@ void VarNode::setValue(Node other) {
         valueNode.setValue(other.getValue());
     } else {
         valueNode = other;
+        borrowed = false;
+        detachSparseString();
     }
     if (!other.isValid()) {throw MerkError("Other Is Invalid");}
 
@@ -722,13 +829,28 @@ void VarNode::setValue(Node other) {
         varFlags.type = valueNode.getType();
     }
 
-    if (std::holds_alternative<NullType>(getValueNode().getValue()) || getValueNode().getType() == NodeValueType::Null) {
+    if (!valueNode.isString() && (std::holds_alternative<NullType>(getValueNode().getValue()) || getValueNode().getType() == NodeValueType::Null)) {
         throw MerkError("Var " + varFlags.name + " was set to Null during the process");
     }
 
     DEBUG_FLOW_EXIT();
 }
 
+void VarNode::bindValue(const Node& value) {
+    if (varFlags.isConst) { throw MerkError("Assignment to const variable"); }
+    if (varFlags.fullType.getBaseType() != "Any" && varFlags.type != NodeValueType::Any && value.getType() != varFlags.type) {
+        throw MerkError("Type Mismatch from declaration: Expected: " + nodeTypeToString(varFlags.type) + ", But Got " + nodeTypeToString(value.getType()));
+    }
+    valueNode = value;
+    borrowed = true;
+}
+
+void VarNode::detachSparseString() {
+    if (valueNode.isValid() && valueNode.getType() == NodeValueType::String) {
+        static_cast<const StringNode*>(valueNode.getInner().get())->detachIfSparse();
+    }
+}
+
 bool VarNode::getIsMutable() {return varFlags.isMutable;}
 bool VarNode::getIsStatic() {return varFlags.isMutable;}
 bool VarNode::getIsConst() {return varFlags.isConst;}
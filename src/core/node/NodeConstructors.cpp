@@ -236,10 +236,19 @@ BoolNode::BoolNode(VariantType v) {
     
 }
 
-StringNode::StringNode(String v) : value(v) { flags.type = NodeValueType::String; flags.fullType.setBaseType("String");}
+StringNode::StringNode(String v) : buffer(makeShared<String>(std::move(v))) {
+    length = buffer->size();
+    flags.type = NodeValueType::String;
+    flags.fullType.setBaseType("String");
+}
+StringNode::StringNode(SharedPtr<String> sharedBuffer, std::size_t start, std::size_t len) : buffer(std::move(sharedBuffer)), offset(start), length(len) {
+    if (!buffer || offset + length > buffer->size()) { throw MerkError("StringNode view exceeds its buffer"); }
+    flags.type = NodeValueType::String;
+    flags.fullType.setBaseType("String");
+}
 // StringNode::StringNode(VariantType v) : value(v) { flags.type = NodeValueType::String; flags.fullType.setBaseType("String");}
 
-void StringNode::clear() {value = "";}
+void StringNode::clear() { buffer = makeShared<String>(); offset = 0; length = 0; }
 
 IntNode::IntNode(int v) : value(v) {    
     DEBUG_FLOW(FlowLevel::PERMISSIVE);
@@ -451,7 +460,10 @@ VarNode::VarNode(Node startingValue, DataTypeFlags declFlags) {
         valueNode = startingValue.clone();
         valueNode.getFlags().applyRuntimeIdentityFromValue(startingValue.getFlags());
     } else if (shareByMutability) {
+        // Shared with the initializer (a literal, an argument, a yielded value):
+        // the first assignment must rebind rather than write through it.
         valueNode = startingValue;
+        borrowed = true;
     } else {
         valueNode = startingValue.clone();
         valueNode.getFlags().applyRuntimeIdentityFromValue(startingValue.getFlags());
@@ -476,6 +488,7 @@ VarNode::VarNode(Node startingValue, DataTypeFlags declFlags) {
     // can reliably enforce parameter-level mutability.
     valueNode.getFlags().isMutable = varFlags.isMutable;
     valueNode.getFlags().isConst = varFlags.isConst;
+    detachSparseString();
 
     typeIdBasedValidation(startingValue, varFlags);
     stringBasedValidation(valueNode, varFlags);
@@ -537,6 +550,7 @@ VarNode::VarNode(const Node value) {
 VarNode::VarNode(const VarNode& other): NodeWrapper(other.getValueNode()) {
     DEBUG_FLOW(FlowLevel::PERMISSIVE);
     varFlags = other.varFlags;
+    borrowed = other.borrowed;
     DEBUG_FLOW_EXIT();
 }
 
@@ -544,6 +558,10 @@ VarNode::VarNode(const VarNode& other): NodeWrapper(other.getValueNode()) {
 // LitNode
 LitNode::LitNode() = default;
 
+LitNode::LitNode(Node value) : NodeWrapper(std::move(value)) {
+    if (!getValueNode().isValid()) { throw MerkError("LiteralNode is invalid at construction"); }
+}
+
 LitNode::LitNode(const String& value, const String& typeStr) {
     DEBUG_FLOW(FlowLevel::PERMISSIVE);
     String typeOf = typeStr;
@@ -643,8 +661,7 @@ Node::Node(SharedPtr<SetNode> v) {
 Node& Node::operator=(const Node& other) {
     if (this == &other) return *this;
 
-    data = other.data;
-    data->flags = other.getFlags(); // always copy full flags
+    data = other.data; // shares other's NodeBase, flags included
     return *this;
 }
 
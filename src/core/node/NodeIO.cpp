@@ -6,6 +6,8 @@
 #include "algorithm"
 #include "core/evaluators/Evaluator.hpp"
 #include "core/evaluators/TypeEvaluator.hpp"
+#include "core/evaluators/EventLoop.hpp"
+#include "core/evaluators/Future.hpp"
 
 #include <curl/curl.h>
 #include <functional> 
@@ -75,11 +77,26 @@ HttpNode::HttpNode(SharedPtr<ClassInstanceNode> instanceNode): InstanceBoundNati
 HttpNode::~HttpNode() {}
 
 
-Node HttpNode::send() {
-    auto inst = getInstance();
-    if (!inst) throw MerkError("HttpNode has no bound instance");
+namespace {
 
-    
+// One request's curl state: the easy handle, header list and buffers live and die together.
+struct HttpExchange {
+    CURL* easy = nullptr;
+    curl_slist* headers = nullptr;
+    String method;
+    String body;
+    String response;
+
+    HttpExchange() = default;
+    HttpExchange(const HttpExchange&) = delete;
+    HttpExchange& operator=(const HttpExchange&) = delete;
+    ~HttpExchange() {
+        if (headers) curl_slist_free_all(headers);
+        if (easy) curl_easy_cleanup(easy);
+    }
+};
+
+UniquePtr<HttpExchange> prepareExchange(SharedPtr<ClassInstance> inst) {
     auto url    = getStringField(inst, "url");
     auto method = getStringField(inst, "method");
 
@@ -87,58 +104,50 @@ Node HttpNode::send() {
     auto bodyDict    = getDictField(inst, "body");
     // for now body is just a dict, instead of string
 
-    String bodyStr;
-
-    CURL* curl = curl_easy_init();
-    if (!curl) throw MerkError("curl_easy_init failed");
-
-    String response;
-    long status = 0;
-    curl_slist* hdrList = nullptr;
-
-    try {
-        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-        curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
-        curl_easy_setopt(curl, CURLOPT_TIMEOUT, 30L);
-        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeToString);
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
-
-        // headers
-        hdrList = dictToCurlHeaders(*headersDict);
-        if (hdrList) curl_easy_setopt(curl, CURLOPT_HTTPHEADER, hdrList);
-
-        // method
-        auto m = method; 
-        for (auto& c : m) c = std::toupper(static_cast<unsigned char>(c));
-        if (m == "GET") {
-            curl_easy_setopt(curl, CURLOPT_HTTPGET, 1L);
-        } else if (m == "POST") {
-            curl_easy_setopt(curl, CURLOPT_POST, 1L);
+    auto exchange = makeUnique<HttpExchange>();
+    exchange->easy = curl_easy_init();
+    if (!exchange->easy) throw MerkError("curl_easy_init failed");
+    CURL* curl = exchange->easy;
+
+    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT, 30L);
+    curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeToString);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &exchange->response);
+
+    // headers
+    exchange->headers = dictToCurlHeaders(*headersDict);
+    if (exchange->headers) curl_easy_setopt(curl, CURLOPT_HTTPHEADER, exchange->headers);
+
+    // method; curl keeps pointers to these, not copies
+    auto& m = exchange->method;
+    m = method;
+    for (auto& c : m) c = std::toupper(static_cast<unsigned char>(c));
+    const String& bodyStr = exchange->body;
+    if (m == "GET") {
+        curl_easy_setopt(curl, CURLOPT_HTTPGET, 1L);
+    } else if (m == "POST") {
+        curl_easy_setopt(curl, CURLOPT_POST, 1L);
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, bodyStr.c_str());
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, bodyStr.size());
+    } else if (m == "PUT" || m == "PATCH" || m == "DELETE") {
+        curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, m.c_str());
+        if (m != "DELETE") {
             curl_easy_setopt(curl, CURLOPT_POSTFIELDS, bodyStr.c_str());
             curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, bodyStr.size());
-        } else if (m == "PUT" || m == "PATCH" || m == "DELETE") {
-            curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, m.c_str());
-            if (m != "DELETE") {
-                curl_easy_setopt(curl, CURLOPT_POSTFIELDS, bodyStr.c_str());
-                curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, bodyStr.size());
-            }
-        } else {
-            curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, m.c_str());
         }
-
-        auto rc = curl_easy_perform(curl);
-        if (rc != CURLE_OK) {
-            throw MerkError(String("HTTP error: ") + curl_easy_strerror(rc));
-        }
-        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &status);
-    } catch (...) {
-        if (hdrList) curl_slist_free_all(hdrList);
-        curl_easy_cleanup(curl);
-        throw;
+    } else {
+        curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, m.c_str());
     }
+    return exchange;
+}
 
-    if (hdrList) curl_slist_free_all(hdrList);
-    curl_easy_cleanup(curl);
+// Records the outcome on the Http instance and builds the response.
+Node finishExchange(SharedPtr<ClassInstance> inst, const HttpExchange& exchange) {
+    long status = 0;
+    curl_easy_getinfo(exchange.easy, CURLINFO_RESPONSE_CODE, &status);
+    const String& response = exchange.response;
 
     auto scope = inst->getInstanceScope();
 
@@ -164,9 +173,42 @@ Node HttpNode::send() {
 
     if (!respNode.isInstance()) {throw MerkError("The response is not an instance");}
     return respNode;
+}
+
+Async::Task runExchange(EventLoop& loop, SharedPtr<ClassInstance> inst, UniquePtr<HttpExchange> exchange, SharedPtr<FutureState> state) {
+    try {
+        const CURLcode rc = co_await loop.perform(exchange->easy);
+        if (rc != CURLE_OK) throw MerkError(String("HTTP error: ") + curl_easy_strerror(rc));
+        state->complete(finishExchange(inst, *exchange), nullptr);
+    } catch (...) {
+        state->complete(Node(), std::current_exception());
+    }
+}
+
+} // namespace
+
+
+Node HttpNode::send() {
+    auto inst = getInstance();
+    if (!inst) throw MerkError("HttpNode has no bound instance");
 
+    auto exchange = prepareExchange(inst);
+    auto rc = curl_easy_perform(exchange->easy);
+    if (rc != CURLE_OK) {
+        throw MerkError(String("HTTP error: ") + curl_easy_strerror(rc));
+    }
+    return finishExchange(inst, *exchange);
 } // performs the HTTP request and returns a response Node
 
+SharedPtr<FutureState> HttpNode::sendAsync() {
+    auto inst = getInstance();
+    if (!inst) throw MerkError("HttpNode has no bound instance");
+
+    auto state = FutureState::pending();
+    runExchange(EventLoop::current(), inst, prepareExchange(inst), state);
+    return state;
+}
+
 
 String HttpNode::toString() const {
     return "";
@@ -229,6 +271,7 @@ SharedPtr<NodeBase> FileNode::clone() const {
 
 String FileNode::readAll() {
     if (!isOpen()) open();
+    dropLineChunk();
     std::ostringstream oss;
     oss << stream.rdbuf();
     return oss.str();
@@ -239,33 +282,82 @@ String FileNode::read(size_t n = 0) {
         return readAll();
     }
     if (!isOpen()) open();
+    dropLineChunk();
     String s(n, '\0');
     stream.read(&s[0], static_cast<std::streamsize>(n));
     s.resize(static_cast<size_t>(stream.gcount()));
     return s;
 }
 
+bool FileNode::refillLineChunk() {
+    const std::size_t carry = lineChunk ? lineChunk->size() - lineChunkPos : 0;
+
+    // Lines handed out earlier may still view the old chunk; only reuse it when nobody does.
+    if (lineChunk && lineChunk.use_count() == 1) {
+        lineChunk->erase(0, lineChunkPos);
+    } else {
+        auto next = makeShared<String>();
+        next->reserve(carry + kLineChunkSize);
+        if (lineChunk) { next->append(*lineChunk, lineChunkPos, carry); }
+        lineChunk = std::move(next);
+    }
+    lineChunkPos = 0;
+
+    lineChunk->resize(carry + kLineChunkSize);
+    stream.read(lineChunk->data() + carry, static_cast<std::streamsize>(kLineChunkSize));
+    const auto got = static_cast<std::size_t>(stream.gcount());
+    lineChunk->resize(carry + got);
+    if (got == 0 && !stream.eof()) { throw MerkError("File.readLine failed"); }
+    return got != 0;
+}
+
+void FileNode::dropLineChunk() {
+    if (!lineChunk) { return; }
+    const auto unread = static_cast<std::streamoff>(lineChunk->size() - lineChunkPos);
+    lineChunk.reset();
+    lineChunkPos = 0;
+    if (unread != 0 && stream.is_open()) {
+        stream.clear();
+        stream.seekg(-unread, std::ios::cur);
+    }
+}
+
 Node FileNode::readLineNode() {
     if (!isOpen()) open();
-    String line;
-    if (!std::getline(stream, line)) {
-        if (stream.eof()) {
-            stream.clear();
-            return Node(Null);
+    for (;;) {
+        if (lineChunk) {
+            const auto newline = lineChunk->find('\n', lineChunkPos);
+            if (newline != String::npos) {
+                const auto start = lineChunkPos;
+                lineChunkPos = newline + 1;
+                return Node(makeShared<StringNode>(lineChunk, start, newline - start));
+            }
         }
-        throw MerkError("File.readLine failed");
+        if (!refillLineChunk()) { break; }
+    }
+
+    // EOF: a final line without a trailing newline is still a line. A view of it would own the
+    // chunk's tail and append into the reader's buffer, so it is copied out.
+    if (lineChunk && lineChunkPos < lineChunk->size()) {
+        String last = lineChunk->substr(lineChunkPos);
+        lineChunk.reset();
+        lineChunkPos = 0;
+        return Node(makeShared<StringNode>(std::move(last)));
     }
-    return Node(line);
+    stream.clear();
+    return Node(Null);
 }
 
 void FileNode::write(String s) {
     if (!isOpen()) open();
+    dropLineChunk();
     stream.write(s.data(), static_cast<std::streamsize>(s.size()));
     if (!stream) throw MerkError("File.write failed");
 }
 
 void FileNode::writeLine(const String& s) {
     if (!isOpen()) open();
+    dropLineChunk();
     stream.write(s.data(), static_cast<std::streamsize>(s.size()));
     stream.put('\n');
     if (!stream) throw MerkError("File.writeLine failed");
@@ -279,17 +371,20 @@ void FileNode::flush() {
 
 bool FileNode::eof() {
     if (!isOpen()) open();
+    if (lineChunk && lineChunkPos < lineChunk->size()) { return false; }
     return stream.eof();
 }
 
 void FileNode::writeBytes(const std::vector<uint8_t>& b) {
     if (!isOpen()) open();
+    dropLineChunk();
     stream.write(reinterpret_cast<const char*>(b.data()), static_cast<std::streamsize>(b.size()));
     if (!stream) throw MerkError("File.writeBytes failed");
 }
 
 void FileNode::seek(std::streamoff pos, std::ios_base::seekdir dir) {
     if (!isOpen()) open();
+    dropLineChunk();
     stream.clear();
     stream.seekg(pos, dir);
     stream.seekp(pos, dir);
@@ -297,6 +392,7 @@ void FileNode::seek(std::streamoff pos, std::ios_base::seekdir dir) {
 
 std::streamoff FileNode::tell() {
     if (!isOpen()) open();
+    dropLineChunk();
     return stream.tellg(); // for text reads this is fine; could prefer tellp when writing
 }
 
@@ -307,3 +403,49 @@ void FileNode::removeFile(const String& path) {
     std::filesystem::remove(path, ec);
     if (ec) throw MerkError("File.remove failed: " + ec.message());
 }
+
+namespace {
+
+Async::Task runFileRead(EventLoop& loop, String path, SharedPtr<FutureState> state) {
+    String text;
+    try {
+        co_await loop.offload([&] {
+            std::ifstream ifs(path, std::ios::binary);
+            if (!ifs) throw MerkError("File.readAsync failed: " + path);
+            std::ostringstream oss;
+            oss << ifs.rdbuf();
+            text = oss.str();
+        });
+        state->complete(Node(std::move(text)), nullptr);
+    } catch (...) {
+        state->complete(Node(), std::current_exception());
+    }
+}
+
+Async::Task runFileWrite(EventLoop& loop, String path, String data, bool append, SharedPtr<FutureState> state) {
+    try {
+        co_await loop.offload([&] {
+            std::ofstream ofs(path, std::ios::binary | (append ? std::ios::app : std::ios::trunc));
+            if (!ofs) throw MerkError("File.writeAsync failed: " + path);
+            ofs.write(data.data(), static_cast<std::streamsize>(data.size()));
+            if (!ofs) throw MerkError("File.writeAsync write failed: " + path);
+        });
+        state->complete(Node(static_cast<int>(data.size())), nullptr);
+    } catch (...) {
+        state->complete(Node(), std::current_exception());
+    }
+}
+
+} // namespace
+
+SharedPtr<FutureState> FileNode::readAllAsync(const String& path) {
+    auto state = FutureState::pending();
+    runFileRead(EventLoop::current(), path, state);
+    return state;
+}
+
+SharedPtr<FutureState> FileNode::writeAllAsync(const String& path, String data, bool append) {
+    auto state = FutureState::pending();
+    runFileWrite(EventLoop::current(), path, std::move(data), append, state);
+    return state;
+}
@@ -0,0 +1,150 @@
+#include "core/node/NodeStructures.hpp"
+#include "core/callables/classes/ClassBase.hpp"
+#include "core/errors.h"
+
+// Iterators hand out the stored element Nodes themselves (no copies); the loop
+// variable binding is responsible for not writing through them.
+
+namespace {
+
+class ListIterator : public NodeIterator {
+    SharedPtr<const ListNode> list;
+    std::size_t index = 0;
+public:
+    explicit ListIterator(SharedPtr<const ListNode> source) : list(std::move(source)) {}
+
+    bool next(Node& out) override {
+        // Size is re-read each step so appends inside the loop body are visited.
+        const NodeList& elements = list->getElements();
+        if (index >= elements.size()) return false;
+        out = elements[index++];
+        return true;
+    }
+};
+
+template <typename Container, typename Owner>
+class HashedIterator : public NodeIterator {
+    SharedPtr<const Owner> owner;
+    const Container& elements;
+    typename Container::const_iterator it;
+    std::size_t expectedSize;
+    const char* kind;
+public:
+    HashedIterator(SharedPtr<const Owner> source, const char* kindName)
+        : owner(std::move(source)),
+          elements(owner->getElements()),
+          it(elements.begin()),
+          expectedSize(elements.size()),
+          kind(kindName) {}
+
+    bool next(Node& out) override {
+        if (elements.size() != expectedSize) {
+            throw MerkError(String(kind) + " changed size during iteration");
+        }
+        if (it == elements.end()) return false;
+        if constexpr (std::is_same_v<Container, std::unordered_map<Node, Node>>) {
+            out = it->first;
+        } else {
+            out = *it;
+        }
+        ++it;
+        return true;
+    }
+};
+
+using DictKeyIterator = HashedIterator<std::unordered_map<Node, Node>, DictNode>;
+using SetIterator = HashedIterator<std::unordered_set<Node>, SetNode>;
+
+class RangeIterator : public NodeIterator {
+    int current;
+    int stop;
+    int step;
+public:
+    RangeIterator(int start, int stopAt, int stepBy) : current(start), stop(stopAt), step(stepBy) {}
+
+    bool next(Node& out) override {
+        if (step > 0 ? current >= stop : current <= stop) return false;
+        out = Node(current);
+        current += step;
+        return true;
+    }
+};
+
+class FileLineIterator : public NodeIterator {
+    SharedPtr<FileNode> file;
+public:
+    explicit FileLineIterator(SharedPtr<FileNode> source) : file(std::move(source)) {}
+
+    bool next(Node& out) override {
+        Node line = file->readLineNode();
+        if (line.isNull()) return false;
+        out = line;
+        return true;
+    }
+};
+
+// Characters come out as one-byte slices of the original buffer.
+class StringCharIterator : public NodeIterator {
+    SharedPtr<const StringNode> source;
+    std::size_t index = 0;
+public:
+    explicit StringCharIterator(SharedPtr<const StringNode> str) : source(std::move(str)) {}
+
+    bool next(Node& out) override {
+        if (index >= source->size()) return false;
+        out = Node(std::static_pointer_cast<NodeBase>(source->slice(index, index + 1)));
+        ++index;
+        return true;
+    }
+};
+
+} // namespace
+
+UniquePtr<NodeIterator> NativeNode::makeIterator() const {
+    throw MerkError(getTypeAsString() + " is not iterable");
+}
+
+UniquePtr<NodeIterator> ListNode::makeIterator() const {
+    return makeUnique<ListIterator>(std::static_pointer_cast<const ListNode>(shared_from_this()));
+}
+
+UniquePtr<NodeIterator> DictNode::makeIterator() const {
+    return makeUnique<DictKeyIterator>(std::static_pointer_cast<const DictNode>(shared_from_this()), "Dict");
+}
+
+UniquePtr<NodeIterator> SetNode::makeIterator() const {
+    return makeUnique<SetIterator>(std::static_pointer_cast<const SetNode>(shared_from_this()), "Set");
+}
+
+UniquePtr<NodeIterator> RangeNode::makeIterator() const {
+    return makeUnique<RangeIterator>(start, stop, step);
+}
+
+UniquePtr<NodeIterator> FileNode::makeIterator() const {
+    auto self = std::const_pointer_cast<FileNode>(std::static_pointer_cast<const FileNode>(shared_from_this()));
+    return makeUnique<FileLineIterator>(std::move(self));
+}
+
+UniquePtr<NodeIterator> makeNodeIterator(const Node& iterable) {
+    if (!iterable.isValid()) {
+        throw MerkError("Cannot iterate over an invalid value");
+    }
+
+    if (iterable.isInstance()) {
+        auto native = iterable.toInstance()->getNativeData();
+        if (!native) {
+            throw MerkError("Instance of " + iterable.toInstance()->getName() + " is not iterable");
+        }
+        return native->makeIterator();
+    }
+
+    if (iterable.isString()) {
+        return makeUnique<StringCharIterator>(std::static_pointer_cast<const StringNode>(iterable.getInner()));
+    }
+
+    if (auto native = std::dynamic_pointer_cast<NativeNode>(iterable.getInner())) {
+        return native->makeIterator();
+    }
+
+    throw MerkError(iterable.getTypeAsString() + " is not iterable");
+}
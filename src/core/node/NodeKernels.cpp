@@ -0,0 +1,220 @@
+#include "core/node/NodeKernels.hpp"
+
+#include <array>
+#include <utility>
+
+namespace NodeKernels {
+
+namespace {
+
+using Kernel = bool (*)(const NodeBase& lhs, const NodeBase& rhs, Node& out);
+using KernelRow = std::array<std::array<Kernel, kKindCount>, kKindCount>;
+using KernelTable = std::array<KernelRow, kBinaryOpCount>;
+
+constexpr size_t index(Kind kind) { return static_cast<size_t>(kind); }
+
+template <BinaryOp Op, typename T>
+constexpr bool compareValues(const T& lhs, const T& rhs) {
+    if constexpr (Op == BinaryOp::Eq) return lhs == rhs;
+    else if constexpr (Op == BinaryOp::Ne) return lhs != rhs;
+    else if constexpr (Op == BinaryOp::Lt) return lhs < rhs;
+    else if constexpr (Op == BinaryOp::Le) return lhs <= rhs;
+    else if constexpr (Op == BinaryOp::Gt) return lhs > rhs;
+    else return lhs >= rhs;
+}
+
+// A StringNode lends its text; anything else answering isString is copied into `scratch`.
+std::string_view textOf(const NodeBase& node, String& scratch) {
+    if (node.getType() == NodeValueType::String) {
+        return static_cast<const StringNode&>(node).view();
+    }
+    scratch = node.toString();
+    return scratch;
+}
+
+template <BinaryOp Op>
+bool intKernel(const NodeBase& lhs, const NodeBase& rhs, Node& out) {
+    const int a = lhs.toInt();
+    const int b = rhs.toInt();
+    if constexpr (isComparisonOp(Op)) {
+        out = Node(compareValues<Op>(a, b));
+    } else {
+        int result = 0;
+        applyInt(Op, a, b, result);
+        out = Node(result);
+    }
+    return true;
+}
+
+template <BinaryOp Op>
+bool numericKernel(const NodeBase& lhs, const NodeBase& rhs, Node& out) {
+    const double a = lhs.toDouble();
+    const double b = rhs.toDouble();
+    if constexpr (isComparisonOp(Op)) {
+        out = Node(compareValues<Op>(a, b));
+    } else if constexpr (Op == BinaryOp::Add) {
+        out = Node(a + b);
+    } else if constexpr (Op == BinaryOp::Sub) {
+        out = Node(a - b);
+    } else if constexpr (Op == BinaryOp::Mul) {
+        out = Node(a * b);
+    } else {
+        if (b == 0.0) throw MerkError("Division by zero");
+        out = Node(a / b);
+    }
+    return true;
+}
+
+template <BinaryOp Op>
+bool stringKernel(const NodeBase& lhs, const NodeBase& rhs, Node& out) {
+    String lhsScratch;
+    String rhsScratch;
+    const std::string_view a = textOf(lhs, lhsScratch);
+    const std::string_view b = textOf(rhs, rhsScratch);
+    if constexpr (Op == BinaryOp::Add) {
+        String joined;
+        joined.reserve(a.size() + b.size());
+        joined.append(a).append(b);
+        out = Node(std::move(joined));
+    } else {
+        out = Node(compareValues<Op>(a, b));
+    }
+    return true;
+}
+
+template <BinaryOp Op>
+bool boolKernel(const NodeBase& lhs, const NodeBase& rhs, Node& out) {
+    const bool a = lhs.toBool();
+    const bool b = rhs.toBool();
+    if constexpr (Op == BinaryOp::And) out = Node(a && b);
+    else if constexpr (Op == BinaryOp::Or) out = Node(a || b);
+    else out = Node(compareValues<Op>(a, b));
+    return true;
+}
+
+// A string against a bool is only a bool operation when the string reads as one.
+template <BinaryOp Op>
+bool stringBoolKernel(const NodeBase& lhs, const NodeBase& rhs, Node& out) {
+    if (!lhs.isBool() || !rhs.isBool()) return false;
+    return boolKernel<Op>(lhs, rhs, out);
+}
+
+template <BinaryOp Op>
+constexpr void fillRow(KernelRow& row) {
+    constexpr bool arithmetic = Op <= BinaryOp::Mod;
+    constexpr bool comparison = isComparisonOp(Op);
+    constexpr size_t I = index(Kind::Int);
+    constexpr size_t D = index(Kind::Double);
+    constexpr size_t S = index(Kind::String);
+    constexpr size_t B = index(Kind::Bool);
+
+    if constexpr (arithmetic || comparison) {
+        row[I][I] = &intKernel<Op>;
+    }
+    if constexpr ((arithmetic && Op != BinaryOp::Mod) || comparison) {
+        row[I][D] = &numericKernel<Op>;
+        row[D][I] = &numericKernel<Op>;
+        row[D][D] = &numericKernel<Op>;
+    }
+    if constexpr (Op == BinaryOp::Add || comparison) {
+        row[S][S] = &stringKernel<Op>;
+    }
+    if constexpr (Op == BinaryOp::And || Op == BinaryOp::Or || Op == BinaryOp::Eq || Op == BinaryOp::Ne) {
+        row[B][B] = &boolKernel<Op>;
+        row[S][B] = &stringBoolKernel<Op>;
+        row[B][S] = &stringBoolKernel<Op>;
+    }
+}
+
+template <size_t... Ops>
+constexpr KernelTable buildTable(std::index_sequence<Ops...>) {
+    KernelTable table{};
+    (fillRow<static_cast<BinaryOp>(Ops)>(table[Ops]), ...);
+    return table;
+}
+
+constexpr KernelTable kKernels = buildTable(std::make_index_sequence<kBinaryOpCount>{});
+
+BinaryOp arithmeticOf(BinaryOp op) {
+    switch (op) {
+        case BinaryOp::AddAssign: return BinaryOp::Add;
+        case BinaryOp::SubAssign: return BinaryOp::Sub;
+        case BinaryOp::MulAssign: return BinaryOp::Mul;
+        case BinaryOp::DivAssign: return BinaryOp::Div;
+        default: throw MerkError("Not a compound assignment operator: " + binaryOpToString(op));
+    }
+}
+
+double applyDouble(BinaryOp op, double lhs, double rhs) {
+    switch (op) {
+        case BinaryOp::Add: return lhs + rhs;
+        case BinaryOp::Sub: return lhs - rhs;
+        case BinaryOp::Mul: return lhs * rhs;
+        default: return lhs / rhs;
+    }
+}
+
+} // namespace
+
+Kind kindOf(const NodeBase& node) {
+    switch (node.getType()) {
+        case NodeValueType::Int: return Kind::Int;
+        case NodeValueType::Float:
+        case NodeValueType::Double: return Kind::Double;
+        case NodeValueType::String: return Kind::String;
+        case NodeValueType::Bool: return Kind::Bool;
+        default: break;
+    }
+    // AnyNode and wrappers answer by what they hold.
+    if (node.isInt()) return Kind::Int;
+    if (node.isFloat() || node.isDouble()) return Kind::Double;
+    if (node.isString()) return Kind::String;
+    if (node.isBool()) return Kind::Bool;
+    return Kind::Other;
+}
+
+bool apply(BinaryOp op, const Node& lhs, const Node& rhs, Node& out) {
+    if (!kEnableOperatorKernels || op == BinaryOp::Unknown) return false;
+    const NodeBase* a = lhs.getInnerPtr();
+    const NodeBase* b = rhs.getInnerPtr();
+    if (!a || !b) return false;
+
+    const Kernel kernel = kKernels[static_cast<size_t>(op)][index(kindOf(*a))][index(kindOf(*b))];
+    return kernel && kernel(*a, *b, out);
+}
+
+void applyInPlace(BinaryOp op, NodeBase& target, const NodeBase& rhs) {
+    const BinaryOp arithmetic = arithmeticOf(op);
+    switch (target.getType()) {
+        case NodeValueType::Int: {
+            auto& node = static_cast<IntNode&>(target);
+            int result = 0;
+            applyInt(arithmetic, node.rawValue(), rhs.toInt(), result);
+            node.setRawValue(result);
+            return;
+        }
+        case NodeValueType::Float: {
+            auto& node = static_cast<FloatNode&>(target);
+            node.setRawValue(static_cast<float>(applyDouble(arithmetic, node.rawValue(), rhs.toDouble())));
+            return;
+        }
+        case NodeValueType::Double: {
+            auto& node = static_cast<DoubleNode&>(target);
+            node.setRawValue(applyDouble(arithmetic, node.rawValue(), rhs.toDouble()));
+            return;
+        }
+        default:
+            break;
+    }
+
+    SharedPtr<NodeBase> result;
+    switch (arithmetic) {
+        case BinaryOp::Add: result = target + rhs; break;
+        case BinaryOp::Sub: result = target - rhs; break;
+        case BinaryOp::Mul: result = target * rhs; break;
+        default: result = target / rhs; break;
+    }
+    target.setValue(result->getValue());
+}
+
+} // namespace NodeKernels
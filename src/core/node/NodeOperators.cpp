@@ -1,5 +1,6 @@
 #include "core/node/Node.hpp"
 #include "core/node/NodeStructures.hpp"
+#include "core/node/NodeKernels.hpp"
 #include "core/types.h"
 
 #include "utilities/debugger.h"
@@ -23,66 +24,26 @@ inline bool tryGetIntPair(const NodeBase* lhsData, const NodeBase* rhsData, int&
     rhs = static_cast<const IntNode*>(rhsData)->rawValue();
     return true;
 }
-} // namespace
-
-SharedPtr<NodeBase> AnyNode::applyAdd(const NodeBase& lhs, const NodeBase& rhs) {
-    return lhs + rhs;
-}
-
-SharedPtr<NodeBase> AnyNode::applySub(const NodeBase& lhs, const NodeBase& rhs) {
-    return lhs - rhs;
-}
-
-SharedPtr<NodeBase> AnyNode::applyMul(const NodeBase& lhs, const NodeBase& rhs) {
-    return lhs * rhs;
-}
-
-SharedPtr<NodeBase> AnyNode::applyDiv(const NodeBase& lhs, const NodeBase& rhs) {
-    return lhs / rhs;
-}
-
-SharedPtr<NodeBase> AnyNode::applyMod(const NodeBase& lhs, const NodeBase& rhs) {
-    return lhs % rhs;
-}
-
-
-
-void AnyNode::applyAddMut(NodeBase& lhs, const NodeBase& rhs) {
-    lhs.setValue((lhs + rhs)->getValue());
-}
-
-void AnyNode::applySubMut(NodeBase& lhs, const NodeBase& rhs) {
-    lhs.setValue((lhs - rhs)->getValue());
-}
-
-void AnyNode::applyMulMut(NodeBase& lhs, const NodeBase& rhs) {
-    lhs.setValue((lhs * rhs)->getValue());
-}
-
-void AnyNode::applyDivMut(NodeBase& lhs, const NodeBase& rhs) {
-    lhs.setValue((lhs / rhs)->getValue());
-}
 
-SharedPtr<NodeBase> AnyNode::applyEq(const NodeBase& lhs, const NodeBase& rhs) {
-    return lhs == rhs;
+template <typename T>
+inline Ordering orderOf(const T& lhs, const T& rhs) {
+    if (lhs < rhs) return Ordering::Less;
+    if (rhs < lhs) return Ordering::Greater;
+    if (lhs == rhs) return Ordering::Equal;
+    return Ordering::Unordered;
 }
 
-SharedPtr<NodeBase> AnyNode::applyNeq(const NodeBase& lhs, const NodeBase& rhs) {
-    return lhs != rhs;
+inline bool isFloating(const NodeBase& node) {
+    const NodeValueType type = node.getType();
+    return type == NodeValueType::Float || type == NodeValueType::Double;
 }
 
-SharedPtr<NodeBase> AnyNode::applyLt(const NodeBase& lhs, const NodeBase& rhs) {
-    return lhs < rhs;
-}
-SharedPtr<NodeBase> AnyNode::applyGt(const NodeBase& lhs, const NodeBase& rhs) {
-    return lhs > rhs;
-}
-SharedPtr<NodeBase> AnyNode::applyLe(const NodeBase& lhs, const NodeBase& rhs) {
-    return lhs <= rhs;
-}
-SharedPtr<NodeBase> AnyNode::applyGe(const NodeBase& lhs, const NodeBase& rhs) {
-    return lhs >= rhs;
+// Compound assignment updates these in place, so their type cannot have changed.
+inline bool updatedInPlace(const NodeBase& node) {
+    const NodeValueType type = node.getType();
+    return type == NodeValueType::Int || isFloating(node);
 }
+} // namespace
 
 std::ostream& operator<<(std::ostream& os, const Node& node) {
     os << "(";
@@ -105,15 +66,15 @@ std::ostream& operator<<(std::ostream& os, const Node& node) {
 }
 
 String operator+(const String& lhs, const Node& node) {
-    std::ostringstream oss;
-    oss << lhs << node.toString();
-    return oss.str();
+    String out = lhs;
+    out += node.toString();
+    return out;
 }
 
 String operator+(const Node& node, const String& rhs) {
-    std::ostringstream oss;
-    oss << node.toString() << rhs;
-    return oss.str();
+    String out = node.toString();
+    out += rhs;
+    return out;
 }
 
 
@@ -210,6 +171,9 @@ SharedPtr<NodeBase> AnyNode::operator<=(const NodeBase& other) const {
 SharedPtr<NodeBase> AnyNode::operator>=(const NodeBase& other) const {
     return makeShared<AnyNode>(toInt() >= other.toInt());
 }
+Ordering AnyNode::compare(const NodeBase& other) const {
+    return orderOf(toInt(), other.toInt());
+}
 
 
 
@@ -358,6 +322,12 @@ SharedPtr<NodeBase> NodeBase::operator>(const NodeBase& other) const {(void)othe
 SharedPtr<NodeBase> NodeBase::operator<=(const NodeBase& other) const {(void)other; throw MerkError("Invalid op <="); }
 SharedPtr<NodeBase> NodeBase::operator>=(const NodeBase& other) const {(void)other; throw MerkError("Invalid op >="); }
 
+Ordering NodeBase::compare(const NodeBase& other) const {
+    if ((*this == other)->toBool()) return Ordering::Equal;
+    if ((*this < other)->toBool()) return Ordering::Less;
+    return Ordering::Greater;
+}
+
 
 SharedPtr<NodeBase> NodeBase::operator+=(const NodeBase& other) {(void)other; throw MerkError("Invalid op +="); }
 SharedPtr<NodeBase> NodeBase::operator-=(const NodeBase& other) {(void)other; throw MerkError("Invalid op -="); }
@@ -413,6 +383,8 @@ Node Node::operator+=(const Node& other) const {
     if (!data) {throw MerkError("Cannot perform += on null value");}
     if (!getFlags().isMutable) {throw MerkError("Cannot mutate immutable value with '+='");}
     *this->data += (*other.data);
+    // StringNode::operator+= only ever appends text; skip copying the buffer out for the check.
+    if (data->getType() == NodeValueType::String || updatedInPlace(*data)) { return *this; }
     auto val = this->data->getValue();
     if (TypeEvaluator::getTypeFromValue(val) != getType()) {
         throw MerkError("Cannot Convert from type " + nodeTypeToString(getType()) + " to " + data->getNodeTypeAsString());
@@ -424,6 +396,7 @@ Node Node::operator-=(const Node& other) const {
     if (!data) {throw MerkError("Cannot perform += on null value");}
     if (!getFlags().isMutable) {throw MerkError("Cannot mutate immutable value with '-='");}
     *this->data -= (*other.data);
+    if (updatedInPlace(*data)) { return *this; }
     auto val = this->data->getValue();
     if (TypeEvaluator::getTypeFromValue(val) != getType()) {
         throw MerkError("Cannot Convert from type " + nodeTypeToString(getType()) + " to " + data->getNodeTypeAsString());
@@ -434,6 +407,7 @@ Node Node::operator*=(const Node& other) const {
     if (!data) {throw MerkError("Cannot perform += on null value");}
     if (!getFlags().isMutable) {throw MerkError("Cannot mutate immutable value with '*='");}
     *this->data *= (*other.data);
+    if (updatedInPlace(*data)) { return *this; }
     auto val = this->data->getValue();
     if (TypeEvaluator::getTypeFromValue(val) != getType()) {
         throw MerkError("Cannot Convert from type " + nodeTypeToString(getType()) + " to " + data->getNodeTypeAsString());
@@ -444,6 +418,7 @@ Node Node::operator/=(const Node& other) const {
     if (!data) {throw MerkError("Cannot perform += on null value");}
     if (!getFlags().isMutable) {throw MerkError("Cannot mutate immutable value with '/='");}
     *this->data /= (*other.data);
+    if (updatedInPlace(*data)) { return *this; }
     auto val = this->data->getValue();
     if (TypeEvaluator::getTypeFromValue(val) != getType()) {
         throw MerkError("Cannot Convert from type " + nodeTypeToString(getType()) + " to " + data->getNodeTypeAsString());
@@ -484,49 +459,38 @@ bool Node::operator==(const Node& other) const {
             return static_cast<const DoubleNode*>(data.get())->rawValue() ==
                    static_cast<const DoubleNode*>(other.data.get())->rawValue();
         case NodeValueType::String:
-            return static_cast<const StringNode*>(data.get())->rawValue() ==
-                   static_cast<const StringNode*>(other.data.get())->rawValue();
+            return static_cast<const StringNode*>(data.get())->view() ==
+                   static_cast<const StringNode*>(other.data.get())->view();
         default:
             return data->getValue() == other.data->getValue();
     }
 }
 
 bool Node::operator!=(const Node& other) const { return !(*this == other); }
-bool Node::operator<(const Node& other) const {
+Ordering Node::compare(const Node& other) const {
     int lhs = 0;
     int rhs = 0;
     if (tryGetIntPair(data.get(), other.data.get(), lhs, rhs)) {
-        return lhs < rhs;
+        return orderOf(lhs, rhs);
+    }
+    if (!data || !other.data) {
+        throw MerkError("Cannot compare an invalid value");
     }
-    auto cmp = (*data) < (*other.data);
-    return cmp ? cmp->toBool() : false;
+    return data->compare(*other.data);
+}
+bool Node::operator<(const Node& other) const {
+    return compare(other) == Ordering::Less;
 }
 bool Node::operator>(const Node& other) const {
-    int lhs = 0;
-    int rhs = 0;
-    if (tryGetIntPair(data.get(), other.data.get(), lhs, rhs)) {
-        return lhs > rhs;
-    }
-    auto cmp = (*data) > (*other.data);
-    return cmp ? cmp->toBool() : false;
+    return compare(other) == Ordering::Greater;
 }
 bool Node::operator<=(const Node& other) const {
-    int lhs = 0;
-    int rhs = 0;
-    if (tryGetIntPair(data.get(), other.data.get(), lhs, rhs)) {
-        return lhs <= rhs;
-    }
-    auto cmp = (*data) <= (*other.data);
-    return cmp ? cmp->toBool() : false;
+    const Ordering order = compare(other);
+    return order == Ordering::Less || order == Ordering::Equal;
 }
 bool Node::operator>=(const Node& other) const {
-    int lhs = 0;
-    int rhs = 0;
-    if (tryGetIntPair(data.get(), other.data.get(), lhs, rhs)) {
-        return lhs >= rhs;
-    }
-    auto cmp = (*data) >= (*other.data);
-    return cmp ? cmp->toBool() : false;
+    const Ordering order = compare(other);
+    return order == Ordering::Greater || order == Ordering::Equal;
 }
 
 
@@ -553,20 +517,20 @@ SharedPtr<NodeBase> BoolNode::operator%(const NodeBase& other) const {
 
 // Mutating Operations
 SharedPtr<NodeBase> BoolNode::operator+=(const NodeBase& other) {
-    AnyNode::applyAddMut(*this, other);
+    NodeKernels::applyInPlace(BinaryOp::AddAssign, *this, other);
     return shared_from_this();
 }
 
 SharedPtr<NodeBase> BoolNode::operator-=(const NodeBase& other) {
-    AnyNode::applySubMut(*this, other);
+    NodeKernels::applyInPlace(BinaryOp::SubAssign, *this, other);
     return shared_from_this();
 }
 SharedPtr<NodeBase> BoolNode::operator*=(const NodeBase& other) {
-    AnyNode::applyMulMut(*this, other);
+    NodeKernels::applyInPlace(BinaryOp::MulAssign, *this, other);
     return shared_from_this();
 }
 SharedPtr<NodeBase> BoolNode::operator/=(const NodeBase& other) {
-    AnyNode::applyDivMut(*this, other);
+    NodeKernels::applyInPlace(BinaryOp::DivAssign, *this, other);
     return shared_from_this();
 }
 
@@ -589,13 +553,19 @@ SharedPtr<NodeBase> BoolNode::operator<=(const NodeBase& other) const {
 SharedPtr<NodeBase> BoolNode::operator>=(const NodeBase& other) const {
     return makeShared<BoolNode>(toInt() >= other.toInt());
 }
+Ordering BoolNode::compare(const NodeBase& other) const {
+    return orderOf(toInt(), other.toInt());
+}
 
 
 
 // Calculation Operators
 SharedPtr<NodeBase> StringNode::operator+(const NodeBase& other) const {
     if (!other.isString()) {throw MerkError("Attempted String + " + nodeTypeToString(other.getType()));}
-    return makeShared<StringNode>(value + other.toString());
+    if (other.getType() == NodeValueType::String) {
+        return concat(static_cast<const StringNode&>(other).view());
+    }
+    return concat(other.toString());
 }
 SharedPtr<NodeBase> StringNode::operator-(const NodeBase& other) const {
     if (!other.isString()) {throw MerkError("Attempted String - " + nodeTypeToString(other.getType()));}
@@ -643,41 +613,71 @@ SharedPtr<NodeBase> StringNode::operator%(const NodeBase& other) const {
 
 // Mutating Operations
 SharedPtr<NodeBase> StringNode::operator+=(const NodeBase& other) {
-    AnyNode::applyAddMut(*this, other);
+    if (!other.isString()) {throw MerkError("Attempted String += " + nodeTypeToString(other.getType()));}
+    if (other.getType() == NodeValueType::String) {
+        append(static_cast<const StringNode&>(other).view());
+    } else {
+        append(other.toString());
+    }
     return shared_from_this();
 }
 
 SharedPtr<NodeBase> StringNode::operator-=(const NodeBase& other) {
-    AnyNode::applySubMut(*this, other);
+    NodeKernels::applyInPlace(BinaryOp::SubAssign, *this, other);
     return shared_from_this();
 }
 SharedPtr<NodeBase> StringNode::operator*=(const NodeBase& other) {
-    AnyNode::applyMulMut(*this, other);
+    NodeKernels::applyInPlace(BinaryOp::MulAssign, *this, other);
     return shared_from_this();
 }
 SharedPtr<NodeBase> StringNode::operator/=(const NodeBase& other) {
-    AnyNode::applyDivMut(*this, other);
+    NodeKernels::applyInPlace(BinaryOp::DivAssign, *this, other);
     return shared_from_this();
 }
 
 // Logic Operations
 SharedPtr<NodeBase> StringNode::operator==(const NodeBase& other) const {
-    return makeShared<BoolNode>(value == other.toString());
+    if (other.getType() == NodeValueType::String) {
+        return makeShared<BoolNode>(view() == static_cast<const StringNode&>(other).view());
+    }
+    return makeShared<BoolNode>(view() == std::string_view(other.toString()));
 }
 SharedPtr<NodeBase> StringNode::operator!=(const NodeBase& other) const {
-    return makeShared<BoolNode>(value != other.toString());
+    if (other.getType() == NodeValueType::String) {
+        return makeShared<BoolNode>(view() != static_cast<const StringNode&>(other).view());
+    }
+    return makeShared<BoolNode>(view() != std::string_view(other.toString()));
 }
 SharedPtr<NodeBase> StringNode::operator<(const NodeBase& other) const {
-    return makeShared<BoolNode>(value < other.toString());
+    if (other.getType() == NodeValueType::String) {
+        return makeShared<BoolNode>(view() < static_cast<const StringNode&>(other).view());
+    }
+    return makeShared<BoolNode>(view() < std::string_view(other.toString()));
 }
 SharedPtr<NodeBase> StringNode::operator>(const NodeBase& other) const {
-    return makeShared<BoolNode>(value > other.toString());
+    if (other.getType() == NodeValueType::String) {
+        return makeShared<BoolNode>(view() > static_cast<const StringNode&>(other).view());
+    }
+    return makeShared<BoolNode>(view() > std::string_view(other.toString()));
 }
 SharedPtr<NodeBase> StringNode::operator<=(const NodeBase& other) const {
-    return makeShared<BoolNode>(value <= other.toString());
+    if (other.getType() == NodeValueType::String) {
+        return makeShared<BoolNode>(view() <= static_cast<const StringNode&>(other).view());
+    }
+    return makeShared<BoolNode>(view() <= std::string_view(other.toString()));
 }
 SharedPtr<NodeBase> StringNode::operator>=(const NodeBase& other) const {
-    return makeShared<BoolNode>(value >= other.toString());
+    if (other.getType() == NodeValueType::String) {
+        return makeShared<BoolNode>(view() >= static_cast<const StringNode&>(other).view());
+    }
+    return makeShared<BoolNode>(view() >= std::string_view(other.toString()));
+}
+Ordering StringNode::compare(const NodeBase& other) const {
+    if (other.getType() == NodeValueType::String) {
+        return orderOf(view(), static_cast<const StringNode&>(other).view());
+    }
+    const String rhs = other.toString();
+    return orderOf(view(), std::string_view(rhs));
 }
 
 
@@ -733,20 +733,20 @@ SharedPtr<NodeBase> CharNode::operator%(const NodeBase& other) const {
 
 // Mutating Operations
 SharedPtr<NodeBase> CharNode::operator+=(const NodeBase& other) {
-    AnyNode::applyAddMut(*this, other);
+    NodeKernels::applyInPlace(BinaryOp::AddAssign, *this, other);
     return shared_from_this();
 }
 
 SharedPtr<NodeBase> CharNode::operator-=(const NodeBase& other) {
-    AnyNode::applySubMut(*this, other);
+    NodeKernels::applyInPlace(BinaryOp::SubAssign, *this, other);
     return shared_from_this();
 }
 SharedPtr<NodeBase> CharNode::operator*=(const NodeBase& other) {
-    AnyNode::applyMulMut(*this, other);
+    NodeKernels::applyInPlace(BinaryOp::MulAssign, *this, other);
     return shared_from_this();
 }
 SharedPtr<NodeBase> CharNode::operator/=(const NodeBase& other) {
-    AnyNode::applyDivMut(*this, other);
+    NodeKernels::applyInPlace(BinaryOp::DivAssign, *this, other);
     return shared_from_this();
 }
 
@@ -769,6 +769,9 @@ SharedPtr<NodeBase> CharNode::operator<=(const NodeBase& other) const {
 SharedPtr<NodeBase> CharNode::operator>=(const NodeBase& other) const {
     return makeShared<BoolNode>(value >= other.toChar());
 }
+Ordering CharNode::compare(const NodeBase& other) const {
+    return orderOf(value, other.toChar());
+}
 
 
 
@@ -806,20 +809,20 @@ SharedPtr<NodeBase> IntNode::operator%(const NodeBase& other) const {
 
 // Mutating Operations
 SharedPtr<NodeBase> IntNode::operator+=(const NodeBase& other) {
-    AnyNode::applyAddMut(*this, other);
+    NodeKernels::applyInPlace(BinaryOp::AddAssign, *this, other);
     return shared_from_this();
 }
 
 SharedPtr<NodeBase> IntNode::operator-=(const NodeBase& other) {
-    AnyNode::applySubMut(*this, other);
+    NodeKernels::applyInPlace(BinaryOp::SubAssign, *this, other);
     return shared_from_this();
 }
 SharedPtr<NodeBase> IntNode::operator*=(const NodeBase& other) {
-    AnyNode::applyMulMut(*this, other);
+    NodeKernels::applyInPlace(BinaryOp::MulAssign, *this, other);
     return shared_from_this();
 }
 SharedPtr<NodeBase> IntNode::operator/=(const NodeBase& other) {
-    AnyNode::applyDivMut(*this, other);
+    NodeKernels::applyInPlace(BinaryOp::DivAssign, *this, other);
     return shared_from_this();
 }
 
@@ -863,6 +866,16 @@ SharedPtr<NodeBase> IntNode::operator>=(const NodeBase& other) const {
     }
     return makeShared<BoolNode>(value >= other.toInt());
 }
+// Mixed Int/Float comparisons widen to double, matching the evaluator.
+Ordering IntNode::compare(const NodeBase& other) const {
+    if (other.getType() == NodeValueType::Int) {
+        return orderOf(value, static_cast<const IntNode&>(other).value);
+    }
+    if (isFloating(other)) {
+        return orderOf(static_cast<double>(value), other.toDouble());
+    }
+    return orderOf(value, other.toInt());
+}
 
 
 // Calculation Operators
@@ -885,20 +898,20 @@ SharedPtr<NodeBase> FloatNode::operator%(const NodeBase& other) const {
 
 // Mutating Operations
 SharedPtr<NodeBase> FloatNode::operator+=(const NodeBase& other) {
-    AnyNode::applyAddMut(*this, other);
+    NodeKernels::applyInPlace(BinaryOp::AddAssign, *this, other);
     return shared_from_this();
 }
 
 SharedPtr<NodeBase> FloatNode::operator-=(const NodeBase& other) {
-    AnyNode::applySubMut(*this, other);
+    NodeKernels::applyInPlace(BinaryOp::SubAssign, *this, other);
     return shared_from_this();
 }
 SharedPtr<NodeBase> FloatNode::operator*=(const NodeBase& other) {
-    AnyNode::applyMulMut(*this, other);
+    NodeKernels::applyInPlace(BinaryOp::MulAssign, *this, other);
     return shared_from_this();
 }
 SharedPtr<NodeBase> FloatNode::operator/=(const NodeBase& other) {
-    AnyNode::applyDivMut(*this, other);
+    NodeKernels::applyInPlace(BinaryOp::DivAssign, *this, other);
     return shared_from_this();
 }
 
@@ -921,6 +934,9 @@ SharedPtr<NodeBase> FloatNode::operator<=(const NodeBase& other) const {
 SharedPtr<NodeBase> FloatNode::operator>=(const NodeBase& other) const {
     return makeShared<BoolNode>(value >= other.toDouble());
 }
+Ordering FloatNode::compare(const NodeBase& other) const {
+    return orderOf(static_cast<double>(value), other.toDouble());
+}
 
 // Calculation Operators
 SharedPtr<NodeBase> DoubleNode::operator+(const NodeBase& other) const {
@@ -942,20 +958,20 @@ SharedPtr<NodeBase> DoubleNode::operator%(const NodeBase& other) const {
 
 // Mutating Operations
 SharedPtr<NodeBase> DoubleNode::operator+=(const NodeBase& other) {
-    AnyNode::applyAddMut(*this, other);
+    NodeKernels::applyInPlace(BinaryOp::AddAssign, *this, other);
     return shared_from_this();
 }
 
 SharedPtr<NodeBase> DoubleNode::operator-=(const NodeBase& other) {
-    AnyNode::applySubMut(*this, other);
+    NodeKernels::applyInPlace(BinaryOp::SubAssign, *this, other);
     return shared_from_this();
 }
 SharedPtr<NodeBase> DoubleNode::operator*=(const NodeBase& other) {
-    AnyNode::applyMulMut(*this, other);
+    NodeKernels::applyInPlace(BinaryOp::MulAssign, *this, other);
     return shared_from_this();
 }
 SharedPtr<NodeBase> DoubleNode::operator/=(const NodeBase& other) {
-    AnyNode::applyDivMut(*this, other);
+    NodeKernels::applyInPlace(BinaryOp::DivAssign, *this, other);
     return shared_from_this();
 }
 
@@ -978,3 +994,6 @@ SharedPtr<NodeBase> DoubleNode::operator<=(const NodeBase& other) const {
 SharedPtr<NodeBase> DoubleNode::operator>=(const NodeBase& other) const {
     return makeShared<BoolNode>(value >= other.toDouble());
 }
+Ordering DoubleNode::compare(const NodeBase& other) const {
+    return orderOf(value, other.toDouble());
+}
@@ -91,6 +91,10 @@ void ListNode::setValue(const VariantType& v) {
     }
 }
 
+void ListNode::freezeChildren() const {
+    for (const auto& element : elements) { element.freeze(); }
+}
+
 SharedPtr<NodeBase> ListNode::clone() const {
     // keeps it shared
     auto copy = std::make_shared<ListNode>(*this);
@@ -123,8 +127,11 @@ String ListNode::toString() const {
     return repr;
 }
 
-ArrayNode::ArrayNode(NodeList init, NodeValueType type) : ListNode(init) {
+ArrayNode::ArrayNode(NodeList init, NodeValueType type) : ListNode(std::move(init)) {
     contains = type;
+    setType(NodeValueType::Array);
+    flags.type = NodeValueType::Array;
+    dataType = NodeValueType::Array;
 }
 
 void ArrayNode::append(const Node& node) {
@@ -202,6 +209,8 @@ const std::unordered_map<Node, Node>& DictNode::getElements() const {
     return elements;
 }
 
+std::unordered_map<Node, Node>& DictNode::getMutableElements() { return elements; }
+
 DictNode::DictNode(NodeMapU init) : elements(std::move(init)) {
     dataType = NodeValueType::Dict;
     flags.type = NodeValueType::Dict;
@@ -302,6 +311,13 @@ void DictNode::setValue(const VariantType& v) {
     }
 }
 
+void DictNode::freezeChildren() const {
+    for (const auto& [key, value] : elements) {
+        key.freeze();
+        value.freeze();
+    }
+}
+
 SharedPtr<NodeBase> DictNode::clone() const {
     std::unordered_map<Node, Node> clonedElements;
     for (auto& [key, val] : elements) {
@@ -345,6 +361,10 @@ String SetNode::toString() const {
     return repr;
 }
 
+void SetNode::freezeChildren() const {
+    for (const auto& element : elements) { element.freeze(); }
+}
+
 SharedPtr<NodeBase> SetNode::clone() const {
     std::unordered_set<Node> clonedElements;
     for (auto& el : elements) {
@@ -458,6 +478,7 @@ SetNode::SetNode(std::unordered_set<Node>&& init)
     }
 
 const std::unordered_set<Node>& SetNode::getElements() const {return elements; }
+std::unordered_set<Node>& SetNode::getMutableElements() { return elements; }
 
 InstanceBoundNative::InstanceBoundNative(SharedPtr<ClassInstanceNode> node): instance(node->getInstance()) {}
 
@@ -497,6 +518,50 @@ SharedPtr<NativeNode> SetNode::toNative() const {
     return makeShared<SetNode>(getElements());
 }
 
+RangeNode::RangeNode(int start, int stop, int step) : start(start), stop(stop), step(step) {
+    if (step == 0) {
+        throw MerkError("range() step cannot be 0");
+    }
+    setType(NodeValueType::Range);
+    flags.type = NodeValueType::Range;
+}
+
+String RangeNode::toString() const {
+    return "range(" + std::to_string(start) + ", " + std::to_string(stop) + ", " + std::to_string(step) + ")";
+}
+
+bool RangeNode::holdsValue() { return length() > 0; }
+
+std::size_t RangeNode::hash() const {
+    std::size_t h = std::hash<int>()(start);
+    h ^= std::hash<int>()(stop) + 0x9e3779b9 + (h << 6) + (h >> 2);
+    h ^= std::hash<int>()(step) + 0x9e3779b9 + (h << 6) + (h >> 2);
+    return h;
+}
+
+int RangeNode::length() const {
+    if (step > 0) return stop > start ? (stop - start + step - 1) / step : 0;
+    return start > stop ? (start - stop - step - 1) / -step : 0;
+}
+
+VariantType RangeNode::getValue() const {
+    return std::static_pointer_cast<NativeNode>(std::const_pointer_cast<NodeBase>(shared_from_this()));
+}
+
+void RangeNode::setValue(const VariantType&) {
+    throw MerkError("range objects are immutable");
+}
+
+SharedPtr<NodeBase> RangeNode::clone() const {
+    return makeShared<RangeNode>(start, stop, step);
+}
+
+void RangeNode::clear() {}
+
+SharedPtr<NativeNode> RangeNode::toNative() const {
+    return makeShared<RangeNode>(start, stop, step);
+}
+
 SharedPtr<NativeNode> InstanceBoundNative::toNative() const {
     throw MerkError("InstanceBoundNative cannot return toNative()");
 }
@@ -0,0 +1,181 @@
+#include <algorithm>
+#include <filesystem>
+#include <thread>
+#include <unordered_set>
+
+#include "core/ModuleLoader.hpp"
+#include "core/errors.h"
+#include "core/Tokenizer.hpp"
+#include "core/Parser.hpp"
+#include "core/Environments/Isolate.hpp"
+#include "ast/AstControl.hpp"
+
+
+ModuleLoader::ModuleLoader(String root, ScopeFactory makeScope, size_t workers, bool parallel)
+    : root(std::move(root)), makeScope(std::move(makeScope)), parallel(parallel) {
+    if (parallel) {
+        if (workers == 0) {workers = std::max(1u, std::thread::hardware_concurrency());}
+        pool = makeUnique<WorkStealingPool>(workers);
+    }
+}
+
+ModuleLoader::~ModuleLoader() {
+    if (pool) {pool->wait();}
+    pool.reset();
+
+    // Scopes and nodes are torn down in the isolate that built them.
+    for (auto& [name, entry] : entries) {
+        Module& module = entry->module;
+        if (!module.isolate) {continue;}
+        Isolate::Enter enter(*module.isolate);
+        if (module.ast) {module.ast->clear();}
+        module.ast.reset();
+        if (module.scope) {module.scope->clear();}
+        module.scope.reset();
+    }
+}
+
+String ModuleLoader::load(const String& entryPath) {
+    entryName = std::filesystem::path(entryPath).stem().string();
+    request(entryName, entryPath);
+    return entryName;
+}
+
+String ModuleLoader::pathFor(const String& name) const {
+    String relative = name;
+    std::replace(relative.begin(), relative.end(), '.', '/');
+    return (std::filesystem::path(root) / (relative + ".merk")).string();
+}
+
+void ModuleLoader::request(const String& name, const String& path) {
+    Entry* entry = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto [it, inserted] = entries.try_emplace(name);
+        if (!inserted) {return;}
+        it->second = makeUnique<Entry>();
+        entry = it->second.get();
+        entry->module.name = name;
+        entry->module.path = path;
+        entry->ready = entry->parsed.get_future().share();
+    }
+
+    if (pool) {
+        pool->submit([this, entry](std::size_t) { read(*entry); });
+    } else {
+        read(*entry);
+    }
+}
+
+void ModuleLoader::read(Entry& entry) {
+    Module& module = entry.module;
+    try {
+        if (!std::filesystem::exists(module.path)) {
+            throw MerkError("Module '" + module.name + "' not found at " + module.path);
+        }
+        module.isolate = makeUnique<Isolate>();
+        Isolate::Enter enter(*module.isolate);
+
+        LexerConfig config;
+        module.scope = makeScope(config);
+        Tokenizer tokenizer(module.path, true);
+        Vector<Token>& tokens = tokenizer.tokenize(config);
+
+        // Imports go out before this module is parsed.
+        module.imports = takeImports(tokens);
+        for (const String& name : module.imports) {
+            request(name, pathFor(name));
+        }
+
+        module.tokenCount = tokens.size();
+        Parser parser(tokens, module.scope, false, false);
+        module.ast = parser.parse();
+        entry.parsed.set_value();
+    } catch (...) {
+        entry.parsed.set_exception(std::current_exception());
+    }
+}
+
+ModuleLoader::Entry& ModuleLoader::find(const String& name) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(name);
+    if (it == entries.end()) {throw MerkError("Module '" + name + "' was never imported");}
+    return *it->second;
+}
+
+ModuleLoader::Module& ModuleLoader::require(const String& name) {
+    Entry& entry = find(name);
+    entry.ready.get();
+    return entry.module;
+}
+
+Vector<ModuleLoader::Module*> ModuleLoader::requireAll() {
+    Vector<Module*> order;
+    std::unordered_set<String> visited;
+    std::function<void(const String&)> visit = [&](const String& name) {
+        if (!visited.insert(name).second) {return;}
+        Module& module = require(name);
+        for (const String& imported : module.imports) {
+            visit(imported);
+        }
+        order.push_back(&module);
+    };
+    visit(entryName);
+    return order;
+}
+
+Vector<String> ModuleLoader::takeImports(Vector<Token>& tokens) {
+    Vector<String> imports;
+    size_t kept = 0;
+    int depth = 0;
+    bool lineStart = true;
+
+    for (size_t i = 0; i < tokens.size();) {
+        const Token& token = tokens[i];
+        if (token.type == TokenType::Indent) {++depth;}
+        if (token.type == TokenType::Dedent) {--depth;}
+
+        const bool opensImport = depth == 0 && lineStart && token.type == TokenType::Keyword
+            && (token.value == "import" || token.value == "from");
+        if (!opensImport) {
+            lineStart = token.type == TokenType::Newline || token.type == TokenType::SOF_Token
+                || token.type == TokenType::Indent || token.type == TokenType::Dedent;
+            if (kept != i) {tokens[kept] = std::move(tokens[i]);}
+            ++kept;
+            ++i;
+            continue;
+        }
+
+        // `from a.b import x, y` names a.b; `import a.b as c, d` names a.b and d.
+        const bool fromForm = token.value == "from";
+        Vector<String> named(1);
+        bool aliasing = false;
+        size_t end = i + 1;
+        for (; end < tokens.size(); ++end) {
+            const Token& part = tokens[end];
+            if (part.type == TokenType::Newline || part.type == TokenType::EOF_Token) {break;}
+            if (fromForm) {
+                if (part.type == TokenType::Keyword && part.value == "import") {break;}
+                named.back() += part.value;
+                continue;
+            }
+            if (part.value == ",") {named.emplace_back(); aliasing = false; continue;}
+            if (part.value == "as") {aliasing = true; continue;}
+            if (!aliasing) {named.back() += part.value;}
+        }
+        for (const String& name : named) {
+            if (name.empty() || name.front() == '.' || name.back() == '.') {
+                throw MerkError("Malformed import on line " + std::to_string(token.line));
+            }
+            if (std::find(imports.begin(), imports.end(), name) == imports.end()) {imports.push_back(name);}
+        }
+
+        while (end < tokens.size() && tokens[end].type != TokenType::Newline && tokens[end].type != TokenType::EOF_Token) {++end;}
+        if (end < tokens.size() && tokens[end].type == TokenType::Newline) {++end;}
+        i = end;
+        lineStart = true;
+    }
+
+    tokens.erase(tokens.begin() + kept, tokens.end());
+    return imports;
+}
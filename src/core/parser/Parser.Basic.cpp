@@ -141,9 +141,14 @@ UniquePtr<ASTStatement> Parser::parseBinaryExpression(int precedence) {
         advance(); // Consume the operator
         DEBUG_LOG(LogLevel::INFO, "After consuming operator ", op.value, " current is now: ", currentToken().toString());
 
-        if (op.value == "++") {
+        const BinaryOp binaryOp = stringToBinaryOp(op.value);
+        if (binaryOp == BinaryOp::Unknown) {
+            throw SyntaxError("Unsupported operator: " + op.value, op);
+        }
+
+        if (binaryOp == BinaryOp::Increment) {
             left = makeUnique<BinaryOperation>(
-                op.value, std::move(left), std::move(makeUnique<NoOpNode>(currentScope)), currentScope
+                binaryOp, std::move(left), std::move(makeUnique<NoOpNode>(currentScope)), currentScope
             );
             return left;
         }
@@ -157,7 +162,7 @@ UniquePtr<ASTStatement> Parser::parseBinaryExpression(int precedence) {
             throw MerkError("Current Scope In Parser::parseBinaryExpression is null");
         }
         left = makeUnique<BinaryOperation>(
-            op.value, std::move(left), std::move(right), currentScope
+            binaryOp, std::move(left), std::move(right), currentScope
         );
         DEBUG_LOG(LogLevel::INFO, "Created BinaryOperation node for ", op.value);
 
@@ -216,7 +221,7 @@ UniquePtr<ASTStatement> Parser::parsePrimaryExpression() {
 
         auto operand = parsePrimaryExpression(); // recursively parse next value
         DEBUG_LOG(LogLevel::ERROR, "Operand: ", operand->toString());
-        return makeUnique<UnaryOperation>(op, std::move(operand), currentScope);
+        return makeUnique<UnaryOperation>(stringToUnaryOp(op), std::move(operand), currentScope);
     }
 
     if (token.type == TokenType::ChainEntryPoint) {
@@ -234,7 +239,7 @@ UniquePtr<ASTStatement> Parser::parsePrimaryExpression() {
         if (peek().value == "?") {
             advance(); // consume Var Name
             advance(); // consume ?
-            return makeUnique<UnaryOperation>("?", std::move(varRefNode), currentScope);
+            return makeUnique<UnaryOperation>(UnaryOp::Exists, std::move(varRefNode), currentScope);
         }
         advance();  // Consume Variable Name
         DEBUG_FLOW_EXIT();
@@ -369,7 +374,9 @@ UniquePtr<ASTStatement> Parser::parseKeyWord() {
 
     else if (token.value == "while") { statement = parseWhileLoop(); }
     else if (token.value == "for") { statement = parseForLoop(); }
+    else if (token.value == "parallel") { statement = parseParallelFor(); }
     else if (token.value == "return") { statement = parseReturnStatement(); } 
+    else if (token.value == "yield") { statement = parseYieldStatement(); }
 
     else if (token.value == "continue") { 
         if (!isInsideLoop()) { throw SyntaxError("Unexpected 'continue' outside loop: ", currentToken());
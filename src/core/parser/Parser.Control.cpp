@@ -3,6 +3,8 @@
 #include <iostream>
 #include <variant>
 #include <string>
+#include <limits>
+#include <unordered_set>
 #include "core/node/Node.hpp"
 
 #include "core/types.h"
@@ -23,6 +25,63 @@
 #include "ast/AstFunction.hpp"
 #include "ast/AstMethod.hpp"
 
+namespace {
+
+// Chunks of a parallel for only share their reduction variables; an assignment to any other
+// variable the body did not declare would silently stay private to one chunk.
+void checkParallelWrites(const String& loopVariable, const Vector<LoopReduction>& reductions, const CodeBlock& body, const Token& at) {
+    std::unordered_set<String> owned{loopVariable};
+    for (const auto& reduction : reductions) owned.insert(reduction.variable);
+
+    const Vector<const BaseAST*> nodes = body.getAllAst(true);
+    for (const BaseAST* node : nodes) {
+        if (node->getAstType() == AstType::VariableDeclaration) {
+            owned.insert(static_cast<const VariableDeclaration*>(node)->getName());
+        } else if (node->getAstType() == AstType::ForLoop) {
+            owned.insert(static_cast<const ForLoop*>(node)->getLoopVariable());
+        }
+    }
+
+    for (const BaseAST* node : nodes) {
+        String target;
+        if (node->getAstType() == AstType::VariableAssignment) {
+            target = static_cast<const VariableAssignment*>(node)->getName();
+        } else if (node->getAstType() == AstType::BinaryOperation) {
+            const auto* op = static_cast<const BinaryOperation*>(node);
+            const ASTStatement* left = op->getLeftSide();
+            if (!isCompoundAssignOp(op->getOperator()) || !left || left->getAstType() != AstType::VariableReference) continue;
+            target = static_cast<const VariableReference*>(left)->getName();
+        } else {
+            continue;
+        }
+        if (!owned.count(target)) {
+            throw SyntaxError("parallel for writes to '" + target + "', which is neither declared in the loop nor listed in reduce(...).", at);
+        }
+    }
+}
+
+} // namespace
+
+// The identity after `reduce(acc: op = ...`: an int literal, optionally negated.
+int Parser::parseReductionIdentity() {
+    bool negative = false;
+    if (currentToken().value == "-") {
+        negative = true;
+        advance(); // consume '-'
+    }
+    const Token& literal = currentToken();
+    if (literal.type != TokenType::Number) {
+        throw UnexpectedTokenError(literal, "integer reduction identity", "Parser::parseReductionIdentity");
+    }
+    int value = 0;
+    try {
+        value = std::stoi(literal.value);
+    } catch (const std::exception&) {
+        throw SyntaxError("reduction identity must be an Int.", literal);
+    }
+    advance(); // consume identity
+    return negative ? -value : value;
+}
 
 UniquePtr<IfStatement> Parser::parseIfStatement() {
     DEBUG_FLOW(FlowLevel::MED);
@@ -115,7 +174,7 @@ UniquePtr<WhileLoop> Parser::parseWhileLoop() {
     return makeUnique<WhileLoop>(std::move(conditionalBlock), std::move(body), currentScope);
 }
 
-UniquePtr<ForLoop> Parser::parseForLoop() {
+UniquePtr<ForLoop> Parser::parseForLoop(bool parallel) {
     DEBUG_FLOW(FlowLevel::MED);
 
     consume(TokenType::Keyword, "for", "Parser::parseForLoop");
@@ -128,6 +187,26 @@ UniquePtr<ForLoop> Parser::parseForLoop() {
     advance(); // consume loop variable
 
     consume("in", "Parser::parseForLoop");
+
+    // Anything other than a literal range(...) header is a for-in over an iterable value.
+    if (currentToken().value != "range" || peek().value != "(") {
+        if (parallel) {
+            throw SyntaxError("parallel for requires a range(...) header.", currentToken());
+        }
+        auto iterableExpr = parseExpression();
+        if (!iterableExpr) {
+            throw MerkError("Parser::parseForLoop: missing iterable expression.");
+        }
+        consume(TokenType::Punctuation, ":", "Parser::parseForLoop");
+
+        enterLoop();
+        auto body = parseBlock();
+        exitLoop();
+
+        DEBUG_FLOW_EXIT();
+        return makeUnique<ForLoop>(loopVariable, std::move(iterableExpr), std::move(body), currentScope);
+    }
+
     consume("range", "Parser::parseForLoop");
     consume(TokenType::Punctuation, "(", "Parser::parseForLoop");
 
@@ -136,11 +215,16 @@ UniquePtr<ForLoop> Parser::parseForLoop() {
         throw MerkError("Parser::parseForLoop: missing range start expression.");
     }
 
-    consume(TokenType::Punctuation, ",", "Parser::parseForLoop");
-
-    auto endExpr = parseExpression();
-    if (!endExpr) {
-        throw MerkError("Parser::parseForLoop: missing range end expression.");
+    // range(stop) counts from 0, matching the range() builtin.
+    UniquePtr<ASTStatement> endExpr;
+    if (consumeIf(TokenType::Punctuation, ",")) {
+        endExpr = parseExpression();
+        if (!endExpr) {
+            throw MerkError("Parser::parseForLoop: missing range end expression.");
+        }
+    } else {
+        endExpr = std::move(startExpr);
+        startExpr = makeUnique<LiteralValue>(LitNode("0", "Int"), currentScope);
     }
 
     UniquePtr<ASTStatement> stepExpr;
@@ -154,14 +238,47 @@ UniquePtr<ForLoop> Parser::parseForLoop() {
     }
 
     consume(TokenType::Punctuation, ")", "Parser::parseForLoop");
+
+    // reduce(total: sum, best: max, acc: combine = 0)
+    Vector<LoopReduction> reductions;
+    if (parallel && currentToken().value == "reduce") {
+        advance(); // consume 'reduce'
+        consume(TokenType::Punctuation, "(", "Parser::parseForLoop");
+        do {
+            LoopReduction reduction;
+            reduction.variable = currentToken().value;
+            advance(); // consume reduction variable
+            consume(TokenType::Punctuation, ":", "Parser::parseForLoop");
+            const Token opToken = currentToken();
+            reduction.op = opToken.value;
+            advance(); // consume reduction operator
+            if (currentToken().value == "=") {
+                advance(); // consume '='
+                reduction.identity = parseReductionIdentity();
+            } else if (reduction.op == "min") {
+                reduction.identity = std::numeric_limits<int>::max();
+            } else if (reduction.op == "max") {
+                reduction.identity = std::numeric_limits<int>::min();
+            } else if (reduction.op != "sum") {
+                throw SyntaxError("reducer '" + reduction.op + "' needs an identity: reduce(" + reduction.variable + ": " + reduction.op + " = <identity>)", opToken);
+            }
+            reductions.push_back(std::move(reduction));
+        } while (consumeIf(TokenType::Punctuation, ","));
+        consume(TokenType::Punctuation, ")", "Parser::parseForLoop");
+    }
+
+    const Token bodyToken = currentToken();
     consume(TokenType::Punctuation, ":", "Parser::parseForLoop");
 
     enterLoop();
     auto body = parseBlock();
     exitLoop();
 
-    DEBUG_FLOW_EXIT();
-    return makeUnique<ForLoop>(
+    if (parallel) {
+        checkParallelWrites(loopVariable, reductions, *body, bodyToken);
+    }
+
+    auto forLoop = makeUnique<ForLoop>(
         loopVariable,
         std::move(startExpr),
         std::move(endExpr),
@@ -169,6 +286,22 @@ UniquePtr<ForLoop> Parser::parseForLoop() {
         std::move(body),
         currentScope
     );
+    if (parallel) {
+        forLoop->makeParallel(std::move(reductions));
+    }
+
+    DEBUG_FLOW_EXIT();
+    return forLoop;
+}
+
+UniquePtr<ForLoop> Parser::parseParallelFor() {
+    DEBUG_FLOW(FlowLevel::MED);
+    consume(TokenType::Keyword, "parallel", "Parser::parseParallelFor");
+    if (currentToken().value != "for") {
+        throw UnexpectedTokenError(currentToken(), "for", "Parser::parseParallelFor");
+    }
+    DEBUG_FLOW_EXIT();
+    return parseForLoop(true);
 }
 
 UniquePtr<CodeBlock> Parser::parseBlock(SharedPtr<Scope> controlScope) {
@@ -284,6 +284,29 @@ UniquePtr<ASTStatement> Parser::parseReturnStatement() {
     return makeUnique<Return>(currentScope, std::move(returnValue));
 }
 
+UniquePtr<ASTStatement> Parser::parseYieldStatement() {
+    DEBUG_FLOW(FlowLevel::MED);
+
+    Token controllingToken = currentToken();
+    if (!expect(TokenType::Keyword) || controllingToken.value != "yield") {
+        throw SyntaxError("Expected 'yield' keyword.", controllingToken);
+    }
+
+    controllingToken = advance(); // Consume `yield`
+
+    if (controllingToken.type == TokenType::Newline || controllingToken.type == TokenType::EOF_Token || controllingToken.type == TokenType::Dedent) {
+        throw SyntaxError("Yield statement must yield a value.", controllingToken);
+    }
+
+    auto yieldValue = parseExpression();
+    if (!yieldValue) {
+        throw SyntaxError("Yield statement must yield a valid expression.", currentToken());
+    }
+
+    DEBUG_FLOW_EXIT();
+    return makeUnique<Yield>(currentScope, std::move(yieldValue));
+}
+
 
 
 
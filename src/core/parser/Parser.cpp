@@ -9,6 +9,7 @@
 #include "ast/AstBase.hpp"
 #include "ast/Ast.hpp"
 #include "ast/AstControl.hpp"
+#include "ast/AstCallable.hpp"
 #include "core/Environments/Scope.hpp"
 
 #include "utilities/utilities.h"
@@ -51,6 +52,7 @@ UniquePtr<CodeBlock> Parser::parse() {
             auto statement = parseStatement();
             if (!statement) { throw MerkError("Parser::parse: Null statement returned during parsing. Token: " + currentToken().toString()); }
             if (interpretMode && byBlock){
+                CallableDef::resolveAllCaptures(*statement);
                 setAllowScopeCreation(true);
                 try {
                     DEBUG_LOG(LogLevel::PERMISSIVE, highlight("EVALUATING AST TYPE: " + statement->getAstTypeAsString(), Colors::orange));
@@ -65,6 +67,15 @@ UniquePtr<CodeBlock> Parser::parse() {
         }
     
         setAllowScopeCreation(true);
+        // Statements interpreted as they are parsed run as parsed: the pass needs the whole
+        // program to know which names are ever rebound.
+        if (kEnableAstOptimizer && !(interpretMode && byBlock)) {
+            AstOptimizer optimizer;
+            optimizer.run(*rootBlock);
+            optimizerStats = optimizer.stats();
+        }
+        // After the optimizer, which can drop the only use of a name.
+        if (!(interpretMode && byBlock)) {CallableDef::resolveAllCaptures(*rootBlock);}
         if (interpretMode && !byBlock){
             // interpret(rootBlock.get());
             interpretFlow(rootBlock.get());
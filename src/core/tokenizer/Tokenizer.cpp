@@ -3,27 +3,20 @@
 #include "utilities/debugging_functions.h"
 #include "utilities/debugger.h"
 #include "core/errors.h"
-#include <filesystem>
-#include <fstream>
 #include <iostream>
 
 
 void Tokenizer::read() {
-    std::ifstream file(filePath);
-    if (!file.is_open()) {
-        throw std::runtime_error("Error: Cannot open file '" + filePath + "'. Please ensure the file exists and is accessible.");
-    }
-    std::ostringstream content;
-    content << file.rdbuf();
-    source = content.str();
+    source = SourceBuffer::open(filePath);
 }
 
 
-Tokenizer::Tokenizer(const String& source, bool readFile): source(readFile ? "" : source), filePath(readFile ? source : "") {
+Tokenizer::Tokenizer(const String& source, bool readFile): filePath(readFile ? source : "") {
     if (readFile) {
         read();
+    } else {
+        this->source = SourceBuffer::fromString(source);
     }
-    
 }
 
 
@@ -40,21 +33,23 @@ void Tokenizer::printTokens(bool colored) const {
 
 
 
-Vector<Token> Tokenizer::tokenize(LexerConfig& lexCfg) {
+Vector<Token>& Tokenizer::tokenize(LexerConfig& lexCfg) {
     return lex(lexCfg);
 }
 
 LexerConfig& handleLex(LexerConfig& lexCfg) {
-    if (lexCfg.keywords.size() == 0) {
-        lexCfg.keywords         = {"if","elif","else","from","as","import","while","continue","break","return","for","throw", "const", "mut"};
+    // Keywords and primitives are the Lexer's built-in table; list them for anyone reading the config.
+    if (lexCfg.keywords.size() == 0 || lexCfg.primitiveCtors.size() == 0) {
+        const bool fillKeywords = lexCfg.keywords.size() == 0;
+        const bool fillPrimitives = lexCfg.primitiveCtors.size() == 0;
+        for (const auto& entry : Keywords::kTable) {
+            if (fillKeywords && (entry.flags & Keywords::Keyword)) lexCfg.keywords.emplace(entry.word);
+            if (fillPrimitives && (entry.flags & Keywords::Primitive)) lexCfg.primitiveCtors.emplace(entry.word);
+        }
     }
 
     if (lexCfg.nativeClasses.size() == 0) {
-        lexCfg.nativeClasses    = {"List","Dict","Set","Array", "Http","File"}; 
-    }
-
-    if (lexCfg.primitiveCtors.size() == 0) {
-        lexCfg.primitiveCtors   = {"Int","Float","Long","Bool","String"};
+        lexCfg.nativeClasses    = {"List","Dict","Set","Array", "Http","File","Future","Channel"}; 
     }
 
     auto& primitives = lexCfg.primitiveCtors;
@@ -84,19 +79,14 @@ LayoutConfig handleLayoutConfig() {
     return lcfg;
 }
 
-Vector<Token> Tokenizer::lex(LexerConfig& lexCfg) {
-    CommentConfig cfg       = handleScannerConfig();
-    Scanner scanner(source, cfg);
-    auto toks = scanner.scan();
-    // printRawTokens(toks);
-    LayoutConfig lcfg       = handleLayoutConfig();
-    Structurizer structurizer(lcfg);
-    auto structs = structurizer.structurize(toks);
+Vector<Token>& Tokenizer::lex(LexerConfig& lexCfg) {
+    Scanner scanner(source, handleScannerConfig(), handleLayoutConfig());
     std::cout << std::endl;
 
     auto& v = handleLex(lexCfg);
     Lexer lexer(v);
-    lexer.lex(structs, tokens);
+    tokens.clear();
+    lexer.lex(scanner, tokens);
 
     
     if (tokens.size() < 1) {
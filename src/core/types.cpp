@@ -47,6 +47,8 @@ String nodeTypeToString(NodeValueType type, bool colored) {
         case NodeValueType::Text: return colored ? highlight("Text", Colors::green) : "Text";
         case NodeValueType::File: return colored ? highlight("File", Colors::bg_cyan) : "File";
         case NodeValueType::Http: return colored ? highlight("Http", Colors::cyan) : "Http";
+        case NodeValueType::Range: return colored ? highlight("Range", Colors::bold_white) : "Range";
+        case NodeValueType::Generator: return colored ? highlight("Generator", Colors::bold_white) : "Generator";
         default: return "UNKNOWN";
     }
 }
@@ -107,6 +109,7 @@ String astTypeToString(AstType type) {
 
         case AstType::Break: return highlight("Break", Colors::bold_red);
         case AstType::Return: return highlight("Return", Colors::bold_red);
+        case AstType::Yield: return highlight("Yield", Colors::bold_red);
         case AstType::Continue: return highlight("Continue", Colors::bold_red);
         case AstType::LoopBlock: return highlight("LoopNode", Colors::light_gray);
 
@@ -157,6 +160,68 @@ String astTypeToString(AstType type) {
     }
 }
 
+BinaryOp stringToBinaryOp(std::string_view op) {
+    if (op == "+") return BinaryOp::Add;
+    if (op == "-") return BinaryOp::Sub;
+    if (op == "*") return BinaryOp::Mul;
+    if (op == "/") return BinaryOp::Div;
+    if (op == "%") return BinaryOp::Mod;
+    if (op == "and" || op == "&&") return BinaryOp::And;
+    if (op == "or" || op == "||") return BinaryOp::Or;
+    if (op == "+=") return BinaryOp::AddAssign;
+    if (op == "-=") return BinaryOp::SubAssign;
+    if (op == "*=") return BinaryOp::MulAssign;
+    if (op == "/=") return BinaryOp::DivAssign;
+    if (op == "++") return BinaryOp::Increment;
+    if (op == "==") return BinaryOp::Eq;
+    if (op == "!=") return BinaryOp::Ne;
+    if (op == "<") return BinaryOp::Lt;
+    if (op == "<=") return BinaryOp::Le;
+    if (op == ">") return BinaryOp::Gt;
+    if (op == ">=") return BinaryOp::Ge;
+    return BinaryOp::Unknown;
+}
+
+String binaryOpToString(BinaryOp op) {
+    switch (op) {
+        case BinaryOp::Add: return "+";
+        case BinaryOp::Sub: return "-";
+        case BinaryOp::Mul: return "*";
+        case BinaryOp::Div: return "/";
+        case BinaryOp::Mod: return "%";
+        case BinaryOp::And: return "and";
+        case BinaryOp::Or: return "or";
+        case BinaryOp::AddAssign: return "+=";
+        case BinaryOp::SubAssign: return "-=";
+        case BinaryOp::MulAssign: return "*=";
+        case BinaryOp::DivAssign: return "/=";
+        case BinaryOp::Increment: return "++";
+        case BinaryOp::Eq: return "==";
+        case BinaryOp::Ne: return "!=";
+        case BinaryOp::Lt: return "<";
+        case BinaryOp::Le: return "<=";
+        case BinaryOp::Gt: return ">";
+        case BinaryOp::Ge: return ">=";
+        default: return "Unknown";
+    }
+}
+
+UnaryOp stringToUnaryOp(std::string_view op) {
+    if (op == "!" || op == "not") return UnaryOp::Not;
+    if (op == "?") return UnaryOp::Exists;
+    if (op == "-") return UnaryOp::Negate;
+    return UnaryOp::Unknown;
+}
+
+String unaryOpToString(UnaryOp op) {
+    switch (op) {
+        case UnaryOp::Not: return "!";
+        case UnaryOp::Exists: return "?";
+        case UnaryOp::Negate: return "-";
+        default: return "Unknown";
+    }
+}
+
 String tokenTypeToString(TokenType type, bool colored) {
     switch (type) {
         case TokenType::Type: return colored ? highlight("Type", Colors::red) : "Type";
@@ -0,0 +1,332 @@
+#include "core/evaluators/Channel.hpp"
+
+#include <cstdint>
+#include <thread>
+#include <unordered_map>
+
+#include "core/errors.h"
+#include "core/Environments/Isolate.hpp"
+#include "core/evaluators/Scheduler.hpp"
+#include "core/callables/classes/ClassBase.hpp"
+
+namespace {
+
+// Spins before parking, so a busy producer/consumer pair never touches the mutex.
+constexpr int kSpinsBeforeBlocking = 64;
+
+// Signalled on every send and close while a select is parked.
+std::mutex selectMutex;
+std::condition_variable selectReady;
+std::atomic<int> selecting{0};
+
+void wakeSelect() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (selecting.load(std::memory_order_relaxed) == 0) return;
+    { std::lock_guard<std::mutex> lock(selectMutex); }
+    selectReady.notify_all();
+}
+
+std::mutex registryMutex;
+std::unordered_map<String, SharedPtr<ChannelState>> registry;
+
+// Under registryMutex a count of 1 is stable: a new reference can only come from the registry.
+void evictUnused() {
+    for (auto it = registry.begin(); it != registry.end();) {
+        if (it->second.use_count() == 1 && it->second->size() == 0) {
+            it = registry.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+class ChannelIterator : public NodeIterator {
+    SharedPtr<ChannelState> state;
+public:
+    explicit ChannelIterator(SharedPtr<ChannelState> source) : state(std::move(source)) {}
+
+    bool next(Node& out) override { return state->recv(out); }
+};
+
+} // namespace
+
+
+ChannelState::ChannelState(std::size_t capacity) : slots(capacity) {
+    if (slots == 0) return;
+    ring.reset(new Cell[slots]);
+    for (std::size_t i = 0; i < slots; ++i) {
+        ring[i].sequence.store(2 * i, std::memory_order_relaxed);
+    }
+}
+
+SharedPtr<ChannelState> ChannelState::named(const String& name, std::size_t capacity) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    evictUnused();
+    auto& channel = registry[name];
+    if (!channel) {
+        channel = makeShared<ChannelState>(capacity);
+    } else if (channel->capacity() != capacity) {
+        throw MerkError("Channel '" + name + "' already exists with capacity " + std::to_string(channel->capacity()));
+    }
+    return channel;
+}
+
+// The in-flight count makes close() and a send linearizable: a send that saw the channel open
+// has landed before any receiver can observe "closed and drained".
+ChannelState::PushResult ChannelState::pushUnlessClosed(Node& value) {
+    PushResult result = PushResult::Closed;
+    if (!(sendState.fetch_add(kSendInFlight, std::memory_order_acq_rel) & kClosedBit)) {
+        result = push(value) ? PushResult::Pushed : PushResult::Full;
+    }
+    // The last send to leave a closed channel is what lets parked receivers finish.
+    if (sendState.fetch_sub(kSendInFlight, std::memory_order_acq_rel) == (kClosedBit | kSendInFlight)) {
+        wake(receivers, notEmpty);
+        wakeSelect();
+    }
+    return result;
+}
+
+// Bounded: Vyukov's ring. Each cell's sequence says whose turn it is, so producers and
+// consumers only contend on their own index. Sequences count in steps of two (2*pos free for
+// the send at pos, 2*pos+1 full) so a one-cell ring can tell "full" from "free for the next lap".
+bool ChannelState::push(Node& value) {
+    if (!ring) {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        queue.push_back(std::move(value));
+        return true;
+    }
+
+    std::size_t pos = tail.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell& cell = ring[pos % slots];
+        const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(2 * pos);
+        if (diff == 0) {
+            if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                cell.value = std::move(value);
+                cell.sequence.store(2 * pos + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = tail.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool ChannelState::pop(Node& out) {
+    if (!ring) {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        if (queue.empty()) return false;
+        out = std::move(queue.front());
+        queue.pop_front();
+        return true;
+    }
+
+    std::size_t pos = head.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell& cell = ring[pos % slots];
+        const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(2 * pos + 1);
+        if (diff == 0) {
+            if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                out = std::move(cell.value);
+                cell.value = Node();
+                cell.sequence.store(2 * (pos + slots), std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = head.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+std::size_t ChannelState::size() const {
+    if (!ring) {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        return queue.size();
+    }
+    const std::size_t begin = head.load(std::memory_order_acquire);
+    const std::size_t end = tail.load(std::memory_order_acquire);
+    return end > begin ? end - begin : 0;
+}
+
+bool ChannelState::drained() const {
+    return size() == 0;
+}
+
+// Only pays for the mutex when someone is actually parked on the other side.
+void ChannelState::wake(std::atomic<int>& waiters, std::condition_variable& cv) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters.load(std::memory_order_relaxed) == 0) return;
+    { std::lock_guard<std::mutex> lock(waitMutex); }
+    cv.notify_all();
+}
+
+bool ChannelState::trySend(const Node& value) {
+    if (isClosed()) throw MerkError("send on a closed Channel");
+    Node copy = Isolate::transfer(value);
+    const PushResult result = pushUnlessClosed(copy);
+    if (result == PushResult::Closed) throw MerkError("send on a closed Channel");
+    if (result == PushResult::Full) return false;
+    wake(receivers, notEmpty);
+    wakeSelect();
+    return true;
+}
+
+void ChannelState::send(const Node& value) {
+    if (isClosed()) throw MerkError("send on a closed Channel");
+    Node copy = Isolate::transfer(value);
+
+    PushResult result = PushResult::Full;
+    for (int spin = 0; spin < kSpinsBeforeBlocking && result == PushResult::Full; ++spin) {
+        result = pushUnlessClosed(copy);
+        if (result == PushResult::Full) std::this_thread::yield();
+    }
+
+    if (result == PushResult::Full) {
+        Scheduler::Blocking blocked;
+        senders.fetch_add(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::unique_lock<std::mutex> lock(waitMutex);
+        notFull.wait(lock, [&] { result = pushUnlessClosed(copy); return result != PushResult::Full; });
+        senders.fetch_sub(1);
+    }
+    if (result == PushResult::Closed) throw MerkError("send on a closed Channel");
+    wake(receivers, notEmpty);
+    wakeSelect();
+}
+
+bool ChannelState::tryRecv(Node& out) {
+    if (!pop(out)) return false;
+    wake(senders, notFull);
+    return true;
+}
+
+bool ChannelState::recv(Node& out) {
+    for (int spin = 0; spin < kSpinsBeforeBlocking; ++spin) {
+        if (tryRecv(out)) return true;
+        if (finished()) return tryRecv(out);
+        std::this_thread::yield();
+    }
+
+    bool received = false;
+    {
+        Scheduler::Blocking blocked;
+        receivers.fetch_add(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::unique_lock<std::mutex> lock(waitMutex);
+        notEmpty.wait(lock, [&] { received = pop(out); return received || finished(); });
+        receivers.fetch_sub(1);
+    }
+    if (received) {
+        wake(senders, notFull);
+        return true;
+    }
+    return tryRecv(out);
+}
+
+void ChannelState::close() {
+    sendState.fetch_or(kClosedBit, std::memory_order_acq_rel);
+    {
+        std::lock_guard<std::mutex> lock(waitMutex);
+    }
+    notEmpty.notify_all();
+    notFull.notify_all();
+    wakeSelect();
+}
+
+std::size_t ChannelState::select(const Vector<SharedPtr<ChannelState>>& channels, Node& out) {
+    if (channels.empty()) throw MerkError("Channel.select needs at least one Channel");
+
+    // Rotating the starting point keeps one busy channel from starving the rest.
+    thread_local std::size_t rotation = 0;
+    const std::size_t count = channels.size();
+    const std::size_t start = rotation++ % count;
+
+    const auto poll = [&](bool& allClosed) -> std::size_t {
+        allClosed = true;
+        for (std::size_t k = 0; k < count; ++k) {
+            const std::size_t i = (start + k) % count;
+            if (channels[i]->tryRecv(out)) return i;
+            if (!channels[i]->finished()) allClosed = false;
+        }
+        return count;
+    };
+
+    for (;;) {
+        bool allClosed = false;
+        std::size_t index = poll(allClosed);
+        if (index < count) return index;
+        if (allClosed) return poll(allClosed);
+
+        selecting.fetch_add(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        {
+            Scheduler::Blocking blocked;
+            std::unique_lock<std::mutex> lock(selectMutex);
+            selectReady.wait(lock, [&] {
+                bool everyClosed = true;
+                for (const auto& channel : channels) {
+                    if (!channel->drained()) return true;
+                    if (!channel->finished()) everyClosed = false;
+                }
+                return everyClosed;
+            });
+        }
+        selecting.fetch_sub(1);
+    }
+}
+
+
+ChannelNode::ChannelNode(SharedPtr<ChannelState> state) : state(std::move(state)) {
+    setType(NodeValueType::Any);
+}
+
+String ChannelNode::toString() const {
+    if (state->isClosed()) return "<Channel closed>";
+    if (state->capacity() == 0) return "<Channel " + std::to_string(state->size()) + ">";
+    return "<Channel " + std::to_string(state->size()) + "/" + std::to_string(state->capacity()) + ">";
+}
+
+bool ChannelNode::holdsValue() { return true; }
+
+std::size_t ChannelNode::hash() const {
+    return std::hash<const ChannelState*>()(state.get());
+}
+
+VariantType ChannelNode::getValue() const {
+    return std::static_pointer_cast<NativeNode>(std::const_pointer_cast<NodeBase>(shared_from_this()));
+}
+
+void ChannelNode::setValue(const VariantType&) {
+    throw MerkError("Channel objects are immutable");
+}
+
+// Copies, including transferred ones, talk to the same channel.
+SharedPtr<NodeBase> ChannelNode::clone() const {
+    return makeShared<ChannelNode>(*this);
+}
+
+void ChannelNode::clear() {}
+
+UniquePtr<NodeIterator> ChannelNode::makeIterator() const {
+    return makeUnique<ChannelIterator>(state);
+}
+
+SharedPtr<NativeNode> ChannelNode::toNative() const {
+    return makeShared<ChannelNode>(*this);
+}
+
+
+SharedPtr<ChannelState> channelOf(const Node& value) {
+    if (value.isInstance()) {
+        if (auto channel = std::dynamic_pointer_cast<ChannelNode>(value.toInstance()->getNativeData())) {
+            return channel->getState();
+        }
+    }
+    throw MerkError("Expected a Channel, got " + value.getTypeAsString());
+}
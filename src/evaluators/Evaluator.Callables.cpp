@@ -40,7 +40,7 @@ Node evaluateClassBody(SharedPtr<Scope> classCapturedScope, SharedPtr<Scope> cla
     if (accessor.empty()) {throw MerkError("Accessor Was Not Set On Body");}
 
 
-    generatedScope->owner = generateScopeOwner("Class", "Body");
+    MARK_UNUSED_MULTI(generatedScope);
     DEBUG_LOG(LogLevel::TRACE, highlight("Moving to Apply Accessor Scope Fix", Colors::yellow));
     Vector<String> methods;
     for (const auto& child : children) {
@@ -50,22 +50,22 @@ Node evaluateClassBody(SharedPtr<Scope> classCapturedScope, SharedPtr<Scope> cla
                 break;
             case AstType::ClassMethodDef:
                 if (child->getAstType() == AstType::ClassMethodDef){
-                    auto* methodDef = static_cast<MethodDef*>(child.get());
                     DEBUG_LOG(LogLevel::TRACE, "CREATING METHOD CALL SCOPE");
                     auto methodScope = classScope->createChildScope();
                     DEBUG_LOG(LogLevel::TRACE, "CREATED METHOD CALL SCOPE");
                     if (!methodScope){throw MerkError("generated methodscope is null for method in ClassDef::evaluate");} 
+
+                    // The accessor rewrites below work on this class's own copy; the parsed tree stays untouched.
+                    auto ownedDef = static_cast<MethodDef*>(child.get())->cloneInto(methodScope);
+                    auto* methodDef = ownedDef.get();
                     methodScope->owner = generateScopeOwner("ClassMethodBody", methodDef->getName());
 
-                    methodDef->setClassScope(classScope);
-                    if (methodDef->getClassScope().get() != classScope.get()) {throw MerkError("method class Scope is not the same as cls->classScope");}
- 
                     Vector<Chain*> nonStaticElements = applyAccessorScopeFix(methodDef, classScope, accessor);
                     
                     stripImplicitAccessor(methodDef, accessor);
                     methods.emplace_back(methodDef->getName());
                     // methodDef->setNonStaticElements(nonStaticElements);
-                    methodDef->evaluate(classScope, instanceNode);
+                    methodDef->evaluateIn(classScope, classScope, instanceNode);
                 } 
                 break;
 
@@ -93,6 +93,7 @@ Node evaluateMethodDef(
     SharedPtr<Scope> classScope, 
     String methodName, 
     MethodBody* body, 
+    const Captures& captures,
     ParamList parameters, 
     CallableType callType, 
     SharedPtr<ClassInstanceNode> instanceNode) {
@@ -103,24 +104,9 @@ Node evaluateMethodDef(
     if (!ownScope){throw MerkError("MethodDef::evaluate, scope is null");}
     if (!classScope) {throw MerkError("Class Scope wargValuesas not supplied to Method: " + methodName);}
 
-    auto freeVarNames = body->collectFreeVariables();
-
-    if (callType == CallableType::FUNCTION){
-        FreeVars tempFreeVars = freeVarNames;
-        for (auto& param : parameters){
-            auto it = tempFreeVars.find(param.getName()); // find a matching param name
-            if (it != tempFreeVars.end()){                // indicates a match
-                tempFreeVars.erase(it);
-            }
-        }
-
-        if (tempFreeVars.size() > 0){
-            std::ostringstream oss;
-            throw MerkError("The Following Vars: " + highlight(joinUnorderedSetStrings(tempFreeVars, ", "), Colors::yellow) + "; were defined outside of function defined using function");
-        }
-    } 
+    if (callType == CallableType::FUNCTION) {captures.requireBound();}
     
-    SharedPtr<Scope> defScope = passedScope->buildFunctionDefScope(freeVarNames, methodName);
+    SharedPtr<Scope> defScope = passedScope->buildFunctionDefScope(captures.names, methodName);
     if (!defScope){DEBUG_FLOW_EXIT();throw MerkError("Defining Scope for FunctionDef::evaluate is null");}
     if (!defScope){throw MerkError("defScope created in MethodDef::evaluate is null");}
 
@@ -188,6 +174,13 @@ Node evaluateFunctionCall(String name, SharedPtr<Scope> scope, Arguments* argume
     if (!scope) {throw MerkError("scope passed to FunctionCall::evaluate is null");}
     if (name == "showScope") {scope->debugPrint(); return Node(Null);}
     auto callArgs = arguments->evaluateAll(scope, instanceNode);
+    Node value = invokeFunction(name, callArgs, scope, instanceNode);
+    DEBUG_FLOW_EXIT();
+    return value;
+}
+
+Node invokeFunction(const String& name, ArgumentList callArgs, SharedPtr<Scope> scope, SharedPtr<ClassInstanceNode> instanceNode) {
+    if (!scope) {throw MerkError("scope passed to invokeFunction is null");}
     SharedPtr<CallableSignature> optSig;
 
     auto sigOpt = scope->getFunction(name, callArgs);
@@ -217,7 +210,25 @@ Node evaluateFunctionCall(String name, SharedPtr<Scope> scope, Arguments* argume
 
 
     SharedPtr<Function> func = std::static_pointer_cast<Function>(optSig->getCallable());
+    return callFunction(func, std::move(callArgs), scope, instanceNode);
+}
+
+SharedPtr<Function> resolveFunctionValue(const Node& callee, const ArgumentList& callArgs, SharedPtr<Scope> scope) {
+    if (!scope) {throw MerkError("scope passed to resolveFunctionValue is null");}
+    if (!callee.isFunctionNode()) {
+        throw MerkError("Expected a function, got " + callee.getTypeAsString());
+    }
+    auto funcNode = callee.toFunctionNode();
+    const String name = callee.getFlags().name;
+    auto opt = funcNode.getFunction(name, callArgs, scope);
+    if (!opt.has_value()) {
+        throw MerkError("Could Not Determine Overload for function " + name);
+    }
+    return std::static_pointer_cast<Function>(opt.value()->getCallable());
+}
 
+Node callFunction(SharedPtr<Function> func, ArgumentList callArgs, SharedPtr<Scope> scope, SharedPtr<ClassInstanceNode> instanceNode) {
+    if (!func) {throw MerkError("callFunction received a null function");}
     if (func->getSubType() == CallableType::NATIVE) {
         return func->execute(callArgs, scope, instanceNode);
     }
@@ -228,7 +239,8 @@ Node evaluateFunctionCall(String name, SharedPtr<Scope> scope, Arguments* argume
     if (!captured) { throw MerkError("Function has No CapturedScope 1"); }
 
     
-    if (captured->getContext().getVariables().size() == 0) {
+    // Generators outlive this call, so they always get a frame of their own.
+    if (captured->getContext().getVariables().size() == 0 && !func->isGenerator()) {
         callScope = captured;
         scope->appendChildScope(callScope, false);
         
@@ -377,7 +389,7 @@ Node evaluateChain(SharedPtr<Scope> currentScope, SharedPtr<Scope> methodScope,
                 
             default:
                 currentVal = elem.object->evaluate(currentScope, instanceNode);
-                currentScope = elem.object->getScope();
+                currentScope = methodScope; // not the node's parse-time scope: the tree is shared between runs
                 
                 break;
             }
@@ -436,7 +448,7 @@ Node evaluateChain(SharedPtr<Scope> currentScope, SharedPtr<Scope> methodScope,
             }
             
             DEBUG_LOG(LogLevel::DEBUG, highlight("Else OBJECTS AST TYPE: ", Colors::red), astTypeToString(elem.object->getAstType()));            
-            currentScope = elem.object->getScope();
+            currentScope = methodScope;
             
         }
         
@@ -8,6 +8,7 @@
 #include "core/node/Node.hpp"
 #include "core/node/ArgumentNode.hpp"
 #include "core/node/NodeStructures.hpp"
+#include "core/node/NodeKernels.hpp"
 
 #include "core/types.h"
 #include "core/errors.h"
@@ -15,6 +16,7 @@
 
 #include "core/Environments/Scope.hpp"
 #include "core/evaluators/Evaluator.hpp"
+#include "core/evaluators/Parallel.hpp"
 #include "core/Environments/Scope.hpp"
 
 #include "utilities/helper_functions.h"
@@ -34,40 +36,7 @@
 #include "core/callables/functions/Function.hpp"
 #include "core/callables/classes/Method.hpp"
 #include "core/evaluators/TypeEvaluator.hpp"
-
-// enum class Operator {
-//     Equals,
-//     NotEquals,
-//     LessThan,
-//     GreaterThan,
-//     LessThanOrEquals,
-//     GreaterThanOrEquals,
-//     Plus,
-//     Minus,
-//     Multiply,
-//     Divide,
-//     Modulo,
-//     Invalid
-// };
-
-// Operator stringToOperator(const String& op) {
-//     static const std::unordered_map<String, Operator> operatorMap = {
-//         {"==", Operator::Equals},
-//         {"!=", Operator::NotEquals},
-//         {"<", Operator::LessThan},
-//         {">", Operator::GreaterThan},
-//         {"<=", Operator::LessThanOrEquals},
-//         {">=", Operator::GreaterThanOrEquals},
-//         {"+", Operator::Plus},
-//         {"-", Operator::Minus},
-//         {"*", Operator::Multiply},
-//         {"/", Operator::Divide},
-//         {"%", Operator::Modulo}
-//     };
-
-//     auto it = operatorMap.find(op);
-//     return (it != operatorMap.end()) ? it->second : Operator::Invalid;
-// }
+#include "core/evaluators/Scheduler.hpp"
 
 bool isDebug = Debugger::getInstance().getLogLevel() == LogLevel::DEBUG;
 
@@ -102,22 +71,29 @@ namespace Evaluator {
 
 namespace {
 constexpr bool kEnableFastIntExprAssign = true;
+constexpr bool kEnableDirectConditions = true;
+
+bool isNumericNode(const Node& node) {
+    return node.isInt() || node.isFloat() || node.isDouble();
+}
 
-bool tryApplyIntBinary(const String& op, int lhs, int rhs, int& out) {
-    if (op == "+") { out = lhs + rhs; return true; }
-    if (op == "-") { out = lhs - rhs; return true; }
-    if (op == "*") { out = lhs * rhs; return true; }
-    if (op == "/") {
-        if (rhs == 0) throw MerkError("Division by zero");
-        out = lhs / rhs;
-        return true;
+// Same results as evaluateBinaryOperation for comparison operators, without
+// materialising a Bool node.
+bool compareForCondition(BinaryOp op, const Node& lhs, const Node& rhs) {
+    if (op == BinaryOp::Eq || op == BinaryOp::Ne) {
+        const bool equal = (isNumericNode(lhs) && isNumericNode(rhs))
+            ? lhs.compare(rhs) == Ordering::Equal
+            : lhs == rhs;
+        return (op == BinaryOp::Eq) == equal;
     }
-    if (op == "%") {
-        if (rhs == 0) throw MerkError("Modulo by zero");
-        out = lhs % rhs;
-        return true;
+
+    const Ordering order = lhs.compare(rhs);
+    switch (op) {
+        case BinaryOp::Lt: return order == Ordering::Less;
+        case BinaryOp::Gt: return order == Ordering::Greater;
+        case BinaryOp::Le: return order == Ordering::Less || order == Ordering::Equal;
+        default: return order == Ordering::Greater || order == Ordering::Equal;
     }
-    return false;
 }
 
 bool tryEvalIntExprFast(const ASTStatement* expr,
@@ -141,7 +117,7 @@ bool tryEvalIntExprFast(const ASTStatement* expr,
             const auto* u = static_cast<const UnaryOperation*>(expr);
             int v = 0;
             if (!tryEvalIntExprFast(u->getOperand(), scope, instanceNode, v)) return false;
-            if (u->getOperator() == "-") {
+            if (u->getOperator() == UnaryOp::Negate) {
                 out = -v;
                 return true;
             }
@@ -153,90 +129,13 @@ bool tryEvalIntExprFast(const ASTStatement* expr,
             int rhs = 0;
             if (!tryEvalIntExprFast(b->getLeftSide(), scope, instanceNode, lhs)) return false;
             if (!tryEvalIntExprFast(b->getRightSide(), scope, instanceNode, rhs)) return false;
-            return tryApplyIntBinary(b->getOperator(), lhs, rhs, out);
+            return NodeKernels::applyInt(b->getOperator(), lhs, rhs, out);
         }
         default:
             return false;
     }
 }
 
-bool computeBinary(const String& op, int lhs, int rhs, Node& out) {
-    if (op == "+")  { out = Node(lhs + rhs); return true; }
-    if (op == "-")  { out = Node(lhs - rhs); return true; }
-    if (op == "*")  { out = Node(lhs * rhs); return true; }
-    if (op == "/")  {
-        if (rhs == 0) throw MerkError("Division by zero");
-        out = Node(lhs / rhs);
-        return true;
-    }
-    if (op == "%")  {
-        if (rhs == 0) throw MerkError("Modulo by zero");
-        out = Node(lhs % rhs);
-        return true;
-    }
-    if (op == "==") { out = Node(lhs == rhs); return true; }
-    if (op == "!=") { out = Node(lhs != rhs); return true; }
-    if (op == "<")  { out = Node(lhs < rhs); return true; }
-    if (op == "<=") { out = Node(lhs <= rhs); return true; }
-    if (op == ">")  { out = Node(lhs > rhs); return true; }
-    if (op == ">=") { out = Node(lhs >= rhs); return true; }
-    return false;
-}
-
-bool computeBinaryMixedNumeric(const String& op, double lhs, double rhs, Node& out) {
-    if (op == "+")  { out = Node(lhs + rhs); return true; }
-    if (op == "-")  { out = Node(lhs - rhs); return true; }
-    if (op == "*")  { out = Node(lhs * rhs); return true; }
-    if (op == "/")  {
-        if (rhs == 0.0) throw MerkError("Division by zero");
-        out = Node(lhs / rhs);
-        return true;
-    }
-    if (op == "==") { out = Node(lhs == rhs); return true; }
-    if (op == "!=") { out = Node(lhs != rhs); return true; }
-    if (op == "<")  { out = Node(lhs < rhs); return true; }
-    if (op == "<=") { out = Node(lhs <= rhs); return true; }
-    if (op == ">")  { out = Node(lhs > rhs); return true; }
-    if (op == ">=") { out = Node(lhs >= rhs); return true; }
-    return false;
-}
-
-bool computeBinary(const String& op, const String& lhs, const String& rhs, Node& out) {
-    if (op == "+")  { out = Node(lhs + rhs); return true; }
-    if (op == "==") { out = Node(lhs == rhs); return true; }
-    if (op == "!=") { out = Node(lhs != rhs); return true; }
-    if (op == "<")  { out = Node(lhs < rhs); return true; }
-    if (op == "<=") { out = Node(lhs <= rhs); return true; }
-    if (op == ">")  { out = Node(lhs > rhs); return true; }
-    if (op == ">=") { out = Node(lhs >= rhs); return true; }
-    return false;
-}
-
-bool computeBinary(const String& op, bool lhs, bool rhs, Node& out) {
-    if (op == "and" || op == "&&") { out = Node(lhs && rhs); return true; }
-    if (op == "or"  || op == "||") { out = Node(lhs || rhs); return true; }
-    if (op == "==")               { out = Node(lhs == rhs); return true; }
-    if (op == "!=")               { out = Node(lhs != rhs); return true; }
-    return false;
-}
-
-bool dispatchTypedBinary(const String& op, const Node& lhs, const Node& rhs, Node& out) {
-    if (lhs.isInt() && rhs.isInt()) {
-        return computeBinary(op, lhs.toInt(), rhs.toInt(), out);
-    }
-    const bool lhsNumeric = lhs.isInt() || lhs.isFloat() || lhs.isDouble();
-    const bool rhsNumeric = rhs.isInt() || rhs.isFloat() || rhs.isDouble();
-    if (lhsNumeric && rhsNumeric) {
-        return computeBinaryMixedNumeric(op, lhs.toDouble(), rhs.toDouble(), out);
-    }
-    if (lhs.isString() && rhs.isString()) {
-        return computeBinary(op, lhs.toString(), rhs.toString(), out);
-    }
-    if (lhs.isBool() && rhs.isBool()) {
-        return computeBinary(op, lhs.toBool(), rhs.toBool(), out);
-    }
-    return false;
-}
 } // namespace
 
     Node evaluateLiteral(Node value){
@@ -390,20 +289,51 @@ bool dispatchTypedBinary(const String& op, const Node& lhs, const Node& rhs, Nod
 
 
 
+    bool evaluateCondition(const ASTStatement* condition, SharedPtr<Scope> scope, SharedPtr<ClassInstanceNode> instanceNode) {
+        if (!condition) { throw MerkError("Condition is null"); }
+
+        if (kEnableDirectConditions && condition->getAstType() == AstType::BinaryOperation) {
+            const auto* binary = static_cast<const BinaryOperation*>(condition);
+            const BinaryOp op = binary->getOperator();
+            if (op == BinaryOp::And) {
+                return evaluateCondition(binary->getLeftSide(), scope, instanceNode) &&
+                       evaluateCondition(binary->getRightSide(), scope, instanceNode);
+            }
+            if (op == BinaryOp::Or) {
+                return evaluateCondition(binary->getLeftSide(), scope, instanceNode) ||
+                       evaluateCondition(binary->getRightSide(), scope, instanceNode);
+            }
+            if (isComparisonOp(op)) {
+                const Node lhs = binary->getLeftSide()->evaluate(scope, instanceNode);
+                const Node rhs = binary->getRightSide()->evaluate(scope, instanceNode);
+                return compareForCondition(op, lhs, rhs);
+            }
+        }
+
+        if (kEnableDirectConditions && condition->getAstType() == AstType::UnaryOperation) {
+            const auto* unary = static_cast<const UnaryOperation*>(condition);
+            if (unary->getOperator() == UnaryOp::Not && unary->getOperand() &&
+                unary->getOperand()->getAstType() == AstType::BinaryOperation) {
+                return !evaluateCondition(unary->getOperand(), scope, instanceNode);
+            }
+        }
+
+        return condition->evaluate(scope, instanceNode).isTruthy();
+    }
+
     Node evaluateIf (const IfStatement& ifStatement, SharedPtr<Scope> conditionScope, SharedPtr<ClassInstanceNode> instanceNode) {
         MARK_UNUSED_MULTI(instanceNode);
         DEBUG_FLOW(FlowLevel::PERMISSIVE);
         DEBUG_LOG(LogLevel::TRACE, "evaluateIf");
         DEBUG_LOG(LogLevel::TRACE, "Condition Ast Below: ");
-        if (ifStatement.getCondition()->evaluate(conditionScope, instanceNode).isTruthy()) {
+        if (evaluateCondition(ifStatement.getCondition(), conditionScope, instanceNode)) {
 
             DEBUG_FLOW_EXIT();
             return ifStatement.getBody()->evaluate(conditionScope, instanceNode);
         }
 
         for (const auto& elif : ifStatement.getElifs()) {
-            auto val = elif->evaluate(conditionScope, instanceNode);
-            if (val.isTruthy()) {
+            if (evaluateCondition(elif->getCondition(), conditionScope, instanceNode)) {
                 return elif->getBody()->evaluate(conditionScope, instanceNode);
             }
         }
@@ -429,7 +359,7 @@ bool dispatchTypedBinary(const String& op, const Node& lhs, const Node& rhs, Nod
             throw MerkError("ElIfStatement missing condition in Evaluator::evaluateElif");
         }
 
-        return Node(elifStatement.getCondition()->evaluate(scope, instanceNode).isTruthy());
+        return Node(evaluateCondition(elifStatement.getCondition(), scope, instanceNode));
 
         DEBUG_FLOW_EXIT();
         return Node();
@@ -460,11 +390,10 @@ bool dispatchTypedBinary(const String& op, const Node& lhs, const Node& rhs, Nod
         }
 
         while (true) {
+            Fuel::burn();
             DEBUG_LOG(LogLevel::TRACE, "About To Evaluate While Loop Condition Result");
  
-            Node conditionResult = condition.evaluate(scope, instanceNode);
-            DEBUG_LOG(LogLevel::INFO, "While Loop Condition Result: ", conditionResult);
-            if (!conditionResult.toBool()) {
+            if (!condition.isTruthy(scope, instanceNode)) {
                 DEBUG_LOG(LogLevel::TRACE, "Condition evaluated to false. Exiting loop.");
                 break;
             }
@@ -485,9 +414,61 @@ bool dispatchTypedBinary(const String& op, const Node& lhs, const Node& rhs, Nod
         return Node();
     }
 
+    VarNode* resolveLoopVariable(const String& name, NodeValueType type, const Node& initial, SharedPtr<Scope> scope) {
+        if (!scope->hasVariable(name)) {
+            DataTypeFlags loopFlags;
+            loopFlags.isConst = false;
+            loopFlags.isMutable = true;
+            loopFlags.isStatic = false;
+            loopFlags.type = type;
+            scope->declareVariable(name, makeUnique<VarNode>(initial, loopFlags));
+        }
+        return scope->resolveLoopSlot(name);
+    }
+
+    void bindLoopVariable(VarNode* slot, const String& name, const Node& value, SharedPtr<Scope> scope) {
+        if (slot) {
+            slot->bindValue(value);
+        } else {
+            scope->updateVariable(name, value);
+        }
+    }
+
+    static Node evaluateForInLoop(const ForLoop& forLoop, SharedPtr<Scope> scope, SharedPtr<ClassInstanceNode> instanceNode) {
+        const Node iterable = forLoop.getIterableExpr()->evaluate(scope, instanceNode);
+        auto it = makeNodeIterator(iterable);
+
+        Node item;
+        if (!it->next(item)) {
+            return Node();
+        }
+
+        const String& loopVar = forLoop.getLoopVariable();
+        VarNode* slot = resolveLoopVariable(loopVar, NodeValueType::Any, Node(0), scope);
+        const CodeBlock* body = forLoop.getBody();
+        do {
+            Fuel::burn();
+            bindLoopVariable(slot, loopVar, item, scope);
+            try {
+                body->evaluate(scope, instanceNode);
+            } catch (const ContinueException&) {
+                continue;
+            } catch (const BreakException&) {
+                break;
+            }
+        } while (it->next(item));
+
+        return Node();
+    }
+
     Node evaluateForLoop(const ForLoop& forLoop, SharedPtr<Scope> scope, SharedPtr<ClassInstanceNode> instanceNode) {
         DEBUG_FLOW(FlowLevel::LOW);
         if (!scope) throw MerkError("evaluateForLoop: scope is null");
+        if (forLoop.isForIn()) {
+            Node val = evaluateForInLoop(forLoop, scope, instanceNode);
+            DEBUG_FLOW_EXIT();
+            return val;
+        }
 
         const ASTStatement* startExpr = forLoop.getStartExpr();
         const ASTStatement* endExpr = forLoop.getEndExpr();
@@ -508,23 +489,22 @@ bool dispatchTypedBinary(const String& op, const Node& lhs, const Node& rhs, Nod
             throw MerkError("for-loop step cannot be 0");
         }
 
-        const String& loopVar = forLoop.getLoopVariable();
-        if (!scope->hasVariable(loopVar)) {
-            DataTypeFlags loopFlags;
-            loopFlags.isConst = false;
-            loopFlags.isMutable = true;
-            loopFlags.isStatic = false;
-            loopFlags.type = NodeValueType::Int;
-            scope->declareVariable(loopVar, makeUnique<VarNode>(Node(start), loopFlags));
-        } else {
-            scope->updateVariable(loopVar, Node(start));
+        if (forLoop.isParallel()) {
+            if (auto parallel = Parallel::tryEvaluateFor(forLoop, start, end, step, scope, instanceNode)) {
+                DEBUG_FLOW_EXIT();
+                return parallel->value;
+            }
         }
 
+        const String& loopVar = forLoop.getLoopVariable();
+        VarNode* slot = resolveLoopVariable(loopVar, NodeValueType::Int, Node(start), scope);
+
         int i = start;
         const auto inRange = [&]() { return step > 0 ? (i < end) : (i > end); };
 
         while (inRange()) {
-            scope->updateVariable(loopVar, Node(i));
+            Fuel::burn();
+            bindLoopVariable(slot, loopVar, Node(i), scope);
             try {
                 body->evaluate(scope, instanceNode);
             } catch (const ContinueException&) {
@@ -541,45 +521,46 @@ bool dispatchTypedBinary(const String& op, const Node& lhs, const Node& rhs, Nod
     }
 
 
-    Node evaluateBinaryOperation(const String& op, const Node& leftValue, const Node& rightValue, SharedPtr<Scope> scope, SharedPtr<ClassInstanceNode> instanceNode) {
+    Node evaluateBinaryOperation(BinaryOp op, const Node& leftValue, const Node& rightValue, SharedPtr<Scope> scope, SharedPtr<ClassInstanceNode> instanceNode) {
         MARK_UNUSED_MULTI(instanceNode);
         DEBUG_FLOW(FlowLevel::PERMISSIVE);
         evaluatingFor(leftValue, "evaluateBinaryOperation", scope->getScopeLevel());
         evaluatingFor(rightValue, "evaluateBinaryOperation", scope->getScopeLevel());
 
-        DEBUG_LOG(LogLevel::TRACE, "Evaluating BinaryOperation: ", leftValue, " ", op, " ", rightValue);
+        DEBUG_LOG(LogLevel::TRACE, "Evaluating BinaryOperation: ", leftValue, " ", binaryOpToString(op), " ", rightValue);
 
         Node typedOut;
-        if (dispatchTypedBinary(op, leftValue, rightValue, typedOut)) {
+        if (NodeKernels::apply(op, leftValue, rightValue, typedOut)) {
             DEBUG_FLOW_EXIT();
             return typedOut;
         }
 
         Node val;
-        if (op == "+") val = leftValue + rightValue;
-        else if (op == "-") val = leftValue - rightValue;
-        else if (op == "*") val = leftValue * rightValue;
-        else if (op == "/") val = leftValue / rightValue;
-        else if (op == "%") val = leftValue % rightValue;
-        
-        else if (op == "and" || op == "&&") val = Node(leftValue.isTruthy() && rightValue.isTruthy());
-        else if (op == "or" || op == "||") val = Node(leftValue.isTruthy() || rightValue.isTruthy());
-
-        else if (op == "+=") val = leftValue += rightValue;
-        else if (op == "-=") val = leftValue -= rightValue;
-        else if (op == "*=") val = leftValue *= rightValue;
-        else if (op == "/=") val = leftValue /= rightValue;
-        else if (op == "++") val = leftValue += Node(1);
-
-        // Relational operations
-        else if (op == "==") {val = Node(leftValue == rightValue);}
-        else if (op == "!=") val = Node(leftValue != rightValue);
-        else if (op == "<") val = Node(leftValue < rightValue);
-        else if (op == "<=") val = Node(leftValue <= rightValue);
-        else if (op == ">") val = Node(leftValue > rightValue);
-        else if (op == ">=") val = Node(leftValue >= rightValue);
-
-
+        switch (op) {
+            case BinaryOp::Add: val = leftValue + rightValue; break;
+            case BinaryOp::Sub: val = leftValue - rightValue; break;
+            case BinaryOp::Mul: val = leftValue * rightValue; break;
+            case BinaryOp::Div: val = leftValue / rightValue; break;
+            case BinaryOp::Mod: val = leftValue % rightValue; break;
+
+            case BinaryOp::And: val = Node(leftValue.isTruthy() && rightValue.isTruthy()); break;
+            case BinaryOp::Or: val = Node(leftValue.isTruthy() || rightValue.isTruthy()); break;
+
+            case BinaryOp::AddAssign: val = leftValue += rightValue; break;
+            case BinaryOp::SubAssign: val = leftValue -= rightValue; break;
+            case BinaryOp::MulAssign: val = leftValue *= rightValue; break;
+            case BinaryOp::DivAssign: val = leftValue /= rightValue; break;
+            case BinaryOp::Increment: val = leftValue += Node(1); break;
+
+            // Relational operations
+            case BinaryOp::Eq: val = Node(leftValue == rightValue); break;
+            case BinaryOp::Ne: val = Node(leftValue != rightValue); break;
+            case BinaryOp::Lt: val = Node(leftValue < rightValue); break;
+            case BinaryOp::Le: val = Node(leftValue <= rightValue); break;
+            case BinaryOp::Gt: val = Node(leftValue > rightValue); break;
+            case BinaryOp::Ge: val = Node(leftValue >= rightValue); break;
+            default: break;
+        }
 
         if (val.isValid()) {
             DEBUG_FLOW_EXIT();
@@ -588,31 +569,28 @@ bool dispatchTypedBinary(const String& op, const Node& lhs, const Node& rhs, Nod
 
         DEBUG_LOG(LogLevel::TRACE,"BINARY OPERATION RESULT: ", val.toString());
         DEBUG_FLOW_EXIT();
-        throw MerkError("Unsupported operator: " + op);
+        throw MerkError("Unsupported operator: " + binaryOpToString(op));
     }
 
-    Node evaluateUnaryOperation(const String& op, const Node& operand, SharedPtr<ClassInstanceNode> instanceNode) {
+    Node evaluateUnaryOperation(UnaryOp op, const Node& operand, SharedPtr<ClassInstanceNode> instanceNode) {
         MARK_UNUSED_MULTI(instanceNode);
         DEBUG_FLOW(FlowLevel::PERMISSIVE);
         MARK_UNUSED_MULTI(operand);
         evaluatingFor(operand, "evaluateUnaryOperation");
-        Node val;
-        if (op == "!" || op == "not") {
-            if (operand.isBool() || operand.toBool()) {
-                return Node(!operand.toBool());
-            }
-            DEBUG_FLOW_EXIT();
-            throw MerkError("Invalid type for '!': Operand must be boolean.");
-        } else if (op == "?") {
-            return Node(!operand.isNull());
-        } 
-        
-        else if (op == "-") { return operand.negate(); }
+        switch (op) {
+            case UnaryOp::Not:
+                if (operand.isBool() || operand.toBool()) {
+                    return Node(!operand.toBool());
+                }
+                DEBUG_FLOW_EXIT();
+                throw MerkError("Invalid type for '!': Operand must be boolean.");
+            case UnaryOp::Exists: return Node(!operand.isNull());
+            case UnaryOp::Negate: return operand.negate();
+            default: break;
+        }
 
-        return Node();
-        
         DEBUG_FLOW_EXIT();
-        throw MerkError("Unsupported unary operator: " + op);
+        return Node();
     }
 
     [[noreturn]] Node evaluateBreak(SharedPtr<Scope> scope, SharedPtr<ClassInstanceNode> instanceNode) {
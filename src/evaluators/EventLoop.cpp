@@ -0,0 +1,446 @@
+#include "core/evaluators/EventLoop.hpp"
+
+#include <condition_variable>
+#include <mutex>
+
+#include <fcntl.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#else
+#include <poll.h>
+#endif
+
+#include "core/errors.h"
+#include "core/node/ArgumentNode.hpp"
+#include "core/Environments/Isolate.hpp"
+#include "core/evaluators/Evaluator.hpp"
+#include "core/evaluators/Future.hpp"
+#include "core/evaluators/Generator.hpp"
+#include "core/evaluators/Parallel.hpp"
+#include "core/evaluators/Scheduler.hpp"
+#include "core/callables/functions/Function.hpp"
+#include "utilities/thread_pool.h"
+
+
+// Handles posted back from other threads, plus the descriptor that wakes the poller for them.
+struct EventLoop::Inbox {
+    std::mutex mutex;
+    std::condition_variable settled;
+    Vector<std::coroutine_handle<>> posted;
+    std::size_t offloads = 0; // on the pool, not yet posted back
+    bool closed = false;
+    int readFd = -1;
+    int writeFd = -1;
+
+    Inbox() {
+#if defined(__linux__)
+        readFd = writeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        if (readFd < 0) throw MerkError("EventLoop: eventfd failed");
+#else
+        int fds[2];
+        if (pipe(fds) != 0) throw MerkError("EventLoop: pipe failed");
+        readFd = fds[0];
+        writeFd = fds[1];
+        fcntl(readFd, F_SETFL, O_NONBLOCK);
+        fcntl(writeFd, F_SETFL, O_NONBLOCK);
+#endif
+    }
+
+    ~Inbox() {
+        close(readFd);
+        if (writeFd != readFd) close(writeFd);
+    }
+
+    // Any thread. A null handle only wakes the loop.
+    void post(std::coroutine_handle<> handle, bool fromOffload) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (fromOffload && --offloads == 0) settled.notify_all();
+        if (closed) return;
+        if (handle) posted.push_back(handle);
+#if defined(__linux__)
+        const std::uint64_t one = 1;
+#else
+        const char one = 1;
+#endif
+        [[maybe_unused]] auto written = write(writeFd, &one, sizeof(one));
+    }
+
+    Vector<std::coroutine_handle<>> take() {
+        std::lock_guard<std::mutex> lock(mutex);
+        char buffer[64];
+        while (read(readFd, buffer, sizeof(buffer)) > 0) {}
+        Vector<std::coroutine_handle<>> out;
+        out.swap(posted);
+        return out;
+    }
+};
+
+
+#if defined(__linux__)
+
+struct EventLoop::Poller {
+    int fd;
+
+    Poller() : fd(epoll_create1(EPOLL_CLOEXEC)) {
+        if (fd < 0) throw MerkError("EventLoop: epoll_create1 failed");
+    }
+    ~Poller() { close(fd); }
+
+    void watch(int socket, bool in, bool out) {
+        epoll_event event{};
+        event.events = (in ? EPOLLIN : 0u) | (out ? EPOLLOUT : 0u);
+        event.data.fd = socket;
+        if (epoll_ctl(fd, EPOLL_CTL_MOD, socket, &event) != 0) epoll_ctl(fd, EPOLL_CTL_ADD, socket, &event);
+    }
+
+    void forget(int socket) { epoll_ctl(fd, EPOLL_CTL_DEL, socket, nullptr); }
+
+    // Calls onEvent(fd, CURL_CSELECT_* mask) for each ready descriptor.
+    template <typename F>
+    void wait(int timeoutMs, F&& onEvent) {
+        epoll_event events[64];
+        const int count = epoll_wait(fd, events, 64, timeoutMs);
+        for (int i = 0; i < count; ++i) {
+            const auto flags = events[i].events;
+            int mask = 0;
+            if (flags & (EPOLLIN | EPOLLHUP)) mask |= CURL_CSELECT_IN;
+            if (flags & EPOLLOUT) mask |= CURL_CSELECT_OUT;
+            if (flags & EPOLLERR) mask |= CURL_CSELECT_ERR;
+            onEvent(events[i].data.fd, mask);
+        }
+    }
+};
+
+#else
+
+struct EventLoop::Poller {
+    std::unordered_map<int, short> sockets;
+
+    void watch(int socket, bool in, bool out) {
+        sockets[socket] = static_cast<short>((in ? POLLIN : 0) | (out ? POLLOUT : 0));
+    }
+
+    void forget(int socket) { sockets.erase(socket); }
+
+    template <typename F>
+    void wait(int timeoutMs, F&& onEvent) {
+        Vector<pollfd> fds;
+        fds.reserve(sockets.size());
+        for (const auto& [socket, events] : sockets) fds.push_back({socket, events, 0});
+        if (poll(fds.data(), static_cast<nfds_t>(fds.size()), timeoutMs) <= 0) return;
+        for (const auto& entry : fds) {
+            int mask = 0;
+            if (entry.revents & (POLLIN | POLLHUP)) mask |= CURL_CSELECT_IN;
+            if (entry.revents & POLLOUT) mask |= CURL_CSELECT_OUT;
+            if (entry.revents & POLLERR) mask |= CURL_CSELECT_ERR;
+            if (mask) onEvent(entry.fd, mask);
+        }
+    }
+};
+
+#endif
+
+
+EventLoop::EventLoop() : inbox(makeShared<Inbox>()), poller(makeUnique<Poller>()) {
+    poller->watch(inbox->readFd, true, false);
+}
+
+EventLoop::~EventLoop() {
+    {
+        // Pool work writes into suspended frames; let it land before they go.
+        std::unique_lock<std::mutex> lock(inbox->mutex);
+        inbox->settled.wait(lock, [this] { return inbox->offloads == 0; });
+        inbox->closed = true;
+        inbox->posted.clear(); // all of them are parked
+    }
+
+    std::unordered_set<void*> frames(parked.begin(), parked.end());
+    for (auto handle : ready) frames.insert(handle.address());
+    for (; !timers.empty(); timers.pop()) frames.insert(timers.top().handle.address());
+    for (auto& [easy, transfer] : transfers) {
+        curl_multi_remove_handle(multi, easy);
+        frames.insert(transfer.handle.address());
+    }
+    ready.clear();
+    transfers.clear();
+    parked.clear();
+
+    for (void* frame : frames) std::coroutine_handle<>::from_address(frame).destroy();
+    if (multi) curl_multi_cleanup(multi);
+}
+
+EventLoop& EventLoop::current() {
+    return Isolate::current().eventLoop();
+}
+
+bool EventLoop::FutureAwaiter::await_ready() const {
+    return future.isDone();
+}
+
+bool EventLoop::idle() const {
+    return ready.empty() && timers.empty() && transfers.empty() && parked.empty();
+}
+
+
+void EventLoop::addTimer(Clock::time_point deadline, std::coroutine_handle<> handle) {
+    timers.push({deadline, timerOrder++, handle});
+}
+
+void EventLoop::addTransfer(CURL* easy, CURLcode* result, std::coroutine_handle<> handle) {
+    if (!multi) {
+        multi = curl_multi_init();
+        if (!multi) throw MerkError("curl_multi_init failed");
+        curl_multi_setopt(multi, CURLMOPT_SOCKETFUNCTION, &EventLoop::onCurlSocket);
+        curl_multi_setopt(multi, CURLMOPT_SOCKETDATA, this);
+        curl_multi_setopt(multi, CURLMOPT_TIMERFUNCTION, &EventLoop::onCurlTimer);
+        curl_multi_setopt(multi, CURLMOPT_TIMERDATA, this);
+    }
+    transfers[easy] = Transfer{result, handle};
+    if (curl_multi_add_handle(multi, easy) != CURLM_OK) {
+        transfers.erase(easy);
+        *result = CURLE_FAILED_INIT;
+        ready.push_back(handle);
+    }
+}
+
+void EventLoop::addOffload(std::function<void()>& work, std::exception_ptr* failure, std::coroutine_handle<> handle) {
+    {
+        std::lock_guard<std::mutex> lock(inbox->mutex);
+        ++inbox->offloads;
+    }
+    parked.insert(handle.address());
+    // `work` and `failure` live in the suspended frame, which stays put until the post.
+    Parallel::pool().submit([box = inbox, &work, failure, handle](std::size_t) {
+        try {
+            work();
+        } catch (...) {
+            *failure = std::current_exception();
+        }
+        box->post(handle, true);
+    });
+}
+
+void EventLoop::addFutureWait(FutureState& future, std::coroutine_handle<> handle) {
+    parked.insert(handle.address());
+    future.onComplete([box = inbox, handle] { box->post(handle, false); });
+}
+
+
+int EventLoop::onCurlSocket(CURL*, curl_socket_t fd, int what, void* loop, void*) {
+    auto& self = *static_cast<EventLoop*>(loop);
+    if (what == CURL_POLL_REMOVE) {
+        self.poller->forget(fd);
+    } else {
+        self.poller->watch(fd, (what & CURL_POLL_IN) != 0, (what & CURL_POLL_OUT) != 0);
+    }
+    return 0;
+}
+
+int EventLoop::onCurlTimer(CURLM*, long timeoutMs, void* loop) {
+    auto& self = *static_cast<EventLoop*>(loop);
+    self.curlTimerArmed = timeoutMs >= 0;
+    if (self.curlTimerArmed) self.curlDeadline = Clock::now() + std::chrono::milliseconds(timeoutMs);
+    return 0;
+}
+
+void EventLoop::finishTransfers() {
+    int pending = 0;
+    while (CURLMsg* message = curl_multi_info_read(multi, &pending)) {
+        if (message->msg != CURLMSG_DONE) continue;
+        CURL* easy = message->easy_handle;
+        const CURLcode code = message->data.result;
+        curl_multi_remove_handle(multi, easy);
+
+        auto it = transfers.find(easy);
+        if (it == transfers.end()) continue;
+        *it->second.result = code;
+        ready.push_back(it->second.handle);
+        transfers.erase(it);
+    }
+}
+
+
+int EventLoop::pollTimeoutMs() const {
+    if (!ready.empty()) return 0;
+    bool bounded = false;
+    Clock::time_point deadline{};
+    if (!timers.empty()) {
+        deadline = timers.top().deadline;
+        bounded = true;
+    }
+    if (curlTimerArmed && (!bounded || curlDeadline < deadline)) {
+        deadline = curlDeadline;
+        bounded = true;
+    }
+    if (!bounded) return -1;
+    const auto wait = std::chrono::ceil<std::chrono::milliseconds>(deadline - Clock::now()).count();
+    return wait > 0 ? static_cast<int>(wait) : 0;
+}
+
+void EventLoop::drainInbox() {
+    for (auto handle : inbox->take()) {
+        parked.erase(handle.address());
+        ready.push_back(handle);
+    }
+}
+
+void EventLoop::fireTimers() {
+    const auto now = Clock::now();
+    while (!timers.empty() && timers.top().deadline <= now) {
+        ready.push_back(timers.top().handle);
+        timers.pop();
+    }
+    if (multi && curlTimerArmed && curlDeadline <= now) {
+        curlTimerArmed = false;
+        int running = 0;
+        curl_multi_socket_action(multi, CURL_SOCKET_TIMEOUT, 0, &running);
+    }
+}
+
+// Takes the batch first: resumed coroutines may wait again, and nested waits run the loop too.
+void EventLoop::resumeReady() {
+    std::deque<std::coroutine_handle<>> batch;
+    batch.swap(ready);
+    for (auto handle : batch) handle.resume();
+}
+
+bool EventLoop::runOnce() {
+    if (!ready.empty()) {
+        resumeReady();
+        return true;
+    }
+    if (idle()) return false;
+
+    const int timeoutMs = pollTimeoutMs();
+    Vector<std::pair<int, int>> events;
+    const auto collect = [&events](int fd, int mask) { events.emplace_back(fd, mask); };
+    if (timeoutMs == 0) {
+        poller->wait(0, collect);
+    } else {
+        // Nothing can run until an event arrives or a timer is due, so another script may have the slot.
+        Scheduler::Blocking blocked;
+        poller->wait(timeoutMs, collect);
+    }
+    for (const auto& [fd, mask] : events) {
+        if (fd == inbox->readFd) {
+            drainInbox();
+        } else if (multi) {
+            int running = 0;
+            curl_multi_socket_action(multi, fd, mask, &running);
+        }
+    }
+    fireTimers();
+    if (multi) finishTransfers();
+    resumeReady();
+    return true;
+}
+
+void EventLoop::runUntil(const std::function<bool()>& done) {
+    while (!done() && runOnce()) {}
+}
+
+void EventLoop::runUntilDone(FutureState& future) {
+    if (future.isDone()) return;
+    future.onComplete([box = inbox] { box->post({}, false); });
+    runUntil([&future] { return future.isDone(); });
+}
+
+void EventLoop::runUntilAnyDone(const Vector<SharedPtr<FutureState>>& futures) {
+    const auto anyDone = [&futures] {
+        for (const auto& future : futures) {
+            if (future->isDone()) return true;
+        }
+        return false;
+    };
+    if (anyDone()) return;
+    for (const auto& future : futures) future->onComplete([box = inbox] { box->post({}, false); });
+    runUntil(anyDone);
+}
+
+
+namespace {
+
+// An interpreted call running on its own stack (a generator frame) so it can suspend in the
+// middle of an await while the loop runs other work. Frames are resumed by the loop thread
+// itself; none of them needs a thread.
+struct AsyncFrame {
+    SharedPtr<GeneratorState> generator;
+    FutureState* awaiting = nullptr;
+    Node result;
+};
+
+thread_local AsyncFrame* currentFrame = nullptr;
+
+// Marks the frame being resumed on this thread for the duration of one resume.
+struct FrameScope {
+    AsyncFrame* outer;
+    explicit FrameScope(AsyncFrame* frame) : outer(currentFrame) { currentFrame = frame; }
+    ~FrameScope() { currentFrame = outer; }
+};
+
+// Each time the frame suspends on a future, waits for it on the loop and resumes the frame.
+Async::Task driveFrame(EventLoop& loop, SharedPtr<AsyncFrame> frame, SharedPtr<FutureState> state) {
+    try {
+        Node unused;
+        for (;;) {
+            bool suspended = false;
+            {
+                FrameScope bind(frame.get());
+                suspended = frame->generator->resume(unused);
+            }
+            if (!suspended) break;
+            co_await loop.whenDone(*frame->awaiting);
+        }
+        state->complete(frame->result, nullptr);
+    } catch (...) {
+        state->complete(Node(), std::current_exception());
+    }
+}
+
+Async::Task completeAfter(EventLoop& loop, std::chrono::milliseconds delay, SharedPtr<FutureState> state) {
+    co_await loop.sleepFor(delay);
+    state->complete(Node(), nullptr);
+}
+
+} // namespace
+
+namespace Async {
+
+void await(FutureState& future) {
+    // Only the frame's own body may suspend it; a generator nested inside the frame waits in place.
+    if (currentFrame && GeneratorState::active() == currentFrame->generator.get()) {
+        currentFrame->awaiting = &future;
+        currentFrame->generator->yieldValue(Node());
+        currentFrame->awaiting = nullptr;
+        return;
+    }
+    EventLoop::current().runUntilDone(future);
+}
+
+SharedPtr<FutureState> start(const Node& fn, const ArgumentList& args, SharedPtr<Scope> scope) {
+    if (!scope) throw MerkError("async: scope is null");
+    SharedPtr<Function> func = Evaluator::resolveFunctionValue(fn, args, scope);
+    return start(std::move(func), args, std::move(scope));
+}
+
+SharedPtr<FutureState> start(SharedPtr<Function> func, const ArgumentList& args, SharedPtr<Scope> scope) {
+    auto frame = makeShared<AsyncFrame>();
+    AsyncFrame* raw = frame.get();
+    frame->generator = makeShared<GeneratorState>([raw, func, args, scope] {
+        raw->result = Evaluator::callFunction(func, args, scope);
+    });
+
+    auto state = FutureState::pending();
+    driveFrame(EventLoop::current(), std::move(frame), state);
+    return state;
+}
+
+SharedPtr<FutureState> sleep(std::chrono::milliseconds delay) {
+    auto state = FutureState::pending();
+    completeAfter(EventLoop::current(), delay, state);
+    return state;
+}
+
+} // namespace Async
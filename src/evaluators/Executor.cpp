@@ -4,6 +4,7 @@
 #include "utilities/debugger.h"
 #include "core/node/ArgumentNode.hpp"
 #include "core/evaluators/EvalResult.hpp"
+#include "core/evaluators/Scheduler.hpp"
 #include "ast/AstControl.hpp"
 #include "core/node/ParamNode.hpp"
 #include "core/Environments/Scope.hpp"
@@ -60,6 +61,7 @@ Node Function(const String& name, SharedPtr<Scope> callScope, SharedPtr<Scope> c
     MARK_UNUSED_MULTI(name, capturedScope);
     DEBUG_FLOW(FlowLevel::NONE);
     if (!callScope){throw MerkError("UserFunction::execute -> Starting Scope Null in: ");}
+    Fuel::burn();
     placeArgsInCallScope(args, callScope, parameters);
 
     DEBUG_FLOW_EXIT();
@@ -76,6 +78,7 @@ Node Method(const String& name, SharedPtr<Scope> callScope, SharedPtr<Scope> cap
     SharedPtr<ClassInstanceNode> instanceNode) {
     DEBUG_FLOW(FlowLevel::PERMISSIVE);
     if (!instanceNode) { throw MerkError("An Instance In UserMethod::execute was not provided"); }
+    Fuel::burn();
     DEBUG_LOG(LogLevel::TRACE, "Validated Instance Node");
     callScope->owner = generateScopeOwner("MethodExecutor", name);
     
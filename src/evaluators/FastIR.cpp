@@ -3,16 +3,20 @@
 #include "ast/Ast.hpp"
 #include "ast/AstControl.hpp"
 #include "ast/AstFunction.hpp"
+#include "ast/Exceptions.hpp"
 #include "core/Environments/Scope.hpp"
 #include "core/Environments/StackScope.hpp"
+#include "core/evaluators/Scheduler.hpp"
 #include "core/errors.h"
 
+#include <unordered_set>
+
 namespace FastIR {
 namespace {
 
 class Lowerer {
 public:
-    explicit Lowerer(Program& p) : p(p) {}
+    explicit Lowerer(Program& p, bool skipDebugCalls = true) : p(p), skipDebugCalls(skipDebugCalls) {}
 
     bool lowerBlock(const CodeBlock& block) {
         const auto& children = block.getChildren();
@@ -23,8 +27,56 @@ public:
         return true;
     }
 
+    bool lowerRangeLoop(const String& loopVar, bool ascending, const CodeBlock& body) {
+        const int var = slotFor(loopVar);
+        const int end = slotFor(kRangeEndSlot);
+        const int step = slotFor(kRangeStepSlot);
+
+        const int loopStart = static_cast<int>(p.code.size());
+        emit(OpCode::LoadVarInt, var);
+        emit(OpCode::LoadVarInt, end);
+        emit(ascending ? OpCode::CmpLtInt : OpCode::CmpGtInt);
+        const int jumpIfFalsePos = static_cast<int>(p.code.size());
+        emit(OpCode::JumpIfFalse, -1);
+
+        if (!lowerBlock(body)) return false;
+
+        emit(OpCode::LoadVarInt, var);
+        emit(OpCode::LoadVarInt, step);
+        emit(OpCode::AddInt);
+        emit(OpCode::StoreVarInt, var);
+        emit(OpCode::Jump, loopStart);
+        p.code[static_cast<size_t>(jumpIfFalsePos)].arg = static_cast<int>(p.code.size());
+        return true;
+    }
+
+    bool lowerFunction(const Vector<String>& params, const CodeBlock& body) {
+        closed = true;
+        for (const auto& param : params) {
+            slotFor(param);
+            known.insert(param);
+        }
+        returnSlot = slotFor(kReturnSlot);
+        returnedSlot = slotFor(kReturnedSlot);
+
+        if (!lowerBlock(body)) return false;
+        const int end = static_cast<int>(p.code.size());
+        for (int pos : returnJumps) {
+            p.code[static_cast<size_t>(pos)].arg = end;
+        }
+        return true;
+    }
+
 private:
     Program& p;
+    bool skipDebugCalls;
+
+    // Function mode: only parameters and locals may be read, and `return` is allowed.
+    bool closed = false;
+    std::unordered_set<String> known;
+    int returnSlot = -1;
+    int returnedSlot = -1;
+    Vector<int> returnJumps;
 
     int slotFor(const String& name) {
         for (size_t i = 0; i < p.slots.size(); ++i) {
@@ -56,11 +108,13 @@ private:
                 if (!vd.getRawExpression()) return fail("VariableDeclaration missing expression");
                 if (!lowerExpr(*vd.getRawExpression())) return false;
                 emit(OpCode::StoreVarIntDecl, slotFor(vd.getName()));
+                known.insert(vd.getName());
                 return true;
             }
             case AstType::VariableAssignment: {
                 const auto& va = static_cast<const VariableAssignment&>(st);
                 if (!va.getRawExpression()) return fail("VariableAssignment missing expression");
+                if (closed && !known.count(va.getName())) return fail("Assignment to free variable in FastIR: " + va.getName());
                 if (!lowerExpr(*va.getRawExpression())) return false;
                 emit(OpCode::StoreVarInt, slotFor(va.getName()));
                 return true;
@@ -122,12 +176,24 @@ private:
             case AstType::FunctionCall: {
                 const auto& fc = static_cast<const FunctionCall&>(st);
                 const String n = fc.getName();
-                if (n == "print" || n == "DEBUG_LOG" || n == "showScope") {
+                if (skipDebugCalls && (n == "print" || n == "DEBUG_LOG" || n == "showScope")) {
                     // Side-effect-only debug/print calls are skipped in the int fast-path.
                     return true;
                 }
                 return fail("Unsupported function call in FastIR: " + n);
             }
+            case AstType::Return: {
+                const auto& ret = static_cast<const Return&>(st);
+                if (returnSlot < 0) return fail("Return outside a lowered function");
+                if (!ret.getValue()) return fail("Return missing value");
+                if (!lowerExpr(*ret.getValue())) return false;
+                emit(OpCode::StoreVarInt, returnSlot);
+                emit(OpCode::PushConstInt, constFor(1));
+                emit(OpCode::StoreVarInt, returnedSlot);
+                returnJumps.push_back(static_cast<int>(p.code.size()));
+                emit(OpCode::Jump, -1);
+                return true;
+            }
             case AstType::NoOp:
                 return true;
             default:
@@ -151,6 +217,7 @@ private:
             }
             case AstType::VariableReference: {
                 const auto& vr = static_cast<const VariableReference&>(expr);
+                if (closed && !known.count(vr.getName())) return fail("Free variable in FastIR: " + vr.getName());
                 emit(OpCode::LoadVarInt, slotFor(vr.getName()));
                 return true;
             }
@@ -159,15 +226,11 @@ private:
                 const ASTStatement* opnd = u.getOperand();
                 if (!opnd) return fail("Unary operation missing operand");
                 if (!lowerExpr(*opnd)) return false;
-                if (u.getOperator() == "-") {
-                    emit(OpCode::NegInt);
-                    return true;
+                switch (u.getOperator()) {
+                    case UnaryOp::Negate: emit(OpCode::NegInt); return true;
+                    case UnaryOp::Not: emit(OpCode::NotBool); return true;
+                    default: return fail("Unsupported unary op in FastIR: " + unaryOpToString(u.getOperator()));
                 }
-                if (u.getOperator() == "!" || u.getOperator() == "not") {
-                    emit(OpCode::NotBool);
-                    return true;
-                }
-                return fail("Unsupported unary op in FastIR: " + u.getOperator());
             }
             case AstType::BinaryOperation: {
                 const auto& b = static_cast<const BinaryOperation&>(expr);
@@ -177,19 +240,20 @@ private:
                 if (!lowerExpr(*l)) return false;
                 if (!lowerExpr(*r)) return false;
 
-                const String& op = b.getOperator();
-                if (op == "+") { emit(OpCode::AddInt); return true; }
-                if (op == "-") { emit(OpCode::SubInt); return true; }
-                if (op == "*") { emit(OpCode::MulInt); return true; }
-                if (op == "/") { emit(OpCode::DivInt); return true; }
-                if (op == "%") { emit(OpCode::ModInt); return true; }
-                if (op == "<") { emit(OpCode::CmpLtInt); return true; }
-                if (op == "<=") { emit(OpCode::CmpLeInt); return true; }
-                if (op == ">") { emit(OpCode::CmpGtInt); return true; }
-                if (op == ">=") { emit(OpCode::CmpGeInt); return true; }
-                if (op == "==") { emit(OpCode::CmpEqInt); return true; }
-                if (op == "!=") { emit(OpCode::CmpNeInt); return true; }
-                return fail("Unsupported binary op in FastIR: " + op);
+                switch (b.getOperator()) {
+                    case BinaryOp::Add: emit(OpCode::AddInt); return true;
+                    case BinaryOp::Sub: emit(OpCode::SubInt); return true;
+                    case BinaryOp::Mul: emit(OpCode::MulInt); return true;
+                    case BinaryOp::Div: emit(OpCode::DivInt); return true;
+                    case BinaryOp::Mod: emit(OpCode::ModInt); return true;
+                    case BinaryOp::Lt: emit(OpCode::CmpLtInt); return true;
+                    case BinaryOp::Le: emit(OpCode::CmpLeInt); return true;
+                    case BinaryOp::Gt: emit(OpCode::CmpGtInt); return true;
+                    case BinaryOp::Ge: emit(OpCode::CmpGeInt); return true;
+                    case BinaryOp::Eq: emit(OpCode::CmpEqInt); return true;
+                    case BinaryOp::Ne: emit(OpCode::CmpNeInt); return true;
+                    default: return fail("Unsupported binary op in FastIR: " + binaryOpToString(b.getOperator()));
+                }
             }
             default:
                 return fail("Unsupported expr in FastIR: " + expr.getAstTypeAsString());
@@ -212,8 +276,22 @@ bool lowerCodeBlock(const CodeBlock& block, Program& outProgram) {
     return lowerer.lowerBlock(block);
 }
 
-EvalResult execute(const Program& program, SharedPtr<Scope> scope) {
-    if (!scope) throw MerkError("FastIR execute: scope is null");
+bool lowerRangeLoop(const String& loopVar, bool ascending, const CodeBlock& body, Program& outProgram) {
+    outProgram = Program{};
+    Lowerer lowerer(outProgram, false);
+    return lowerer.lowerRangeLoop(loopVar, ascending, body);
+}
+
+bool lowerFunction(const Vector<String>& params, const CodeBlock& body, Program& outProgram) {
+    outProgram = Program{};
+    Lowerer lowerer(outProgram, false);
+    return lowerer.lowerFunction(params, body);
+}
+
+namespace {
+
+// With a frame, slots are bound once up front; otherwise every access goes through the scope by name.
+EvalResult run(const Program& program, Frame* frame, Scope* scope) {
     if (!program.supported) throw MerkError("FastIR execute: program unsupported");
 
     Vector<int> stack;
@@ -225,14 +303,12 @@ EvalResult execute(const Program& program, SharedPtr<Scope> scope) {
     };
 
     Vector<BoundIntSlot> boundSlots;
-    SharedPtr<StackScope> stackScope = std::dynamic_pointer_cast<StackScope>(scope);
-    if (stackScope) {
+    if (frame) {
         boundSlots.resize(program.slots.size());
-        Frame& frame = stackScope->getFrame();
         for (size_t i = 0; i < program.slots.size(); ++i) {
             const String& name = program.slots[i];
 
-            if (auto* cell = frame.getOwnedCell(name)) {
+            if (auto* cell = frame->getOwnedCell(name)) {
                 if (cell->kind != Frame::SlotKind::Int) {
                     int v = 0;
                     if (cell->toNode().isInt()) v = cell->toNode().toInt();
@@ -244,7 +320,7 @@ EvalResult execute(const Program& program, SharedPtr<Scope> scope) {
                 continue;
             }
 
-            if (VarNode* slot = frame.getSlot(name)) {
+            if (VarNode* slot = frame->getSlot(name)) {
                 if (slot->getValueNode().isInt() || slot->getValueNode().isBool()) {
                     boundSlots[i].borrowed = slot;
                     continue;
@@ -254,11 +330,12 @@ EvalResult execute(const Program& program, SharedPtr<Scope> scope) {
 
             DataTypeFlags flags;
             flags.name = name;
-            boundSlots[i].owned = frame.ensureOwnedIntCell(name, 0, &flags);
+            boundSlots[i].owned = frame->ensureOwnedIntCell(name, 0, &flags);
         }
     }
 
     int pc = 0;
+    std::int64_t fuel = Fuel::remaining;
     while (pc >= 0 && pc < static_cast<int>(program.code.size())) {
         const Instr& ins = program.code[static_cast<size_t>(pc)];
         switch (ins.op) {
@@ -269,7 +346,7 @@ EvalResult execute(const Program& program, SharedPtr<Scope> scope) {
 
             case OpCode::LoadVarInt: {
                 const size_t idx = static_cast<size_t>(ins.arg);
-                if (stackScope) {
+                if (frame) {
                     const auto& bs = boundSlots[idx];
                     if (bs.owned) {
                         if (bs.owned->kind != Frame::SlotKind::Int) {
@@ -303,7 +380,7 @@ EvalResult execute(const Program& program, SharedPtr<Scope> scope) {
             case OpCode::StoreVarIntDecl: {
                 const size_t idx = static_cast<size_t>(ins.arg);
                 const int value = pop1(stack);
-                if (stackScope) {
+                if (frame) {
                     auto& bs = boundSlots[idx];
                     if (bs.owned) {
                         bs.owned->kind = Frame::SlotKind::Int;
@@ -334,7 +411,7 @@ EvalResult execute(const Program& program, SharedPtr<Scope> scope) {
             case OpCode::StoreVarInt: {
                 const size_t idx = static_cast<size_t>(ins.arg);
                 const int value = pop1(stack);
-                if (stackScope) {
+                if (frame) {
                     auto& bs = boundSlots[idx];
                     if (bs.owned) {
                         bs.owned->kind = Frame::SlotKind::Int;
@@ -396,6 +473,7 @@ EvalResult execute(const Program& program, SharedPtr<Scope> scope) {
             }
 
             case OpCode::Jump:
+                Fuel::burn(fuel);
                 pc = ins.arg;
                 break;
 
@@ -407,8 +485,23 @@ EvalResult execute(const Program& program, SharedPtr<Scope> scope) {
             }
         }
     }
+    Fuel::remaining = fuel;
 
     return EvalResult::Normal(Node());
 }
 
+} // namespace
+
+EvalResult execute(const Program& program, SharedPtr<Scope> scope) {
+    if (!scope) throw MerkError("FastIR execute: scope is null");
+    if (auto stackScope = std::dynamic_pointer_cast<StackScope>(scope)) {
+        return run(program, &stackScope->getFrame(), scope.get());
+    }
+    return run(program, nullptr, scope.get());
+}
+
+EvalResult execute(const Program& program, Frame& frame) {
+    return run(program, &frame, nullptr);
+}
+
 } // namespace FastIR
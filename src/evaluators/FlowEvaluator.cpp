@@ -7,6 +7,7 @@
 #include "core/node/Node.hpp"
 #include "core/node/ArgumentNode.hpp"
 #include "core/node/NodeStructures.hpp"
+#include "core/node/NodeKernels.hpp"
 
 #include "core/types.h"
 #include "core/errors.h"
@@ -14,7 +15,10 @@
 
 // New flow types
 #include "core/evaluators/EvalResult.hpp"
+#include "core/evaluators/Evaluator.hpp"
 #include "core/evaluators/FlowEvaluator.hpp"   // your new header (or core/Evaluator.h if you keep name)
+#include "core/evaluators/Parallel.hpp"
+#include "core/evaluators/Scheduler.hpp"
 
 #include "utilities/helper_functions.h"
 #include "utilities/debugging_functions.h"
@@ -35,41 +39,6 @@
 
 // namespace {
 
-// // Keep this if you still use it elsewhere
-// enum class Operator {
-//     Equals,
-//     NotEquals,
-//     LessThan,
-//     GreaterThan,
-//     LessThanOrEquals,
-//     GreaterThanOrEquals,
-//     Plus,
-//     Minus,
-//     Multiply,
-//     Divide,
-//     Modulo,
-//     Invalid
-// };
-
-// Operator stringToOperator(const String& op) {
-//     static const std::unordered_map<String, Operator> operatorMap = {
-//         {"==", Operator::Equals},
-//         {"!=", Operator::NotEquals},
-//         {"<",  Operator::LessThan},
-//         {">",  Operator::GreaterThan},
-//         {"<=", Operator::LessThanOrEquals},
-//         {">=", Operator::GreaterThanOrEquals},
-//         {"+",  Operator::Plus},
-//         {"-",  Operator::Minus},
-//         {"*",  Operator::Multiply},
-//         {"/",  Operator::Divide},
-//         {"%",  Operator::Modulo}
-//     };
-
-//     auto it = operatorMap.find(op);
-//     return (it != operatorMap.end()) ? it->second : Operator::Invalid;
-// }
-
 // bool isDebug = Debugger::getInstance().getLogLevel() == LogLevel::DEBUG;
 
 // void evaluatingFor(const String& value, const String& methodName, int scopeLevel = -2) {
@@ -93,23 +62,6 @@ namespace FlowEvaluator {
 namespace {
 constexpr bool kEnableFastIntExprAssign = true;
 
-bool tryApplyIntBinary(const String& op, int lhs, int rhs, int& out) {
-    if (op == "+") { out = lhs + rhs; return true; }
-    if (op == "-") { out = lhs - rhs; return true; }
-    if (op == "*") { out = lhs * rhs; return true; }
-    if (op == "/") {
-        if (rhs == 0) throw MerkError("Division by zero");
-        out = lhs / rhs;
-        return true;
-    }
-    if (op == "%") {
-        if (rhs == 0) throw MerkError("Modulo by zero");
-        out = lhs % rhs;
-        return true;
-    }
-    return false;
-}
-
 bool tryEvalIntExprFast(const ASTStatement* expr,
                         SharedPtr<Scope> scope,
                         SharedPtr<ClassInstanceNode> instanceNode,
@@ -131,7 +83,7 @@ bool tryEvalIntExprFast(const ASTStatement* expr,
             const auto* u = static_cast<const UnaryOperation*>(expr);
             int v = 0;
             if (!tryEvalIntExprFast(u->getOperand(), scope, instanceNode, v)) return false;
-            if (u->getOperator() == "-") {
+            if (u->getOperator() == UnaryOp::Negate) {
                 out = -v;
                 return true;
             }
@@ -143,90 +95,13 @@ bool tryEvalIntExprFast(const ASTStatement* expr,
             int rhs = 0;
             if (!tryEvalIntExprFast(b->getLeftSide(), scope, instanceNode, lhs)) return false;
             if (!tryEvalIntExprFast(b->getRightSide(), scope, instanceNode, rhs)) return false;
-            return tryApplyIntBinary(b->getOperator(), lhs, rhs, out);
+            return NodeKernels::applyInt(b->getOperator(), lhs, rhs, out);
         }
         default:
             return false;
     }
 }
 
-bool computeBinary(const String& op, int lhs, int rhs, Node& out) {
-    if (op == "+")  { out = Node(lhs + rhs); return true; }
-    if (op == "-")  { out = Node(lhs - rhs); return true; }
-    if (op == "*")  { out = Node(lhs * rhs); return true; }
-    if (op == "/")  {
-        if (rhs == 0) throw MerkError("Division by zero");
-        out = Node(lhs / rhs);
-        return true;
-    }
-    if (op == "%")  {
-        if (rhs == 0) throw MerkError("Modulo by zero");
-        out = Node(lhs % rhs);
-        return true;
-    }
-    if (op == "==") { out = Node(lhs == rhs); return true; }
-    if (op == "!=") { out = Node(lhs != rhs); return true; }
-    if (op == "<")  { out = Node(lhs < rhs); return true; }
-    if (op == "<=") { out = Node(lhs <= rhs); return true; }
-    if (op == ">")  { out = Node(lhs > rhs); return true; }
-    if (op == ">=") { out = Node(lhs >= rhs); return true; }
-    return false;
-}
-
-bool computeBinaryMixedNumeric(const String& op, double lhs, double rhs, Node& out) {
-    if (op == "+")  { out = Node(lhs + rhs); return true; }
-    if (op == "-")  { out = Node(lhs - rhs); return true; }
-    if (op == "*")  { out = Node(lhs * rhs); return true; }
-    if (op == "/")  {
-        if (rhs == 0.0) throw MerkError("Division by zero");
-        out = Node(lhs / rhs);
-        return true;
-    }
-    if (op == "==") { out = Node(lhs == rhs); return true; }
-    if (op == "!=") { out = Node(lhs != rhs); return true; }
-    if (op == "<")  { out = Node(lhs < rhs); return true; }
-    if (op == "<=") { out = Node(lhs <= rhs); return true; }
-    if (op == ">")  { out = Node(lhs > rhs); return true; }
-    if (op == ">=") { out = Node(lhs >= rhs); return true; }
-    return false;
-}
-
-bool computeBinary(const String& op, const String& lhs, const String& rhs, Node& out) {
-    if (op == "+")  { out = Node(lhs + rhs); return true; }
-    if (op == "==") { out = Node(lhs == rhs); return true; }
-    if (op == "!=") { out = Node(lhs != rhs); return true; }
-    if (op == "<")  { out = Node(lhs < rhs); return true; }
-    if (op == "<=") { out = Node(lhs <= rhs); return true; }
-    if (op == ">")  { out = Node(lhs > rhs); return true; }
-    if (op == ">=") { out = Node(lhs >= rhs); return true; }
-    return false;
-}
-
-bool computeBinary(const String& op, bool lhs, bool rhs, Node& out) {
-    if (op == "and" || op == "&&") { out = Node(lhs && rhs); return true; }
-    if (op == "or"  || op == "||") { out = Node(lhs || rhs); return true; }
-    if (op == "==")               { out = Node(lhs == rhs); return true; }
-    if (op == "!=")               { out = Node(lhs != rhs); return true; }
-    return false;
-}
-
-bool dispatchTypedBinary(const String& op, const Node& lhs, const Node& rhs, Node& out) {
-    if (lhs.isInt() && rhs.isInt()) {
-        return computeBinary(op, lhs.toInt(), rhs.toInt(), out);
-    }
-    const bool lhsNumeric = lhs.isInt() || lhs.isFloat() || lhs.isDouble();
-    const bool rhsNumeric = rhs.isInt() || rhs.isFloat() || rhs.isDouble();
-    if (lhsNumeric && rhsNumeric) {
-        return computeBinaryMixedNumeric(op, lhs.toDouble(), rhs.toDouble(), out);
-    }
-    if (lhs.isString() && rhs.isString()) {
-        return computeBinary(op, lhs.toString(), rhs.toString(), out);
-    }
-    if (lhs.isBool() && rhs.isBool()) {
-        return computeBinary(op, lhs.toBool(), rhs.toBool(), out);
-    }
-    return false;
-}
 } // namespace
 
 EvalResult evaluateLiteral(Node value) {
@@ -318,7 +193,7 @@ VarNode& evaluateVariableReference(String name,
     return variable;
 }
 
-EvalResult evaluateBinaryOperation(const String& op,
+EvalResult evaluateBinaryOperation(BinaryOp op,
                                   const Node& leftValue,
                                   const Node& rightValue,
                                   SharedPtr<Scope> scope,
@@ -332,41 +207,43 @@ EvalResult evaluateBinaryOperation(const String& op,
     // evaluatingFor(rightValue, "evaluateBinaryOperation", scope->getScopeLevel());
 
     Node typedOut;
-    if (dispatchTypedBinary(op, leftValue, rightValue, typedOut)) {
+    if (NodeKernels::apply(op, leftValue, rightValue, typedOut)) {
         return EvalResult::Normal(std::move(typedOut));
     }
 
     Node val;
 
-    if (op == "+") val = leftValue + rightValue;
-    else if (op == "-") val = leftValue - rightValue;
-    else if (op == "*") val = leftValue * rightValue;
-    else if (op == "/") val = leftValue / rightValue;
-    else if (op == "%") val = leftValue % rightValue;
-
-    else if (op == "and" || op == "&&") val = Node(leftValue.isTruthy() && rightValue.isTruthy());
-    else if (op == "or"  || op == "||") val = Node(leftValue.isTruthy() || rightValue.isTruthy());
-
-    else if (op == "+=") val = (Node(leftValue) += rightValue);
-    else if (op == "-=") val = (Node(leftValue) -= rightValue);
-    else if (op == "*=") val = (Node(leftValue) *= rightValue);
-    else if (op == "/=") val = (Node(leftValue) /= rightValue);
-    else if (op == "++") val = (Node(leftValue) += Node(1));
-
-    else if (op == "==") val = Node(leftValue == rightValue);
-    else if (op == "!=") val = Node(leftValue != rightValue);
-    else if (op == "<")  val = Node(leftValue <  rightValue);
-    else if (op == "<=") val = Node(leftValue <= rightValue);
-    else if (op == ">")  val = Node(leftValue >  rightValue);
-    else if (op == ">=") val = Node(leftValue >= rightValue);
-
-    else throw MerkError("Unsupported operator: " + op);
+    switch (op) {
+        case BinaryOp::Add: val = leftValue + rightValue; break;
+        case BinaryOp::Sub: val = leftValue - rightValue; break;
+        case BinaryOp::Mul: val = leftValue * rightValue; break;
+        case BinaryOp::Div: val = leftValue / rightValue; break;
+        case BinaryOp::Mod: val = leftValue % rightValue; break;
+
+        case BinaryOp::And: val = Node(leftValue.isTruthy() && rightValue.isTruthy()); break;
+        case BinaryOp::Or:  val = Node(leftValue.isTruthy() || rightValue.isTruthy()); break;
+
+        case BinaryOp::AddAssign: val = (Node(leftValue) += rightValue); break;
+        case BinaryOp::SubAssign: val = (Node(leftValue) -= rightValue); break;
+        case BinaryOp::MulAssign: val = (Node(leftValue) *= rightValue); break;
+        case BinaryOp::DivAssign: val = (Node(leftValue) /= rightValue); break;
+        case BinaryOp::Increment: val = (Node(leftValue) += Node(1)); break;
+
+        case BinaryOp::Eq: val = Node(leftValue == rightValue); break;
+        case BinaryOp::Ne: val = Node(leftValue != rightValue); break;
+        case BinaryOp::Lt: val = Node(leftValue <  rightValue); break;
+        case BinaryOp::Le: val = Node(leftValue <= rightValue); break;
+        case BinaryOp::Gt: val = Node(leftValue >  rightValue); break;
+        case BinaryOp::Ge: val = Node(leftValue >= rightValue); break;
+
+        default: throw MerkError("Unsupported operator: " + binaryOpToString(op));
+    }
 
     DEBUG_FLOW_EXIT();
     return EvalResult::Normal(std::move(val));
 }
 
-EvalResult evaluateUnaryOperation(const String& op,
+EvalResult evaluateUnaryOperation(UnaryOp op,
                                  const Node& operand,
                                  SharedPtr<ClassInstanceNode> instanceNode)
 {
@@ -374,26 +251,17 @@ EvalResult evaluateUnaryOperation(const String& op,
     DEBUG_FLOW(FlowLevel::PERMISSIVE);
 
     Node val;
-    if (op == "!" || op == "not") {
-        val = Node(!operand.toBool());
-        DEBUG_FLOW_EXIT();
-        return EvalResult::Normal(std::move(val));
-    }
-
-    if (op == "?") {
-        val = Node(!operand.isNull());
-        DEBUG_FLOW_EXIT();
-        return EvalResult::Normal(std::move(val));
-    }
-
-    if (op == "-") {
-        val = operand.negate();
-        DEBUG_FLOW_EXIT();
-        return EvalResult::Normal(std::move(val));
+    switch (op) {
+        case UnaryOp::Not: val = Node(!operand.toBool()); break;
+        case UnaryOp::Exists: val = Node(!operand.isNull()); break;
+        case UnaryOp::Negate: val = operand.negate(); break;
+        default:
+            DEBUG_FLOW_EXIT();
+            throw MerkError("Unsupported unary operator: " + unaryOpToString(op));
     }
 
     DEBUG_FLOW_EXIT();
-    throw MerkError("Unsupported unary operator: " + op);
+    return EvalResult::Normal(std::move(val));
 }
 
 EvalResult evaluateBasicLoop() {
@@ -456,7 +324,7 @@ EvalResult evaluateIf(const IfStatement& ifStatement,
     if (!scope) throw MerkError("evaluateIf: scope is null");
 
     // NOTE: condition is expression eval (Node). Body is flow eval.
-    if (ifStatement.getCondition()->evaluate(scope, instanceNode).isTruthy()) {
+    if (Evaluator::evaluateCondition(ifStatement.getCondition(), scope, instanceNode)) {
         EvalResult r = ifStatement.getBody()->evaluateFlow(scope, instanceNode);
         DEBUG_FLOW_EXIT();
         return r;
@@ -464,7 +332,7 @@ EvalResult evaluateIf(const IfStatement& ifStatement,
 
     for (const auto& elif : ifStatement.getElifs()) {
         // Your ElifStatement::evaluate() returns truthy Node currently.
-        if (elif->getCondition()->evaluate(scope, instanceNode).isTruthy()) {
+        if (Evaluator::evaluateCondition(elif->getCondition(), scope, instanceNode)) {
             EvalResult r = elif->getBody()->evaluateFlow(scope, instanceNode);
             DEBUG_FLOW_EXIT();
             return r;
@@ -494,7 +362,7 @@ EvalResult evaluateElif(const ElifStatement& elifStatement,
         throw MerkError("ElifStatement missing condition");
     }
 
-    Node v = Node(elifStatement.getCondition()->evaluate(scope, instanceNode).isTruthy());
+    Node v = Node(Evaluator::evaluateCondition(elifStatement.getCondition(), scope, instanceNode));
     DEBUG_FLOW_EXIT();
     return EvalResult::Normal(std::move(v));
 }
@@ -518,8 +386,8 @@ EvalResult evaluateWhileLoop(const ConditionalBlock& condition, const BaseAST* b
     if (!body)  throw MerkError("WhileLoop has no body");
 
     while (true) {
-        Node cond = condition.evaluate(scope, instanceNode);
-        if (!cond.toBool()) break;
+        Fuel::burn();
+        if (!condition.isTruthy(scope, instanceNode)) break;
 
         EvalResult r = body->evaluateFlow(scope, instanceNode);
 
@@ -543,9 +411,42 @@ EvalResult evaluateWhileLoop(const ConditionalBlock& condition, const BaseAST* b
     return EvalResult::Normal(Node());
 }
 
+static EvalResult evaluateForInLoop(const ForLoop& forLoop, SharedPtr<Scope> scope, SharedPtr<ClassInstanceNode> instanceNode) {
+    const Node iterable = forLoop.getIterableExpr()->evaluate(scope, instanceNode);
+    auto it = makeNodeIterator(iterable);
+
+    Node item;
+    if (!it->next(item)) {
+        return EvalResult::Normal(Node());
+    }
+
+    const String& loopVar = forLoop.getLoopVariable();
+    VarNode* slot = Evaluator::resolveLoopVariable(loopVar, NodeValueType::Any, Node(0), scope);
+    const CodeBlock* body = forLoop.getBody();
+    do {
+        Fuel::burn();
+        Evaluator::bindLoopVariable(slot, loopVar, item, scope);
+        EvalResult r = body->evaluateFlow(scope, instanceNode);
+
+        if (r.flow == ControlFlow::Return || r.flow == ControlFlow::Throw) {
+            return r;
+        }
+        if (r.flow == ControlFlow::Break) {
+            break;
+        }
+    } while (it->next(item));
+
+    return EvalResult::Normal(Node());
+}
+
 EvalResult evaluateForLoop(const ForLoop& forLoop, SharedPtr<Scope> scope, SharedPtr<ClassInstanceNode> instanceNode) {
     DEBUG_FLOW(FlowLevel::LOW);
     if (!scope) throw MerkError("evaluateForLoop: scope is null");
+    if (forLoop.isForIn()) {
+        auto r = evaluateForInLoop(forLoop, scope, instanceNode);
+        DEBUG_FLOW_EXIT();
+        return r;
+    }
 
     const ASTStatement* startExpr = forLoop.getStartExpr();
     const ASTStatement* endExpr = forLoop.getEndExpr();
@@ -566,22 +467,21 @@ EvalResult evaluateForLoop(const ForLoop& forLoop, SharedPtr<Scope> scope, Share
         throw MerkError("for-loop step cannot be 0");
     }
 
-    const String& loopVar = forLoop.getLoopVariable();
-    if (!scope->hasVariable(loopVar)) {
-        DataTypeFlags loopFlags;
-        loopFlags.isConst = false;
-        loopFlags.isMutable = true;
-        loopFlags.isStatic = false;
-        loopFlags.type = NodeValueType::Int;
-        scope->declareVariable(loopVar, makeUnique<VarNode>(Node(start), loopFlags));
-    } else {
-        scope->updateVariable(loopVar, Node(start));
+    if (forLoop.isParallel()) {
+        if (auto parallel = Parallel::tryEvaluateFor(forLoop, start, end, step, scope, instanceNode)) {
+            DEBUG_FLOW_EXIT();
+            return *parallel;
+        }
     }
 
+    const String& loopVar = forLoop.getLoopVariable();
+    VarNode* slot = Evaluator::resolveLoopVariable(loopVar, NodeValueType::Int, Node(start), scope);
+
     int i = start;
     const auto inRange = [&]() { return step > 0 ? (i < end) : (i > end); };
     while (inRange()) {
-        scope->updateVariable(loopVar, Node(i));
+        Fuel::burn();
+        Evaluator::bindLoopVariable(slot, loopVar, Node(i), scope);
         EvalResult r = body->evaluateFlow(scope, instanceNode);
 
         if (r.flow == ControlFlow::Return || r.flow == ControlFlow::Throw) {
@@ -663,8 +563,6 @@ EvalResult evaluateClassBody(SharedPtr<Scope> classCapturedScope,
     if (!generatedScope) throw MerkError("generatedScope is null in evaluateClassBody");
     if (accessor.empty()) throw MerkError("Accessor Was Not Set On Body");
 
-    generatedScope->owner = generateScopeOwner("Class", "Body");
-
     for (const auto& child : children) {
         if (!child) throw MerkError("Null child in class body");
 
@@ -674,17 +572,18 @@ EvalResult evaluateClassBody(SharedPtr<Scope> classCapturedScope,
                 break;
 
             case AstType::ClassMethodDef: {
-                auto* methodDef = static_cast<MethodDef*>(child.get());
                 auto methodScope = classScope->createChildScope();
                 if (!methodScope) throw MerkError("generated methodScope is null in ClassDef::evaluate");
-                methodScope->owner = generateScopeOwner("ClassMethodBody", methodDef->getName());
 
-                methodDef->setClassScope(classScope);
+                // The accessor rewrites below work on this class's own copy; the parsed tree stays untouched.
+                auto ownedDef = static_cast<MethodDef*>(child.get())->cloneInto(methodScope);
+                auto* methodDef = ownedDef.get();
+                methodScope->owner = generateScopeOwner("ClassMethodBody", methodDef->getName());
 
                 applyAccessorScopeFix(methodDef, classScope, accessor);
                 stripImplicitAccessor(methodDef, accessor);
 
-                methodDef->evaluate(classScope, instanceNode);
+                methodDef->evaluateIn(classScope, classScope, instanceNode);
                 break;
             }
 
@@ -740,6 +639,7 @@ EvalResult evaluateMethodDef(SharedPtr<Scope> passedScope,
                             SharedPtr<Scope> classScope,
                             String methodName,
                             MethodBody* body,
+                            const Captures& captures,
                             ParamList parameters,
                             CallableType callType,
                             SharedPtr<ClassInstanceNode> instanceNode)
@@ -752,21 +652,9 @@ EvalResult evaluateMethodDef(SharedPtr<Scope> passedScope,
     if (!classScope) throw MerkError("MethodDef::evaluate: classScope is null");
     if (!body) throw MerkError("MethodDef::evaluate: body is null");
 
-    auto freeVarNames = body->collectFreeVariables();
-
-    if (callType == CallableType::FUNCTION) {
-        FreeVars temp = freeVarNames;
-        for (auto& param : parameters) {
-            auto it = temp.find(param.getName());
-            if (it != temp.end()) temp.erase(it);
-        }
-        if (!temp.empty()) {
-            throw MerkError("Vars defined outside function: " +
-                            highlight(joinUnorderedSetStrings(temp, ", "), Colors::yellow));
-        }
-    }
+    if (callType == CallableType::FUNCTION) captures.requireBound();
 
-    SharedPtr<Scope> defScope = passedScope->buildFunctionDefScope(freeVarNames, methodName);
+    SharedPtr<Scope> defScope = passedScope->buildFunctionDefScope(captures.names, methodName);
     if (!defScope) { throw MerkError("Def scope is null for MethodDef: " + methodName); }
 
     defScope->owner = generateScopeOwner("MethodDef", methodName);
@@ -0,0 +1,214 @@
+#include "core/evaluators/Future.hpp"
+
+#include <algorithm>
+
+#include "core/errors.h"
+#include "core/node/ArgumentNode.hpp"
+#include "core/Environments/Frame.hpp"
+#include "core/Environments/Isolate.hpp"
+#include "core/evaluators/Evaluator.hpp"
+#include "core/evaluators/EventLoop.hpp"
+#include "core/evaluators/Parallel.hpp"
+#include "core/evaluators/Scheduler.hpp"
+#include "core/callables/classes/ClassBase.hpp"
+#include "core/callables/functions/Function.hpp"
+#include "core/callables/functions/NativeFunction.hpp"
+#include "utilities/thread_pool.h"
+
+namespace {
+
+// Signalled whenever any future completes, for waitAny.
+std::mutex completionMutex;
+std::condition_variable completion;
+
+bool allInts(const ArgumentList& args) {
+    for (std::size_t i = 0; i < args.size(); ++i) {
+        if (!args[i].isInt()) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+
+SharedPtr<FutureState> FutureState::pending() {
+    return SharedPtr<FutureState>(new FutureState());
+}
+
+SharedPtr<FutureState> FutureState::spawn(const Node& fn, const ArgumentList& args, SharedPtr<Scope> scope) {
+    if (!scope) throw MerkError("spawn: scope is null");
+
+    if (allInts(args)) {
+        if (auto compiled = Parallel::IntKernel::compile(fn, args.size(), scope)) {
+            SharedPtr<Parallel::IntKernel> kernel = std::move(compiled);
+            Vector<int> ints;
+            for (std::size_t i = 0; i < args.size(); ++i) ints.push_back(args[i].toInt());
+
+            auto state = pending();
+            Parallel::pool().submit([state, kernel, ints](std::size_t) {
+                try {
+                    Frame frame;
+                    int value = 0;
+                    const bool returned = kernel->call(frame, ints.data(), value);
+                    if (!returned && kernel->requiresReturn()) throw MerkError("Function did not return a value.");
+                    state->complete(returned ? Node(value) : Node(), nullptr);
+                } catch (...) {
+                    state->complete(Node(), std::current_exception());
+                }
+            });
+            return state;
+        }
+    }
+
+    SharedPtr<Function> func = Evaluator::resolveFunctionValue(fn, args, scope);
+
+    bool offThread = std::dynamic_pointer_cast<NativeFunction>(func) != nullptr;
+    for (std::size_t i = 0; offThread && i < args.size(); ++i) offThread = Isolate::isTransferable(args[i]);
+
+    if (offThread) {
+        ArgumentList copies;
+        for (std::size_t i = 0; i < args.size(); ++i) copies.addPositionalArg(Isolate::transfer(args[i]));
+        copies.freeze(); // the list is itself a node shared with the worker's copy
+
+        auto state = pending();
+        Parallel::pool().submit([state, func, copies](std::size_t) {
+            try {
+                state->complete(func->execute(copies, nullptr), nullptr);
+            } catch (...) {
+                state->complete(Node(), std::current_exception());
+            }
+        });
+        return state;
+    }
+
+    // An interpreted call stays in this isolate but runs as an async frame: it starts now and
+    // suspends at each await, so spawned calls waiting on I/O or timers overlap.
+    return Async::start(std::move(func), args, std::move(scope));
+}
+
+bool FutureState::isDone() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return done;
+}
+
+void FutureState::complete(Node value, std::exception_ptr failure) {
+    value.freeze(); // read by whichever thread waits
+    Vector<std::function<void()>> callbacks;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        result = std::move(value);
+        error = failure;
+        done = true;
+        callbacks.swap(continuations);
+    }
+    ready.notify_all();
+    { std::lock_guard<std::mutex> lock(completionMutex); }
+    completion.notify_all();
+    for (auto& fn : callbacks) fn();
+}
+
+void FutureState::onComplete(std::function<void()> fn) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!done) {
+            continuations.push_back(std::move(fn));
+            return;
+        }
+    }
+    fn();
+}
+
+Node FutureState::wait() {
+    if (!isDone()) Async::await(*this);
+    if (!isDone()) {
+        Scheduler::Blocking blocked;
+        std::unique_lock<std::mutex> lock(mutex);
+        ready.wait(lock, [this] { return done; });
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    if (error) std::rethrow_exception(error);
+    return result;
+}
+
+std::size_t FutureState::waitAny(const Vector<SharedPtr<FutureState>>& futures) {
+    if (futures.empty()) throw MerkError("waitAny needs at least one Future");
+
+    const auto firstDone = [&]() -> std::size_t {
+        for (std::size_t i = 0; i < futures.size(); ++i) {
+            if (futures[i]->isDone()) return i;
+        }
+        return futures.size();
+    };
+
+    std::size_t index = firstDone();
+    if (index < futures.size()) return index;
+
+    // Loop-driven futures only finish while the loop runs.
+    EventLoop::current().runUntilAnyDone(futures);
+    index = firstDone();
+    if (index < futures.size()) return index;
+
+    Scheduler::Blocking blocked;
+    std::unique_lock<std::mutex> lock(completionMutex);
+    completion.wait(lock, [&] { index = firstDone(); return index < futures.size(); });
+    return index;
+}
+
+
+FutureNode::FutureNode(SharedPtr<FutureState> state) : state(std::move(state)) {
+    setType(NodeValueType::Any);
+}
+
+String FutureNode::toString() const {
+    return state->isDone() ? "<Future done>" : "<Future pending>";
+}
+
+bool FutureNode::holdsValue() { return true; }
+
+std::size_t FutureNode::hash() const {
+    return std::hash<const FutureState*>()(state.get());
+}
+
+VariantType FutureNode::getValue() const {
+    return std::static_pointer_cast<NativeNode>(std::const_pointer_cast<NodeBase>(shared_from_this()));
+}
+
+void FutureNode::setValue(const VariantType&) {
+    throw MerkError("Future objects are immutable");
+}
+
+// Copies share the pending result.
+SharedPtr<NodeBase> FutureNode::clone() const {
+    return makeShared<FutureNode>(*this);
+}
+
+void FutureNode::clear() {}
+
+SharedPtr<NativeNode> FutureNode::toNative() const {
+    return makeShared<FutureNode>(*this);
+}
+
+
+namespace {
+
+SharedPtr<FutureNode> futureNodeOf(const Node& value) {
+    if (!value.isInstance()) return nullptr;
+    return std::dynamic_pointer_cast<FutureNode>(value.toInstance()->getNativeData());
+}
+
+} // namespace
+
+bool isFuture(const Node& value) {
+    return futureNodeOf(value) != nullptr;
+}
+
+SharedPtr<FutureState> futureOf(const Node& value) {
+    if (auto future = futureNodeOf(value)) return future->getState();
+    throw MerkError("Expected a Future, got " + value.getTypeAsString());
+}
+
+Node futureValue(SharedPtr<FutureState> state, SharedPtr<Scope> scope) {
+    ArgumentList args;
+    args.addPositionalArg(Node(std::static_pointer_cast<NodeBase>(makeShared<FutureNode>(std::move(state)))));
+    return Evaluator::evaluateClassCall(scope, "Future", args);
+}
@@ -0,0 +1,225 @@
+#include <cxxabi.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "core/evaluators/Generator.hpp"
+#include "core/errors.h"
+#include "core/Environments/Isolate.hpp"
+
+#if defined(__SANITIZE_ADDRESS__)
+#define MERK_ASAN_FIBERS 1
+#include <sanitizer/common_interface_defs.h>
+#endif
+#if defined(__SANITIZE_THREAD__)
+#define MERK_TSAN_FIBERS 1
+#include <sanitizer/tsan_interface.h>
+#endif
+
+namespace {
+
+thread_local GeneratorState* activeGenerator = nullptr;
+thread_local GeneratorState* startingGenerator = nullptr;
+
+// Raised inside a suspended frame when its generator is dropped before
+// finishing. Deliberately not a std::exception so interpreter catch sites
+// never swallow it on the way out.
+struct GeneratorExit {};
+
+class GeneratorIterator : public NodeIterator {
+    SharedPtr<GeneratorState> state;
+public:
+    explicit GeneratorIterator(SharedPtr<GeneratorState> source) : state(std::move(source)) {}
+
+    bool next(Node& out) override { return state->resume(out); }
+};
+
+// Hands the thread's caught/uncaught exception lists over to the stack being switched to.
+void swapExceptions(GeneratorState::ExceptionState& saved) {
+    auto* globals = reinterpret_cast<GeneratorState::ExceptionState*>(abi::__cxa_get_globals());
+    std::swap(*globals, saved);
+}
+
+} // namespace
+
+
+GeneratorState::GeneratorState(Body body) : body(std::move(body)), isolate(&Isolate::current()) {}
+
+GeneratorState::~GeneratorState() {
+    if (started && !finished) {
+        // Unwind the suspended frame so everything it holds is released.
+        cancelled = true;
+        Isolate::Enter bind(*isolate);
+        outer = activeGenerator;
+        activeGenerator = this;
+        running = true;
+        enter();
+        activeGenerator = outer;
+    }
+    releaseStack();
+}
+
+GeneratorState* GeneratorState::active() {
+    return activeGenerator;
+}
+
+bool GeneratorState::resume(Node& out) {
+    if (finished) return false;
+    if (running) {
+        throw MerkError("Generator is already running");
+    }
+
+    // Whatever the frame drops, the state outlives this call.
+    const SharedPtr<GeneratorState> keep = shared_from_this();
+    Isolate::Enter bind(*isolate);
+    if (!started) start();
+
+    outer = activeGenerator;
+    activeGenerator = this;
+    running = true;
+    enter();
+    activeGenerator = outer;
+    running = false;
+
+    if (finished) releaseStack();
+    if (error) {
+        auto pending = error;
+        error = nullptr;
+        std::rethrow_exception(pending);
+    }
+    if (finished) return false;
+
+    out = std::move(slot);
+    slot = Node();
+    return true;
+}
+
+void GeneratorState::yieldValue(Node value) {
+    slot = std::move(value);
+    leave();
+    if (cancelled) throw GeneratorExit{};
+}
+
+void GeneratorState::start() {
+    const long page = sysconf(_SC_PAGESIZE);
+    stack = mmap(nullptr, kStackSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_STACK, -1, 0);
+    if (stack == MAP_FAILED) {
+        stack = nullptr;
+        throw MerkError("Generator: cannot map a frame stack");
+    }
+    mprotect(stack, static_cast<std::size_t>(page), PROT_NONE);  // guard page below the frame
+
+    getcontext(&frameContext);
+    frameContext.uc_stack.ss_sp = stack;
+    frameContext.uc_stack.ss_size = kStackSize;
+    frameContext.uc_link = nullptr;
+    makecontext(&frameContext, &GeneratorState::entry, 0);
+#if MERK_TSAN_FIBERS
+    fiber = __tsan_create_fiber(0);
+#endif
+    started = true;
+}
+
+void GeneratorState::releaseStack() {
+    if (!stack) return;
+#if MERK_TSAN_FIBERS
+    __tsan_destroy_fiber(fiber);
+    fiber = nullptr;
+#endif
+    munmap(stack, kStackSize);
+    stack = nullptr;
+}
+
+void GeneratorState::enter() {
+    startingGenerator = this;
+#if MERK_ASAN_FIBERS
+    __sanitizer_start_switch_fiber(&fakeStack, stack, kStackSize);
+#endif
+#if MERK_TSAN_FIBERS
+    callerFiber = __tsan_get_current_fiber();
+    __tsan_switch_to_fiber(fiber, 0);
+#endif
+    swapExceptions(exceptions);
+    swapcontext(&callerContext, &frameContext);
+#if MERK_ASAN_FIBERS
+    __sanitizer_finish_switch_fiber(fakeStack, nullptr, nullptr);
+#endif
+}
+
+void GeneratorState::leave() {
+    swapExceptions(exceptions);
+#if MERK_ASAN_FIBERS
+    // A finished frame never comes back, so its fake stack can go.
+    __sanitizer_start_switch_fiber(finished ? nullptr : &fakeStack, callerStack, callerStackSize);
+#endif
+#if MERK_TSAN_FIBERS
+    __tsan_switch_to_fiber(callerFiber, 0);
+#endif
+    swapcontext(&frameContext, &callerContext);
+    arrived();
+}
+
+// Runs on the frame's stack each time control reaches it.
+void GeneratorState::arrived() {
+#if MERK_ASAN_FIBERS
+    __sanitizer_finish_switch_fiber(fakeStack, &callerStack, &callerStackSize);
+#endif
+}
+
+void GeneratorState::entry() {
+    GeneratorState* self = startingGenerator;
+    self->arrived();
+
+    if (!self->cancelled) {
+        try {
+            self->body();
+        } catch (const GeneratorExit&) {
+        } catch (...) {
+            self->error = std::current_exception();
+        }
+    }
+
+    // Release the frame before handing control back for the last time.
+    self->body = nullptr;
+    self->finished = true;
+    self->leave();
+}
+
+
+GeneratorNode::GeneratorNode(String name, GeneratorState::Body body)
+    : name(std::move(name)), state(makeShared<GeneratorState>(std::move(body))) {
+    setType(NodeValueType::Generator);
+    flags.type = NodeValueType::Generator;
+}
+
+String GeneratorNode::toString() const {
+    return "<generator " + name + ">";
+}
+
+bool GeneratorNode::holdsValue() { return !state->isFinished(); }
+
+std::size_t GeneratorNode::hash() const {
+    return std::hash<const GeneratorState*>()(state.get());
+}
+
+VariantType GeneratorNode::getValue() const {
+    return std::static_pointer_cast<NativeNode>(std::const_pointer_cast<NodeBase>(shared_from_this()));
+}
+
+void GeneratorNode::setValue(const VariantType&) {
+    throw MerkError("generator objects are immutable");
+}
+
+// Copies share the suspended frame: a generator can only be consumed once.
+SharedPtr<NodeBase> GeneratorNode::clone() const {
+    return makeShared<GeneratorNode>(*this);
+}
+
+void GeneratorNode::clear() {}
+
+UniquePtr<NodeIterator> GeneratorNode::makeIterator() const {
+    return makeUnique<GeneratorIterator>(state);
+}
+
+SharedPtr<NativeNode> GeneratorNode::toNative() const {
+    return makeShared<GeneratorNode>(*this);
+}
@@ -0,0 +1,266 @@
+#include "core/evaluators/Parallel.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <latch>
+#include <mutex>
+#include <thread>
+
+#include "ast/AstControl.hpp"
+#include "ast/AstFunction.hpp"
+#include "core/node/ArgumentNode.hpp"
+#include "core/Environments/Scope.hpp"
+#include "core/Environments/Frame.hpp"
+#include "core/evaluators/Evaluator.hpp"
+#include "core/callables/functions/Function.hpp"
+#include "core/errors.h"
+#include "utilities/thread_pool.h"
+
+namespace Parallel {
+namespace {
+
+// Enough chunks per worker for stealing to even out uneven iterations.
+constexpr long long kChunksPerWorker = 8;
+
+std::mutex poolMutex;
+UniquePtr<WorkStealingPool> sharedPool;
+std::size_t requestedWorkers = 0;
+
+struct CapturedInt {
+    String name;
+    int value;
+};
+
+bool isBuiltinReduction(const String& op) {
+    return op == "sum" || op == "min" || op == "max";
+}
+
+int combineBuiltin(const String& op, int acc, int partial) {
+    if (op == "sum") return acc + partial;
+    if (op == "min") return std::min(acc, partial);
+    return std::max(acc, partial);
+}
+
+void setIntCell(Frame& frame, const String& name, int value) {
+    Frame::FrameCell* cell = frame.ensureOwnedIntCell(name, value);
+    cell->kind = Frame::SlotKind::Int;
+    cell->intValue = value;
+}
+
+bool readInt(const Node& value, int& out) {
+    if (value.isInt()) { out = value.toInt(); return true; }
+    if (value.isBool()) { out = value.toBool() ? 1 : 0; return true; }
+    return false;
+}
+
+} // namespace
+
+
+WorkStealingPool& pool() {
+    std::lock_guard<std::mutex> lock(poolMutex);
+    if (!sharedPool) {
+        const std::size_t workers = requestedWorkers > 0
+            ? requestedWorkers
+            : std::max(1u, std::thread::hardware_concurrency());
+        sharedPool = makeUnique<WorkStealingPool>(workers);
+    }
+    return *sharedPool;
+}
+
+void setWorkerCount(std::size_t workers) {
+    std::lock_guard<std::mutex> lock(poolMutex);
+    requestedWorkers = workers;
+    sharedPool.reset();
+}
+
+std::size_t workerCount() {
+    return pool().size();
+}
+
+std::size_t chunkCount(std::size_t count) {
+    return std::min<std::size_t>(count, workerCount() * kChunksPerWorker);
+}
+
+void forChunks(std::size_t count, std::size_t chunks, const ChunkBody& body) {
+    if (count == 0 || chunks == 0) return;
+    WorkStealingPool& workers = pool();
+    Vector<std::exception_ptr> errors(chunks);
+    std::latch done(static_cast<std::ptrdiff_t>(chunks));
+
+    for (std::size_t k = 0; k < chunks; ++k) {
+        const std::size_t begin = k * count / chunks;
+        const std::size_t end = (k + 1) * count / chunks;
+        workers.submit([&, k, begin, end](std::size_t worker) {
+            try {
+                body(k, begin, end, worker);
+            } catch (...) {
+                errors[k] = std::current_exception();
+            }
+            done.count_down();
+        });
+    }
+    // A chunk body can itself run a parallel loop; a worker waiting on its chunks runs
+    // queued tasks instead of blocking, so nested loops cannot starve the pool.
+    if (!workers.isWorkerThread()) {
+        done.wait();
+    } else {
+        while (!done.try_wait()) {
+            if (!workers.runPending()) std::this_thread::yield();
+        }
+    }
+
+    for (const auto& error : errors) {
+        if (error) std::rethrow_exception(error);
+    }
+}
+
+std::optional<EvalResult> tryEvaluateFor(const ForLoop& forLoop, int start, int end, int step, SharedPtr<Scope> scope, SharedPtr<ClassInstanceNode> instanceNode) {
+    if (!scope) throw MerkError("parallel for: scope is null");
+    const CodeBlock* body = forLoop.getBody();
+    if (!body) throw MerkError("parallel for: loop AST is incomplete");
+
+    for (const BaseAST* node : body->getAllAst(true)) {
+        const AstType type = node->getAstType();
+        if (type == AstType::Break || type == AstType::Return || type == AstType::Yield) {
+            throw MerkError("'" + astTypeToString(type) + "' is not allowed inside a parallel for");
+        }
+    }
+
+    const String& loopVar = forLoop.getLoopVariable();
+    const auto& reductions = forLoop.getReductions();
+    for (const auto& reduction : reductions) {
+        if (reduction.variable == loopVar) {
+            throw MerkError("parallel for: the loop variable cannot be a reduction variable");
+        }
+        if (!scope->hasVariable(reduction.variable)) {
+            throw MerkError("parallel for: reduction variable '" + reduction.variable + "' is not declared");
+        }
+    }
+
+    FastIR::Program program;
+    if (!FastIR::lowerRangeLoop(loopVar, step > 0, *body, program)) {
+        return std::nullopt;
+    }
+
+    Vector<int> initials;
+    for (const auto& reduction : reductions) {
+        int value = 0;
+        if (!readInt(scope->getVariable(reduction.variable).getValueNode(), value)) {
+            return std::nullopt;
+        }
+        initials.push_back(value);
+    }
+
+    // Outer variables the body reads are copied into every chunk's frame; writes to them stay private.
+    Vector<CapturedInt> captured;
+    for (const String& name : program.slots) {
+        if (name == loopVar || name == FastIR::kRangeEndSlot || name == FastIR::kRangeStepSlot) continue;
+        const bool isReduction = std::any_of(reductions.begin(), reductions.end(),
+            [&](const LoopReduction& r) { return r.variable == name; });
+        if (isReduction || !scope->hasVariable(name)) continue;
+
+        int value = 0;
+        if (!readInt(scope->getVariable(name).getValueNode(), value)) {
+            return std::nullopt;
+        }
+        captured.push_back({name, value});
+    }
+
+    const long long span = step > 0
+        ? static_cast<long long>(end) - start
+        : static_cast<long long>(start) - end;
+    const long long stride = step > 0 ? step : -static_cast<long long>(step);
+    const long long iterations = span > 0 ? (span + stride - 1) / stride : 0;
+    if (iterations == 0) {
+        return EvalResult::Normal(Node());
+    }
+
+    const std::size_t chunks = chunkCount(static_cast<std::size_t>(iterations));
+    Vector<UniquePtr<Frame>> frames(workerCount());
+    Vector<Vector<int>> partials(chunks, Vector<int>(reductions.size()));
+
+    forChunks(static_cast<std::size_t>(iterations), chunks, [&](std::size_t k, std::size_t first, std::size_t last, std::size_t worker) {
+        if (!frames[worker]) {
+            frames[worker] = makeUnique<Frame>();
+        }
+        Frame& frame = *frames[worker];
+        for (const auto& c : captured) {
+            setIntCell(frame, c.name, c.value);
+        }
+        for (std::size_t r = 0; r < reductions.size(); ++r) {
+            setIntCell(frame, reductions[r].variable, reductions[r].identity);
+        }
+        setIntCell(frame, loopVar, static_cast<int>(start + static_cast<long long>(first) * step));
+        setIntCell(frame, FastIR::kRangeEndSlot, static_cast<int>(start + static_cast<long long>(last) * step));
+        setIntCell(frame, FastIR::kRangeStepSlot, step);
+
+        FastIR::execute(program, frame);
+
+        for (std::size_t r = 0; r < reductions.size(); ++r) {
+            partials[k][r] = frame.getOwnedCell(reductions[r].variable)->intValue;
+        }
+    });
+
+    // Every chunk started from the identity, so the variable's own value is folded in exactly once.
+    for (std::size_t r = 0; r < reductions.size(); ++r) {
+        const LoopReduction& reduction = reductions[r];
+        if (isBuiltinReduction(reduction.op)) {
+            int acc = initials[r];
+            for (const auto& partial : partials) {
+                acc = combineBuiltin(reduction.op, acc, partial[r]);
+            }
+            scope->updateVariable(reduction.variable, Node(acc));
+            continue;
+        }
+
+        Node acc(initials[r]);
+        for (const auto& partial : partials) {
+            ArgumentList args;
+            args.addPositionalArg(acc);
+            args.addPositionalArg(Node(partial[r]));
+            acc = Evaluator::invokeFunction(reduction.op, args, scope, instanceNode);
+        }
+        scope->updateVariable(reduction.variable, acc);
+    }
+
+    return EvalResult::Normal(Node());
+}
+
+
+UniquePtr<IntKernel> IntKernel::compile(const Node& callee, std::size_t arity, SharedPtr<Scope> scope) {
+    if (!callee.isFunctionNode()) return nullptr;
+
+    ArgumentList sample;
+    for (std::size_t i = 0; i < arity; ++i) {
+        sample.addPositionalArg(Node(0));
+    }
+    SharedPtr<Function> func = Evaluator::resolveFunctionValue(callee, sample, scope);
+    auto user = std::dynamic_pointer_cast<UserFunction>(func);
+    if (!user || user->isGenerator() || user->parameters.size() != arity) return nullptr;
+
+    auto kernel = UniquePtr<IntKernel>(new IntKernel());
+    for (const auto& param : user->parameters) {
+        if (param.isVarArgsParameter() || param.hasDefault()) return nullptr;
+        kernel->params.push_back(param.getName());
+    }
+    if (!user->getThisBody() || !FastIR::lowerFunction(kernel->params, *user->getThisBody(), kernel->program)) {
+        return nullptr;
+    }
+    kernel->mustReturn = user->getRequiresReturn();
+    return kernel;
+}
+
+bool IntKernel::call(Frame& frame, const int* args, int& out) const {
+    for (std::size_t i = 0; i < params.size(); ++i) {
+        setIntCell(frame, params[i], args[i]);
+    }
+    setIntCell(frame, FastIR::kReturnedSlot, 0);
+
+    FastIR::execute(program, frame);
+
+    if (!frame.getOwnedCell(FastIR::kReturnedSlot)->intValue) return false;
+    out = frame.getOwnedCell(FastIR::kReturnSlot)->intValue;
+    return true;
+}
+
+} // namespace Parallel
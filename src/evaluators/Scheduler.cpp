@@ -0,0 +1,145 @@
+#include "core/evaluators/Scheduler.hpp"
+
+namespace {
+
+struct Slice {
+    Scheduler* scheduler = nullptr;
+    void* script = nullptr;
+};
+
+thread_local Slice currentSlice;
+
+} // namespace
+
+namespace Fuel {
+
+constinit thread_local std::int64_t remaining = kUnlimited;
+
+} // namespace Fuel
+
+
+Scheduler::Scheduler(std::size_t slots, std::int64_t quantum)
+    : quantum(quantum > 0 ? quantum : Fuel::kUnlimited), freeSlots(slots > 0 ? slots : 1) {}
+
+Scheduler::~Scheduler() {
+    wait();
+}
+
+void Scheduler::submit(Job job) {
+    std::lock_guard<std::mutex> lock(mutex);
+    scripts.push_back(makeUnique<Script>());
+    scripts.back()->job = std::move(job);
+    queue.push_back(scripts.back().get());
+    ++unfinished;
+    dispatchLocked();
+}
+
+void Scheduler::wait() {
+    Vector<std::thread> threads;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        allDone.wait(lock, [this] { return unfinished == 0; });
+        threads.swap(exited);
+        scripts.clear();
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+// Hands free slots to the front of the queue; a script's thread starts on its first turn.
+void Scheduler::dispatchLocked() {
+    while (freeSlots > 0 && !queue.empty()) {
+        Script* next = queue.front();
+        queue.pop_front();
+        --freeSlots;
+        next->running = true;
+        if (!next->started) {
+            next->started = true;
+            next->thread = std::thread([this, next] { run(next); });
+        } else {
+            next->turn.notify_one();
+        }
+    }
+}
+
+void Scheduler::run(Script* script) {
+    currentSlice = {this, script};
+    Fuel::remaining = quantum;
+    try {
+        script->job();
+    } catch (...) {
+        // Jobs report their own failures; nothing may escape the script's thread.
+    }
+    currentSlice = {};
+    Fuel::remaining = Fuel::kUnlimited;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    // Threads that finished earlier have already released the mutex, so joining them here is
+    // short; it keeps a long batch at one exited-but-unjoined thread instead of one per script.
+    for (auto& thread : exited) thread.join();
+    exited.clear();
+    exited.push_back(std::move(script->thread));
+    script->running = false;
+    script->job = nullptr;
+    ++freeSlots;
+    --unfinished;
+    dispatchLocked();
+    if (unfinished == 0) allDone.notify_all();
+}
+
+void Scheduler::yield(Script* script) {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (!queue.empty()) {
+        preempted.fetch_add(1, std::memory_order_relaxed);
+        script->running = false;
+        queue.push_back(script);
+        ++freeSlots;
+        dispatchLocked();
+        script->turn.wait(lock, [script] { return script->running; });
+    }
+}
+
+void Scheduler::release(Script* script) {
+    std::lock_guard<std::mutex> lock(mutex);
+    script->running = false;
+    ++freeSlots;
+    dispatchLocked();
+}
+
+void Scheduler::reacquire(Script* script) {
+    std::unique_lock<std::mutex> lock(mutex);
+    queue.push_back(script);
+    dispatchLocked();
+    script->turn.wait(lock, [script] { return script->running; });
+}
+
+// The slice is cleared while blocked so a nested wait doesn't release the slot twice.
+Scheduler::Blocking::Blocking() {
+    const Slice slice = currentSlice;
+    if (!slice.scheduler) return;
+    scheduler = slice.scheduler;
+    script = slice.script;
+    currentSlice = {};
+    scheduler->release(static_cast<Script*>(script));
+}
+
+Scheduler::Blocking::~Blocking() {
+    if (!scheduler) return;
+    scheduler->reacquire(static_cast<Script*>(script));
+    currentSlice = {scheduler, script};
+}
+
+namespace Fuel {
+
+void exhausted() {
+    const Slice slice = currentSlice;
+    if (!slice.scheduler) {
+        remaining = kUnlimited;
+        return;
+    }
+    slice.scheduler->yield(static_cast<Scheduler::Script*>(slice.script));
+    remaining = slice.scheduler->quantum;
+}
+
+} // namespace Fuel
@@ -1,4 +1,5 @@
 #include "core/evaluators/TypeEvaluator.hpp"
+#include <charconv>
 #include "core/callables/Callable.hpp"
 #include "utilities/debugger.h"   
 
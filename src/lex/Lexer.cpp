@@ -23,16 +23,14 @@ static bool isOpLike(const RawToken& t) {
     return t.kind == RawKind::Operator || t.kind == RawKind::Punctuation;
 }
 
-bool Lexer::tryEmitCompoundOp(const Vector<RawToken>& raw, size_t& i, Vector<Token>& out) {
-    if (i + 1 >= raw.size()) return false;
-    const RawToken& a = raw[i];
-    const RawToken& b = raw[i + 1];
+bool Lexer::tryEmitCompoundOp(Scanner& scanner, Vector<Token>& out) {
+    const RawToken a = scanner.peek(0);
+    const RawToken& b = scanner.peek(1);
 
     if (!isOpLike(a) || !isOpLike(b)) return false;
-    if (a.lexeme.empty() || b.lexeme.empty()) return false;
 
-    const char ca = a.lexeme[0];
-    const char cb = b.lexeme[0];
+    const char ca = scanner.text(a)[0];
+    const char cb = scanner.text(b)[0];
     if (!isCompoundPair(ca, cb)) return false;
 
     String two;
@@ -40,44 +38,26 @@ bool Lexer::tryEmitCompoundOp(const Vector<RawToken>& raw, size_t& i, Vector<Tok
     two += cb;
 
     // special case: ":=" becomes VarAssignment
-    if (two == ":=") {
-        out.emplace_back(TokenType::VarAssignment, two, a.line, a.column);
-        i += 2;
-        return true;
-    }
-
-    // else: treat as Operator (your old tokenizer did)
-    out.emplace_back(TokenType::Operator, two, a.line, a.column);
-    i += 2;
+    const TokenType type = two == ":=" ? TokenType::VarAssignment : TokenType::Operator;
+    out.emplace_back(type, std::move(two), a.line, a.column);
+    scanner.advance();
+    scanner.advance();
     return true;
 }
 
-
-static bool isTriviaRaw(const RawToken& t) {
-    return t.kind == RawKind::Space || t.kind == RawKind::Tab;
-}
-
-bool Lexer::nextNonTriviaIsLParen(const Vector<RawToken>& raw, size_t i) const {
-    for (size_t j = i + 1; j < raw.size(); ++j) {
-        if (isTriviaRaw(raw[j])) continue;
-        return raw[j].kind == RawKind::Punctuation && raw[j].lexeme == "(";
-    }
-    return false;
+static bool nextIsLParen(Scanner& scanner) {
+    const RawToken& next = scanner.peek(1);
+    return next.kind == RawKind::Punctuation && scanner.textIs(next, '(');
 }
 
-static bool nextNonTriviaIsDotOrColonColon(const Vector<RawToken>& raw, size_t i) {
-    // '.' is punctuation, '::' would be merged into Operator token by tryEmitCompoundOp,
-    // but the ChainEntryPoint check happens BEFORE emitting identifier token, so we must look raw-side too.
-    for (size_t j = i + 1; j < raw.size(); ++j) {
-        if (isTriviaRaw(raw[j])) continue;
-        if (raw[j].kind == RawKind::Punctuation && raw[j].lexeme == ".") return true;
-        // raw ':' ':' (before merge) case:
-        if (raw[j].kind == RawKind::Punctuation && raw[j].lexeme == ":" &&
-            (j + 1 < raw.size()) && raw[j + 1].kind == RawKind::Punctuation && raw[j + 1].lexeme == ":")
-            return true;
-        return false;
-    }
-    return false;
+static bool nextIsDotOrColonColon(Scanner& scanner) {
+    // '.' is punctuation; '::' is still two ':' here, the pair is merged when it is emitted.
+    const RawToken next = scanner.peek(1);
+    if (next.kind != RawKind::Punctuation) return false;
+    if (scanner.textIs(next, '.')) return true;
+    if (!scanner.textIs(next, ':')) return false;
+    const RawToken& after = scanner.peek(2);
+    return after.kind == RawKind::Punctuation && scanner.textIs(after, ':');
 }
 
 bool Lexer::prevTokenWasDot(const Vector<Token>& out) const {
@@ -86,13 +66,32 @@ bool Lexer::prevTokenWasDot(const Vector<Token>& out) const {
 }
 
 
-TokenType Lexer::classifyIdentifier(const String& value, const Vector<Token>& out, const Vector<RawToken>& raw, size_t rawIndex) {
+void Lexer::internConfig() {
+    names.clear();
+    defined = 0;
+    const auto add = [this](const std::unordered_set<String>& words, std::uint8_t flag) {
+        for (const String& word : words) {
+            if (!Keywords::find(word)) names[word] |= flag;
+        }
+    };
+    add(cfg.keywords, Keywords::Keyword);
+    add(cfg.primitiveCtors, Keywords::Primitive);
+    add(cfg.knownTypes, Keywords::KnownType);
+    add(cfg.nativeClasses, Keywords::Class);
+    add(cfg.nativeFuncs, Keywords::Function);
+}
+
+void Lexer::define(std::string_view name, std::uint8_t flag) {
+    names[name] |= flag;
+    ++defined;
+}
+
+TokenType Lexer::classifyIdentifier(std::string_view value, const Vector<Token>& out, Scanner& scanner) {
     TokenType type = TokenType::Variable;
 
     auto lastType = [&]() -> TokenType { return out.empty() ? TokenType::Unknown : out.back().type; };
-    auto lastVal  = [&]() -> String    { return out.empty() ? "" : out.back().value; };
 
-    const bool nextIsCall = nextNonTriviaIsLParen(raw, rawIndex);
+    const bool nextIsCall = nextIsLParen(scanner);
 
     // 0) Dot always wins: .name( => method call
     if (prevTokenWasDot(out) && nextIsCall) {
@@ -100,42 +99,54 @@ TokenType Lexer::classifyIdentifier(const String& value, const Vector<Token>& ou
         return TokenType::ClassMethodCall;
     }
 
+    // One probe: the fixed table answers for its own words, everything else is interned.
+    // Class and function names never need the fixed words' flags, nor they theirs.
+    using Keywords::Kind;
+    const Keywords::Entry* fixed = Keywords::find(value);
+    const Kind kind = fixed ? fixed->kind : Kind::None;
+    std::uint8_t flags = 0;
+    if (fixed) {
+        flags = fixed->flags;
+    } else if (auto it = names.find(value); it != names.end()) {
+        flags = it->second;
+    }
+
     // 1) Class definition keyword
-    if (value == "Class") {
+    if (kind == Kind::ClassDef) {
         return TokenType::ClassDef;
     }
 
     // 2) After ClassDef: class name (also arms "pendingClass")
     if (!out.empty() && lastType() == TokenType::ClassDef) {
-        classes.insert(value);
+        define(value, Keywords::Class);
         pendingClass = true;              // <- arm it HERE
         return TokenType::ClassRef;
     }
 
     // 3) def/function keywords
-    if (value == "function" || value == "def") {
+    if (kind == Kind::FunctionDef) {
         insideParams = true;
         return insideClass ? TokenType::ClassMethodDef : TokenType::FunctionDef;
     }
 
     // 4) name after def
     if (!out.empty() && (lastType() == TokenType::FunctionDef || lastType() == TokenType::ClassMethodDef)) {
-        functions.insert(value);
+        define(value, Keywords::Function);
         return insideClass ? TokenType::ClassMethodRef : TokenType::FunctionRef;
     }
 
     // 5) literals / word-ops
-    if (value == "true" || value == "false") return TokenType::Bool;
-    if (value == "and" || value == "or" || value == "not") return TokenType::Operator;
+    if (kind == Kind::Bool) return TokenType::Bool;
+    if (kind == Kind::WordOperator) return TokenType::Operator;
 
     // 6) var/const
-    if (value == "var" || value == "const") return TokenType::VarDeclaration;
+    if (kind == Kind::VarDeclaration) return TokenType::VarDeclaration;
 
     // 7) keyword bucket
-    if (keywords.count(value)) return TokenType::Keyword;
+    if (flags & Keywords::Keyword) return TokenType::Keyword;
 
     // 8) Primitive ctor call: String(1) => FunctionCall
-    if (primitives.count(value) && nextIsCall) {
+    if ((flags & Keywords::Primitive) && nextIsCall) {
         insideArgs = true;
         return TokenType::FunctionCall;
     }
@@ -143,17 +154,17 @@ TokenType Lexer::classifyIdentifier(const String& value, const Vector<Token>& ou
     // 9) Type token for annotations: x: String
     // If a known type is followed by '.' or '::', treat it as a chain start
     // (e.g. File.writeAll(...)) so parser can resolve static class methods.
-    if (knownTypes.count(value) && nextNonTriviaIsDotOrColonColon(raw, rawIndex)) {
+    if ((flags & Keywords::KnownType) && nextIsDotOrColonColon(scanner)) {
         return TokenType::ChainEntryPoint;
     }
 
     // Otherwise classify as Type when NOT immediately being called.
-    if (knownTypes.count(value) && !nextIsCall) {
+    if ((flags & Keywords::KnownType) && !nextIsCall) {
         return TokenType::Type;
     }
 
     // 10) Class ctor call: List(1), Square(5), Dict()
-    if ((cfg.nativeClasses.count(value) || classes.count(value)) && nextIsCall) {
+    if ((flags & Keywords::Class) && nextIsCall) {
         insideArgs = true;
         return TokenType::ClassCall;
     }
@@ -165,8 +176,9 @@ TokenType Lexer::classifyIdentifier(const String& value, const Vector<Token>& ou
     }
 
     // 12) Argument / Parameter modes (must run before generic call classification)
+    // A known function name passed as an argument stays a reference: List.map(square)
     if (insideArgs && !out.empty() && out.back().type == TokenType::Punctuation && !nextIsCall) {
-        return TokenType::Argument;
+        return (flags & Keywords::Function) ? TokenType::FunctionRef : TokenType::Argument;
     }
         
     if (insideParams && !nextIsCall) {
@@ -174,23 +186,23 @@ TokenType Lexer::classifyIdentifier(const String& value, const Vector<Token>& ou
     }
         
     // 13) function ref / class ref if known
-    if (functions.count(value)) { type = TokenType::FunctionRef; }
-    if (classes.count(value))   { type = TokenType::ClassRef; }
+    if (flags & Keywords::Function) { type = TokenType::FunctionRef; }
+    if (flags & Keywords::Class)    { type = TokenType::ClassRef; }
 
 
-    if (type == TokenType::Variable && value == "null") {
+    if (type == TokenType::Variable && kind == Kind::Null) {
         return TokenType::String;
     }
     // 14) ChainEntryPoint
-    if (type == TokenType::Variable && lastVal() != "." && nextNonTriviaIsDotOrColonColon(raw, rawIndex)) {
+    if (type == TokenType::Variable && !prevTokenWasDot(out) && nextIsDotOrColonColon(scanner)) {
         return TokenType::ChainEntryPoint;
     }
 
     // 15) demotions (same as before)
     if (type == TokenType::FunctionRef || type == TokenType::ClassMethodRef) {
-        if (nextNonTriviaIsDotOrColonColon(raw, rawIndex) ||
+        if (nextIsDotOrColonColon(scanner) ||
             (!out.empty() && out.back().type == TokenType::VarDeclaration) ||
-            (!out.empty() && out.back().type == TokenType::VarAssignment && nextNonTriviaIsDotOrColonColon(raw, rawIndex))) {
+            (!out.empty() && out.back().type == TokenType::VarAssignment && nextIsDotOrColonColon(scanner))) {
             return TokenType::Variable;
         }
     }
@@ -202,38 +214,24 @@ TokenType Lexer::classifyIdentifier(const String& value, const Vector<Token>& ou
 
 
 
-Vector<Token> Lexer::lex(const Vector<RawToken>& raw, Vector<Token>& out) {
-    
-    out.reserve(raw.size());
-    String s = "SOF";
-    String e = "EOF";
-    out.emplace_back(TokenType::SOF_Token, s, 0, 0);
-    classes = cfg.nativeClasses;   // seed from runtime/builtins
-    functions = cfg.nativeFuncs; 
-    keywords = cfg.keywords;
-    primitives = cfg.primitiveCtors;
-    knownTypes = cfg.knownTypes;
-    auto eofToken = RawToken(RawKind::EOF_, e, 0, 0);
-    
-    for (size_t i = 0; i < raw.size(); ) {
-        const RawToken& t = raw[i];
-        if (t.kind == RawKind::SOF) {
-            ++i;
-            continue;
-        }
-        // drop trivia
-        if (t.kind == RawKind::Space || t.kind == RawKind::Tab) { ++i; continue; }
+void Lexer::lex(Scanner& scanner, Vector<Token>& out) {
+    out.emplace_back(TokenType::SOF_Token, "SOF", 0, 0);
+    // Names defined by an earlier source view that source; start again from the config.
+    if (defined > 0) internConfig();
 
-        // comments: Merk previously skipped them
-        if (t.kind == RawKind::Comment || t.kind == RawKind::CommentLineStart ||
-            t.kind == RawKind::CommentBlockStart || t.kind == RawKind::CommentBlockEnd) {
-            ++i;
-            continue;
+    while (true) {
+        const RawToken t = scanner.peek();
+        if (t.kind == RawKind::EOF_) {
+            out.emplace_back(TokenType::EOF_Token, "EOF", t.line, t.column);
+            return;
         }
 
         if (t.kind == RawKind::Newline) {
             out.emplace_back(TokenType::Newline, "NewLine", t.line, t.column);
-            ++i;
+            // Outside brackets the line ends the statement, and any parameter or argument
+            // list it left open with it.
+            if (brackets == 0) { insideParams = false; insideArgs = false; }
+            scanner.advance();
             continue;
         }
 
@@ -261,12 +259,13 @@ Vector<Token> Lexer::lex(const Vector<RawToken>& raw, Vector<Token>& out) {
                 pendingClass = false;
             }
 
-            ++i;
+            scanner.advance();
             continue;
         }
 
         if (t.kind == RawKind::Dedent) {
             out.emplace_back(TokenType::Dedent, "<-", t.line, t.column);
+            pendingClass = false;  // the class header had no body
 
             const int newIndent = (int)t.aux;
             currentIndent = newIndent;
@@ -298,83 +297,81 @@ Vector<Token> Lexer::lex(const Vector<RawToken>& raw, Vector<Token>& out) {
                 classBodyIndent = 0;
             }
 
-            ++i;
+            scanner.advance();
             continue;
         }
 
-        if (tryEmitCompoundOp(raw, i, out)) {continue;}
+        if (pendingClass && out.back().type == TokenType::Newline) { pendingClass = false; }
+        if (tryEmitCompoundOp(scanner, out)) {continue;}
 
         // numbers/strings
         if (t.kind == RawKind::Number) {
-            out.emplace_back(TokenType::Number, t.lexeme, t.line, t.column);
-            ++i;
+            out.emplace_back(TokenType::Number, String(scanner.text(t)), t.line, t.column);
+            scanner.advance();
             continue;
         }
         if (t.kind == RawKind::String) {
-            out.emplace_back(TokenType::String, t.lexeme, t.line, t.column);
-            ++i;
+            out.emplace_back(TokenType::String, scanner.literal(t), t.line, t.column);
+            scanner.advance();
             continue;
         }
         if (t.kind == RawKind::Char) {
-            out.emplace_back(TokenType::Char, t.lexeme, t.line, t.column);
-            ++i;
+            out.emplace_back(TokenType::Char, scanner.literal(t), t.line, t.column);
+            scanner.advance();
             continue;
         }
         if (t.kind == RawKind::Text) {
-            out.emplace_back(TokenType::Text, t.lexeme, t.line, t.column);
-            ++i;
+            out.emplace_back(TokenType::Text, scanner.literal(t), t.line, t.column);
+            scanner.advance();
             continue;
         }
 
         // identifiers
         if (t.kind == RawKind::Identifier) {
-            TokenType tt = classifyIdentifier(t.lexeme, out, raw, i);
+            const std::string_view value = scanner.text(t);
+            TokenType tt = classifyIdentifier(value, out, scanner);
             if (tt == TokenType::FunctionCall && prevTokenWasDot(out)) {
                 tt = TokenType::ClassMethodCall;
             }
-            out.emplace_back(tt, t.lexeme, t.line, t.column);
-            ++i;
+            out.emplace_back(tt, String(value), t.line, t.column);
+            scanner.advance();
             continue;
         }
 
         // single '=' is VarAssignment
-        if (t.kind == RawKind::Operator && t.lexeme == "=") {
+        if (t.kind == RawKind::Operator && scanner.textIs(t, '=')) {
             out.emplace_back(TokenType::VarAssignment, "=", t.line, t.column);
-            ++i;
+            scanner.advance();
             continue;
         }
 
         // operator / punctuation passthrough
         if (t.kind == RawKind::Operator) {
-            out.emplace_back(TokenType::Operator, t.lexeme, t.line, t.column);
-            ++i;
+            out.emplace_back(TokenType::Operator, String(scanner.text(t)), t.line, t.column);
+            scanner.advance();
             continue;
         }
 
         if (t.kind == RawKind::Punctuation) {
             // preserve your special bracket tokens if you still want them:
-            if (t.lexeme == "[") { out.emplace_back(TokenType::LeftBracket, "[", t.line, t.column); }
-            else if (t.lexeme == "]") { out.emplace_back(TokenType::RightBracket, "]", t.line, t.column); }
-            else { out.emplace_back(TokenType::Punctuation, t.lexeme, t.line, t.column); }
-
-            if (t.lexeme == ")") { insideArgs = false; insideParams = false; }
-            ++i;
+            const char c = scanner.text(t)[0];
+            if (c == '[') { out.emplace_back(TokenType::LeftBracket, "[", t.line, t.column); }
+            else if (c == ']') { out.emplace_back(TokenType::RightBracket, "]", t.line, t.column); }
+            else { out.emplace_back(TokenType::Punctuation, String(1, c), t.line, t.column); }
+
+            if (c == '(' || c == '[' || c == '{') { ++brackets; }
+            else if ((c == ')' || c == ']' || c == '}') && brackets > 0) { --brackets; }
+            if (c == ')') { insideArgs = false; insideParams = false; }
+            scanner.advance();
             continue;
         }
 
-        if (t.kind == RawKind::EOF_) { break; }
-
         // unknown
-        out.emplace_back(TokenType::Unknown, t.lexeme, t.line, t.column);
-        ++i;
+        out.emplace_back(TokenType::Unknown, String(scanner.text(t)), t.line, t.column);
+        scanner.advance();
     }
-    
-    // EOF    
-    const RawToken& last = raw.empty() ? RawToken(RawKind::EOF_, e, 0, 0) : raw.back();
-    out.emplace_back(TokenType::EOF_Token, e, last.line, last.column);
-    return out;
 }
 
-Lexer::Lexer(LexerConfig lxCfg) { cfg = lxCfg; }
+Lexer::Lexer(LexerConfig lxCfg) : cfg(std::move(lxCfg)) { internConfig(); }
 
-Lexer::Lexer() {}
\ No newline at end of file
+Lexer::Lexer() { internConfig(); }
\ No newline at end of file
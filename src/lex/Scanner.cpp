@@ -1,416 +1,410 @@
 #include "lex/Scanner.hpp"
 
-Vector<RawToken> Scanner::scan() {
-    rawTokens.emplace_back(RawToken(RawKind::SOF));
-    while (position < sourceLength) {
-        
-        handleWhiteSpace();
-        if (tryScanComment()) {
-            continue;
-        }
-        
-
-        if (isDigit(current)) {
-             rawTokens.emplace_back(readNumber());
-             continue;
-        }
-
-        if (isTextBegin(current)) {
-            rawTokens.emplace_back(readText());
-            continue;
-        }
-
-
-        if (isOperator(current)) {
-            rawTokens.emplace_back(readOperator());
-            continue;
-        }
-
-        if (isPunctuation(current)) {
-            rawTokens.emplace_back(readPunctuation());
-            continue;
-        }
+#include <cstring>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
-        if (isLetter(current)) {
-            rawTokens.emplace_back(readIdentifier());
-            continue;
-
-        }
-
-        if (!hasNext()) {
-            break;
-        }
-        rawTokens.emplace_back( RawToken(RawKind::Unknown, String(1, current), line, column));
-        advanceN(1);
-        
-    }
+namespace {
 
-    String eof = "EOF";
-    rawTokens.emplace_back(RawToken(RawKind::EOF_, eof, line, column));
-    return rawTokens;
-}
+bool isDigit(char c) { return c >= '0' && c <= '9'; }
 
-Scanner::Scanner(String src, CommentConfig cfg)
-    : source(std::move(src)), commentCfg(std::move(cfg)) {
-    sourceLength = source.size();
-    current = (sourceLength > 0) ? source[0] : '\0';
+bool isLetter(char c) {
+    const char lower = static_cast<char>(c | 0x20);
+    return (lower >= 'a' && lower <= 'z') || c == '_';
 }
 
-Scanner::Scanner(const char* src, const CommentConfig& cfg) : Scanner(String(src), cfg) {}
-
-char Scanner::next() {
-    column++;
-    if (position + 1 >= sourceLength) {
-        position = sourceLength;
-        current = '\0';
-        return current;
-    }
-    position++;
-    current = source[position];
-    return current;
-}
-
-bool Scanner::hasNext() { return position < sourceLength; }
-
-
-bool Scanner::isWhiteSpace(char c) {
-    return c == ' ' || c == '\t' || c == '\n';
+bool isOperator(char c) {
+    return c == '+' || c == '-' || c == '*' || c == '/' ||
+        c == '%' || c == '=' || c == '<' || c == '>' ||
+        c == '&' || c == '|' || c == '!';
 }
 
-bool Scanner::isDigit(char c) {
-    return std::isdigit(static_cast<unsigned char>(c));
+bool isPunctuation(char c) {
+    return c == ':' || c == ';' || c == '.' || c == ',' || c == '$' || c == '@' || c == '?'
+        || c == '(' || c == ')' || c == '[' || c == ']' || c == '{' || c == '}';
 }
 
-void Scanner::handleWhiteSpace() {
-    while (isWhiteSpace(current) && hasNext()) {
-        int startLine = line;
-        int startCol = column;
-        if (current == '\n') {
-            int numNewLines = 0;
-            while (current == '\n') { ++numNewLines; line++; column = 0; next(); }
-            rawTokens.emplace_back(RawKind::Newline, "\n", startLine, startCol, numNewLines);            
-        }
-        if (current == '\t') {
-            int numTabs = 0;
-            while (current == '\t') { ++numTabs; next(); }
-            rawTokens.emplace_back(RawToken(RawKind::Tab, "    ", startLine, startCol, numTabs));
-        }
-        
-        if (current == ' ') {
-            int numSpaces = 0;
-            while (current == ' ') { ++numSpaces; next(); }
-            rawTokens.emplace_back(RawToken(RawKind::Space, " ", startLine, startCol, numSpaces));
-            continue;
-        }
-
-    }
+bool isTextBegin(char c) {
+    return c == '\'' || c == '"' || c == '`';
 }
 
-bool Scanner::isSpecialChar(char c) {
+bool isEscape(char c, char quote) {
     switch (c) {
-        case 'n':
-        case 't':
-        case 'r':
-        case '\\':
-        case '\'':
-        case '"':
+        case 'n': case 't': case 'r': case '\\': case '\'': case '"': case '`':
             return true;
         default:
-            return false;
+            return c == quote;
     }
-
 }
 
-bool Scanner::handleSpecialChar(char nextChar, char startChar, String& resultAccum) {
-    if (nextChar == startChar) { return true; }
-    if (isSpecialChar(nextChar)) {
-        resultAccum += '\\' + nextChar;
-        return true;
+// Runs of whitespace, identifier characters, digits and literal bodies are classified a block
+// at a time: AVX2 when the build targets it, SSE2 on any x86-64, bytewise otherwise and for the
+// tail of the source. A block's "stop" mask has a bit set for every byte that ends the run.
+inline constexpr bool kEnableSimdScan = true;
+
+#if defined(__AVX2__)
+using Block = __m256i;
+constexpr std::ptrdiff_t kBlockWidth = 32;
+inline Block loadBlock(const char* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+inline Block splat(char c) { return _mm256_set1_epi8(c); }
+inline Block matches(Block v, char c) { return _mm256_cmpeq_epi8(v, splat(c)); }
+inline Block either(Block a, Block b) { return _mm256_or_si256(a, b); }
+inline Block both(Block a, Block b) { return _mm256_and_si256(a, b); }
+inline Block greater(Block a, Block b) { return _mm256_cmpgt_epi8(a, b); }
+inline std::uint32_t bits(Block m) { return static_cast<std::uint32_t>(_mm256_movemask_epi8(m)); }
+constexpr std::uint32_t kAllBits = 0xFFFFFFFFu;
+#define MERK_SIMD_SCAN 1
+#elif defined(__SSE2__)
+using Block = __m128i;
+constexpr std::ptrdiff_t kBlockWidth = 16;
+inline Block loadBlock(const char* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+inline Block splat(char c) { return _mm_set1_epi8(c); }
+inline Block matches(Block v, char c) { return _mm_cmpeq_epi8(v, splat(c)); }
+inline Block either(Block a, Block b) { return _mm_or_si128(a, b); }
+inline Block both(Block a, Block b) { return _mm_and_si128(a, b); }
+inline Block greater(Block a, Block b) { return _mm_cmpgt_epi8(a, b); }
+inline std::uint32_t bits(Block m) { return static_cast<std::uint32_t>(_mm_movemask_epi8(m)); }
+constexpr std::uint32_t kAllBits = 0xFFFFu;
+#define MERK_SIMD_SCAN 1
+#endif
+
+// Character classes a run is made of. keep() decides a single byte; with a vector unit,
+// stopMask() decides a whole block and sets a bit for every byte that ends the run.
+struct SameAs { char c; bool keep(char x) const { return x == c; } };
+struct Digits { bool keep(char x) const { return isDigit(x); } };
+struct WordChars { bool keep(char x) const { return isLetter(x) || isDigit(x); } };
+// A literal body runs up to the closing quote, an escape or a newline (which the caller counts).
+struct TextBody { char quote; bool keep(char x) const { return x != quote && x != '\\' && x != '\n'; } };
+
+#ifdef MERK_SIMD_SCAN
+// Bytes in [lo, hi]; the compares are signed, so bytes >= 0x80 never match an ASCII range.
+inline Block inRange(Block v, char lo, char hi) {
+    return both(greater(v, splat(static_cast<char>(lo - 1))), greater(splat(static_cast<char>(hi + 1)), v));
+}
+
+inline std::uint32_t stopMask(Block v, SameAs cls) { return ~bits(matches(v, cls.c)) & kAllBits; }
+inline std::uint32_t stopMask(Block v, Digits) { return ~bits(inRange(v, '0', '9')) & kAllBits; }
+inline std::uint32_t stopMask(Block v, WordChars) {
+    const Block word = either(either(inRange(v, '0', '9'), inRange(either(v, splat(0x20)), 'a', 'z')), matches(v, '_'));
+    return ~bits(word) & kAllBits;
+}
+inline std::uint32_t stopMask(Block v, TextBody cls) {
+    return bits(either(either(matches(v, cls.quote), matches(v, '\\')), matches(v, '\n')));
+}
+#endif
+
+// First position in [p, end) that does not belong to the run.
+template <typename Class>
+const char* scanRun(const char* p, const char* end, Class cls) {
+#ifdef MERK_SIMD_SCAN
+    if constexpr (kEnableSimdScan) {
+        while (end - p >= kBlockWidth) {
+            const std::uint32_t stop = stopMask(loadBlock(p), cls);
+            if (stop) return p + __builtin_ctz(stop);
+            p += kBlockWidth;
+        }
     }
-    return false;
+#endif
+    while (p < end && cls.keep(*p)) ++p;
+    return p;
 }
 
-bool Scanner::isOperator(char c) {
-    return c == '+' || c == '-' || c == '*' || c == '/' || 
-        c == '%' || c == '=' || c == '<' || c == '>' || 
-        c == '&' || c == '|' || c == '!';
-}
+} // namespace
 
-bool Scanner::isPunctuation(char c) {
-    return c == ':' || c == ';' || c == '.' || c == ',' || c == '$' || c == '@' || c == '?'
-        || c == '(' || c == ')' || c == '[' || c == ']' || c == '{' || c == '}';
-}
 
-bool Scanner::isTextBegin(char c) {
-    return c == '\'' || c == '"' || c == '`';
+Scanner::Scanner(std::string_view src, CommentConfig comments, LayoutConfig layout)
+    : source(src), commentCfg(std::move(comments)), layoutCfg(layout) {
+    if (source.size() > UINT32_MAX) {
+        throw ScannerError("Source larger than 4 GiB", 1, 1);
+    }
 }
 
-bool Scanner::isLetter(char c) {
-    return std::isalpha(static_cast<unsigned char>(c)) || c == '_';
+Scanner::Scanner(SharedPtr<SourceBuffer> src, CommentConfig comments, LayoutConfig layout)
+    : Scanner(src->view(), std::move(comments), layout) {
+    buffer = std::move(src);
 }
 
-bool Scanner::isCommentBegin(char c) {
-    String s(1, c);
-    for (auto& starts : commentCfg.lineStarts) {
-        if (starts == s) {
-            return true;
-        }
-    }
-    for (auto& pair : commentCfg.blockPairs) {
-        
-        if (pair.start == s) {
-            return true;
-        }
+const RawToken& Scanner::peek(size_t ahead) {
+    while (pending.size() - head <= ahead) {
+        if (finished) return eofToken;
+        scanMore();
     }
-
-    return false;
+    return pending[head + ahead];
 }
 
-
-RawToken Scanner::readOperator() {
-    if (!isOperator(current)) {
-        throw ScannerError("Not Operator in readOperator -> " + std::to_string(current), line, column);
+void Scanner::advance() {
+    if (head < pending.size() && ++head == pending.size()) {
+        pending.clear();
+        head = 0;
     }
-
-    auto t = RawToken(RawKind::Operator, current, line, column);
-    next();
-    return t;
 }
 
-RawToken Scanner::readPunctuation() {
-    if (!isPunctuation(current)) {
-        throw ScannerError("Not Punctuation in readPunctuation -> " + std::to_string(current), line, column);
-    }
-    auto t = RawToken(RawKind::Punctuation, current, line, column);
-    next();
+RawToken Scanner::span(RawKind kind, size_t start, int startLine, int startColumn, int aux) const {
+    RawToken t;
+    t.kind = kind;
+    t.offset = static_cast<std::uint32_t>(start);
+    t.length = static_cast<std::uint32_t>(position - start);
+    t.line = startLine;
+    t.column = startColumn;
+    t.aux = aux;
     return t;
 }
 
-RawToken Scanner::readText() {
-    if (!isTextBegin(current)) { throw ScannerError("Not Text in readText -> " + std::to_string(current), line, column); }
-
-    char startChar = current;
-    int startColumn = column;
-    int startLine = line;
-    String result;
-    RawKind type = current == '\'' ? RawKind::Char : current == '"' ? RawKind::String : RawKind::Text;
-    next();
-
-    while (hasNext() && current != startChar) {
-        if (current == '\\') {
-            if (!hasNext()) {
-                throw ScannerError("Unfinished escape sequence in string literal", line, column);
-            }
-            next();
-            const char escaped = current;
-            switch (escaped) {
-                case 'n':  result += '\n'; break;
-                case 't':  result += '\t'; break;
-                case 'r':  result += '\r'; break;
-                case '\\': result += '\\'; break;
-                case '\'': result += '\''; break;
-                case '"':  result += '"'; break;
-                case '`':  result += '`'; break;
-                default:
-                    if (escaped == startChar) {
-                        result += startChar;
-                    } else {
-                        throw ScannerError("Unknown escape in string literal", line, column);
-                    }
-                    break;
-            }
-            next();
-            continue;
-
-        } else {
-            result += current;
+void Scanner::scanMore() {
+    const size_t before = pending.size();
+    while (pending.size() == before && !finished) {
+        if (handleWhiteSpace()) continue;
+        if (position >= source.size()) {
+            finish();
+            break;
         }
-
-        next();
+        if (skipComment()) continue;
+
+        const char c = source[position];
+        if (isDigit(c))            emit(readNumber());
+        else if (isTextBegin(c))   emit(readText());
+        else if (isOperator(c))    emit(readSingle(RawKind::Operator));
+        else if (isPunctuation(c)) emit(readSingle(RawKind::Punctuation));
+        else if (isLetter(c))      emit(readIdentifier());
+        else                       emit(readSingle(RawKind::Unknown));
     }
-
-    if (hasNext() && current != startChar) {
-        throw ScannerError("Unmatched quote for " + std::to_string(startChar), line, column);
-    }
-
-    next();
-
-    return RawToken(type, result, startLine, startColumn);
 }
 
-RawToken Scanner::readNumber() {
-    if (!isDigit(current)) {
-        throw ScannerError("Not Digit in readNumber -> " + std::to_string((int)current), line, column);
+void Scanner::finish() {
+    RawToken end = span(RawKind::EOF_, position, line, column());
+    while (indentStack.size() > 1) {
+        indentStack.pop_back();
+        RawToken dedent = end;
+        dedent.kind = RawKind::Dedent;
+        dedent.aux = 0;
+        pending.push_back(dedent);
+    }
+    pending.push_back(end);
+    eofToken = end;
+    finished = true;
+}
+
+// Layout: newlines inside brackets are dropped, and the first token of a line outside
+// brackets opens or closes blocks against the indentation stack.
+void Scanner::emit(const RawToken& t) {
+    if (t.kind == RawKind::Newline) {
+        const bool continued = !atLineStart && layoutCfg.parenContinuation && parenDepth > 0;
+        atLineStart = true;
+        pendingIndent = 0;
+        if (!continued) pending.push_back(t);
+        return;
     }
 
-    const int startLine = line;
-    const int startCol  = column;
-
-    String number;
-    bool seenDot = false;
-    while (position < sourceLength) {
-        if (isDigit(current)) {
-            number += current;
-            next();
-            continue;
-        }
-
-        if (!seenDot && current == '.' && (position + 1) < sourceLength && isDigit(source[position + 1]))
-        {
-            seenDot = true;
-            number += current;
-            next();
-            continue;
-        }
-
-        break;
+    if (t.kind == RawKind::Punctuation) {
+        const char c = source[t.offset];
+        if (c == '(' || c == '[' || c == '{') ++parenDepth;
+        else if ((c == ')' || c == ']' || c == '}') && parenDepth > 0) --parenDepth;
     }
 
-    return RawToken(RawKind::Number, number, startLine, startCol);
+    if (atLineStart) {
+        if (parenDepth == 0) applyIndent(t);
+        pendingIndent = 0;
+        atLineStart = false;
+    }
+    pending.push_back(t);
 }
 
-RawToken Scanner::readIdentifier() {
-    if (!isLetter(current)) throw ScannerError("Not Letter in readIdentifier -> " + std::to_string(current), line, column);
-
-    int startCol = column;
-    int startLine = line;
-    String accum;
+void Scanner::applyIndent(const RawToken& atToken) {
+    const int indent = pendingIndent;
+    if (indent == indentStack.back()) return;
 
-    while (true) {
-        if (isLetter(current) || isDigit(current)) { accum += current; }
-        else if (current == '_') { accum += current; }
-        else break;
+    RawToken marker = atToken;
+    marker.length = 0;
+    marker.aux = indent;
 
-        if (!hasNext()) break;
-        next();
+    if (indent > indentStack.back()) {
+        indentStack.push_back(indent);
+        marker.kind = RawKind::Indent;
+        pending.push_back(marker);
+        return;
     }
 
-    return RawToken(RawKind::Identifier, accum, startLine, startCol);
+    marker.kind = RawKind::Dedent;
+    while (indentStack.size() > 1 && indentStack.back() > indent) {
+        indentStack.pop_back();
+        pending.push_back(marker);
+    }
+    if (indentStack.back() != indent) {
+        throw ScannerError("Indentation error: unaligned dedent", atToken.line, atToken.column);
+    }
 }
 
-bool Scanner::handleSpecialChars() {
-    if (isSpecialChar(current)){
-        String accum;
-        accum += current;
-        while (hasNext() && isSpecialChar(current)) {
-            if (handleSpecialChar(source[position], current, accum)) {
-                next();
-            }
+void Scanner::newLine() {
+    ++line;
+    lineStart = position;
+}
+
+// Newline runs become one token; spaces and tabs only count toward a line's indentation.
+bool Scanner::handleWhiteSpace() {
+    const size_t start = position;
+    while (position < source.size()) {
+        const char c = source[position];
+        if (c == '\n') {
+            const size_t runStart = position;
+            const int startLine = line;
+            const int startColumn = column();
+            position = offsetOf(scanRun(at(position), end(), SameAs{'\n'}));
+            line += static_cast<int>(position - runStart);
+            lineStart = position;
+            emit(span(RawKind::Newline, runStart, startLine, startColumn, static_cast<int>(position - runStart)));
+            continue;
         }
-        return true;
-    }
-    return false;
-}
+        if (c != ' ' && c != '\t') break;
 
-int Scanner::matchBlockStartIndex() const {
-    int best = -1;
-    size_t bestLen = 0;
-    for (int i = 0; i < (int)commentCfg.blockPairs.size(); ++i) {
-        const auto& st = commentCfg.blockPairs[i].start;
-        if (matchAt(position, st) && st.size() > bestLen) {
-            best = i;
-            bestLen = st.size();
+        const size_t runStart = position;
+        position = offsetOf(scanRun(at(position), end(), SameAs{c}));
+        if (!atLineStart) continue;
+
+        const int count = static_cast<int>(position - runStart);
+        if (c == '\t') {
+            if (!layoutCfg.tabsAllowed) throw std::runtime_error("Tabs not allowed");
+            pendingIndent += count * layoutCfg.tabWidth;
+        } else {
+            pendingIndent += count;
         }
     }
-    return best;
+    return position != start;
 }
 
-bool Scanner::tryScanCommentDelimiter() {
-    // Prefer starts over ends,
-    if (tryScanCommentStart()) { return true; }
-    if (tryScanCommentEnd())   { return true; }
-    return false;
-}
- 
-bool Scanner::inBounds(size_t pos) const { return pos < sourceLength; }
-
 bool Scanner::matchAt(size_t pos, const String& s) const {
-    if (s.empty()) {return false;}
-    if (pos + s.size() > sourceLength) {return false;}
+    if (s.empty() || pos + s.size() > source.size()) return false;
     return source.compare(pos, s.size(), s) == 0;
 }
 
-void Scanner::advanceN(size_t n) {
-    // Advance n characters, updating column (and line if '\n' is seen
-    for (size_t i = 0; i < n && position < sourceLength; ++i) {
-        ++position;
-        ++column;
-    }
-    current = (position < sourceLength) ? source[position] : '\0';
-}
-
-
-bool Scanner::tryScanCommentStart() {
-    if (!inBounds(position)) return false;
-
-    // Find the best (longest) match among ALL start delimiters at this position.
-    enum class StartKind { None, Line, Block };
-    StartKind bestKind = StartKind::None;
+// Comments never reach the lexer; a comment-only line still ends in a Newline.
+bool Scanner::skipComment() {
     size_t bestLen = 0;
-    int bestBlockIndex = -1;
-    String bestLexeme;
-
-    // 1) Line starts
+    int bestBlock = -1;
     for (const auto& ls : commentCfg.lineStarts) {
-        if (ls.size() >= bestLen && matchAt(position, ls)) {
-            // Longest match wins; if equal length, line vs block tie-break is arbitrary.
-            bestKind = StartKind::Line;
+        if (ls.size() > bestLen && matchAt(position, ls)) {
             bestLen = ls.size();
-            bestLexeme = ls;
-            bestBlockIndex = -1;
+            bestBlock = -1;
         }
     }
-
-    // 2) Block starts
-    for (int i = 0; i < (int)commentCfg.blockPairs.size(); ++i) {
+    for (int i = 0; i < static_cast<int>(commentCfg.blockPairs.size()); ++i) {
         const auto& bs = commentCfg.blockPairs[i].start;
-        if (bs.size() >= bestLen && matchAt(position, bs)) {
-            bestKind = StartKind::Block;
+        if (bs.size() > bestLen && matchAt(position, bs)) {
             bestLen = bs.size();
-            bestLexeme = bs;
-            bestBlockIndex = i;
+            bestBlock = i;
         }
     }
+    if (bestLen == 0) return false;
 
-    if (bestKind == StartKind::None) {return false;}
-
+    atLineStart = false;
     const int startLine = line;
-    const int startCol  = column;
+    const int startColumn = column();
+    position += bestLen;
 
-    if (bestKind == StartKind::Line) {
-        rawTokens.emplace_back(RawKind::CommentLineStart, bestLexeme, startLine, startCol, -1);
-        advanceN(bestLen);
+    if (bestBlock < 0) {
+        const void* newline = std::memchr(at(position), '\n', source.size() - position);
+        position = newline ? offsetOf(static_cast<const char*>(newline)) : source.size();
         return true;
     }
-
-    rawTokens.emplace_back(RawKind::CommentBlockStart, bestLexeme, startLine, startCol, bestBlockIndex);
-    advanceN(bestLen);
+    skipBlockComment(commentCfg.blockPairs[bestBlock], startLine, startColumn);
     return true;
 }
 
-bool Scanner::tryScanCommentEnd() {
-    if (!inBounds(position)) return false;
-    size_t bestLen = 0;
-    int bestBlockIndex = -1;
-    String bestLexeme;
-
-    for (int i = 0; i < (int)commentCfg.blockPairs.size(); ++i) {
-        const auto& be = commentCfg.blockPairs[i].end;
-        if (be.size() >= bestLen && matchAt(position, be)) {
-            bestLen = be.size();
-            bestLexeme = be;
-            bestBlockIndex = i;
+void Scanner::skipBlockComment(const CommentPair& pair, int startLine, int startColumn) {
+    int depth = 1;
+    while (position < source.size()) {
+        if (pair.nestable && matchAt(position, pair.start)) {
+            position += pair.start.size();
+            ++depth;
+            continue;
         }
+        if (matchAt(position, pair.end)) {
+            position += pair.end.size();
+            if (--depth == 0) return;
+            continue;
+        }
+        if (source[position++] == '\n') newLine();
     }
+    throw ScannerError("Unterminated block comment", startLine, startColumn);
+}
+
+RawToken Scanner::readSingle(RawKind kind) {
+    const size_t start = position;
+    const int startColumn = column();
+    ++position;
+    return span(kind, start, line, startColumn);
+}
 
-    if (bestBlockIndex < 0) return false;
+RawToken Scanner::readNumber() {
+    const size_t start = position;
+    const int startColumn = column();
+    position = offsetOf(scanRun(at(position), end(), Digits{}));
+    if (position + 1 < source.size() && source[position] == '.' && isDigit(source[position + 1])) {
+        position = offsetOf(scanRun(at(position + 1), end(), Digits{}));
+    }
+    return span(RawKind::Number, start, line, startColumn);
+}
 
-    const int endLine = line;
-    const int endCol  = column;
+RawToken Scanner::readIdentifier() {
+    const size_t start = position;
+    const int startColumn = column();
+    position = offsetOf(scanRun(at(position), end(), WordChars{}));
+    return span(RawKind::Identifier, start, line, startColumn);
+}
 
-    rawTokens.emplace_back(RawKind::CommentBlockEnd, bestLexeme, endLine, endCol, bestBlockIndex);
-    advanceN(bestLen);
-    return true;
+// The token spans the body only; escapes are checked here and resolved by literal().
+// An unterminated literal runs to the end of the source.
+RawToken Scanner::readText() {
+    const char quote = source[position];
+    const RawKind kind = quote == '\'' ? RawKind::Char : quote == '"' ? RawKind::String : RawKind::Text;
+    const int startLine = line;
+    const int startColumn = column();
+    ++position;
+
+    const size_t bodyStart = position;
+    int escapes = 0;
+    while (true) {
+        position = offsetOf(scanRun(at(position), end(), TextBody{quote}));
+        if (position >= source.size() || source[position] == quote) break;
+        const char c = source[position++];
+        if (c == '\\') {
+            const char escaped = position < source.size() ? source[position] : '\0';
+            if (!isEscape(escaped, quote)) {
+                throw ScannerError("Unknown escape in string literal", line, column());
+            }
+            escapes = 1;
+            ++position;
+        } else if (c == '\n') {
+            newLine();
+        }
+    }
+
+    RawToken t = span(kind, bodyStart, startLine, startColumn, escapes);
+    if (position < source.size()) ++position;
+    return t;
+}
+
+String Scanner::literal(const RawToken& t) const {
+    const std::string_view body = text(t);
+    if (t.aux != 1) return String(body);
+
+    String result;
+    result.reserve(body.size());
+    for (size_t i = 0; i < body.size(); ++i) {
+        if (body[i] != '\\' || i + 1 >= body.size()) {
+            result += body[i];
+            continue;
+        }
+        switch (body[++i]) {
+            case 'n': result += '\n'; break;
+            case 't': result += '\t'; break;
+            case 'r': result += '\r'; break;
+            default:  result += body[i]; break; // \\ and the quotes
+        }
+    }
+    return result;
 }
 
 const char* rawKindToString(RawKind k) {
@@ -444,159 +438,6 @@ const char* rawKindToString(RawKind k) {
     }
 }
 
-bool Scanner::matchBlockEndIndex(int i) const {
-    return matchAt(position, commentCfg.blockPairs[i].end);
-}
-
-RawToken Scanner::scanBlockComment(int pairIndex) {
-    const int startLine = line;
-    const int startCol  = column;
-
-    const auto& pair = commentCfg.blockPairs[pairIndex];
-    advanceN(pair.start.size());
-
-    String text;
-    int depth = 1;
-
-    while (position < sourceLength) {
-        // If nestable, detect nested start
-        if (pair.nestable) {
-            int nested = matchBlockStartIndex();
-            if (nested == pairIndex) {
-                advanceN(commentCfg.blockPairs[nested].start.size());
-                depth++;
-                continue;
-            }
-        }
-
-        // Detect end for this pair
-        if (matchBlockEndIndex(pairIndex)) {
-            advanceN(pair.end.size());
-            depth--;
-            if (depth == 0) {
-                return RawToken(RawKind::Comment, text, startLine, startCol, pairIndex);
-            }
-            continue;
-        }
-
-        // Normal char in comment body
-        text += current;
-        next(); // use next() for newline tracking
-    }
-
-    throw ScannerError("Unterminated block comment", startLine, startCol);
-}
-
-RawToken Scanner::scanLineComment(const String& startLexeme) {
-    const int startLine = line;
-    const int startCol  = column;
-
-    advanceN(startLexeme.size());
-
-    String text;
-    while (position < sourceLength && current != '\n') {
-        text += current;
-        next();
-    }
-    if (!text.empty() && text[0] == ' ') text.erase(0, 1);
-
-    return RawToken(RawKind::Comment, text, startLine, startCol, -1);
-}
-
-bool Scanner::tryScanComment() {
-    if (!inBounds(position)) return false;
-
-    enum class StartKind { None, Line, Block };
-    StartKind bestKind = StartKind::None;
-    size_t bestLen = 0;
-    int bestBlockIndex = -1;
-    String bestLexeme;
-
-    for (const auto& ls : commentCfg.lineStarts) {
-        if (matchAt(position, ls) && ls.size() > bestLen) {
-            bestKind = StartKind::Line;
-            bestLen = ls.size();
-            bestLexeme = ls;
-            bestBlockIndex = -1;
-        }
-    }
-    for (int i = 0; i < (int)commentCfg.blockPairs.size(); ++i) {
-        const auto& bs = commentCfg.blockPairs[i].start;
-        if (matchAt(position, bs) && bs.size() > bestLen) {
-            bestKind = StartKind::Block;
-            bestLen = bs.size();
-            bestLexeme = bs;
-            bestBlockIndex = i;
-        }
-    }
-
-    if (bestKind == StartKind::None) return false;
-
-    const int startLine = line;
-    const int startCol  = column;
-
-    if (bestKind == StartKind::Line) {
-        rawTokens.emplace_back(RawKind::CommentLineStart, bestLexeme, startLine, startCol, -1);
-
-        advanceN(bestLexeme.size());
-        rawTokens.emplace_back(scanLineCommentBody());
-        return true;
-    }
-
-    // Block comment
-    rawTokens.emplace_back(RawKind::CommentBlockStart, bestLexeme, startLine, startCol, bestBlockIndex);
-    advanceN(bestLexeme.size());
-    rawTokens.emplace_back(scanBlockCommentBody(bestBlockIndex)); 
-    rawTokens.emplace_back(RawKind::CommentBlockEnd, commentCfg.blockPairs[bestBlockIndex].end, line, column, bestBlockIndex);
-    return true;
-}
-
-RawToken Scanner::scanLineCommentBody() {
-    const int startLine = line;
-    const int startCol  = column;
-
-    String text;
-    while (position < sourceLength && current != '\n') {
-        text += current;
-        next();
-    }
-    if (!text.empty() && text[0] == ' ') text.erase(0, 1);
-    return RawToken(RawKind::Comment, text, startLine, startCol, -1);
-}
-
-RawToken Scanner::scanBlockCommentBody(int pairIndex) {
-    const int startLine = line;
-    const int startCol  = column;
-    const auto& pair = commentCfg.blockPairs[pairIndex];
-
-    String text;
-    int depth = 1;
-
-    while (position < sourceLength) {
-        // nested start
-        if (pair.nestable && matchAt(position, pair.start)) {
-            advanceN(pair.start.size());
-            depth++;
-            continue;
-        }
-
-        // end
-        if (matchAt(position, pair.end)) {
-            advanceN(pair.end.size());
-            depth--;
-            if (depth == 0) {
-                return RawToken(RawKind::Comment, text, startLine, startCol, pairIndex);
-            }
-            continue;
-        }
-
-        text += current;
-        next();
-    }
-
-    throw ScannerError("Unterminated block comment", startLine, startCol);
-}
-
 String escapeLexeme(const String& s) {
     String out;
     out.reserve(s.size());
@@ -622,35 +463,6 @@ String escapeLexeme(const String& s) {
     return out;
 }
 
-void printRawTokens(const Vector<RawToken>& toks, std::ostream& os) {
-    os << "RawTokens (" << toks.size() << ")\n";
-    os << "------------------------------------------------------------\n";
-    for (size_t i = 0; i < toks.size(); ++i) {
-        const auto& t = toks[i];
-        os << std::setw(4) << i << "  "
-           << std::setw(18) << rawKindToString(t.kind)
-           << "  (" << t.line << ":" << t.column << ")";
-
-        if (t.aux != -1) {
-            os << "  aux=" << t.aux;
-        }
-
-        if (!t.lexeme.empty()) {
-            os << "  \"" << escapeLexeme(t.lexeme) << "\"";
-        }
-
-        os << "\n";
-    }
-    os << "------------------------------------------------------------\n";
-}
-
-std::ostream& operator<<(std::ostream& os, const RawToken& t) {
-    os << rawKindToString(t.kind) << " (" << t.line << ":" << t.column << ")";
-    if (t.aux != -1) os << " aux=" << t.aux;
-    if (!t.lexeme.empty()) os << " \"" << escapeLexeme(t.lexeme) << "\"";
-    return os;
-}
-
 ScannerError::ScannerError(const String& m, int l, int c): RunTimeError(m), message(m), line(l), column(c) {}
 
 String ScannerError::errorString() const {
@@ -660,4 +472,4 @@ String ScannerError::errorString() const {
 const char* ScannerError::what() const noexcept {
     cache = errorString();
     return cache.c_str();
-};
\ No newline at end of file
+};
@@ -0,0 +1,71 @@
+#include "lex/SourceBuffer.hpp"
+
+#include <cerrno>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace {
+
+struct FileHandle {
+    int fd;
+    ~FileHandle() { if (fd >= 0) ::close(fd); }
+};
+
+} // namespace
+
+
+SharedPtr<SourceBuffer> SourceBuffer::open(const String& path) {
+    FileHandle file{::open(path.c_str(), O_RDONLY)};
+    if (file.fd < 0) {
+        throw std::runtime_error("Error: Cannot open file '" + path + "'. Please ensure the file exists and is accessible.");
+    }
+
+    SharedPtr<SourceBuffer> buffer(new SourceBuffer());
+    buffer->filePath = path;
+
+    struct stat info {};
+    const bool regular = ::fstat(file.fd, &info) == 0 && S_ISREG(info.st_mode);
+
+    // Empty files cannot be mapped and need no buffer at all.
+    if (regular && info.st_size == 0) return buffer;
+    if (regular) {
+        const size_t length = static_cast<size_t>(info.st_size);
+        void* mapping = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, file.fd, 0);
+        if (mapping != MAP_FAILED) {
+            ::madvise(mapping, length, MADV_SEQUENTIAL);
+            buffer->mapping = mapping;
+            buffer->data = static_cast<const char*>(mapping);
+            buffer->length = length;
+            return buffer;
+        }
+    }
+
+    // Pipes, special files and failed mappings.
+    if (regular) buffer->owned.reserve(static_cast<size_t>(info.st_size));
+    char chunk[1 << 16];
+    while (true) {
+        const ssize_t got = ::read(file.fd, chunk, sizeof(chunk));
+        if (got == 0) break;
+        if (got < 0 && errno == EINTR) continue;
+        if (got < 0) throw std::runtime_error("Error: Cannot read file '" + path + "'.");
+        buffer->owned.append(chunk, static_cast<size_t>(got));
+    }
+    buffer->data = buffer->owned.data();
+    buffer->length = buffer->owned.size();
+    return buffer;
+}
+
+SharedPtr<SourceBuffer> SourceBuffer::fromString(String text) {
+    SharedPtr<SourceBuffer> buffer(new SourceBuffer());
+    buffer->owned = std::move(text);
+    buffer->data = buffer->owned.data();
+    buffer->length = buffer->owned.size();
+    return buffer;
+}
+
+SourceBuffer::~SourceBuffer() {
+    if (mapping) ::munmap(mapping, length);
+}
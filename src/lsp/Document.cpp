@@ -0,0 +1,580 @@
+#include <algorithm>
+#include <cctype>
+#include <regex>
+
+#include "lsp/Document.hpp"
+#include "core/errors.h"
+#include "core/Tokenizer.hpp"
+#include "core/Parser.hpp"
+#include "core/Environments/Scope.hpp"
+#include "ast/AstControl.hpp"
+
+namespace {
+
+bool isLayout(TokenType type) {
+    return type == TokenType::Newline || type == TokenType::Indent || type == TokenType::Dedent
+        || type == TokenType::SOF_Token || type == TokenType::EOF_Token;
+}
+
+// Tokens that refer to a variable, function or class.
+bool isName(TokenType type) {
+    switch (type) {
+        case TokenType::Type:
+        case TokenType::Identifier:
+        case TokenType::Variable:
+        case TokenType::AccessorVariable:
+        case TokenType::FunctionCall:
+        case TokenType::FunctionRef:
+        case TokenType::Parameter:
+        case TokenType::Argument:
+        case TokenType::ClassCall:
+        case TokenType::ClassRef:
+        case TokenType::ClassMethodCall:
+        case TokenType::ClassMethodRef:
+        case TokenType::ChainEntryPoint:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool isWordChar(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+bool isWord(const String& text) {
+    return !text.empty() && !std::isdigit(static_cast<unsigned char>(text[0])) && std::all_of(text.begin(), text.end(), isWordChar);
+}
+
+// Adds the words in a line, for a block that did not lex.
+void addWords(const String& line, std::unordered_set<String>& out) {
+    for (size_t i = 0; i < line.size();) {
+        if (!isWordChar(line[i])) {++i; continue;}
+        size_t j = i;
+        while (j < line.size() && isWordChar(line[j])) {++j;}
+        if (!std::isdigit(static_cast<unsigned char>(line[i]))) {out.insert(line.substr(i, j - i));}
+        i = j;
+    }
+}
+
+bool startsWithWord(const String& line, std::string_view word) {
+    if (line.compare(0, word.size(), word) != 0) {return false;}
+    if (line.size() == word.size()) {return true;}
+    return !isWordChar(line[word.size()]);
+}
+
+// Whether a line's text lets it start a block: something in column 1 that is not a comment,
+// elif or else.
+bool couldOpen(const String& text) {
+    if (text.empty() || text[0] == ' ' || text[0] == '\t' || text[0] == '#') {return false;}
+    return !startsWithWord(text, "elif") && !startsWithWord(text, "else");
+}
+
+int bracketStep(const Token& token) {
+    if (token.type == TokenType::LeftBracket) {return 1;}
+    if (token.type == TokenType::RightBracket) {return -1;}
+    if (token.type != TokenType::Punctuation) {return 0;}
+    if (token.value == "(" || token.value == "{") {return 1;}
+    if (token.value == ")" || token.value == "}") {return -1;}
+    return 0;
+}
+
+// elif and else carry on the if above them.
+bool continuesBlock(const String& word) {
+    return word == "elif" || word == "else";
+}
+
+Vector<String> splitLines(const String& text) {
+    Vector<String> lines(1);
+    for (const char c : text) {
+        if (c == '\n') {
+            if (!lines.back().empty() && lines.back().back() == '\r') {lines.back().pop_back();}
+            lines.emplace_back();
+        } else {
+            lines.back() += c;
+        }
+    }
+    if (!lines.back().empty() && lines.back().back() == '\r') {lines.back().pop_back();}
+    return lines;
+}
+
+// Error text is coloured for a terminal.
+String plainText(const String& message) {
+    static const std::regex colour("\x1b\\[[0-9;]*m");
+    return std::regex_replace(message, colour, "");
+}
+
+// The 1-based line and column an error message names, if it names one.
+bool locate(const String& message, int& line, int& column) {
+    static const std::regex lineColumn("Line: (\\d+),\\s+Column: (\\d+)");
+    static const std::regex lineAt(" at (\\d+):(\\d+)");
+    std::smatch match;
+    if (!std::regex_search(message, match, lineColumn) && !std::regex_search(message, match, lineAt)) {
+        return false;
+    }
+    line = std::stoi(match[1].str());
+    column = std::stoi(match[2].str());
+    return true;
+}
+
+// The first line of a message, without the prefixes it gathered on the way up.
+String headline(const String& message) {
+    String first = message.substr(0, message.find('\n'));
+    const String wrapper = "MerkError: ";
+    while (first.rfind(wrapper, 0) == 0) {first.erase(0, wrapper.size());}
+    return first;
+}
+
+// A lex error counts lines from where its region started, which the diagnostic's range
+// already says better.
+String withoutLocation(const String& message) {
+    static const std::regex location(" on Line: \\d+,\\s+Column: \\d+| at \\d+:\\d+");
+    return std::regex_replace(message, location, "");
+}
+
+} // namespace
+
+Document::Document(const ScopeFactory& makeScope, bool incremental) : incremental(incremental) {
+    scope = makeScope(natives);
+    config = natives;
+    setText("");
+}
+
+Document::~Document() {
+    if (scope) {scope->clear();}
+}
+
+void Document::setText(const String& text) {
+    stats = {};
+    lines = splitLines(text);
+    blocks.clear();
+    blocks.emplace_back();
+    classCounts.clear();
+    functionCounts.clear();
+    changedNames.clear();
+    config = natives;
+
+    relex(0, 1);
+    refreshNames();
+    for (Block& block : blocks) {
+        if (!block.parsed) {parse(block);}
+    }
+    stats.blocks = blocks.size();
+}
+
+void Document::edit(Position from, Position to, const String& text) {
+    const auto clamp = [this](Position& at) {
+        at.line = std::clamp(at.line, 0, static_cast<int>(lines.size()) - 1);
+        at.column = std::clamp(at.column, 0, static_cast<int>(lines[at.line].size()));
+    };
+    clamp(from);
+    clamp(to);
+    if (to.line < from.line || (to.line == from.line && to.column < from.column)) {std::swap(from, to);}
+
+    Vector<String> inserted = splitLines(text);
+    inserted.front().insert(0, lines[from.line], 0, from.column);
+    inserted.back().append(lines[to.line], to.column);
+    const int delta = static_cast<int>(inserted.size()) - (to.line - from.line + 1);
+    lines.erase(lines.begin() + from.line, lines.begin() + to.line + 1);
+    lines.insert(lines.begin() + from.line, std::make_move_iterator(inserted.begin()), std::make_move_iterator(inserted.end()));
+
+    if (!incremental) {
+        setText(this->text());
+        return;
+    }
+
+    stats = {};
+    // An edit on a block's first line can join it to the block above.
+    size_t first = blockAt(from.line);
+    const size_t last = blockAt(to.line);
+    if (first > 0 && blocks[first].start == from.line) {--first;}
+    for (size_t i = last + 1; i < blocks.size(); ++i) {
+        blocks[i].start += delta;
+        // A parse error names the lines it was found on.
+        if (delta != 0 && blocks[i].diagnostic && !blocks[i].tokens.empty()) {blocks[i].parsed = false;}
+    }
+
+    relex(first, last + 1);
+    refreshNames();
+    for (Block& block : blocks) {
+        if (!block.parsed) {parse(block);}
+    }
+    stats.blocks = blocks.size();
+}
+
+String Document::text() const {
+    String out;
+    for (size_t i = 0; i < lines.size(); ++i) {
+        if (i) {out += '\n';}
+        out += lines[i];
+    }
+    return out;
+}
+
+size_t Document::blockAt(int line) const {
+    auto it = std::upper_bound(blocks.begin(), blocks.end(), line,
+        [](int target, const Block& block) { return target < block.start; });
+    return it == blocks.begin() ? 0 : static_cast<size_t>(it - blocks.begin()) - 1;
+}
+
+int Document::endOf(size_t index) const {
+    return index + 1 < blocks.size() ? blocks[index + 1].start : static_cast<int>(lines.size());
+}
+
+// Re-lexes blocks [first, end). Starts from blocks[first].start, which must still begin a
+// block, and the blocks from `end` on must already be at their new lines. Where that does not
+// lex, everything above the line the lexer gave up on is taken as it came out, and the rest a
+// piece at a time, cut at the lines that could start a block, up to the piece that fails; that
+// one becomes a block of its own and lexing goes on in one run after it. Which blocks come out
+// depends only on the text from the first one down, so an edit gets the blocks setText would.
+void Document::relex(size_t first, size_t end) {
+    const int size = static_cast<int>(lines.size());
+    const auto oldStart = [&](size_t index) { return index < blocks.size() ? blocks[index].start : size; };
+    Vector<Block> fresh;
+    int from = blocks[first].start;
+    const auto landed = [&]() {
+        while (end < blocks.size() && blocks[end].start < from) {++end;}
+        return from == oldStart(end);
+    };
+
+    bool whole = true;
+    while (true) {
+        if (whole) {
+            int stop = size;
+            try {
+                if (lexRegion(from, oldStart(end), end < blocks.size(), fresh)) {break;}
+                ++end;
+                continue;
+            } catch (const std::exception& e) {
+                int line = 0;
+                int column = 0;
+                if (locate(plainText(e.what()), line, column)) {stop = from + line - 1;}
+            }
+            const int cut = lastOpening(from, stop);
+            try {
+                if (cut > from && lexRegion(from, cut, true, fresh)) {from = cut;}
+            } catch (const std::exception&) {}
+            whole = false;
+            if (landed()) {break;}
+        }
+
+        int to = from;
+        while (true) {
+            to = nextOpening(to);
+            try {
+                if (lexRegion(from, to, to < size, fresh)) {break;}
+                continue;  // still inside a bracket or string
+            } catch (const std::exception&) {}
+            try {
+                lexRegion(from, to, false, fresh);  // the probe line may be the one at fault
+            } catch (const std::exception& e) {
+                fresh.push_back(failed(from, to, e));
+                whole = true;
+            }
+            break;
+        }
+        from = to;
+        if (landed()) {break;}
+    }
+    replace(first, end, std::move(fresh));
+}
+
+// The first line after `line` that could start a block, going by its text alone.
+int Document::nextOpening(int line) const {
+    const int size = static_cast<int>(lines.size());
+    while (++line < size && !couldOpen(lines[line])) {}
+    return line;
+}
+
+// The last line in (from, line] that could start a block, else `from`.
+int Document::lastOpening(int from, int line) const {
+    for (line = std::min(line, static_cast<int>(lines.size()) - 1); line > from; --line) {
+        if (couldOpen(lines[line])) {return line;}
+    }
+    return from;
+}
+
+Document::Block Document::failed(int start, int end, const std::exception& error) {
+    Block block;
+    block.start = start;
+    block.parsed = true;
+    for (int line = start; line < end; ++line) {
+        addWords(lines[line], block.names);
+    }
+    const String message = plainText(error.what());
+    Diagnostic diagnostic;
+    int line = 0;
+    int column = 0;
+    if (locate(message, line, column)) {
+        diagnostic.line = std::max(line - 1, 0);
+        diagnostic.column = std::max(column - 1, 0);
+    }
+    diagnostic.message = withoutLocation(headline(message));
+    block.diagnostic = std::move(diagnostic);
+    ++stats.lexedBlocks;
+    return block;
+}
+
+// Lexes lines [regionStart, regionEnd) and cuts them into blocks. With `probe`, the line at
+// regionEnd is lexed too and must come out starting a block; false when it does not.
+bool Document::lexRegion(int regionStart, int regionEnd, bool probe, Vector<Block>& out) {
+    String source;
+    for (int line = regionStart; line < regionEnd + (probe ? 1 : 0); ++line) {
+        source += lines[line];
+        source += '\n';
+    }
+    Tokenizer tokenizer(source, false);
+    Vector<Token>& tokens = tokenizer.tokenize(config);
+    stats.lexedLines += static_cast<size_t>(regionEnd - regionStart);
+
+    const int probeLine = regionEnd - regionStart + 1;
+    const size_t firstOut = out.size();
+    out.emplace_back().start = regionStart;
+    bool content = false;
+    bool lineStart = true;
+    bool probed = false;
+    int depth = 0;
+    int brackets = 0;  // counted as the scanner does, which stops tracking indentation inside them
+
+    for (Token& token : tokens) {
+        if (token.type == TokenType::SOF_Token) {continue;}
+        if (token.type == TokenType::EOF_Token) {break;}
+        if (token.type == TokenType::Indent) {++depth;}
+        if (token.type == TokenType::Dedent) {--depth;}
+        if (token.type == TokenType::Newline) {lineStart = true;}
+
+        if (!isLayout(token.type)) {
+            const bool opens = content && lineStart && depth == 0 && brackets == 0 && token.column == 1
+                && !continuesBlock(token.value);
+            lineStart = false;
+            brackets = std::max(brackets + bracketStep(token), 0);
+            if (probe && token.line >= probeLine) {
+                probed = opens;
+                break;
+            }
+            if (opens) {
+                out.emplace_back().start = regionStart + token.line - 1;
+            }
+            content = true;
+        }
+
+        Block& block = out.back();
+        token.line -= block.start - regionStart;
+        block.tokens.push_back(std::move(token));
+    }
+
+    if (probe && !probed) {
+        out.resize(firstOut);
+        return false;
+    }
+    for (size_t i = firstOut; i < out.size(); ++i) {
+        index(out[i]);
+    }
+    stats.lexedBlocks += out.size() - firstOut;
+    return true;
+}
+
+void Document::replace(size_t first, size_t end, Vector<Block> fresh) {
+    for (size_t i = first; i < end; ++i) {
+        count(classCounts, blocks[i].classes, -1);
+        count(functionCounts, blocks[i].functions, -1);
+    }
+    for (const Block& block : fresh) {
+        count(classCounts, block.classes, 1);
+        count(functionCounts, block.functions, 1);
+    }
+    blocks.erase(blocks.begin() + first, blocks.begin() + end);
+    blocks.insert(blocks.begin() + first, std::make_move_iterator(fresh.begin()), std::make_move_iterator(fresh.end()));
+}
+
+void Document::count(std::unordered_map<String, size_t>& counts, const Vector<String>& names, int step) {
+    for (const String& name : names) {
+        size_t& n = counts[name];
+        if (step < 0) {
+            if (--n == 0) {changedNames.insert(name); counts.erase(name);}
+        } else if (n++ == 0) {
+            changedNames.insert(name);
+        }
+    }
+}
+
+// Brings the config up to the names the document defines now, and re-lexes every block
+// that mentions one that came or went.
+void Document::refreshNames() {
+    while (!changedNames.empty()) {
+        Vector<String> changed;
+        for (const String& name : changedNames) {
+            const bool isClass = classCounts.count(name) || natives.nativeClasses.count(name);
+            const bool isFunction = functionCounts.count(name) || natives.nativeFuncs.count(name);
+            bool moved = false;
+            if (isClass != static_cast<bool>(config.nativeClasses.count(name))) {
+                if (isClass) {config.nativeClasses.insert(name);} else {config.nativeClasses.erase(name);}
+                moved = true;
+            }
+            if (isFunction != static_cast<bool>(config.nativeFuncs.count(name))) {
+                if (isFunction) {config.nativeFuncs.insert(name);} else {config.nativeFuncs.erase(name);}
+                moved = true;
+            }
+            if (moved) {changed.push_back(name);}
+        }
+        changedNames.clear();
+        if (changed.empty()) {return;}
+
+        const auto mentions = [&changed](const Block& block) {
+            return std::any_of(changed.begin(), changed.end(),
+                [&block](const String& name) { return block.names.count(name) > 0; });
+        };
+        // Runs of neighbouring blocks lex as one region, each from the block before it, whose
+        // end was found by lexing the first line of the one that changed. The last run goes
+        // first so the indices of the ones before it hold.
+        Vector<std::pair<size_t, size_t>> runs;
+        for (size_t i = 0; i < blocks.size(); ++i) {
+            if (!mentions(blocks[i])) {continue;}
+            const size_t from = i > 0 ? i - 1 : 0;
+            if (!runs.empty() && runs.back().second >= from) {
+                runs.back().second = i + 1;
+            } else {
+                runs.emplace_back(from, i + 1);
+            }
+        }
+        for (auto run = runs.rbegin(); run != runs.rend(); ++run) {
+            relex(run->first, run->second);
+        }
+    }
+}
+
+void Document::index(Block& block) {
+    int depth = 0;
+    String owner;
+    const Vector<Token>& tokens = block.tokens;
+    for (size_t i = 0; i < tokens.size(); ++i) {
+        const Token& token = tokens[i];
+        if (token.type == TokenType::Indent) {++depth;}
+        if (token.type == TokenType::Dedent) {--depth;}
+        // Any word may lex differently once the document defines it, a definition's own name included.
+        if (isWord(token.value)) {block.names.insert(token.value);}
+        if (i + 1 >= tokens.size()) {continue;}
+
+        const Token& name = tokens[i + 1];
+        const auto add = [&](SymbolKind kind, String container) {
+            block.symbols.push_back({name.value, kind, name.line - 1, name.column - 1, std::move(container)});
+        };
+        if (token.type == TokenType::ClassDef && name.type == TokenType::ClassRef) {
+            block.classes.push_back(name.value);
+            owner = name.value;
+            add(SymbolKind::Class, "");
+        } else if (token.type == TokenType::FunctionDef && name.type == TokenType::FunctionRef) {
+            block.functions.push_back(name.value);
+            add(SymbolKind::Function, "");
+        } else if (token.type == TokenType::ClassMethodDef && name.type == TokenType::ClassMethodRef) {
+            block.functions.push_back(name.value);
+            add(SymbolKind::Method, owner);
+        } else if (token.type == TokenType::VarDeclaration && depth == 0 && isName(name.type)
+                   && !(i + 2 < tokens.size() && tokens[i + 2].value == ".")) {
+            add(SymbolKind::Variable, "");
+        }
+    }
+}
+
+void Document::parse(Block& block) {
+    block.parsed = true;
+    block.diagnostic.reset();
+    ++stats.parsedBlocks;
+
+    Vector<Token> tokens;
+    tokens.reserve(block.tokens.size() + 2);
+    tokens.emplace_back(TokenType::SOF_Token, "SOF", 0, 0);
+    int lastLine = block.start + 1;
+    for (const Token& token : block.tokens) {
+        tokens.push_back(token);
+        tokens.back().line += block.start;
+        lastLine = tokens.back().line;
+    }
+    tokens.emplace_back(TokenType::EOF_Token, "EOF", lastLine, 1);
+
+    // Each parse gets its own scope under the root, dropped with the tree.
+    SharedPtr<Scope> blockScope = scope->createChildScope();
+    {
+        Parser parser(tokens, blockScope, false, false);
+        try {
+            UniquePtr<CodeBlock> ast = parser.parse();
+            ast->clear();
+        } catch (const std::exception& e) {
+            const String message = plainText(e.what());
+            int line = 0;
+            int column = 0;
+            if (!locate(message, line, column) || line <= block.start) {
+                line = parser.stoppedAt().line;
+                column = parser.stoppedAt().column;
+            }
+            if (line <= block.start) {
+                line = block.start + 1;
+                column = 1;
+            }
+
+            Diagnostic diagnostic;
+            diagnostic.line = line - 1 - block.start;
+            diagnostic.column = std::max(column - 1, 0);
+            for (const Token& token : block.tokens) {
+                if (token.line == diagnostic.line + 1 && token.column == column && !isLayout(token.type)) {
+                    diagnostic.length = std::max<int>(1, static_cast<int>(token.value.size()));
+                    break;
+                }
+            }
+            diagnostic.message = headline(message);
+            block.diagnostic = std::move(diagnostic);
+        }
+    }
+    blockScope->clear();
+    scope->removeChildScope(blockScope);
+}
+
+Vector<Document::Diagnostic> Document::diagnostics() const {
+    Vector<Diagnostic> out;
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        if (!blocks[i].diagnostic) {continue;}
+        Diagnostic diagnostic = *blocks[i].diagnostic;
+        // Dedents closing a block sit on the next block's first line.
+        diagnostic.line = std::min(blocks[i].start + diagnostic.line, endOf(i) - 1);
+        out.push_back(std::move(diagnostic));
+    }
+    return out;
+}
+
+Vector<Document::Symbol> Document::symbols() const {
+    Vector<Symbol> out;
+    for (const Block& block : blocks) {
+        for (Symbol symbol : block.symbols) {
+            symbol.line += block.start;
+            out.push_back(std::move(symbol));
+        }
+    }
+    return out;
+}
+
+std::optional<Document::Symbol> Document::definitionAt(Position at) const {
+    if (at.line < 0 || at.line >= static_cast<int>(lines.size())) {return std::nullopt;}
+    const Block& block = blocks[blockAt(at.line)];
+    const int line = at.line - block.start + 1;
+    const Token* name = nullptr;
+    for (const Token& token : block.tokens) {
+        if (token.line == line && isName(token.type) && at.column >= token.column - 1
+            && at.column < token.column - 1 + static_cast<int>(token.value.size())) {
+            name = &token;
+            break;
+        }
+    }
+    if (!name) {return std::nullopt;}
+
+    std::optional<Symbol> above;
+    for (const Block& candidate : blocks) {
+        for (const Symbol& symbol : candidate.symbols) {
+            if (symbol.name != name->value) {continue;}
+            Symbol found = symbol;
+            found.line += candidate.start;
+            if (found.line > at.line) {return above ? above : std::optional<Symbol>(std::move(found));}
+            above = std::move(found);
+        }
+    }
+    return above;
+}
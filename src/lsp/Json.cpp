@@ -0,0 +1,294 @@
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include "lsp/Json.hpp"
+#include "core/errors.h"
+
+namespace {
+
+class JsonReader {
+public:
+    explicit JsonReader(std::string_view source) : source(source) {}
+
+    Json document() {
+        Json value = read();
+        skipSpace();
+        if (position != source.size()) {fail("trailing characters");}
+        return value;
+    }
+
+private:
+    std::string_view source;
+    size_t position = 0;
+
+    [[noreturn]] void fail(const String& what) const {
+        throw MerkError("Malformed JSON at offset " + std::to_string(position) + ": " + what);
+    }
+
+    void skipSpace() {
+        while (position < source.size()) {
+            const char c = source[position];
+            if (c != ' ' && c != '\t' && c != '\n' && c != '\r') {break;}
+            ++position;
+        }
+    }
+
+    bool take(char c) {
+        skipSpace();
+        if (position < source.size() && source[position] == c) {++position; return true;}
+        return false;
+    }
+
+    void expect(char c) {
+        if (!take(c)) {fail(String("expected '") + c + "'");}
+    }
+
+    void word(std::string_view w) {
+        if (source.substr(position, w.size()) != w) {fail("unknown literal");}
+        position += w.size();
+    }
+
+    Json read() {
+        skipSpace();
+        if (position >= source.size()) {fail("unexpected end");}
+        switch (source[position]) {
+            case '{': return readObject();
+            case '[': return readArray();
+            case '"': return Json(readString());
+            case 't': word("true"); return Json(true);
+            case 'f': word("false"); return Json(false);
+            case 'n': word("null"); return Json();
+            default: return readNumber();
+        }
+    }
+
+    Json readObject() {
+        expect('{');
+        Json::Object fields;
+        if (take('}')) {return Json(std::move(fields));}
+        do {
+            skipSpace();
+            String key = readString();
+            expect(':');
+            fields.emplace_back(std::move(key), read());
+        } while (take(','));
+        expect('}');
+        return Json(std::move(fields));
+    }
+
+    Json readArray() {
+        expect('[');
+        Json::Array items;
+        if (take(']')) {return Json(std::move(items));}
+        do {
+            items.push_back(read());
+        } while (take(','));
+        expect(']');
+        return Json(std::move(items));
+    }
+
+    Json readNumber() {
+        const size_t start = position;
+        while (position < source.size()) {
+            const char c = source[position];
+            if ((c < '0' || c > '9') && c != '-' && c != '+' && c != '.' && c != 'e' && c != 'E') {break;}
+            ++position;
+        }
+        if (start == position) {fail("unexpected character");}
+        const String digits(source.substr(start, position - start));
+        char* end = nullptr;
+        const double value = std::strtod(digits.c_str(), &end);
+        if (end != digits.c_str() + digits.size()) {fail("bad number");}
+        return Json(value);
+    }
+
+    unsigned hex4() {
+        if (position + 4 > source.size()) {fail("short \\u escape");}
+        unsigned value = 0;
+        for (int i = 0; i < 4; ++i) {
+            const char c = source[position++];
+            value <<= 4;
+            if (c >= '0' && c <= '9') {value |= static_cast<unsigned>(c - '0');}
+            else if (c >= 'a' && c <= 'f') {value |= static_cast<unsigned>(c - 'a' + 10);}
+            else if (c >= 'A' && c <= 'F') {value |= static_cast<unsigned>(c - 'A' + 10);}
+            else {fail("bad \\u escape");}
+        }
+        return value;
+    }
+
+    static void appendUtf8(String& out, unsigned code) {
+        if (code < 0x80) {
+            out += static_cast<char>(code);
+        } else if (code < 0x800) {
+            out += static_cast<char>(0xC0 | (code >> 6));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        } else if (code < 0x10000) {
+            out += static_cast<char>(0xE0 | (code >> 12));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (code >> 18));
+            out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        }
+    }
+
+    String readString() {
+        if (position >= source.size() || source[position] != '"') {fail("expected string");}
+        ++position;
+        String out;
+        while (true) {
+            if (position >= source.size()) {fail("unterminated string");}
+            const char c = source[position++];
+            if (c == '"') {return out;}
+            if (c != '\\') {out += c; continue;}
+            if (position >= source.size()) {fail("unterminated string");}
+            const char escaped = source[position++];
+            switch (escaped) {
+                case '"': out += '"'; break;
+                case '\\': out += '\\'; break;
+                case '/': out += '/'; break;
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'n': out += '\n'; break;
+                case 'r': out += '\r'; break;
+                case 't': out += '\t'; break;
+                case 'u': {
+                    unsigned code = hex4();
+                    // A high surrogate followed by its low half is one code point.
+                    if (code >= 0xD800 && code < 0xDC00 && source.substr(position, 2) == "\\u") {
+                        position += 2;
+                        const unsigned low = hex4();
+                        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    appendUtf8(out, code);
+                    break;
+                }
+                default: fail("bad escape");
+            }
+        }
+    }
+};
+
+void writeString(String& out, const String& text) {
+    out += '"';
+    for (const char c : text) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+                    out += escaped;
+                } else {
+                    out += c;
+                }
+        }
+    }
+    out += '"';
+}
+
+const Json kNull;
+const String kEmptyString;
+const Json::Array kEmptyArray;
+
+} // namespace
+
+Json Json::object(std::initializer_list<std::pair<String, Json>> values) {
+    return Json(Object(values));
+}
+
+Json Json::array(std::initializer_list<Json> values) {
+    return Json(Array(values));
+}
+
+Json Json::parse(std::string_view source) {
+    return JsonReader(source).document();
+}
+
+String Json::dump() const {
+    String out;
+    write(out);
+    return out;
+}
+
+void Json::write(String& out) const {
+    switch (kind) {
+        case Kind::Null: out += "null"; return;
+        case Kind::Bool: out += boolean ? "true" : "false"; return;
+        case Kind::Number: {
+            // Positions and ids are integers; print them without a fraction.
+            if (std::floor(number) == number && std::fabs(number) < 1e15) {
+                out += std::to_string(static_cast<long long>(number));
+            } else {
+                char digits[32];
+                std::snprintf(digits, sizeof(digits), "%.17g", number);
+                out += digits;
+            }
+            return;
+        }
+        case Kind::String: writeString(out, text); return;
+        case Kind::Array:
+            out += '[';
+            for (size_t i = 0; i < items.size(); ++i) {
+                if (i) {out += ',';}
+                items[i].write(out);
+            }
+            out += ']';
+            return;
+        case Kind::Object:
+            out += '{';
+            for (size_t i = 0; i < fields.size(); ++i) {
+                if (i) {out += ',';}
+                writeString(out, fields[i].first);
+                out += ':';
+                fields[i].second.write(out);
+            }
+            out += '}';
+            return;
+    }
+}
+
+const String& Json::asString() const {
+    return kind == Kind::String ? text : kEmptyString;
+}
+
+const Json::Array& Json::asArray() const {
+    return kind == Kind::Array ? items : kEmptyArray;
+}
+
+bool Json::has(std::string_view key) const {
+    return !(*this)[key].isNull();
+}
+
+const Json& Json::operator[](std::string_view key) const {
+    if (kind != Kind::Object) {return kNull;}
+    for (const auto& [name, value] : fields) {
+        if (name == key) {return value;}
+    }
+    return kNull;
+}
+
+Json& Json::set(String key, Json value) {
+    if (kind != Kind::Object) {
+        *this = Json(Object{});
+    }
+    for (auto& [name, existing] : fields) {
+        if (name == key) {existing = std::move(value); return *this;}
+    }
+    fields.emplace_back(std::move(key), std::move(value));
+    return *this;
+}
+
+void Json::push(Json value) {
+    if (kind != Kind::Array) {
+        *this = Json(Array{});
+    }
+    items.push_back(std::move(value));
+}
@@ -0,0 +1,207 @@
+#include <istream>
+#include <ostream>
+#include <streambuf>
+
+#include "lsp/LanguageServer.hpp"
+#include "core/errors.h"
+
+namespace {
+
+// JSON-RPC and LSP error codes.
+constexpr int kMethodNotFound = -32601;
+constexpr int kInternalError = -32603;
+constexpr int kServerNotInitialized = -32002;
+
+class DiscardBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return traits_type::not_eof(c); }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+int symbolKind(Document::SymbolKind kind) {
+    switch (kind) {
+        case Document::SymbolKind::Class: return 5;
+        case Document::SymbolKind::Method: return 6;
+        case Document::SymbolKind::Function: return 12;
+        case Document::SymbolKind::Variable: return 13;
+    }
+    return 13;
+}
+
+Json position(int line, int column) {
+    return Json::object({{"line", line}, {"character", column}});
+}
+
+Json range(int line, int column, int length) {
+    return Json::object({{"start", position(line, column)}, {"end", position(line, column + length)}});
+}
+
+Document::Position toPosition(const Json& at) {
+    return {at["line"].asInt(), at["character"].asInt()};
+}
+
+} // namespace
+
+LanguageServer::LanguageServer(std::istream& in, std::ostream& out, Document::ScopeFactory makeScope)
+    : in(in), out(out), makeScope(std::move(makeScope)) {}
+
+int LanguageServer::run() {
+    DiscardBuffer discard;
+    std::streambuf* console = std::cout.rdbuf(&discard);
+
+    String body;
+    bool initialized = false;
+    while (!exited && read(body)) {
+        Json message;
+        try {
+            message = Json::parse(body);
+        } catch (const MerkError&) {
+            continue;
+        }
+
+        const String& method = message["method"].asString();
+        const Json& id = message["id"];
+        if (!initialized && method != "initialize" && method != "exit") {
+            if (!id.isNull()) {fail(id, kServerNotInitialized, "Server not initialized");}
+            continue;
+        }
+        initialized = true;
+
+        try {
+            handle(message);
+        } catch (const std::exception& e) {
+            if (!id.isNull()) {fail(id, kInternalError, e.what());}
+        }
+    }
+
+    std::cout.rdbuf(console);
+    return exited && shutdown ? 0 : 1;
+}
+
+bool LanguageServer::read(String& body) {
+    size_t length = 0;
+    bool sized = false;
+    String header;
+    while (std::getline(in, header)) {
+        if (!header.empty() && header.back() == '\r') {header.pop_back();}
+        if (header.empty()) {
+            if (sized) {break;}
+            continue;
+        }
+        const String key = "Content-Length:";
+        if (header.compare(0, key.size(), key) == 0) {
+            length = std::stoul(header.substr(key.size()));
+            sized = true;
+        }
+    }
+    if (!sized) {return false;}
+
+    body.resize(length);
+    in.read(body.data(), static_cast<std::streamsize>(length));
+    return static_cast<size_t>(in.gcount()) == length;
+}
+
+void LanguageServer::send(const Json& message) {
+    const String body = message.dump();
+    out << "Content-Length: " << body.size() << "\r\n\r\n" << body;
+    out.flush();
+}
+
+void LanguageServer::respond(const Json& id, Json result) {
+    send(Json::object({{"jsonrpc", "2.0"}, {"id", id}, {"result", std::move(result)}}));
+}
+
+void LanguageServer::fail(const Json& id, int code, const String& message) {
+    send(Json::object({{"jsonrpc", "2.0"}, {"id", id},
+                       {"error", Json::object({{"code", code}, {"message", message}})}}));
+}
+
+void LanguageServer::notify(const String& method, Json params) {
+    send(Json::object({{"jsonrpc", "2.0"}, {"method", method}, {"params", std::move(params)}}));
+}
+
+void LanguageServer::handle(const Json& message) {
+    const String& method = message["method"].asString();
+    const Json& id = message["id"];
+    const Json& params = message["params"];
+    const String& uri = params["textDocument"]["uri"].asString();
+
+    if (method == "initialize") {
+        const Json sync = Json::object({{"openClose", true}, {"change", 2}});  // 2: incremental
+        const Json capabilities = Json::object({
+            {"textDocumentSync", sync},
+            {"documentSymbolProvider", true},
+            {"definitionProvider", true},
+        });
+        respond(id, Json::object({{"capabilities", capabilities}, {"serverInfo", Json::object({{"name", "merk"}})}}));
+    } else if (method == "shutdown") {
+        shutdown = true;
+        respond(id, Json());
+    } else if (method == "exit") {
+        exited = true;
+    } else if (method == "textDocument/didOpen") {
+        auto doc = makeUnique<Document>(makeScope);
+        doc->setText(params["textDocument"]["text"].asString());
+        documents[uri] = std::move(doc);
+        publishDiagnostics(uri);
+    } else if (method == "textDocument/didChange") {
+        Document& doc = document(uri);
+        for (const Json& change : params["contentChanges"].asArray()) {
+            const Json& changed = change["range"];
+            if (changed.isNull()) {
+                doc.setText(change["text"].asString());
+            } else {
+                doc.edit(toPosition(changed["start"]), toPosition(changed["end"]), change["text"].asString());
+            }
+        }
+        publishDiagnostics(uri);
+    } else if (method == "textDocument/didClose") {
+        documents.erase(uri);
+        notify("textDocument/publishDiagnostics", Json::object({{"uri", uri}, {"diagnostics", Json::array()}}));
+    } else if (method == "textDocument/documentSymbol") {
+        respond(id, documentSymbols(uri));
+    } else if (method == "textDocument/definition") {
+        respond(id, definition(uri, params["position"]));
+    } else if (!id.isNull()) {
+        fail(id, kMethodNotFound, "Unhandled method " + method);
+    }
+}
+
+Document& LanguageServer::document(const String& uri) const {
+    auto it = documents.find(uri);
+    if (it == documents.end()) {throw MerkError("Document " + uri + " is not open");}
+    return *it->second;
+}
+
+void LanguageServer::publishDiagnostics(const String& uri) {
+    Json diagnostics = Json::array();
+    for (const Document::Diagnostic& diagnostic : document(uri).diagnostics()) {
+        diagnostics.push(Json::object({
+            {"range", range(diagnostic.line, diagnostic.column, diagnostic.length)},
+            {"severity", 1},
+            {"source", "merk"},
+            {"message", diagnostic.message},
+        }));
+    }
+    notify("textDocument/publishDiagnostics", Json::object({{"uri", uri}, {"diagnostics", std::move(diagnostics)}}));
+}
+
+Json LanguageServer::documentSymbols(const String& uri) const {
+    Json symbols = Json::array();
+    for (const Document::Symbol& symbol : document(uri).symbols()) {
+        Json entry = Json::object({
+            {"name", symbol.name},
+            {"kind", symbolKind(symbol.kind)},
+            {"location", Json::object({{"uri", uri}, {"range", range(symbol.line, symbol.column, static_cast<int>(symbol.name.size()))}})},
+        });
+        if (!symbol.container.empty()) {entry.set("containerName", symbol.container);}
+        symbols.push(std::move(entry));
+    }
+    return symbols;
+}
+
+Json LanguageServer::definition(const String& uri, const Json& at) const {
+    const auto symbol = document(uri).definitionAt(toPosition(at));
+    if (!symbol) {return Json();}
+    return Json::object({{"uri", uri}, {"range", range(symbol->line, symbol->column, static_cast<int>(symbol->name.size()))}});
+}
@@ -0,0 +1,41 @@
+#include <cstdlib>
+#include <new>
+
+#include "utilities/allocation_counter.h"
+
+// Kept in its own translation unit so the replacements are never inlined into a caller,
+// where GCC would pair the builtin new with free() and warn.
+namespace {
+thread_local std::size_t gAllocationCount = 0;
+}
+
+std::size_t allocationCount() { return gAllocationCount; }
+
+#if MERK_COUNT_ALLOCATIONS
+
+void* operator new(std::size_t size) {
+    ++gAllocationCount;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) { return ::operator new(size); }
+
+// std::stable_sort's scratch buffer comes from the nothrow form.
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    ++gAllocationCount;
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept { return ::operator new(size, tag); }
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+
+#endif
@@ -1,5 +1,6 @@
 #include "core/types.h"
 #include "utilities/debugger.h"
+#include "core/Environments/Isolate.hpp"
 #include <algorithm>
 #include <iomanip> // For setw, left, etc.
 #include <unordered_map>
@@ -16,6 +17,10 @@ String stripAnsi(const String& input) {
     static const std::regex ansiPattern("\033\\[[0-9;]*m");
     return std::regex_replace(input, ansiPattern, "");
 }
+Debugger& Debugger::getInstance() {
+    return Isolate::current().debugger();
+}
+
 // Global log level.
 void Debugger::setGlobalLogLevel(LogLevel level) { currentLevel = level; }
 void Debugger::setGlobalFlowLevel(FlowLevel level) {flowLevel = level;}
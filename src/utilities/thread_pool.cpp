@@ -0,0 +1,136 @@
+#include <stdexcept>
+
+#include "utilities/thread_pool.h"
+
+namespace {
+
+thread_local std::size_t workerIndex = WorkStealingPool::npos;
+thread_local const WorkStealingPool* workerPool = nullptr;
+
+} // namespace
+
+
+WorkStealingPool::WorkStealingPool(std::size_t workers) {
+    if (workers == 0) workers = 1;
+    queues.reserve(workers);
+    for (std::size_t i = 0; i < workers; ++i) {
+        queues.push_back(std::make_unique<Queue>());
+    }
+    threads.reserve(workers);
+    for (std::size_t i = 0; i < workers; ++i) {
+        threads.emplace_back([this, i] { workerLoop(i); });
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+bool WorkStealingPool::isWorkerThread() const {
+    return workerPool == this;
+}
+
+std::size_t WorkStealingPool::currentWorker() {
+    return workerIndex;
+}
+
+void WorkStealingPool::submit(Task task) {
+    std::size_t target = (workerPool == this)
+        ? workerIndex
+        : nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+
+    unfinished.fetch_add(1);
+    queued.fetch_add(1);
+    {
+        std::lock_guard<std::mutex> lock(queues[target]->mutex);
+        queues[target]->tasks.push_back(std::move(task));
+    }
+
+    // Pairs with the sleeper count in workerLoop: either the sleeper sees the task or we see it.
+    if (sleepers.load() > 0) {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        workAvailable.notify_one();
+    }
+}
+
+void WorkStealingPool::wait() {
+    if (isWorkerThread()) {
+        throw std::logic_error("WorkStealingPool::wait called from one of its own workers");
+    }
+    std::unique_lock<std::mutex> lock(doneMutex);
+    allDone.wait(lock, [this] { return unfinished.load() == 0; });
+}
+
+bool WorkStealingPool::runPending() {
+    if (!isWorkerThread()) return false;
+    Task task;
+    if (!tryTake(workerIndex, task)) return false;
+    task(workerIndex);
+    finished();
+    return true;
+}
+
+void WorkStealingPool::finished() {
+    if (unfinished.fetch_sub(1) == 1) {
+        std::lock_guard<std::mutex> lock(doneMutex);
+        allDone.notify_all();
+    }
+}
+
+bool WorkStealingPool::tryTake(std::size_t self, Task& out) {
+    {
+        Queue& own = *queues[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            out = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            queued.fetch_sub(1);
+            return true;
+        }
+    }
+
+    for (std::size_t offset = 1; offset < queues.size(); ++offset) {
+        Queue& victim = *queues[(self + offset) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            out = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            queued.fetch_sub(1);
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::workerLoop(std::size_t self) {
+    workerIndex = self;
+    workerPool = this;
+
+    while (true) {
+        Task task;
+        if (tryTake(self, task)) {
+            task(self);
+            finished();
+            continue;
+        }
+
+        // A task counted in `queued` may not be visible in its deque yet; look again before sleeping.
+        if (queued.load() > 0) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleepers.fetch_add(1);
+        workAvailable.wait(lock, [this] { return stopping || queued.load() > 0; });
+        sleepers.fetch_sub(1);
+        if (stopping && queued.load() == 0) return; // stopping with nothing left to run
+    }
+}